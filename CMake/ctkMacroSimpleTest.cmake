@@ -32,3 +32,23 @@ macro(SIMPLE_TEST testname)
   set_property(TEST ${testname} PROPERTY LABELS ${KIT})
 endmacro()
 
+#! Usage:
+#! \code
+#! SIMPLE_BENCHMARK(<testname> [argument1 ...])
+#! \endcode
+#!
+#! This macro adds a benchmark the same way as SIMPLE_TEST(), only if
+#! CTK_BUILD_BENCHMARKS is ON. Benchmarks are also labeled "Benchmark" so that
+#! they can be run (ctest -L Benchmark) or excluded (ctest -LE Benchmark) as a
+#! group. When the option is OFF, the benchmark is still built in the test
+#! driver and can be run manually: ${KIT}CppTests <testname>
+#!
+#! \sa SIMPLE_TEST
+#!
+#! \ingroup CMakeUtilities
+macro(SIMPLE_BENCHMARK testname)
+  if(CTK_BUILD_BENCHMARKS)
+    SIMPLE_TEST(${testname} ${ARGN})
+    set_property(TEST ${testname} PROPERTY LABELS ${KIT} Benchmark)
+  endif()
+endmacro()
@@ -25,6 +25,15 @@
 namespace ctk {
 namespace CmdLineModuleBackendFunctionPointer {
 
+//----------------------------------------------------------------------------
+const QString& ParameterName(int index)
+{
+  // Function pointers have at most two parameters
+  static const QString names[] = { QString("param0"), QString("param1") };
+  Q_ASSERT(index >= 0 && index < 2);
+  return names[index];
+}
+
 //----------------------------------------------------------------------------
 FunctionPointerHolderBase::~FunctionPointerHolderBase()
 {
@@ -61,5 +70,11 @@ void FunctionPointerProxy::call(const QList<QVariant> &args)
   FpHolder->call(args);
 }
 
+//----------------------------------------------------------------------------
+void FunctionPointerProxy::call(const QHash<QString, QVariant>& values)
+{
+  FpHolder->call(values);
+}
+
 }
 }
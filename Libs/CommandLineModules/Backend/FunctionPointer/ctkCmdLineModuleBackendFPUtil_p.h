@@ -24,6 +24,7 @@
 
 #include "ctkCommandLineModulesBackendFunctionPointerExport.h"
 
+#include <QHash>
 #include <QVariant>
 
 class ctkCmdLineModuleBackendFunctionPointer;
@@ -31,6 +32,12 @@ class ctkCmdLineModuleBackendFunctionPointer;
 namespace ctk {
 namespace CmdLineModuleBackendFunctionPointer {
 
+/**
+ * Returns the name of the function parameter at \c index, as used in the
+ * generated XML description. The returned string is shared between calls.
+ */
+CTK_CMDLINEMODULEBACKENDFP_EXPORT const QString& ParameterName(int index);
+
 struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerHolderBase
 {
   virtual ~FunctionPointerHolderBase();
@@ -38,6 +45,11 @@ struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerHolderBase
   virtual FunctionPointerHolderBase* clone() const = 0;
 
   virtual void call(const QList<QVariant>& args) = 0;
+
+  /**
+   * Call the function pointer with values keyed by parameter name.
+   */
+  virtual void call(const QHash<QString, QVariant>& values) = 0;
 };
 
 
@@ -60,6 +72,11 @@ struct FunctionPointerHolder : public FunctionPointerHolderBase
     Fp(args.at(0).value<A>());
   }
 
+  void call(const QHash<QString, QVariant>& values)
+  {
+    Fp(values.value(ParameterName(0)).template value<A>());
+  }
+
   FunctionPointerType Fp;
 };
 
@@ -83,6 +100,12 @@ struct FunctionPointerHolder2 : public FunctionPointerHolderBase
     Fp(args.at(0).value<A>(), args.at(1).value<B>());
   }
 
+  void call(const QHash<QString, QVariant>& values)
+  {
+    Fp(values.value(ParameterName(0)).template value<A>(),
+       values.value(ParameterName(1)).template value<B>());
+  }
+
   FunctionPointerType Fp;
 };
 
@@ -103,6 +126,7 @@ struct CTK_CMDLINEMODULEBACKENDFP_EXPORT FunctionPointerProxy
     : FpHolder(new FunctionPointerHolder2<A,B>(fp)) {}
 
   void call(const QList<QVariant>& args);
+  void call(const QHash<QString, QVariant>& values);
 
 private:
 
@@ -27,6 +27,7 @@
 
 #include "ctkCmdLineModuleFuture.h"
 #include "ctkCmdLineModuleFrontend.h"
+#include "ctkCmdLineModuleReference.h"
 
 #include <QByteArray>
 #include <QString>
@@ -257,6 +258,20 @@ QList<QVariant> ctkCmdLineModuleBackendFunctionPointer::arguments(ctkCmdLineModu
   return frontend->values().values();
 }
 
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleBackendFunctionPointer::runBatchItem(const ctkCmdLineModuleReference& moduleRef,
+                                                          const QHash<QString, QVariant>& values,
+                                                          ctkCmdLineModuleFuture& future)
+{
+  QHash<QUrl, Description>::const_iterator iter = d->UrlToFpDescription.find(moduleRef.location());
+  if (iter == d->UrlToFpDescription.end()) return false;
+
+  // The manager filled in default values, so every function parameter has a value
+  ctkCmdLineModuleFunctionPointerTask* fpTask = new ctkCmdLineModuleFunctionPointerTask(iter.value(), values);
+  future = fpTask->start();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 QList<QUrl> ctkCmdLineModuleBackendFunctionPointer::registeredFunctionPointers() const
 {
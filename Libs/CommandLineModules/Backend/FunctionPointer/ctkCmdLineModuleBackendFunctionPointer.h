@@ -56,7 +56,7 @@ struct CreateXmlFor
     QString xmlParameter;
     QTextStream str(&xmlParameter);
     str << "    <" << typeName << ">\n";
-    str << "      <name>" << QString("param%1").arg(index) << "</name>\n";
+    str << "      <name>" << ParameterName(index) << "</name>\n";
     str << "      <index>" << index << "</index>\n";
     str << "      <description>" << (description.isEmpty() ? "Description not available." : description) << "</description>\n";
     str << "      <label>" << (label.isEmpty() ? QString("Parameter %1").arg(index) : label) << "</label>\n";
@@ -74,7 +74,7 @@ struct CreateXmlFor<T, typename EnableIf<IsBaseOf<ImageType, T>::value >::Type >
     QString xmlParameter;
     QTextStream str(&xmlParameter);
     str << "    <" << typeName << ">\n";
-    str << "      <name>" << QString("param%1").arg(index) << "</name>\n";
+    str << "      <name>" << ParameterName(index) << "</name>\n";
     str << "      <index>" << index << "</index>\n";
     str << "      <description>" << (description.isEmpty() ? "Description not available." : description) << "</description>\n";
     str << "      <label>" << (label.isEmpty() ? QString("Parameter %1").arg(index) : label) << "</label>\n";
@@ -194,6 +194,14 @@ protected:
 
   virtual QList<QVariant> arguments(ctkCmdLineModuleFrontend* frontend) const;
 
+  /**
+   * Calls the function pointer with the batch values directly, without
+   * creating a front-end or an argument list per item.
+   */
+  virtual bool runBatchItem(const ctkCmdLineModuleReference& moduleRef,
+                            const QHash<QString, QVariant>& values,
+                            ctkCmdLineModuleFuture& future);
+
 private:
 
   Description* registerFunctionPointerProxy(const QString &title,
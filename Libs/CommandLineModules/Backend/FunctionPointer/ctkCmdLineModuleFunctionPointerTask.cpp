@@ -30,6 +30,15 @@
 ctkCmdLineModuleFunctionPointerTask::ctkCmdLineModuleFunctionPointerTask(const ctkCmdLineModuleBackendFunctionPointer::Description &fpDescr, const QList<QVariant> &paramValues)
   : FpDescription(fpDescr)
   , ParamValues(paramValues)
+  , UseNamedParams(false)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFunctionPointerTask::ctkCmdLineModuleFunctionPointerTask(const ctkCmdLineModuleBackendFunctionPointer::Description &fpDescr, const QHash<QString, QVariant> &namedValues)
+  : FpDescription(fpDescr)
+  , NamedParamValues(namedValues)
+  , UseNamedParams(true)
 {
 }
 
@@ -40,7 +49,7 @@ ctkCmdLineModuleFuture ctkCmdLineModuleFunctionPointerTask::start()
   this->setProgressRange(0,0);
   this->reportStarted();
   ctkCmdLineModuleFuture future = this->future();
-  QThreadPool::globalInstance()->start(this, /*m_priority*/ 0);
+  this->startRunnable(this);
   return future;
 }
 
@@ -57,7 +66,14 @@ void ctkCmdLineModuleFunctionPointerTask::run()
   QString excMsg;
   try
   {
-    FpDescription.d->FpProxy.call(ParamValues);
+    if (UseNamedParams)
+    {
+      FpDescription.d->FpProxy.call(NamedParamValues);
+    }
+    else
+    {
+      FpDescription.d->FpProxy.call(ParamValues);
+    }
   }
   catch (const std::exception& e)
   {
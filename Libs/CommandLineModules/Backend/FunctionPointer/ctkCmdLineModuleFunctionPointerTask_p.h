@@ -40,6 +40,12 @@ public:
 
   ctkCmdLineModuleFunctionPointerTask(const ctkCmdLineModuleBackendFunctionPointer::Description& fpDescr, const QList<QVariant>& paramValues);
 
+  /**
+   * Creates a task which passes the values to the function pointer by
+   * parameter name.
+   */
+  ctkCmdLineModuleFunctionPointerTask(const ctkCmdLineModuleBackendFunctionPointer::Description& fpDescr, const QHash<QString, QVariant>& namedValues);
+
   ctkCmdLineModuleFuture start();
 
   void run();
@@ -48,6 +54,8 @@ private:
 
   ctkCmdLineModuleBackendFunctionPointer::Description FpDescription;
   QList<QVariant> ParamValues;
+  QHash<QString, QVariant> NamedParamValues;
+  bool UseNamedParams;
 };
 
 #endif // CTKCMDLINEMODULEFUNCTIONPOINTERTASK_P_H
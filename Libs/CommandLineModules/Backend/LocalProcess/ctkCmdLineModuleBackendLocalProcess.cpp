@@ -29,16 +29,23 @@
 #include "ctkCmdLineModuleProcessTask.h"
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleRunException.h"
+#include "ctkCmdLineModuleWorkerPool_p.h"
+#include "ctkCmdLineModuleWorkerProcessTask_p.h"
 
 #include "ctkUtils.h"
 #include <iostream>
 #include <QProcess>
+#include <QSharedPointer>
 #include <QUrl>
 
 //----------------------------------------------------------------------------
 struct ctkCmdLineModuleBackendLocalProcessPrivate
 {
 
+  ctkCmdLineModuleBackendLocalProcessPrivate()
+    : WorkerPool(new ctkCmdLineModuleWorkerPool)
+  {}
+
   QString normalizeFlag(const QString& flag) const
   {
     return flag.trimmed().remove(QRegExp("^-*"));
@@ -121,6 +128,9 @@ struct ctkCmdLineModuleBackendLocalProcessPrivate
 
     return cmdLineArgs;
   }
+
+  // Shared with running worker tasks, which may outlive the back-end
+  QSharedPointer<ctkCmdLineModuleWorkerPool> WorkerPool;
 };
 
 //----------------------------------------------------------------------------
@@ -185,10 +195,31 @@ QByteArray ctkCmdLineModuleBackendLocalProcess::rawXmlDescription(const QUrl &lo
 ctkCmdLineModuleFuture ctkCmdLineModuleBackendLocalProcess::run(ctkCmdLineModuleFrontend* frontend)
 {
   QStringList args = d->commandLineArguments(frontend->values(), frontend->moduleReference().description());
+  const QString location = frontend->location().toLocalFile();
+
+  if (d->WorkerPool->poolSize(location) > 0)
+  {
+    // Auto-deleted by the thread pool, like ctkCmdLineModuleProcessTask.
+    ctkCmdLineModuleWorkerProcessTask* workerTask =
+        new ctkCmdLineModuleWorkerProcessTask(d->WorkerPool, location, args);
+    return workerTask->start();
+  }
 
   // Instances of ctkCmdLineModuleProcessTask are auto-deleted by the
   // thread pool.
   ctkCmdLineModuleProcessTask* moduleProcess =
-      new ctkCmdLineModuleProcessTask(frontend->location().toLocalFile(), args);
+      new ctkCmdLineModuleProcessTask(location, args);
   return moduleProcess->start();
 }
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBackendLocalProcess::setWorkerProcessCount(const QUrl& location, int count)
+{
+  d->WorkerPool->setPoolSize(location.toLocalFile(), count);
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleBackendLocalProcess::workerProcessCount(const QUrl& location) const
+{
+  return d->WorkerPool->poolSize(location.toLocalFile());
+}
@@ -48,6 +48,22 @@ struct ctkCmdLineModuleBackendLocalProcessPrivate;
  *
  * The ctkCmdLineModuleFuture returned by run() allows cancelation by killing the running
  * process. On Unix systems, it also allows to pause it.
+ *
+ * By default, every run starts a new process. Modules which are run very often can
+ * opt in to a persistent worker mode via setWorkerProcessCount(). In this mode, the
+ * back-end keeps a pool of long-lived processes, started with the \c &ndash;&ndash;worker
+ * argument, and feeds them successive parameter sets over their standard input:
+ *
+ * - A job is framed as the number of arguments followed by a newline, and for each
+ *   argument its UTF-8 byte count, a newline, the UTF-8 data and another newline.
+ * - The module writes the usual progress XML and output for the job on its standard
+ *   output and terminates the job output with a
+ *   \c &lt;ctk-worker-job-end&nbsp;exit-code="N"/&gt; line.
+ * - The module terminates the error output of the job with the same line on its
+ *   standard error. A worker which does not is not reused for the next job.
+ * - The module exits when its standard input is closed.
+ *
+ * Canceling a job kills its worker process; a new one is started on demand.
  */
 class CTK_CMDLINEMODULEBACKENDLP_EXPORT ctkCmdLineModuleBackendLocalProcess : public ctkCmdLineModuleBackend
 {
@@ -90,6 +106,23 @@ public:
    */
   virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend *frontend);
 
+  /**
+   * @brief Enables the persistent worker mode for a module.
+   * @param location The location URL of the module.
+   * @param count The maximum number of worker processes for the module. A value of zero
+   *        (the default) disables the worker mode and runs a new process for each job.
+   *
+   * The module must support the worker protocol described in the class documentation.
+   */
+  void setWorkerProcessCount(const QUrl& location, int count);
+
+  /**
+   * @brief Get the maximum number of worker processes for a module.
+   * @param location The location URL of the module.
+   * @return The maximum number of worker processes, zero if the worker mode is disabled.
+   */
+  int workerProcessCount(const QUrl& location) const;
+
 private:
 
   QScopedPointer<ctkCmdLineModuleBackendLocalProcessPrivate> d;
@@ -27,7 +27,6 @@
 
 #include <QDebug>
 #include <QEventLoop>
-#include <QThreadPool>
 #include <QProcess>
 
 //----------------------------------------------------------------------------
@@ -63,7 +62,7 @@ ctkCmdLineModuleFuture ctkCmdLineModuleProcessTask::start()
   this->setRunnable(this);
   this->reportStarted();
   ctkCmdLineModuleFuture future = this->future();
-  QThreadPool::globalInstance()->start(this, /*m_priority*/ 0);
+  this->startRunnable(this);
   return future;
 }
 
@@ -88,9 +87,9 @@ void ctkCmdLineModuleProcessTask::run()
   process.start(d->Location, d->Args, QIODevice::ReadOnly | QIODevice::Text);
 
   ctkCmdLineModuleProcessWatcher progressWatcher(process, d->Location, *this);
-  Q_UNUSED(progressWatcher)
 
   localLoop.exec();
+  progressWatcher.flushProgress();
 
   if (process.error() != QProcess::UnknownError || process.exitCode() != 0)
   {
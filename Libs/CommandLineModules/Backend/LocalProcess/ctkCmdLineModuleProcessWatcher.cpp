@@ -33,22 +33,44 @@
 //----------------------------------------------------------------------------
 ctkCmdLineModuleProcessWatcher::ctkCmdLineModuleProcessWatcher(QProcess& process, const QString& location,
                                                                ctkCmdLineModuleFutureInterface &futureInterface)
-  : process(process), location(location), futureInterface(futureInterface), processXmlWatcher(&process),
+  : process(process), location(location), futureInterface(futureInterface),
+    processXmlWatcher(new ctkCmdLineModuleXmlProgressWatcher(&process)),
     processPaused(false), progressValue(0)
+{
+  this->init();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleProcessWatcher::ctkCmdLineModuleProcessWatcher(QProcess& process, QIODevice* xmlInput,
+                                                               const QString& location,
+                                                               ctkCmdLineModuleFutureInterface &futureInterface)
+  : process(process), location(location), futureInterface(futureInterface),
+    processXmlWatcher(new ctkCmdLineModuleXmlProgressWatcher(xmlInput)),
+    processPaused(false), progressValue(0)
+{
+  this->init();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessWatcher::init()
 {
   // The reported float value in the range [0.0,1.0] for the progress is scaled to [0,1000].
   // Value 1001 is reserved for the last "filter-end" output, which is reported as a progress event.
   // Value 1002 is reserved internally to report process termination.
   futureInterface.setProgressRange(0, 1002);
 
-  connect(&processXmlWatcher, SIGNAL(filterStarted(QString,QString)), SLOT(filterStarted(QString,QString)));
-  connect(&processXmlWatcher, SIGNAL(filterProgress(float,QString)), SLOT(filterProgress(float,QString)));
-  connect(&processXmlWatcher, SIGNAL(filterResult(QString,QString)), SLOT(filterResult(QString,QString)));
-  connect(&processXmlWatcher, SIGNAL(filterFinished(QString,QString)), SLOT(filterFinished(QString,QString)));
-  connect(&processXmlWatcher, SIGNAL(filterXmlError(QString)), SLOT(filterXmlError(QString)));
+  // QFutureInterface notifies watchers at most 25 times per second anyway,
+  // so coalesce chatty progress output before it reaches the future.
+  processXmlWatcher->setMaxProgressRate(25);
 
-  connect(&processXmlWatcher, SIGNAL(outputDataAvailable(QByteArray)), SLOT(outputDataAvailable(QByteArray)));
-  connect(&processXmlWatcher, SIGNAL(errorDataAvailable(QByteArray)), SLOT(errorDataAvailable(QByteArray)));
+  connect(processXmlWatcher.data(), SIGNAL(filterStarted(QString,QString)), SLOT(filterStarted(QString,QString)));
+  connect(processXmlWatcher.data(), SIGNAL(filterProgress(float,QString)), SLOT(filterProgress(float,QString)));
+  connect(processXmlWatcher.data(), SIGNAL(filterResult(QString,QString)), SLOT(filterResult(QString,QString)));
+  connect(processXmlWatcher.data(), SIGNAL(filterFinished(QString,QString)), SLOT(filterFinished(QString,QString)));
+  connect(processXmlWatcher.data(), SIGNAL(filterXmlError(QString)), SLOT(filterXmlError(QString)));
+
+  connect(processXmlWatcher.data(), SIGNAL(outputDataAvailable(QByteArray)), SLOT(outputDataAvailable(QByteArray)));
+  connect(processXmlWatcher.data(), SIGNAL(errorDataAvailable(QByteArray)), SLOT(errorDataAvailable(QByteArray)));
 
   connect(&futureWatcher, SIGNAL(canceled()), SLOT(cancelProcess()));
 #ifdef Q_OS_UNIX
@@ -63,6 +85,12 @@ ctkCmdLineModuleProcessWatcher::ctkCmdLineModuleProcessWatcher(QProcess& process
   futureWatcher.setFuture(futureInterface.future());
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleProcessWatcher::flushProgress()
+{
+  processXmlWatcher->flushProgress();
+}
+
 //----------------------------------------------------------------------------
 void ctkCmdLineModuleProcessWatcher::filterStarted(const QString& name, const QString& comment)
 {
@@ -31,6 +31,7 @@
 
 class ctkCmdLineModuleResult;
 
+class QIODevice;
 class QProcess;
 
 /**
@@ -47,6 +48,20 @@ public:
   ctkCmdLineModuleProcessWatcher(QProcess& process, const QString& location,
                                  ctkCmdLineModuleFutureInterface& futureInterface);
 
+  /**
+   * Watches the progress XML read from \c xmlInput instead of the standard
+   * output of \c process. The standard error channel of \c process is
+   * not forwarded in this case.
+   */
+  ctkCmdLineModuleProcessWatcher(QProcess& process, QIODevice* xmlInput, const QString& location,
+                                 ctkCmdLineModuleFutureInterface& futureInterface);
+
+  /**
+   * Reports a coalesced progress update that is still pending. Call this
+   * when the process finished, the output may end with a progress element.
+   */
+  void flushProgress();
+
 protected Q_SLOTS:
 
   void filterStarted(const QString& name, const QString& comment);
@@ -65,13 +80,15 @@ protected Q_SLOTS:
 
 private:
 
+  void init();
+
   int updateProgress(float progress);
   int incrementProgress();
 
   QProcess& process;
   QString location;
   ctkCmdLineModuleFutureInterface& futureInterface;
-  ctkCmdLineModuleXmlProgressWatcher processXmlWatcher;
+  QScopedPointer<ctkCmdLineModuleXmlProgressWatcher> processXmlWatcher;
   QFutureWatcher<ctkCmdLineModuleResult> futureWatcher;
   QTimer pollPauseTimer;
   bool processPaused;
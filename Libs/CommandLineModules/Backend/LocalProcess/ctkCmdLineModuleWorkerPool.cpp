@@ -0,0 +1,194 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleWorkerPool_p.h"
+
+#include <QProcess>
+#include <QStringList>
+#include <QThread>
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerHolder::moveProcess(QProcess* process, QThread* thread)
+{
+  process->moveToThread(thread);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleWorkerPool::ctkCmdLineModuleWorkerPool()
+{
+  qRegisterMetaType<QProcess*>("QProcess*");
+  qRegisterMetaType<QThread*>("QThread*");
+
+  Holder.moveToThread(&IdleThread);
+  IdleThread.start();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleWorkerPool::~ctkCmdLineModuleWorkerPool()
+{
+  // Busy workers keep a reference to the pool, so only idle
+  // workers are left.
+  foreach(const Workers& workers, LocationToWorkers)
+  {
+    foreach(QProcess* process, workers.Idle)
+    {
+      shutdown(process);
+    }
+  }
+
+  IdleThread.quit();
+  IdleThread.wait();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPool::setPoolSize(const QString& location, int size)
+{
+  QList<QProcess*> obsolete;
+  {
+    QMutexLocker lock(&Mutex);
+    Workers& workers = LocationToWorkers[location];
+    workers.MaxSize = qMax(0, size);
+    while (workers.Idle.size() > workers.MaxSize)
+    {
+      obsolete.push_back(workers.Idle.takeFirst());
+      --workers.Count;
+    }
+    WorkerAvailable.wakeAll();
+  }
+
+  foreach(QProcess* process, obsolete)
+  {
+    shutdown(process);
+  }
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleWorkerPool::poolSize(const QString& location) const
+{
+  QMutexLocker lock(&Mutex);
+  QHash<QString, Workers>::const_iterator iter = LocationToWorkers.find(location);
+  return iter == LocationToWorkers.end() ? 0 : iter.value().MaxSize;
+}
+
+//----------------------------------------------------------------------------
+QProcess* ctkCmdLineModuleWorkerPool::acquire(const QString& location)
+{
+  QMutexLocker lock(&Mutex);
+  forever
+  {
+    Workers& workers = LocationToWorkers[location];
+    if (!workers.Idle.isEmpty())
+    {
+      QProcess* process = workers.Idle.takeLast();
+      lock.unlock();
+
+      takeProcess(process);
+      if (process->state() == QProcess::Running)
+      {
+        return process;
+      }
+
+      // the worker died while being idle
+      delete process;
+      lock.relock();
+      --LocationToWorkers[location].Count;
+      continue;
+    }
+
+    if (workers.Count < qMax(1, workers.MaxSize))
+    {
+      ++workers.Count;
+      break;
+    }
+
+    WorkerAvailable.wait(&Mutex);
+  }
+  lock.unlock();
+
+  QProcess* process = new QProcess;
+  process->setReadChannel(QProcess::StandardOutput);
+  process->start(location, QStringList("--worker"));
+  if (!process->waitForStarted())
+  {
+    delete process;
+    this->release(location, NULL, false);
+    return NULL;
+  }
+  return process;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPool::release(const QString& location, QProcess* process, bool reuse)
+{
+  if (process && reuse && process->state() == QProcess::Running)
+  {
+    QMutexLocker lock(&Mutex);
+    Workers& workers = LocationToWorkers[location];
+    if (workers.Idle.size() < workers.MaxSize)
+    {
+      // The next call to acquire() might happen in a different
+      // thread, hand the process over to the idle thread.
+      process->moveToThread(&IdleThread);
+      workers.Idle.push_back(process);
+      WorkerAvailable.wakeAll();
+      return;
+    }
+
+    // the pool has been shrunk in the meantime
+  }
+
+  if (process)
+  {
+    shutdown(process);
+  }
+
+  QMutexLocker lock(&Mutex);
+  --LocationToWorkers[location].Count;
+  WorkerAvailable.wakeAll();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPool::takeProcess(QProcess* process)
+{
+  if (process->thread() == &IdleThread)
+  {
+    QMetaObject::invokeMethod(&Holder, "moveProcess", Qt::BlockingQueuedConnection,
+                              Q_ARG(QProcess*, process), Q_ARG(QThread*, QThread::currentThread()));
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPool::shutdown(QProcess* process)
+{
+  takeProcess(process);
+
+  if (process->state() != QProcess::NotRunning)
+  {
+    // workers terminate when their standard input is closed
+    process->closeWriteChannel();
+    if (!process->waitForFinished(1000))
+    {
+      process->kill();
+      process->waitForFinished();
+    }
+  }
+  delete process;
+}
@@ -0,0 +1,125 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULEWORKERPOOL_P_H
+#define CTKCMDLINEMODULEWORKERPOOL_P_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+class QProcess;
+
+/**
+ * \class ctkCmdLineModuleWorkerHolder
+ * \brief Lives in the thread owning the idle worker processes and hands
+ * them over to other threads.
+ * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * QObject::moveToThread() can only push an object from its current thread,
+ * so the thread owning the idle workers has to do it.
+ */
+class ctkCmdLineModuleWorkerHolder : public QObject
+{
+  Q_OBJECT
+
+public Q_SLOTS:
+
+  void moveProcess(QProcess* process, QThread* thread);
+};
+
+/**
+ * \class ctkCmdLineModuleWorkerPool
+ * \brief Keeps long-lived module processes which run in worker mode.
+ * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * Worker processes are started with the \c --worker argument and are
+ * handed out to one task at a time. Idle workers are owned by a thread of
+ * the pool running an event loop, so they keep receiving the notifications
+ * of their process, e.g. when it exits. acquire() moves them into the
+ * calling thread.
+ *
+ * This class is thread-safe.
+ */
+class ctkCmdLineModuleWorkerPool
+{
+
+public:
+
+  ctkCmdLineModuleWorkerPool();
+  ~ctkCmdLineModuleWorkerPool();
+
+  /**
+   * Sets the maximum number of worker processes for a module. A size of
+   * zero disables the worker mode for this module and shuts down its idle
+   * workers.
+   */
+  void setPoolSize(const QString& location, int size);
+
+  int poolSize(const QString& location) const;
+
+  /**
+   * Returns an idle worker process for the module, or starts a new one.
+   * Blocks while the maximum number of workers for the module is busy.
+   * The returned process is owned by the calling thread.
+   *
+   * @return A running worker process, or \c NULL if the process could not
+   *         be started.
+   */
+  QProcess* acquire(const QString& location);
+
+  /**
+   * Returns a worker process to the pool. Processes which are not running
+   * anymore, or if \c reuse is \c false, are terminated.
+   */
+  void release(const QString& location, QProcess* process, bool reuse);
+
+private:
+
+  Q_DISABLE_COPY(ctkCmdLineModuleWorkerPool)
+
+  struct Workers
+  {
+    Workers() : MaxSize(0), Count(0) {}
+
+    int MaxSize;
+    // the number of started worker processes, idle or busy
+    int Count;
+    QList<QProcess*> Idle;
+  };
+
+  // Moves a process owned by IdleThread into the calling thread
+  void takeProcess(QProcess* process);
+  void shutdown(QProcess* process);
+
+  QThread IdleThread;
+  ctkCmdLineModuleWorkerHolder Holder;
+
+  mutable QMutex Mutex;
+  QWaitCondition WorkerAvailable;
+  QHash<QString, Workers> LocationToWorkers;
+};
+
+#endif // CTKCMDLINEMODULEWORKERPOOL_P_H
@@ -0,0 +1,270 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleWorkerProcessTask_p.h"
+#include "ctkCmdLineModuleProcessWatcher_p.h"
+#include "ctkCmdLineModuleRunException.h"
+#include "ctkCmdLineModuleWorkerPool_p.h"
+#include "ctkCmdLineModuleFuture.h"
+
+#include <QEventLoop>
+#include <QProcess>
+
+namespace {
+
+const QByteArray JobEndMarker = "<ctk-worker-job-end exit-code=\"";
+const QByteArray JobEndMarkerClose = "\"/>";
+
+// The time to wait for the standard error end marker once the
+// standard output end marker has been read
+const int ErrorEndTimeout = 1000;
+
+// Moves the job data from the start of pending to jobData. Returns true
+// and sets exitCode if the job end marker was found.
+bool takeJobData(QByteArray& pending, QByteArray& jobData, int& exitCode)
+{
+  int markerPos = pending.indexOf(JobEndMarker);
+  int closePos = markerPos < 0 ? -1 : pending.indexOf(JobEndMarkerClose, markerPos);
+  if (closePos >= 0)
+  {
+    const int codePos = markerPos + JobEndMarker.size();
+    exitCode = pending.mid(codePos, closePos - codePos).toInt();
+    jobData = pending.left(markerPos);
+    pending.clear();
+    return true;
+  }
+
+  // keep enough data to recognize a partially received marker
+  int keep = markerPos >= 0 ? pending.size() - markerPos : qMin(pending.size(), JobEndMarker.size() - 1);
+  jobData = pending.left(pending.size() - keep);
+  pending.remove(0, jobData.size());
+  return false;
+}
+
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleWorkerJobReader::ctkCmdLineModuleWorkerJobReader(QProcess& process, QEventLoop& loop,
+                                                                 ctkCmdLineModuleFutureInterface& futureInterface)
+  : process(process), loop(loop), futureInterface(futureInterface),
+    finished(false), errorFinished(false), jobExitCode(0)
+{
+  output.open(QIODevice::ReadWrite);
+
+  errorTimer.setSingleShot(true);
+  errorTimer.setInterval(ErrorEndTimeout);
+  connect(&errorTimer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+  connect(&process, SIGNAL(readyReadStandardOutput()), SLOT(readOutput()));
+  connect(&process, SIGNAL(readyReadStandardError()), SLOT(readError()));
+  connect(&process, SIGNAL(finished(int)), SLOT(processFinished()));
+  connect(&process, SIGNAL(error(QProcess::ProcessError)), SLOT(processFinished()));
+}
+
+//----------------------------------------------------------------------------
+QIODevice* ctkCmdLineModuleWorkerJobReader::jobOutput()
+{
+  return &output;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleWorkerJobReader::isFinished() const
+{
+  return finished;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleWorkerJobReader::exitCode() const
+{
+  return jobExitCode;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleWorkerJobReader::isErrorFinished() const
+{
+  return errorFinished;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleWorkerJobReader::errorOutput() const
+{
+  return error;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerJobReader::readOutput()
+{
+  if (finished) return;
+
+  pending.append(process.readAllStandardOutput());
+
+  QByteArray jobData;
+  finished = takeJobData(pending, jobData, jobExitCode);
+  if (!jobData.isEmpty())
+  {
+    output.seek(output.size());
+    output.write(jobData);
+  }
+
+  if (finished)
+  {
+    this->checkJobEnd();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerJobReader::readError()
+{
+  if (errorFinished) return;
+
+  errorPending.append(process.readAllStandardError());
+
+  QByteArray errorData;
+  int errorExitCode = 0;
+  errorFinished = takeJobData(errorPending, errorData, errorExitCode);
+  if (!errorData.isEmpty())
+  {
+    error.append(errorData);
+    futureInterface.reportErrorData(errorData);
+  }
+
+  if (errorFinished)
+  {
+    this->checkJobEnd();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerJobReader::checkJobEnd()
+{
+  if (!finished) return;
+
+  if (errorFinished)
+  {
+    errorTimer.stop();
+    // QBuffer emits readyRead() asynchronously, quit the loop after
+    // the progress watcher has processed the last job output.
+    QMetaObject::invokeMethod(&loop, "quit", Qt::QueuedConnection);
+  }
+  else if (!errorTimer.isActive())
+  {
+    errorTimer.start();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerJobReader::processFinished()
+{
+  // the worker process crashed, was killed or exited prematurely
+  loop.quit();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleWorkerProcessTask::ctkCmdLineModuleWorkerProcessTask(const QSharedPointer<ctkCmdLineModuleWorkerPool>& pool,
+                                                                     const QString& location, const QStringList& args)
+  : Pool(pool), Location(location), Args(args)
+{
+  this->setCanCancel(true);
+#ifdef Q_OS_UNIX
+  this->setCanPause(true);
+#endif
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleWorkerProcessTask::start()
+{
+  this->setRunnable(this);
+  this->reportStarted();
+  ctkCmdLineModuleFuture future = this->future();
+  this->startRunnable(this);
+  return future;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerProcessTask::run()
+{
+  if (this->isCanceled())
+  {
+    this->reportFinished();
+    return;
+  }
+
+  QProcess* process = Pool->acquire(Location);
+  if (process == NULL)
+  {
+    this->reportException(ctkCmdLineModuleRunException(Location, 0, QObject::tr("Could not start the worker process.")));
+    this->setProgressValueAndText(1002, QObject::tr("Finished."));
+    this->reportFinished();
+    return;
+  }
+
+  bool reuse = false;
+  {
+    QEventLoop localLoop;
+    ctkCmdLineModuleWorkerJobReader jobReader(*process, localLoop, *this);
+    ctkCmdLineModuleProcessWatcher progressWatcher(*process, jobReader.jobOutput(), Location, *this);
+
+    QByteArray frame = QByteArray::number(Args.size()) + '\n';
+    foreach(const QString& arg, Args)
+    {
+      const QByteArray data = arg.toUtf8();
+      frame += QByteArray::number(data.size()) + '\n' + data + '\n';
+    }
+    process->write(frame);
+
+    localLoop.exec();
+    progressWatcher.flushProgress();
+
+    const bool jobFinished = jobReader.isFinished();
+    // Without the standard error end marker, error output of this job
+    // could show up in the next one
+    reuse = jobFinished && jobReader.isErrorFinished();
+    if (!jobFinished)
+    {
+      this->reportException(ctkCmdLineModuleRunException(Location, process->exitCode(), process->errorString()));
+    }
+    else if (jobReader.exitCode() != 0)
+    {
+      // The worker itself is fine, report what the job wrote to stderr
+      QString errorString = QString::fromLocal8Bit(jobReader.errorOutput()).trimmed();
+      if (errorString.isEmpty())
+      {
+        errorString = QObject::tr("The module exited with code %1.").arg(jobReader.exitCode());
+      }
+      this->reportException(ctkCmdLineModuleRunException(Location, jobReader.exitCode(), errorString));
+    }
+  }
+
+  // Canceled or crashed workers are not reused
+  Pool->release(Location, process, reuse);
+
+  if (this->progressValue() == 1001)
+  {
+    // We got a "filter-end" progress report, potentially with a comment,
+    // so don't overwrite the comment in the progress text.
+    this->setProgressValue(1002);
+  }
+  else
+  {
+    this->setProgressValueAndText(1002, QObject::tr("Finished."));
+  }
+  this->reportFinished();
+}
@@ -0,0 +1,132 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULEWORKERPROCESSTASK_P_H
+#define CTKCMDLINEMODULEWORKERPROCESSTASK_P_H
+
+#include "ctkCmdLineModuleFutureInterface.h"
+
+#include <QBuffer>
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QTimer>
+
+class ctkCmdLineModuleWorkerPool;
+
+class QEventLoop;
+class QProcess;
+
+/**
+ * \class ctkCmdLineModuleWorkerJobReader
+ * \brief Splits the standard output and error of a worker process into
+ * the output of the current job and the job end markers.
+ * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * Standard output and error are separate pipes, so the worker terminates
+ * the job on both of them. The event loop quits when both end markers
+ * have been read, or when the worker process exits.
+ */
+class ctkCmdLineModuleWorkerJobReader : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  ctkCmdLineModuleWorkerJobReader(QProcess& process, QEventLoop& loop,
+                                  ctkCmdLineModuleFutureInterface& futureInterface);
+
+  /**
+   * The output of the current job, without the end marker.
+   */
+  QIODevice* jobOutput();
+
+  /**
+   * True if the end marker of the job was read from the standard output.
+   */
+  bool isFinished() const;
+  int exitCode() const;
+
+  /**
+   * True if the end marker of the job was read from the standard error.
+   * Otherwise, error output of the job may still be pending and the
+   * worker must not be reused.
+   */
+  bool isErrorFinished() const;
+
+  /**
+   * The standard error output written by the worker during the current job.
+   */
+  QByteArray errorOutput() const;
+
+protected Q_SLOTS:
+
+  void readOutput();
+  void readError();
+  void processFinished();
+
+private:
+
+  void checkJobEnd();
+
+  QProcess& process;
+  QEventLoop& loop;
+  ctkCmdLineModuleFutureInterface& futureInterface;
+  QBuffer output;
+  QByteArray pending;
+  QByteArray errorPending;
+  QByteArray error;
+  // bounds the wait for the standard error end marker
+  QTimer errorTimer;
+  bool finished;
+  bool errorFinished;
+  int jobExitCode;
+};
+
+/**
+ * \class ctkCmdLineModuleWorkerProcessTask
+ * \brief Runs a module job in a persistent worker process.
+ * \ingroup CommandLineModulesBackendLocalProcess_API
+ *
+ * This is the worker mode counterpart of ctkCmdLineModuleProcessTask.
+ */
+class ctkCmdLineModuleWorkerProcessTask
+    : public ctkCmdLineModuleFutureInterface, public QRunnable
+{
+
+public:
+
+  ctkCmdLineModuleWorkerProcessTask(const QSharedPointer<ctkCmdLineModuleWorkerPool>& pool,
+                                    const QString& location, const QStringList& args);
+
+  ctkCmdLineModuleFuture start();
+
+  void run();
+
+private:
+
+  const QSharedPointer<ctkCmdLineModuleWorkerPool> Pool;
+  const QString Location;
+  const QStringList Args;
+};
+
+#endif // CTKCMDLINEMODULEWORKERPROCESSTASK_P_H
@@ -24,13 +24,23 @@
 #include "ctkCmdLineModuleBackend.h"
 #include "ctkException.h"
 #include "ctkCmdLineModuleFuture.h"
+#include "ctkCmdLineModuleFrontend.h"
+#include "ctkCmdLineModuleScheduler.h"
+#include "ctkCmdLineModuleBatchResult.h"
+#include "ctkCmdLineModuleRunException.h"
 
 #include "ctkTest.h"
 
 #include <QCoreApplication>
 #include <QBuffer>
+#include <QFuture>
 #include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QRunnable>
+#include <QSemaphore>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 extern int qHash(const QUrl& url);
@@ -43,6 +53,10 @@ class BackendMockUp : public ctkCmdLineModuleBackend
 
 public:
 
+  BackendMockUp()
+    : TimeStamp(0), XmlRequests(0)
+  {}
+
   void addModule(const QUrl& location, const QByteArray& xml)
   {
     this->UrlToXml[location] = xml;
@@ -51,12 +65,16 @@ public:
   virtual QString name() const { return "Mockup"; }
   virtual QString description() const { return "Test Mock-up"; }
   virtual QList<QString> schemes() const { return QList<QString>() << "test"; }
-  virtual qint64 timeStamp(const QUrl& /*location*/) const { return 0; }
+  virtual qint64 timeStamp(const QUrl& /*location*/) const { return TimeStamp; }
   virtual QByteArray rawXmlDescription(const QUrl& location)
   {
-    return UrlToXml[location];
+    XmlRequests.ref();
+    return UrlToXml.value(location);
   }
 
+  qint64 TimeStamp;
+  QAtomicInt XmlRequests;
+
 protected:
 
   virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* /*frontend*/)
@@ -69,6 +87,214 @@ private:
   QHash<QUrl, QByteArray> UrlToXml;
 };
 
+class FrontendMockUp : public ctkCmdLineModuleFrontend
+{
+
+public:
+
+  FrontendMockUp(const ctkCmdLineModuleReference& moduleRef, int id)
+    : ctkCmdLineModuleFrontend(moduleRef), Id(id)
+  {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+  virtual QVariant value(const QString& /*parameter*/, int /*role*/) const { return QVariant(); }
+  virtual void setValue(const QString& /*parameter*/, const QVariant& /*value*/, int /*role*/) {}
+
+  const int Id;
+};
+
+// Blocks on a semaphore and records the order in which the runs are started
+class BlockingTaskMockUp : public ctkCmdLineModuleFutureInterface, public QRunnable
+{
+
+public:
+
+  BlockingTaskMockUp(QSemaphore* gate, QMutex* mutex, QList<int>* order, int id)
+    : Gate(gate), Mutex(mutex), Order(order), Id(id)
+  {}
+
+  ctkCmdLineModuleFuture start()
+  {
+    this->setRunnable(this);
+    this->reportStarted();
+    ctkCmdLineModuleFuture future = this->future();
+    this->startRunnable(this);
+    return future;
+  }
+
+  void run()
+  {
+    Gate->acquire();
+    {
+      QMutexLocker lock(Mutex);
+      Order->push_back(Id);
+    }
+    this->reportFinished();
+  }
+
+private:
+
+  QSemaphore* Gate;
+  QMutex* Mutex;
+  QList<int>* Order;
+  const int Id;
+};
+
+class SchedulingBackendMockUp : public BackendMockUp
+{
+
+public:
+
+  QSemaphore Gate;
+  QMutex Mutex;
+  QList<int> Order;
+
+protected:
+
+  virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend)
+  {
+    int id = static_cast<FrontendMockUp*>(frontend)->Id;
+    return (new BlockingTaskMockUp(&Gate, &Mutex, &Order, id))->start();
+  }
+};
+
+// Doubles the "x" value, fails for negative values
+class DoublingTaskMockUp : public ctkCmdLineModuleFutureInterface, public QRunnable
+{
+
+public:
+
+  DoublingTaskMockUp(const QUrl& location, int x)
+    : Location(location), X(x)
+  {}
+
+  ctkCmdLineModuleFuture start()
+  {
+    this->setRunnable(this);
+    this->reportStarted();
+    ctkCmdLineModuleFuture future = this->future();
+    this->startRunnable(this);
+    return future;
+  }
+
+  void run()
+  {
+    if (X < 0)
+    {
+      this->reportException(ctkCmdLineModuleRunException(Location, 1, "negative"));
+    }
+    else
+    {
+      this->reportResult(ctkCmdLineModuleResult("out", 2 * X));
+    }
+    this->reportFinished();
+  }
+
+private:
+
+  const QUrl Location;
+  const int X;
+};
+
+class BatchBackendMockUp : public BackendMockUp
+{
+
+protected:
+
+  virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend)
+  {
+    return (new DoublingTaskMockUp(frontend->location(), frontend->value("x").toInt()))->start();
+  }
+};
+
+// Shared state of the runs started by BatchItemBackendMockUp
+struct BatchItemState
+{
+  BatchItemState()
+    : Gated(false), Running(0), MaxRunning(0)
+  {}
+
+  bool Gated;
+  QSemaphore Started;
+  QSemaphore Gate;
+
+  QMutex Mutex;
+  int Running;
+  int MaxRunning;
+  QList<QHash<QString, QVariant> > Values;
+};
+
+// Records the number of concurrent runs and optionally blocks on a semaphore
+class BatchItemTaskMockUp : public ctkCmdLineModuleFutureInterface, public QRunnable
+{
+
+public:
+
+  BatchItemTaskMockUp(BatchItemState* state, int x)
+    : State(state), X(x)
+  {}
+
+  ctkCmdLineModuleFuture start()
+  {
+    this->setRunnable(this);
+    this->reportStarted();
+    ctkCmdLineModuleFuture future = this->future();
+    this->startRunnable(this);
+    return future;
+  }
+
+  void run()
+  {
+    {
+      QMutexLocker lock(&State->Mutex);
+      State->MaxRunning = qMax(State->MaxRunning, ++State->Running);
+    }
+    State->Started.release();
+    if (State->Gated)
+    {
+      State->Gate.acquire();
+    }
+    else
+    {
+      QTest::qSleep(10);
+    }
+    {
+      QMutexLocker lock(&State->Mutex);
+      --State->Running;
+    }
+    this->reportResult(ctkCmdLineModuleResult("out", X));
+    this->reportFinished();
+  }
+
+private:
+
+  BatchItemState* State;
+  const int X;
+};
+
+// Runs batch items without a front-end
+class BatchItemBackendMockUp : public BackendMockUp
+{
+
+public:
+
+  BatchItemState State;
+
+protected:
+
+  virtual bool runBatchItem(const ctkCmdLineModuleReference& /*moduleRef*/,
+                            const QHash<QString, QVariant>& values,
+                            ctkCmdLineModuleFuture& future)
+  {
+    {
+      QMutexLocker lock(&State.Mutex);
+      State.Values << values;
+    }
+    future = (new BatchItemTaskMockUp(&State, values.value("param").toInt()))->start();
+    return true;
+  }
+};
+
 }
 
 //-----------------------------------------------------------------------------
@@ -84,6 +310,18 @@ private Q_SLOTS:
   void testWeakValidation();
   void testSkipValidation();
 
+  void testAsyncRegistration();
+
+  void testCachedDescription();
+
+  void testScheduler();
+  void testSchedulerCancel();
+
+  void testBatchRun();
+  void testBatchRunDefaults();
+  void testBatchRunConcurrency();
+  void testBatchRunCancel();
+
 private:
 
   QByteArray validXml;
@@ -186,6 +424,361 @@ void ctkCmdLineModuleManagerTester::testSkipValidation()
   QVERIFY(moduleRef2.xmlValidationErrorString().isEmpty());
 }
 
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testAsyncRegistration()
+{
+  BackendMockUp backend;
+  QList<QUrl> locations;
+  for (int i = 0; i < 50; ++i)
+  {
+    QUrl location(QString("test://validXml%1").arg(i));
+    backend.addModule(location, validXml);
+    locations << location;
+  }
+  backend.addModule(QUrl("test://invalidXml"), invalidXml);
+  locations << QUrl("test://invalidXml") << QUrl("test://missing");
+
+  ctkCmdLineModuleManager manager;
+  manager.registerBackend(&backend);
+  manager.setMaxParallelProbes(4);
+  QCOMPARE(manager.maxParallelProbes(), 4);
+
+  QFuture<ctkCmdLineModuleReference> future = manager.registerModulesAsync(locations);
+  future.waitForFinished();
+
+  QCOMPARE(future.resultCount(), locations.size());
+  QCOMPARE(future.progressValue(), locations.size());
+  for (int i = 0; i < 50; ++i)
+  {
+    QVERIFY(future.resultAt(i));
+    QCOMPARE(future.resultAt(i).location(), locations[i]);
+  }
+  QVERIFY(!future.resultAt(50));
+  QVERIFY(!future.resultAt(51));
+
+  QCOMPARE(manager.moduleReferences().size(), 50);
+
+  // registering an already registered module returns the same reference
+  ctkCmdLineModuleReference ref = manager.registerModuleAsync(locations.front()).result();
+  QVERIFY(ref);
+  QCOMPARE(ref.location(), locations.front());
+  QCOMPARE(manager.moduleReferences().size(), 50);
+
+  // an empty batch finishes immediately
+  QVERIFY(manager.registerModulesAsync(QList<QUrl>()).isFinished());
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testCachedDescription()
+{
+  QDir cacheDir(QDir::temp().absoluteFilePath("ctkCmdLineModuleManagerTestCache"));
+  QFile::remove(cacheDir.absoluteFilePath("ctkCmdLineModuleCache.bin"));
+
+  BackendMockUp backend;
+  backend.TimeStamp = 1;
+  backend.addModule(QUrl("test://validXml"), validXml);
+  backend.addModule(QUrl("test://validXml2"), validXml);
+
+  {
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cacheDir.absolutePath());
+    manager.registerBackend(&backend);
+    QFuture<ctkCmdLineModuleReference> future =
+        manager.registerModulesAsync(QList<QUrl>() << QUrl("test://validXml") << QUrl("test://validXml2"));
+    future.waitForFinished();
+    QCOMPARE(future.results().size(), 2);
+    // the cache is written after each registration batch, not only on destruction
+    QVERIFY(cacheDir.exists("ctkCmdLineModuleCache.bin"));
+  }
+  QCOMPARE(int(backend.XmlRequests), 2);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cacheDir.absolutePath());
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+  QCOMPARE(int(backend.XmlRequests), 2);
+  QCOMPARE(moduleRef.rawXmlDescription(), validXml);
+  QCOMPARE(moduleRef.description().title(), QString("My Filter"));
+  QCOMPARE(moduleRef.description().parameterGroups().size(), 1);
+  QVERIFY(moduleRef.description().hasParameter("param"));
+  QCOMPARE(moduleRef.description().parameter("param").flag(), QString("i"));
+
+  // a newer module time stamp invalidates the cache entry
+  backend.TimeStamp = 2;
+  QVERIFY(manager.registerModule(QUrl("test://validXml2")));
+  QCOMPARE(int(backend.XmlRequests), 3);
+
+  // synchronous registrations are written when the manager is destroyed
+  QDir syncCacheDir(QDir::temp().absoluteFilePath("ctkCmdLineModuleManagerTestSyncCache"));
+  QFile::remove(syncCacheDir.absoluteFilePath("ctkCmdLineModuleCache.bin"));
+  {
+    ctkCmdLineModuleManager syncManager(ctkCmdLineModuleManager::STRICT_VALIDATION, syncCacheDir.absolutePath());
+    syncManager.registerBackend(&backend);
+    QVERIFY(syncManager.registerModule(QUrl("test://validXml")));
+    QVERIFY(syncManager.registerModule(QUrl("test://validXml2")));
+    QVERIFY(!syncCacheDir.exists("ctkCmdLineModuleCache.bin"));
+  }
+  QVERIFY(syncCacheDir.exists("ctkCmdLineModuleCache.bin"));
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testScheduler()
+{
+  SchedulingBackendMockUp backend;
+  backend.addModule(QUrl("test://validXml"), validXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testScheduler");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+
+  ctkCmdLineModuleScheduler* scheduler = manager.scheduler();
+  scheduler->setMaxConcurrentRuns(1);
+  QCOMPARE(scheduler->maxConcurrentRuns(), 1);
+
+  QList<ctkCmdLineModuleFrontend*> frontends;
+  for (int i = 0; i < 5; ++i)
+  {
+    frontends << new FrontendMockUp(moduleRef, i);
+  }
+
+  // the first run occupies the only slot, all others are queued
+  QList<ctkCmdLineModuleFuture> futures;
+  futures << manager.run(frontends[0]);
+  futures << manager.run(frontends[1], 0, "a");
+  futures << manager.run(frontends[2], 0, "a");
+  futures << manager.run(frontends[3], 0, "b");
+  futures << manager.run(frontends[4], 10, "c");
+
+  QVERIFY(!futures[0].isQueued());
+  QVERIFY(futures[1].isQueued());
+  QVERIFY(futures[4].isQueued());
+
+  ctkCmdLineModuleScheduler::Statistics stats = scheduler->statistics();
+  QCOMPARE(stats.queueDepth, 4);
+  QCOMPARE(stats.maxQueueDepth, 4);
+  QCOMPARE(stats.runningCount, 1);
+  QCOMPARE(scheduler->statistics(&backend).queueDepth, 4);
+
+  backend.Gate.release(5);
+  foreach(ctkCmdLineModuleFuture future, futures)
+  {
+    future.waitForFinished();
+  }
+  scheduler->waitForDone();
+
+  // higher priority first, then round-robin between callers
+  QCOMPARE(backend.Order, QList<int>() << 0 << 4 << 1 << 3 << 2);
+
+  stats = scheduler->statistics();
+  QCOMPARE(stats.queueDepth, 0);
+  QCOMPARE(stats.runningCount, 0);
+  QCOMPARE(stats.startedCount, qint64(5));
+  QVERIFY(stats.maxWaitTime >= futures[4].queueWaitTime());
+  QVERIFY(futures[0].queueWaitTime() >= 0);
+  QVERIFY(!futures[2].isQueued());
+
+  qDeleteAll(frontends);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testSchedulerCancel()
+{
+  SchedulingBackendMockUp backend;
+  backend.addModule(QUrl("test://validXml"), validXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testSchedulerCancel");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+
+  ctkCmdLineModuleScheduler* scheduler = manager.scheduler();
+  scheduler->setMaxConcurrentRuns(1);
+
+  QList<ctkCmdLineModuleFrontend*> frontends;
+  QList<ctkCmdLineModuleFuture> futures;
+  for (int i = 0; i < 3; ++i)
+  {
+    frontends << new FrontendMockUp(moduleRef, i);
+    futures << manager.run(frontends[i]);
+  }
+  QVERIFY(futures[1].isQueued());
+
+  // a run canceled while queued is not started
+  futures[1].cancel();
+  backend.Gate.release(3);
+  foreach(ctkCmdLineModuleFuture future, futures)
+  {
+    future.waitForFinished();
+  }
+  scheduler->waitForDone();
+
+  QCOMPARE(backend.Order, QList<int>() << 0 << 2);
+  QVERIFY(futures[1].isCanceled());
+  QVERIFY(futures[1].isFinished());
+  QVERIFY(!futures[1].isQueued());
+
+  ctkCmdLineModuleScheduler::Statistics stats = scheduler->statistics();
+  QCOMPARE(stats.queueDepth, 0);
+  QCOMPARE(stats.runningCount, 0);
+  QCOMPARE(stats.startedCount, qint64(2));
+
+  qDeleteAll(frontends);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testBatchRun()
+{
+  BatchBackendMockUp backend;
+  backend.addModule(QUrl("test://validXml"), validXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testBatchRun");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+
+  const int count = 50;
+  QList<QHash<QString, QVariant> > parameterSets;
+  for (int i = 0; i < count; ++i)
+  {
+    QHash<QString, QVariant> values;
+    values["x"] = (i == 7) ? -1 : i;
+    parameterSets << values;
+  }
+
+  QFuture<ctkCmdLineModuleBatchResult> future = manager.runBatch(moduleRef, parameterSets, 3);
+  future.waitForFinished();
+
+  QCOMPARE(future.resultCount(), count);
+  QCOMPARE(future.progressMaximum(), count);
+  QCOMPARE(future.progressValue(), count);
+  for (int i = 0; i < count; ++i)
+  {
+    ctkCmdLineModuleBatchResult result = future.resultAt(i);
+    QCOMPARE(result.index(), i);
+    QCOMPARE(result.parameters(), parameterSets[i]);
+    if (i == 7)
+    {
+      QVERIFY(result.hasError());
+      QVERIFY(result.results().isEmpty());
+    }
+    else
+    {
+      QVERIFY(!result.hasError());
+      QCOMPARE(result.results(), QList<ctkCmdLineModuleResult>() << ctkCmdLineModuleResult("out", 2 * i));
+    }
+  }
+
+  // an empty batch finishes immediately
+  future = manager.runBatch(moduleRef, QList<QHash<QString, QVariant> >());
+  QVERIFY(future.isFinished());
+  QCOMPARE(future.resultCount(), 0);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testBatchRunDefaults()
+{
+  BatchItemBackendMockUp backend;
+  QByteArray defaultXml = validXml;
+  defaultXml.replace("      <label>bla</label>\n    </integer>",
+                     "      <label>bla</label>\n      <default>5</default>\n    </integer>");
+  backend.addModule(QUrl("test://defaultXml"), defaultXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testBatchRunDefaults");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://defaultXml"));
+  QVERIFY(moduleRef);
+  QCOMPARE(moduleRef.description().parameter("param").defaultValue(), QString("5"));
+
+  QHash<QString, QVariant> values;
+  values["param"] = 3;
+  QList<QHash<QString, QVariant> > parameterSets;
+  parameterSets << values << QHash<QString, QVariant>();
+
+  QFuture<ctkCmdLineModuleBatchResult> future = manager.runBatch(moduleRef, parameterSets);
+  future.waitForFinished();
+
+  // the back-end receives the default value, the result keeps the given values
+  QCOMPARE(future.resultCount(), 2);
+  QCOMPARE(future.resultAt(0).results(), QList<ctkCmdLineModuleResult>() << ctkCmdLineModuleResult("out", 3));
+  QCOMPARE(future.resultAt(1).results(), QList<ctkCmdLineModuleResult>() << ctkCmdLineModuleResult("out", 5));
+  QVERIFY(future.resultAt(1).parameters().isEmpty());
+  QCOMPARE(backend.State.Values.size(), 2);
+  foreach(const QHash<QString, QVariant>& backendValues, backend.State.Values)
+  {
+    QVERIFY(backendValues.contains("param"));
+  }
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testBatchRunConcurrency()
+{
+  BatchItemBackendMockUp backend;
+  backend.addModule(QUrl("test://validXml"), validXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testBatchRunConcurrency");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+
+  const int count = 20;
+  QList<QHash<QString, QVariant> > parameterSets;
+  for (int i = 0; i < count; ++i)
+  {
+    QHash<QString, QVariant> values;
+    values["param"] = i;
+    parameterSets << values;
+  }
+
+  QFuture<ctkCmdLineModuleBatchResult> future = manager.runBatch(moduleRef, parameterSets, 2);
+  future.waitForFinished();
+
+  QCOMPARE(future.resultCount(), count);
+  QCOMPARE(backend.State.Values.size(), count);
+  QVERIFY(backend.State.MaxRunning >= 1);
+  QVERIFY(backend.State.MaxRunning <= 2);
+  QCOMPARE(backend.State.Running, 0);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerTester::testBatchRunCancel()
+{
+  BatchItemBackendMockUp backend;
+  backend.State.Gated = true;
+  backend.addModule(QUrl("test://validXml"), validXml);
+
+  ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION,
+                                  QDir::tempPath() + "/ctkCmdLineModuleManagerTest/testBatchRunCancel");
+  manager.registerBackend(&backend);
+  ctkCmdLineModuleReference moduleRef = manager.registerModule(QUrl("test://validXml"));
+  QVERIFY(moduleRef);
+
+  QList<QHash<QString, QVariant> > parameterSets;
+  for (int i = 0; i < 10; ++i)
+  {
+    QHash<QString, QVariant> values;
+    values["param"] = i;
+    parameterSets << values;
+  }
+
+  // the first item blocks until it is released, canceling stops dispatching the rest
+  QFuture<ctkCmdLineModuleBatchResult> future = manager.runBatch(moduleRef, parameterSets, 1);
+  backend.State.Started.acquire();
+  future.cancel();
+  backend.State.Gate.release();
+  future.waitForFinished();
+
+  QVERIFY(future.isCanceled());
+  QCOMPARE(backend.State.Values.size(), 1);
+  QCOMPARE(manager.scheduler()->statistics(&backend).startedCount, qint64(1));
+  // results of a canceled future are not reported
+  QCOMPARE(future.resultCount(), 0);
+}
+
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleManagerTest)
 #include "moc_ctkCmdLineModuleManagerTest.cpp"
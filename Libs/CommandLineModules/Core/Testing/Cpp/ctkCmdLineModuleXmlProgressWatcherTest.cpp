@@ -95,6 +95,12 @@ private Q_SLOTS:
 
   void testSignalsAndValues();
   void testMalformedXml();
+  void testSplitInput();
+  void testProgressCoalescing();
+  void testProgressAtEndOfOutput();
+
+  void benchmarkProgressParsing_data();
+  void benchmarkProgressParsing();
 };
 
 //-----------------------------------------------------------------------------
@@ -192,6 +198,166 @@ void ctkCmdLineModuleXmlProgressWatcherTester::testMalformedXml()
   QCOMPARE(signalTester.accumulatedProgress, 0.5f);
 }
 
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::testSplitInput()
+{
+  QByteArray filterOutput = "<filter-start>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                              "<filter-comment>Awesome filter</filter-comment>\n"
+                            "</filter-start>\n"
+                            "<filter-progress>0.5</filter-progress>\n"
+                            "<filter-end>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                            "</filter-end>";
+
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+
+  SignalTester signalTester;
+  signalTester.connect(&progressWatcher, SIGNAL(filterStarted(QString,QString)), &signalTester, SLOT(filterStarted(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterProgress(float,QString)), &signalTester, SLOT(filterProgress(float,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterFinished(QString,QString)), &signalTester, SLOT(filterFinished(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterXmlError(QString)), &signalTester, SLOT(filterXmlError(QString)));
+
+  // deliver the output in chunks which split tags and values
+  for (int i = 0; i < filterOutput.size(); i += 7)
+  {
+    buffer.write(filterOutput.mid(i, 7));
+    QCoreApplication::processEvents();
+  }
+
+  QList<QString> expectedSignals;
+  expectedSignals << "filter.started";
+  expectedSignals << "filter.progress";
+  expectedSignals << "filter.finished";
+
+  QVERIFY2(signalTester.error.isEmpty(), qPrintable(signalTester.error));
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+  QCOMPARE(signalTester.accumulatedProgress, 0.5f);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::testProgressCoalescing()
+{
+  QByteArray filterOutput = "<filter-start>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                              "<filter-comment>Awesome filter</filter-comment>\n"
+                            "</filter-start>\n";
+  for (int i = 1; i <= 1000; ++i)
+  {
+    filterOutput += "<filter-progress>" + QByteArray::number(i / 1000.0) + "</filter-progress>\n";
+  }
+  filterOutput += "<filter-end>\n"
+                    "<filter-name>My Filter</filter-name>\n"
+                  "</filter-end>";
+
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+  progressWatcher.setMaxProgressRate(1);
+  QCOMPARE(progressWatcher.maxProgressRate(), 1);
+
+  SignalTester signalTester;
+  signalTester.connect(&progressWatcher, SIGNAL(filterStarted(QString,QString)), &signalTester, SLOT(filterStarted(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterProgress(float,QString)), &signalTester, SLOT(filterProgress(float,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterFinished(QString,QString)), &signalTester, SLOT(filterFinished(QString,QString)));
+
+  buffer.write(filterOutput);
+  QCoreApplication::processEvents();
+
+  // the first update is emitted, the last one is flushed before "filter-end"
+  QList<QString> expectedSignals;
+  expectedSignals << "filter.started";
+  expectedSignals << "filter.progress";
+  expectedSignals << "filter.progress";
+  expectedSignals << "filter.finished";
+
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+  QCOMPARE(signalTester.accumulatedProgress, 1.001f);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::testProgressAtEndOfOutput()
+{
+  // The output ends with a progress element, as when a module exits without "filter-end"
+  QByteArray filterOutput = "<filter-start>\n"
+                              "<filter-name>My Filter</filter-name>\n"
+                              "<filter-comment>Awesome filter</filter-comment>\n"
+                            "</filter-start>\n"
+                            "<filter-progress>0.5</filter-progress>\n"
+                            "<filter-progress>1</filter-progress>\n";
+
+  QBuffer buffer;
+  buffer.open(QIODevice::ReadWrite);
+  ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+  progressWatcher.setMaxProgressRate(1);
+
+  SignalTester signalTester;
+  signalTester.connect(&progressWatcher, SIGNAL(filterStarted(QString,QString)), &signalTester, SLOT(filterStarted(QString,QString)));
+  signalTester.connect(&progressWatcher, SIGNAL(filterProgress(float,QString)), &signalTester, SLOT(filterProgress(float,QString)));
+
+  buffer.write(filterOutput);
+  QCoreApplication::processEvents();
+
+  // the last update is still pending
+  QList<QString> expectedSignals;
+  expectedSignals << "filter.started";
+  expectedSignals << "filter.progress";
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+
+  // the back-ends flush it when the module finished
+  progressWatcher.flushProgress();
+  expectedSignals << "filter.progress";
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+  QCOMPARE(signalTester.accumulatedProgress, 1.5f);
+
+  // flushing again does not repeat the update
+  progressWatcher.flushProgress();
+  QVERIFY(signalTester.checkSignals(expectedSignals));
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::benchmarkProgressParsing_data()
+{
+  QTest::addColumn<int>("maxProgressRate");
+
+  QTest::newRow("unlimited") << 0;
+  QTest::newRow("25 per second") << 25;
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcherTester::benchmarkProgressParsing()
+{
+  QFETCH(int, maxProgressRate);
+
+  // Output of a synthetic module reporting 100000 progress updates,
+  // delivered in pipe-sized chunks.
+  QByteArray filterOutput = "<filter-start><filter-name>Chatty</filter-name></filter-start>\n";
+  for (int i = 0; i < 100000; ++i)
+  {
+    filterOutput += "<filter-progress>" + QByteArray::number(i / 100000.0) + "</filter-progress>\n";
+  }
+  filterOutput += "<filter-end><filter-name>Chatty</filter-name></filter-end>\n";
+  const int chunkSize = 4096;
+
+  QBENCHMARK
+  {
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    ctkCmdLineModuleXmlProgressWatcher progressWatcher(&buffer);
+    progressWatcher.setMaxProgressRate(maxProgressRate);
+
+    SignalTester signalTester;
+    signalTester.connect(&progressWatcher, SIGNAL(filterProgress(float,QString)), &signalTester, SLOT(filterProgress(float,QString)));
+
+    for (int i = 0; i < filterOutput.size(); i += chunkSize)
+    {
+      buffer.write(filterOutput.constData() + i, qMin(chunkSize, filterOutput.size() - i));
+      QCoreApplication::processEvents();
+    }
+  }
+}
 
 // ----------------------------------------------------------------------------
 CTK_TEST_MAIN(ctkCmdLineModuleXmlProgressWatcherTest)
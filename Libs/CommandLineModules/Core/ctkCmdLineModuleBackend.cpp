@@ -21,7 +21,18 @@
 
 #include "ctkCmdLineModuleBackend.h"
 
+#include <QHash>
+#include <QVariant>
+
 //----------------------------------------------------------------------------
 ctkCmdLineModuleBackend::~ctkCmdLineModuleBackend()
 {
 }
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleBackend::runBatchItem(const ctkCmdLineModuleReference& /*moduleRef*/,
+                                           const QHash<QString, QVariant>& /*values*/,
+                                           ctkCmdLineModuleFuture& /*future*/)
+{
+  return false;
+}
@@ -26,9 +26,13 @@
 
 class ctkCmdLineModuleFrontend;
 class ctkCmdLineModuleFuture;
+class ctkCmdLineModuleReference;
 
 template<typename T> class QList;
+template<class Key, class T> class QHash;
+class QString;
 class QUrl;
+class QVariant;
 
 /**
  * @ingroup CommandLineModulesCore_API
@@ -90,6 +94,7 @@ struct CTK_CMDLINEMODULECORE_EXPORT ctkCmdLineModuleBackend
 protected:
 
   friend class ctkCmdLineModuleManager;
+  friend struct ctkCmdLineModuleManagerPrivate;
 
   /**
    * @brief The main method to actually execute the back-end process.
@@ -101,6 +106,25 @@ protected:
    */
   virtual ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend) = 0;
 
+  /**
+   * @brief Execute a module with a set of parameter values, without a front-end.
+   * @param moduleRef The module to run.
+   * @param values The parameter values, keyed by parameter name. The manager fills in
+   *        the default value of parameters without a value, so \c values contains
+   *        every parameter of the module description.
+   * @param future Set to the future of the started run.
+   * @return \c true if the run was started, \c false if this back-end needs a
+   *         front-end to run the module.
+   *
+   * ctkCmdLineModuleManager::runBatch() calls this method for each batch item.
+   * Back-ends can implement it to avoid the overhead of a front-end per item. The
+   * default implementation returns \c false, in which case the manager creates a
+   * light-weight front-end for the item and calls run(ctkCmdLineModuleFrontend*).
+   */
+  virtual bool runBatchItem(const ctkCmdLineModuleReference& moduleRef,
+                            const QHash<QString, QVariant>& values,
+                            ctkCmdLineModuleFuture& future);
+
 };
 
 #endif // CTKCMDLINEMODULEBACKEND_H
@@ -0,0 +1,114 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleBatchResult.h"
+
+#include <QDebug>
+
+struct ctkCmdLineModuleBatchResultPrivate
+{
+  ctkCmdLineModuleBatchResultPrivate()
+    : Index(-1)
+  {}
+
+  int Index;
+  QHash<QString, QVariant> Parameters;
+  QList<ctkCmdLineModuleResult> Results;
+  QString ErrorString;
+};
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatchResult::ctkCmdLineModuleBatchResult()
+  : d(new ctkCmdLineModuleBatchResultPrivate)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatchResult::~ctkCmdLineModuleBatchResult()
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatchResult::ctkCmdLineModuleBatchResult(const ctkCmdLineModuleBatchResult& other)
+  : d(other.d)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatchResult& ctkCmdLineModuleBatchResult::operator=(const ctkCmdLineModuleBatchResult& other)
+{
+  d = other.d;
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleBatchResult::ctkCmdLineModuleBatchResult(int index, const QHash<QString, QVariant>& parameters,
+                                                         const QList<ctkCmdLineModuleResult>& results,
+                                                         const QString& errorString)
+  : d(new ctkCmdLineModuleBatchResultPrivate)
+{
+  d->Index = index;
+  d->Parameters = parameters;
+  d->Results = results;
+  d->ErrorString = errorString;
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleBatchResult::index() const
+{
+  return d->Index;
+}
+
+//----------------------------------------------------------------------------
+QHash<QString, QVariant> ctkCmdLineModuleBatchResult::parameters() const
+{
+  return d->Parameters;
+}
+
+//----------------------------------------------------------------------------
+QList<ctkCmdLineModuleResult> ctkCmdLineModuleBatchResult::results() const
+{
+  return d->Results;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleBatchResult::hasError() const
+{
+  return !d->ErrorString.isNull();
+}
+
+//----------------------------------------------------------------------------
+QString ctkCmdLineModuleBatchResult::errorString() const
+{
+  return d->ErrorString;
+}
+
+//----------------------------------------------------------------------------
+QDebug operator<<(QDebug debug, const ctkCmdLineModuleBatchResult& result)
+{
+  debug.nospace() << "BatchResult(" << result.index() << ", " << result.results();
+  if (result.hasError())
+  {
+    debug.nospace() << ", error: " << result.errorString();
+  }
+  debug.nospace() << ")";
+  return debug;
+}
@@ -0,0 +1,99 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULEBATCHRESULT_H
+#define CTKCMDLINEMODULEBATCHRESULT_H
+
+#include "ctkCommandLineModulesCoreExport.h"
+
+#include "ctkCmdLineModuleResult.h"
+
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariant>
+
+struct ctkCmdLineModuleBatchResultPrivate;
+
+/**
+ * @ingroup CommandLineModulesCore_API
+ *
+ * @brief Describes the outcome of one item of a batch run.
+ *
+ * Instances of this class are reported by the future returned from
+ * ctkCmdLineModuleManager::runBatch(), at the index of the parameter set
+ * they belong to.
+ *
+ * @see ctkCmdLineModuleManager::runBatch()
+ */
+class CTK_CMDLINEMODULECORE_EXPORT ctkCmdLineModuleBatchResult
+{
+public:
+
+  ctkCmdLineModuleBatchResult();
+  ~ctkCmdLineModuleBatchResult();
+
+  ctkCmdLineModuleBatchResult(const ctkCmdLineModuleBatchResult& other);
+  ctkCmdLineModuleBatchResult& operator=(const ctkCmdLineModuleBatchResult& other);
+
+  ctkCmdLineModuleBatchResult(int index, const QHash<QString, QVariant>& parameters,
+                              const QList<ctkCmdLineModuleResult>& results,
+                              const QString& errorString = QString());
+
+  /**
+   * @brief Get the index of the parameter set in the batch.
+   * @return The index, or -1 for a default constructed instance.
+   */
+  int index() const;
+
+  /**
+   * @brief Get the parameter values this item was run with.
+   * @return The parameter set as passed to ctkCmdLineModuleManager::runBatch().
+   */
+  QHash<QString, QVariant> parameters() const;
+
+  /**
+   * @brief Get the results reported by the module for this item.
+   * @return The reported results, empty if the item failed.
+   */
+  QList<ctkCmdLineModuleResult> results() const;
+
+  /**
+   * @brief Check if running this item failed.
+   * @return \c true if the module reported an error, \c false otherwise.
+   */
+  bool hasError() const;
+
+  /**
+   * @brief Get the error reported by the module for this item.
+   * @return The error message or a null string if the item succeeded.
+   */
+  QString errorString() const;
+
+private:
+
+  QSharedPointer<ctkCmdLineModuleBatchResultPrivate> d;
+};
+
+CTK_CMDLINEMODULECORE_EXPORT QDebug operator<<(QDebug debug, const ctkCmdLineModuleBatchResult& result);
+
+#endif // CTKCMDLINEMODULEBATCHRESULT_H
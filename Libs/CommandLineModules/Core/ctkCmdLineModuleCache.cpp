@@ -19,14 +19,20 @@
 
 =============================================================================*/
 
+
 #include "ctkCmdLineModuleCache_p.h"
 
+#include "ctkCmdLineModuleDescription.h"
+#include "ctkCmdLineModuleDescription_p.h"
+
 #include <QUrl>
 #include <QFile>
-#include <QDirIterator>
-#include <QTextStream>
+#include <QDataStream>
+#include <QCryptographicHash>
 #include <QMutex>
 #include <QHash>
+#include <QPair>
+#include <QVector>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 #include "ctkCommandLineModulesCoreExport.h"
@@ -36,148 +42,454 @@ CTK_CMDLINEMODULECORE_EXPORT int qHash(const QUrl& url)
 }
 #endif
 
+namespace {
+
+const quint32 CacheMagic = 0x43544b43; // "CTKC"
+const quint32 CacheVersion = 2;
+const QDataStream::Version CacheStreamVersion = QDataStream::Qt_4_6;
+const int CacheHeaderSize = 5 * sizeof(quint32);
+const int CacheBlobTableEntrySize = sizeof(qint64) + sizeof(qint32);
+
+}
+
+//----------------------------------------------------------------------------
+/**
+ * A chunk of data which is either held in memory or located in
+ * the memory mapped cache file.
+ */
+struct ctkCmdLineModuleCacheBlob
+{
+  ctkCmdLineModuleCacheBlob()
+    : Offset(-1), Length(0)
+  {}
+
+  ctkCmdLineModuleCacheBlob(const QByteArray& data)
+    : Offset(-1), Length(data.size()), Data(data)
+  {}
+
+  bool isEmpty() const
+  {
+    return Length == 0;
+  }
+
+  // offset into the mapped cache file, -1 if Data holds the content
+  qint64 Offset;
+  qint32 Length;
+  QByteArray Data;
+};
+
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleCacheEntry
+{
+  ctkCmdLineModuleCacheEntry()
+    : TimeStamp(-1)
+  {}
+
+  qint64 TimeStamp;
+  ctkCmdLineModuleCacheBlob Xml;
+  ctkCmdLineModuleCacheBlob Description;
+  QString XmlValidationErrorString;
+};
+
+//----------------------------------------------------------------------------
 struct ctkCmdLineModuleCachePrivate
 {
+  ctkCmdLineModuleCachePrivate()
+    : MappedData(NULL), MappedSize(0), Dirty(false)
+  {}
+
+  QString cacheFileName() const
+  {
+    return this->CacheDir + "/ctkCmdLineModuleCache.bin";
+  }
+
+  void loadIndex();
+  void unmap();
+  QByteArray blobData(ctkCmdLineModuleCacheBlob& blob) const;
+
+  static QByteArray serializeDescription(const ctkCmdLineModuleDescription& description);
+  static bool deserializeDescription(const QByteArray& data, ctkCmdLineModuleDescription& description);
+
   QString CacheDir;
+  QHash<QUrl, ctkCmdLineModuleCacheEntry> Entries;
 
-  QHash<QUrl, qint64> LocationToTimeStamp;
-  QHash<QUrl, QByteArray> LocationToXmlDescription;
+  QFile CacheFile;
+  const uchar* MappedData;
+  qint64 MappedSize;
+
+  bool Dirty;
 
   QMutex Mutex;
+};
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleCachePrivate::loadIndex()
+{
+  this->CacheFile.setFileName(this->cacheFileName());
+  if (!this->CacheFile.exists() || !this->CacheFile.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
 
-  void LoadTimeStamps()
+  this->MappedSize = this->CacheFile.size();
+  this->MappedData = this->CacheFile.map(0, this->MappedSize);
+  if (this->MappedData == NULL)
   {
-    QDirIterator dirIter(this->CacheDir, QStringList() << "*.timestamp", QDir::Files | QDir::Readable);
-    while(dirIter.hasNext())
+    this->CacheFile.close();
+    return;
+  }
+
+  QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(this->MappedData),
+                                            static_cast<int>(this->MappedSize));
+  QDataStream in(data);
+  in.setVersion(CacheStreamVersion);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  quint32 descriptionVersion = 0;
+  quint32 entryCount = 0;
+  quint32 blobCount = 0;
+  in >> magic >> version >> descriptionVersion >> entryCount >> blobCount;
+  if (in.status() != QDataStream::Ok || magic != CacheMagic || version != CacheVersion ||
+      descriptionVersion != ctkCmdLineModuleDescriptionPrivate::StreamFormatVersion)
+  {
+    // an incompatible or corrupt cache file, start from scratch
+    this->unmap();
+    this->Dirty = true;
+    return;
+  }
+
+  QList<QPair<QUrl, QPair<qint32, qint32> > > blobRefs;
+  for (quint32 i = 0; i < entryCount && in.status() == QDataStream::Ok; ++i)
+  {
+    QString location;
+    ctkCmdLineModuleCacheEntry entry;
+    qint32 xmlBlob = -1;
+    qint32 descriptionBlob = -1;
+    in >> location >> entry.TimeStamp >> xmlBlob >> descriptionBlob >> entry.XmlValidationErrorString;
+
+    QUrl url(location);
+    this->Entries.insert(url, entry);
+    blobRefs.push_back(qMakePair(url, qMakePair(xmlBlob, descriptionBlob)));
+  }
+
+  QVector<ctkCmdLineModuleCacheBlob> blobs(blobCount);
+  for (quint32 i = 0; i < blobCount && in.status() == QDataStream::Ok; ++i)
+  {
+    in >> blobs[i].Offset >> blobs[i].Length;
+    if (blobs[i].Offset < 0 || blobs[i].Offset + blobs[i].Length > this->MappedSize)
     {
-      QFile timestampFile(dirIter.next());
-      timestampFile.open(QIODevice::ReadOnly);
-      QUrl url = QUrl(timestampFile.readLine().trimmed().data());
-      QByteArray timestamp = timestampFile.readLine();
-      bool ok = false;
-      qint64 ts = timestamp.toLongLong(&ok);
-      if (ok && !url.isEmpty())
-      {
-        this->LocationToTimeStamp[url] = ts;
-      }
+      in.setStatus(QDataStream::ReadCorruptData);
     }
   }
 
-  QString timeStampFileName(const QUrl& moduleLocation) const
+  if (in.status() != QDataStream::Ok)
   {
-    return this->CacheDir + "/" + QString::number(qHash(moduleLocation)) + ".timestamp";
+    this->Entries.clear();
+    this->unmap();
+    this->Dirty = true;
+    return;
   }
 
-  QString xmlFileName(const QUrl& moduleLocation) const
+  for (int i = 0; i < blobRefs.size(); ++i)
   {
-    return this->CacheDir + "/" + QString::number(qHash(moduleLocation)) + ".xml";
+    ctkCmdLineModuleCacheEntry& entry = this->Entries[blobRefs[i].first];
+    const qint32 xmlBlob = blobRefs[i].second.first;
+    const qint32 descriptionBlob = blobRefs[i].second.second;
+    if (xmlBlob >= 0 && xmlBlob < blobs.size())
+    {
+      entry.Xml = blobs[xmlBlob];
+    }
+    if (descriptionBlob >= 0 && descriptionBlob < blobs.size())
+    {
+      entry.Description = blobs[descriptionBlob];
+    }
   }
-};
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleCachePrivate::unmap()
+{
+  if (this->MappedData)
+  {
+    this->CacheFile.unmap(const_cast<uchar*>(this->MappedData));
+    this->MappedData = NULL;
+  }
+  this->CacheFile.close();
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleCachePrivate::blobData(ctkCmdLineModuleCacheBlob& blob) const
+{
+  if (blob.Length == 0)
+  {
+    return QByteArray();
+  }
+  if (blob.Offset >= 0)
+  {
+    // copy the data out of the mapped file, so it stays valid after
+    // the file has been re-written
+    blob.Data = QByteArray(reinterpret_cast<const char*>(this->MappedData + blob.Offset), blob.Length);
+    blob.Offset = -1;
+  }
+  return blob.Data;
+}
+
+//----------------------------------------------------------------------------
+QByteArray ctkCmdLineModuleCachePrivate::serializeDescription(const ctkCmdLineModuleDescription& description)
+{
+  QByteArray data;
+  QDataStream out(&data, QIODevice::WriteOnly);
+  out.setVersion(CacheStreamVersion);
+  out << *description.d;
+  return data;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleCachePrivate::deserializeDescription(const QByteArray& data,
+                                                          ctkCmdLineModuleDescription& description)
+{
+  QDataStream in(data);
+  in.setVersion(CacheStreamVersion);
+
+  ctkCmdLineModuleDescription result;
+  in >> *result.d;
+  if (in.status() != QDataStream::Ok || result.d->Title.isNull())
+  {
+    return false;
+  }
+  description = result;
+  return true;
+}
 
+//----------------------------------------------------------------------------
 ctkCmdLineModuleCache::ctkCmdLineModuleCache(const QString& cacheDir)
   : d(new ctkCmdLineModuleCachePrivate)
 {
   d->CacheDir = cacheDir;
-  d->LoadTimeStamps();
+  d->loadIndex();
 }
 
+//----------------------------------------------------------------------------
 ctkCmdLineModuleCache::~ctkCmdLineModuleCache()
 {
+  this->flush();
+  d->unmap();
 }
 
+//----------------------------------------------------------------------------
 QString ctkCmdLineModuleCache::cacheDir() const
 {
   QMutexLocker lock(&d->Mutex);
   return d->CacheDir;
 }
 
+//----------------------------------------------------------------------------
 QByteArray ctkCmdLineModuleCache::rawXmlDescription(const QUrl& moduleLocation) const
 {
   QMutexLocker lock(&d->Mutex);
+  QHash<QUrl, ctkCmdLineModuleCacheEntry>::iterator iter = d->Entries.find(moduleLocation);
+  if (iter == d->Entries.end())
+  {
+    return QByteArray();
+  }
+  return d->blobData(iter.value().Xml);
+}
 
-  if (d->LocationToXmlDescription.contains(moduleLocation))
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleCache::moduleDescription(const QUrl& moduleLocation,
+                                              ctkCmdLineModuleDescription& description,
+                                              QString& xmlValidationErrorString) const
+{
+  QByteArray data;
+  QString errorString;
   {
-    return d->LocationToXmlDescription[moduleLocation];
+    QMutexLocker lock(&d->Mutex);
+    QHash<QUrl, ctkCmdLineModuleCacheEntry>::iterator iter = d->Entries.find(moduleLocation);
+    if (iter == d->Entries.end() || iter.value().Description.isEmpty())
+    {
+      return false;
+    }
+    data = d->blobData(iter.value().Description);
+    errorString = iter.value().XmlValidationErrorString;
   }
-  // lazily load the XML description from the file system
-  QByteArray xml;
-  QString a = moduleLocation.toString();
-  QString fn = d->xmlFileName(moduleLocation);
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  if (xmlFile.exists() && xmlFile.open(QIODevice::ReadOnly))
+
+  if (!d->deserializeDescription(data, description))
   {
-    xml = xmlFile.readAll();
-    xmlFile.close();
+    return false;
   }
-  d->LocationToXmlDescription[moduleLocation] = xml;
-  return xml;
+  xmlValidationErrorString = errorString;
+  return true;
 }
 
+//----------------------------------------------------------------------------
 qint64 ctkCmdLineModuleCache::timeStamp(const QUrl& moduleLocation) const
 {
   QMutexLocker lock(&d->Mutex);
-  if (d->LocationToTimeStamp.contains(moduleLocation))
+  QHash<QUrl, ctkCmdLineModuleCacheEntry>::const_iterator iter = d->Entries.find(moduleLocation);
+  if (iter != d->Entries.end())
   {
-    return d->LocationToTimeStamp[moduleLocation];
+    return iter.value().TimeStamp;
   }
   return -1;
 }
 
+//----------------------------------------------------------------------------
 void ctkCmdLineModuleCache::cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription)
 {
-  QFile timestampFile(d->timeStampFileName(moduleLocation));
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  timestampFile.remove();
-  timestampFile.open(QIODevice::WriteOnly);
+  ctkCmdLineModuleCacheEntry entry;
+  entry.TimeStamp = timestamp;
+  entry.Xml = ctkCmdLineModuleCacheBlob(xmlDescription);
+
+  QMutexLocker lock(&d->Mutex);
+  d->Entries.insert(moduleLocation, entry);
+  d->Dirty = true;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleCache::cacheModuleDescription(const QUrl& moduleLocation,
+                                                   const ctkCmdLineModuleDescription& description,
+                                                   const QString& xmlValidationErrorString)
+{
+  const QByteArray data = d->serializeDescription(description);
 
-  QByteArray ba;
-  QTextStream str(&ba);
-  str << moduleLocation.toString() << '\n' << timestamp;
-  str.flush();
-  if (timestampFile.write(ba) == -1)
+  QMutexLocker lock(&d->Mutex);
+  QHash<QUrl, ctkCmdLineModuleCacheEntry>::iterator iter = d->Entries.find(moduleLocation);
+  if (iter == d->Entries.end())
   {
-    timestampFile.close();
-    timestampFile.remove();
     return;
   }
-  timestampFile.close();
+  iter.value().Description = ctkCmdLineModuleCacheBlob(data);
+  iter.value().XmlValidationErrorString = xmlValidationErrorString;
+  d->Dirty = true;
+}
 
-  xmlFile.remove();
-  if (!xmlDescription.isEmpty())
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleCache::removeCacheEntry(const QUrl& moduleLocation)
+{
+  QMutexLocker lock(&d->Mutex);
+  if (d->Entries.remove(moduleLocation) > 0)
   {
-    xmlFile.open(QIODevice::WriteOnly);
-    if (xmlFile.write(xmlDescription) == -1)
+    d->Dirty = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleCache::flush()
+{
+  QMutexLocker lock(&d->Mutex);
+  if (!d->Dirty)
+  {
+    return true;
+  }
+
+  // Build the index and the content-addressed blob section
+  QHash<QByteArray, qint32> hashToBlob;
+  QList<QByteArray> blobs;
+  // the entry blobs, re-pointed into the new file once it is mapped
+  QList<QPair<ctkCmdLineModuleCacheBlob*, qint32> > blobRefs;
+
+  QByteArray index;
+  {
+    QDataStream out(&index, QIODevice::WriteOnly);
+    out.setVersion(CacheStreamVersion);
+
+    QMutableHashIterator<QUrl, ctkCmdLineModuleCacheEntry> iter(d->Entries);
+    while (iter.hasNext())
     {
-      timestampFile.remove();
-      xmlFile.close();
-      xmlFile.remove();
-      return;
+      iter.next();
+      ctkCmdLineModuleCacheEntry& entry = iter.value();
+
+      qint32 blobIndex[2] = { -1, -1 };
+      ctkCmdLineModuleCacheBlob* entryBlobs[2] = { &entry.Xml, &entry.Description };
+      for (int i = 0; i < 2; ++i)
+      {
+        if (entryBlobs[i]->isEmpty()) continue;
+
+        const QByteArray data = d->blobData(*entryBlobs[i]);
+        const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        QHash<QByteArray, qint32>::const_iterator blobIter = hashToBlob.find(hash);
+        if (blobIter == hashToBlob.end())
+        {
+          blobIndex[i] = blobs.size();
+          hashToBlob.insert(hash, blobs.size());
+          blobs.push_back(data);
+        }
+        else
+        {
+          blobIndex[i] = blobIter.value();
+        }
+        blobRefs.push_back(qMakePair(entryBlobs[i], blobIndex[i]));
+      }
+
+      out << iter.key().toString() << entry.TimeStamp << blobIndex[0] << blobIndex[1]
+          << entry.XmlValidationErrorString;
     }
   }
 
+  // All blobs are held in memory now, release the old file
+  d->unmap();
+
+  QFile tmpFile(d->cacheFileName() + ".tmp");
+  if (!tmpFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
   {
-    QMutexLocker lock(&d->Mutex);
-    d->LocationToXmlDescription[moduleLocation] = xmlDescription;
-    d->LocationToTimeStamp[moduleLocation] = timestamp;
+    return false;
   }
-}
 
-void ctkCmdLineModuleCache::removeCacheEntry(const QUrl& moduleLocation)
-{
+  QDataStream out(&tmpFile);
+  out.setVersion(CacheStreamVersion);
+  out << CacheMagic << CacheVersion << ctkCmdLineModuleDescriptionPrivate::StreamFormatVersion
+      << static_cast<quint32>(d->Entries.size())
+      << static_cast<quint32>(blobs.size());
+  out.writeRawData(index.constData(), index.size());
+
+  QVector<qint64> blobOffsets(blobs.size());
+  qint64 offset = CacheHeaderSize + index.size() + blobs.size() * CacheBlobTableEntrySize;
+  for (int i = 0; i < blobs.size(); ++i)
   {
-    QMutexLocker lock(&d->Mutex);
-    d->LocationToTimeStamp.remove(moduleLocation);
-    d->LocationToXmlDescription.remove(moduleLocation);
+    blobOffsets[i] = offset;
+    out << offset << static_cast<qint32>(blobs[i].size());
+    offset += blobs[i].size();
+  }
+  foreach(const QByteArray& blob, blobs)
+  {
+    out.writeRawData(blob.constData(), blob.size());
   }
 
-  QFile timestampFile(d->timeStampFileName(moduleLocation));
-  if (timestampFile.exists())
+  tmpFile.close();
+  if (out.status() != QDataStream::Ok || tmpFile.error() != QFile::NoError)
+  {
+    tmpFile.remove();
+    return false;
+  }
+
+  QFile::remove(d->cacheFileName());
+  if (!tmpFile.rename(d->cacheFileName()))
+  {
+    tmpFile.remove();
+    return false;
+  }
+
+  d->Dirty = false;
+
+  // Map the new file, so the blobs are read lazily again instead of
+  // being kept in memory
+  d->CacheFile.setFileName(d->cacheFileName());
+  if (d->CacheFile.open(QIODevice::ReadOnly))
+  {
+    d->MappedSize = d->CacheFile.size();
+    d->MappedData = d->CacheFile.map(0, d->MappedSize);
+  }
+  if (d->MappedData == NULL || d->MappedSize != offset)
   {
-    timestampFile.remove();
+    d->unmap();
+    return true;
   }
-  QFile xmlFile(d->xmlFileName(moduleLocation));
-  if (xmlFile.exists())
+  for (int i = 0; i < blobRefs.size(); ++i)
   {
-    xmlFile.remove();
+    ctkCmdLineModuleCacheBlob* blob = blobRefs[i].first;
+    blob->Offset = blobOffsets[blobRefs[i].second];
+    blob->Data.clear();
   }
+  return true;
 }
@@ -19,20 +19,35 @@
 
 =============================================================================*/
 
+
 #ifndef CTKCMDLINEMODULECACHE_H
 #define CTKCMDLINEMODULECACHE_H
 
 #include <QScopedPointer>
 
 struct ctkCmdLineModuleCachePrivate;
+class ctkCmdLineModuleDescription;
 
 class QUrl;
 
 /**
  * \class ctkCmdLineModuleCache
  * \brief Private non-exported class to contain a cache of
- * XML descriptions and time-stamps.
+ * XML descriptions, parsed module descriptions and time-stamps.
  * \ingroup CommandLineModulesCore_API
+ *
+ * All entries are stored in a single file in the cache directory. The file
+ * starts with an index of all module locations and time-stamps, followed by a
+ * blob section containing the XML descriptions and the binary serialized
+ * ctkCmdLineModuleDescription objects. Blobs are content-addressed, so
+ * identical descriptions are stored only once.
+ *
+ * The file is memory mapped and only the index is read during construction.
+ * Blobs are read lazily. Changes are kept in memory and written back by
+ * flush(), which ctkCmdLineModuleManager calls after each asynchronous
+ * registration batch and when it is destroyed. After a flush, the new file
+ * is mapped and the blobs are read lazily again. The destructor flushes
+ * any remaining changes.
  */
 class ctkCmdLineModuleCache
 {
@@ -56,6 +71,19 @@ public:
    */
   QByteArray rawXmlDescription(const QUrl& moduleLocation) const;
 
+  /**
+   * @brief Returns the cached, already parsed description of a module.
+   * @param moduleLocation QUrl representing the location,
+   * for example a file path for a local process.
+   * @param description Receives the parsed description.
+   * @param xmlValidationErrorString Receives the XML validation error of
+   * the description, if any.
+   * @return <code>true</code> if a parsed description was cached,
+   * <code>false</code> otherwise.
+   */
+  bool moduleDescription(const QUrl& moduleLocation, ctkCmdLineModuleDescription& description,
+                         QString& xmlValidationErrorString) const;
+
   /**
    * @brief Returns the time stamp associated with a module.
    * @param moduleLocation QUrl representing the location,
@@ -70,9 +98,24 @@ public:
    * for example a file path for a local process.
    * @param timestamp the time
    * @param xmlDescription the XML
+   *
+   * Any parsed description previously cached for this module is discarded.
    */
   void cacheXmlDescription(const QUrl& moduleLocation, qint64 timestamp, const QByteArray& xmlDescription);
 
+  /**
+   * @brief Adds the parsed description of a module to the cache.
+   * @param moduleLocation QUrl representing the location,
+   * for example a file path for a local process.
+   * @param description the parsed description
+   * @param xmlValidationErrorString the XML validation error, if any
+   *
+   * This method does nothing if the XML description of the module has
+   * not been cached before.
+   */
+  void cacheModuleDescription(const QUrl& moduleLocation, const ctkCmdLineModuleDescription& description,
+                              const QString& xmlValidationErrorString);
+
   /**
    * @brief Removes an entry from the cache.
    * @param moduleLocation QUrl representing the location,
@@ -80,6 +123,12 @@ public:
    */
   void removeCacheEntry(const QUrl& moduleLocation);
 
+  /**
+   * @brief Writes all modified entries to the cache file.
+   * @return <code>true</code> on success, <code>false</code> otherwise.
+   */
+  bool flush();
+
 private:
 
   QScopedPointer<ctkCmdLineModuleCachePrivate> d;
@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "ctkCmdLineModuleParameter.h"
 #include "ctkCmdLineModuleParameterGroup.h"
+#include "ctkCmdLineModuleParameterGroup_p.h"
 
 #include "ctkException.h"
 
@@ -176,3 +177,43 @@ QTextStream & operator<<(QTextStream &os, const ctkCmdLineModuleDescription &mod
   }
   return os;
 }
+
+//----------------------------------------------------------------------------
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleDescriptionPrivate& description)
+{
+  out << description.Title << description.Category << description.Description
+      << description.Version << description.DocumentationURL << description.License
+      << description.Acknowledgements << description.Contributor << description.Type
+      << description.Target << description.Location << description.AlternativeType
+      << description.AlternativeTarget << description.AlternativeLocation
+      << description.Logo;
+
+  out << static_cast<qint32>(description.ParameterGroups.size());
+  foreach(const ctkCmdLineModuleParameterGroup& group, description.ParameterGroups)
+  {
+    out << *group.d;
+  }
+  return out;
+}
+
+//----------------------------------------------------------------------------
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleDescriptionPrivate& description)
+{
+  in >> description.Title >> description.Category >> description.Description
+     >> description.Version >> description.DocumentationURL >> description.License
+     >> description.Acknowledgements >> description.Contributor >> description.Type
+     >> description.Target >> description.Location >> description.AlternativeType
+     >> description.AlternativeTarget >> description.AlternativeLocation
+     >> description.Logo;
+
+  qint32 groupCount = 0;
+  in >> groupCount;
+  description.ParameterGroups.clear();
+  for (qint32 i = 0; i < groupCount && in.status() == QDataStream::Ok; ++i)
+  {
+    ctkCmdLineModuleParameterGroup group;
+    in >> *group.d;
+    description.ParameterGroups.push_back(group);
+  }
+  return in;
+}
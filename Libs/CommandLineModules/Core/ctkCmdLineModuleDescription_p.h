@@ -22,13 +22,22 @@
 #ifndef CTKCMDLINEMODULEDESCRIPTIONPRIVATE_H
 #define CTKCMDLINEMODULEDESCRIPTIONPRIVATE_H
 
-#include <QString>
+#include <QDataStream>
 #include <QIcon>
+#include <QString>
 
 class ctkCmdLineModuleParameterGroup;
 
 struct ctkCmdLineModuleDescriptionPrivate : public QSharedData
 {
+  /**
+   * Version of the binary format written by the QDataStream operators of
+   * the description, parameter group and parameter private classes.
+   * Increment it whenever one of them changes, so that stored descriptions,
+   * e.g. in the module cache, are discarded.
+   */
+  static const quint32 StreamFormatVersion = 1;
+
   QString Title;
   QString Category;
   QString Description;
@@ -50,4 +59,12 @@ struct ctkCmdLineModuleDescriptionPrivate : public QSharedData
 
 };
 
+/**
+ * Binary serialization of all description fields, including the parameter
+ * groups. Keep in sync with the fields above and increment
+ * StreamFormatVersion when changing it.
+ */
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleDescriptionPrivate& description);
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleDescriptionPrivate& description);
+
 #endif // CTKCMDLINEMODULEDESCRIPTIONPRIVATE_H
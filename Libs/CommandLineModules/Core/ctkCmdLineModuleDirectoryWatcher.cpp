@@ -31,6 +31,7 @@
 #include <QFileInfo>
 #include <QUrl>
 #include <QDebug>
+#include <QFuture>
 #include <QtConcurrentMap>
 
 #include <iostream>
@@ -404,15 +405,30 @@ void ctkCmdLineModuleDirectoryWatcherPrivate::updateModules(const QString &direc
 //-----------------------------------------------------------------------------
 QList<ctkCmdLineModuleReference> ctkCmdLineModuleDirectoryWatcherPrivate::loadModules(const QStringList& executables)
 {
-  QList<ctkCmdLineModuleReference> refs = QtConcurrent::blockingMapped(executables,
-                                                                       ctkCmdLineModuleConcurrentRegister(this->ModuleManager, this->Debug));
+  QList<QUrl> locations;
+  foreach(const QString& executable, executables)
+  {
+    locations << QUrl::fromLocalFile(executable);
+  }
+
+  // Probe and validate all modules in parallel, using the thread pools
+  // of the module manager.
+  QFuture<ctkCmdLineModuleReference> future = this->ModuleManager->registerModulesAsync(locations);
+  future.waitForFinished();
 
+  QList<ctkCmdLineModuleReference> refs;
   for (int i = 0; i < executables.size(); ++i)
   {
-    if (refs[i])
+    ctkCmdLineModuleReference ref = future.resultAt(i);
+    if (ref)
+    {
+      this->MapFileNameToReference[executables[i]] = ref;
+    }
+    else if (this->Debug)
     {
-      this->MapFileNameToReference[executables[i]] = refs[i];
+      qDebug() << "Registering module" << executables[i] << "failed.";
     }
+    refs.push_back(ref);
   }
   return refs;
 }
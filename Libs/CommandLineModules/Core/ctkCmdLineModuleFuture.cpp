@@ -55,3 +55,15 @@ bool ctkCmdLineModuleFuture::canPause() const
 {
   return d.canPause();
 }
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleFuture::isQueued() const
+{
+  return d.isQueued();
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleFuture::queueWaitTime() const
+{
+  return d.queueWaitTime();
+}
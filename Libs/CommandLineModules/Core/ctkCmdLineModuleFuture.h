@@ -74,6 +74,19 @@ public:
    */
   bool canPause() const;
 
+  /**
+   * @brief Check if this module is waiting in the queue of the ctkCmdLineModuleScheduler.
+   * @return \c true if this module has not been started yet, \c false otherwise.
+   */
+  bool isQueued() const;
+
+  /**
+   * @brief Get the time this module spent in the queue of the ctkCmdLineModuleScheduler.
+   * @return The wait time in milliseconds so far if the module is still queued, the
+   *         total wait time if it was started or -1 if it was never queued.
+   */
+  qint64 queueWaitTime() const;
+
 };
 
 inline ctkCmdLineModuleFuture ctkCmdLineModuleFutureInterface::future()
@@ -21,6 +21,7 @@
 
 #include "ctkCmdLineModuleFutureInterface.h"
 #include "ctkCmdLineModuleFutureInterface_p.h"
+#include "ctkCmdLineModuleScheduler_p.h"
 
 const int ctkCmdLineModuleFutureCallOutEvent::TypeId = QEvent::registerEventType();
 
@@ -32,6 +33,8 @@ ctkCmdLineModuleFutureInterfacePrivate::ctkCmdLineModuleFutureInterfacePrivate(c
   : RefCount(1)
   , CanCancel(false)
   , CanPause(false)
+  , Queued(false)
+  , QueueWaitTime(-1)
   , q(q)
 {
 }
@@ -82,6 +85,23 @@ void ctkCmdLineModuleFutureInterfacePrivate::disconnectOutputInterface(ctkCmdLin
   iface->cmdLineModuleCallOutInterfaceDisconnected();
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleFutureInterfacePrivate::reportQueued()
+{
+  QMutexLocker lock(&Mutex);
+  Queued = true;
+  QueueTimer.start();
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkCmdLineModuleFutureInterfacePrivate::reportDequeued()
+{
+  QMutexLocker lock(&Mutex);
+  Queued = false;
+  QueueWaitTime = QueueTimer.elapsedMilli();
+  return QueueWaitTime;
+}
+
 //----------------------------------------------------------------------------
 // QFutureInterface<ctkCmdLineModuleResult>
 
@@ -162,6 +182,26 @@ void QFutureInterface<ctkCmdLineModuleResult>::setCanPause(bool canPause)
   d->CanPause = canPause;
 }
 
+//----------------------------------------------------------------------------
+void QFutureInterface<ctkCmdLineModuleResult>::startRunnable(QRunnable* runnable)
+{
+  ctkCmdLineModuleSchedulerPrivate::start(*this, runnable);
+}
+
+//----------------------------------------------------------------------------
+bool QFutureInterface<ctkCmdLineModuleResult>::isQueued() const
+{
+  QMutexLocker l(&d->Mutex);
+  return d->Queued;
+}
+
+//----------------------------------------------------------------------------
+qint64 QFutureInterface<ctkCmdLineModuleResult>::queueWaitTime() const
+{
+  QMutexLocker l(&d->Mutex);
+  return d->Queued ? d->QueueTimer.elapsedMilli() : d->QueueWaitTime;
+}
+
 //----------------------------------------------------------------------------
 void QFutureInterface<ctkCmdLineModuleResult>::reportOutputData(const QByteArray& outputData)
 {
@@ -31,6 +31,8 @@
 class ctkCmdLineModuleFuture;
 class ctkCmdLineModuleFutureInterfacePrivate;
 
+class QRunnable;
+
 /**
  * \ingroup CommandLineModulesCore_API
  *
@@ -62,6 +64,19 @@ public:
   bool canPause() const;
   void setCanPause(bool canPause);
 
+  /**
+   * @brief Start the task executing this run.
+   * @param runnable The task, usually the object implementing this interface.
+   *
+   * Back-ends should call this method instead of QThreadPool::start(). When called from
+   * within ctkCmdLineModuleManager::run(), the runnable is queued in the manager's
+   * ctkCmdLineModuleScheduler. Otherwise it is started in QThreadPool::globalInstance().
+   */
+  void startRunnable(QRunnable* runnable);
+
+  bool isQueued() const;
+  qint64 queueWaitTime() const;
+
   inline void reportResult(const ctkCmdLineModuleResult *result, int index = -1);
   inline void reportResult(const ctkCmdLineModuleResult &result, int index = -1);
   inline void reportResults(const QVector<ctkCmdLineModuleResult> &results, int beginIndex = -1, int count = -1);
@@ -80,6 +95,7 @@ public:
 private:
 
   friend struct ctkCmdLineModuleFutureWatcherPrivate;
+  friend class ctkCmdLineModuleSchedulerPrivate;
 
   QtConcurrent::ResultStore<ctkCmdLineModuleResult> &resultStore()
   { return static_cast<QtConcurrent::ResultStore<ctkCmdLineModuleResult> &>(resultStoreBase()); }
@@ -26,6 +26,8 @@
 #include <QAtomicInt>
 #include <QMutex>
 
+#include <ctkHighPrecisionTimer.h>
+
 class ctkCmdLineModuleFutureCallOutEvent : public QEvent
 {
 public:
@@ -80,11 +82,19 @@ public:
   QByteArray OutputData;
   QByteArray ErrorData;
 
+  // Set while the run waits in a ctkCmdLineModuleScheduler queue
+  bool Queued;
+  ctkHighPrecisionTimer QueueTimer;
+  qint64 QueueWaitTime;
+
   ctkCmdLineModuleFutureInterface* q;
 
   void sendCallOut(const ctkCmdLineModuleFutureCallOutEvent &callOut);
   void connectOutputInterface(ctkCmdLineModuleFutureCallOutInterface *iface);
   void disconnectOutputInterface(ctkCmdLineModuleFutureCallOutInterface *iface);
+
+  void reportQueued();
+  qint64 reportDequeued();
 };
 
 #endif // CTKCMDLINEMODULEFUTUREINTERFACE_P_H
@@ -22,14 +22,21 @@
 #include "ctkCmdLineModuleManager.h"
 
 #include "ctkCmdLineModuleBackend.h"
+#include "ctkCmdLineModuleBatchResult.h"
 #include "ctkCmdLineModuleFrontend.h"
 #include "ctkCmdLineModuleCache_p.h"
+#include "ctkCmdLineModuleDescription.h"
+#include "ctkCmdLineModuleParameter.h"
+#include "ctkCmdLineModuleParameterGroup.h"
 #include "ctkCmdLineModuleFuture.h"
 #include "ctkCmdLineModuleXmlValidator.h"
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleReference_p.h"
+#include "ctkCmdLineModuleScheduler.h"
+#include "ctkCmdLineModuleScheduler_p.h"
 
 #include <ctkException.h>
+#include <ctkTracer.h>
 
 #include <QFileInfo>
 #include <QDir>
@@ -39,19 +46,86 @@
 #include <QHash>
 #include <QList>
 #include <QMutex>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
 
 #include <QFuture>
+#include <QFutureInterface>
 
 #if (QT_VERSION < QT_VERSION_CHECK(4,7,0))
 extern int qHash(const QUrl& url);
 #endif
 
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleRegistrationBatch
+{
+  ctkCmdLineModuleRegistrationBatch(int total)
+    : Total(total), Done(0)
+  {}
+
+  QFutureInterface<ctkCmdLineModuleReference> FutureInterface;
+  const int Total;
+  QAtomicInt Done;
+};
+
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleRunBatch
+{
+  ctkCmdLineModuleRunBatch(const ctkCmdLineModuleReference& moduleRef, ctkCmdLineModuleBackend* backend,
+                           const QList<QHash<QString, QVariant> >& parameterSets, int priority,
+                           int slotCount)
+    : ModuleRef(moduleRef), Backend(backend), ParameterSets(parameterSets), Priority(priority)
+    , Caller(QString("batch:%1").arg(reinterpret_cast<quintptr>(this)))
+    , Next(0), Done(0), ActiveSlots(slotCount)
+  {}
+
+  QFutureInterface<ctkCmdLineModuleBatchResult> FutureInterface;
+  const ctkCmdLineModuleReference ModuleRef;
+  ctkCmdLineModuleBackend* const Backend;
+  const QList<QHash<QString, QVariant> > ParameterSets;
+  const int Priority;
+  // Makes the scheduler interleave the items of concurrent batches
+  const QString Caller;
+  QAtomicInt Next;
+  QAtomicInt Done;
+  QAtomicInt ActiveSlots;
+};
+
 //----------------------------------------------------------------------------
 struct ctkCmdLineModuleManagerPrivate
 {
-  ctkCmdLineModuleManagerPrivate(ctkCmdLineModuleManager::ValidationMode mode, const QString& cacheDir)
-    : ValidationMode(mode)
+  /**
+   * Intermediate state of a module registration, passed from the
+   * XML fetching stage to the validation stage.
+   */
+  struct Registration
   {
+    Registration()
+      : Backend(NULL), FromCache(false), HasCachedDescription(false), TimeStamp(0)
+    {}
+
+    QUrl Location;
+    ctkCmdLineModuleBackend* Backend;
+    QByteArray Xml;
+    bool FromCache;
+    bool HasCachedDescription;
+    qint64 TimeStamp;
+    ctkCmdLineModuleReference Reference;
+  };
+
+  ctkCmdLineModuleManagerPrivate(ctkCmdLineModuleManager* qq, ctkCmdLineModuleManager::ValidationMode mode,
+                                 const QString& cacheDir)
+    : q(qq)
+    , ValidationMode(mode)
+  {
+    // Fetching the XML description is mostly waiting for external
+    // processes, so we allow more probes than CPU cores. Validation
+    // is CPU bound.
+    ProbePool.setMaxThreadCount(2 * QThread::idealThreadCount());
+    ValidationPool.setMaxThreadCount(QThread::idealThreadCount());
+
     QFileInfo fileInfo(cacheDir);
     if (!fileInfo.exists())
     {
@@ -80,121 +154,366 @@ struct ctkCmdLineModuleManagerPrivate
     }
   }
 
+  bool prepareRegistration(Registration& registration, ctkCmdLineModuleReference& ref);
+  void fetchXmlDescription(Registration& registration);
+  bool needsValidation(const Registration& registration) const;
+  ctkCmdLineModuleReference validateAndRegister(Registration& registration);
+
+  void cacheParsedDescription(const ctkCmdLineModuleReference& ref);
+  void flushCache();
+
+  void reportRegistration(const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                          int index, const ctkCmdLineModuleReference& ref);
+  void reportRegistrationFailure(const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                                 int index, const QUrl& location, const QString& errorString);
+
+  ctkCmdLineModuleBatchResult runBatchItem(ctkCmdLineModuleRunBatch& batch, int index);
+
+  ctkCmdLineModuleManager* const q;
+
   QMutex Mutex;
   QHash<QString, ctkCmdLineModuleBackend*> SchemeToBackend;
   QHash<QUrl, ctkCmdLineModuleReference> LocationToRef;
   QScopedPointer<ctkCmdLineModuleCache> ModuleCache;
 
+  QThreadPool ProbePool;
+  QThreadPool ValidationPool;
+
+  // Threads driving batch runs, they mostly wait for scheduled runs
+  QThreadPool BatchPool;
+
+  ctkCmdLineModuleScheduler Scheduler;
+
   const ctkCmdLineModuleManager::ValidationMode ValidationMode;
 };
 
+namespace {
+
 //----------------------------------------------------------------------------
-ctkCmdLineModuleManager::ctkCmdLineModuleManager(ValidationMode validationMode, const QString& cacheDir)
-  : d(new ctkCmdLineModuleManagerPrivate(validationMode, cacheDir))
+class ctkCmdLineModuleValidationTask : public QRunnable
 {
-}
+public:
+
+  ctkCmdLineModuleValidationTask(ctkCmdLineModuleManagerPrivate* d,
+                                 const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                                 int index, const ctkCmdLineModuleManagerPrivate::Registration& registration)
+    : d(d), Batch(batch), Index(index), Reg(registration)
+  {}
+
+  void run()
+  {
+    try
+    {
+      d->reportRegistration(Batch, Index, d->validateAndRegister(Reg));
+    }
+    catch (const ctkException& e)
+    {
+      d->reportRegistrationFailure(Batch, Index, Reg.Location, e.message());
+    }
+    catch (const std::exception& e)
+    {
+      d->reportRegistrationFailure(Batch, Index, Reg.Location, e.what());
+    }
+  }
+
+private:
+
+  ctkCmdLineModuleManagerPrivate* d;
+  QSharedPointer<ctkCmdLineModuleRegistrationBatch> Batch;
+  int Index;
+  ctkCmdLineModuleManagerPrivate::Registration Reg;
+};
 
 //----------------------------------------------------------------------------
-ctkCmdLineModuleManager::~ctkCmdLineModuleManager()
+class ctkCmdLineModuleProbeTask : public QRunnable
 {
-}
+public:
+
+  ctkCmdLineModuleProbeTask(ctkCmdLineModuleManagerPrivate* d,
+                            const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                            int index, const QUrl& location)
+    : d(d), Batch(batch), Index(index)
+  {
+    Reg.Location = location;
+  }
+
+  void run()
+  {
+    if (Batch->FutureInterface.isCanceled())
+    {
+      d->reportRegistration(Batch, Index, ctkCmdLineModuleReference());
+      return;
+    }
+
+    try
+    {
+      ctkCmdLineModuleReference ref;
+      if (d->prepareRegistration(Reg, ref))
+      {
+        d->reportRegistration(Batch, Index, ref);
+        return;
+      }
+
+      d->fetchXmlDescription(Reg);
+
+      if (!d->needsValidation(Reg))
+      {
+        d->reportRegistration(Batch, Index, d->validateAndRegister(Reg));
+      }
+      else
+      {
+        // Hand the XML over to the validation workers, so this thread
+        // can continue probing the next module.
+        d->ValidationPool.start(new ctkCmdLineModuleValidationTask(d, Batch, Index, Reg));
+      }
+    }
+    catch (const ctkException& e)
+    {
+      d->reportRegistrationFailure(Batch, Index, Reg.Location, e.message());
+    }
+    catch (const std::exception& e)
+    {
+      d->reportRegistrationFailure(Batch, Index, Reg.Location, e.what());
+    }
+  }
+
+private:
+
+  ctkCmdLineModuleManagerPrivate* d;
+  QSharedPointer<ctkCmdLineModuleRegistrationBatch> Batch;
+  int Index;
+  ctkCmdLineModuleManagerPrivate::Registration Reg;
+};
 
 //----------------------------------------------------------------------------
-ctkCmdLineModuleManager::ValidationMode ctkCmdLineModuleManager::validationMode() const
+class ctkCmdLineModuleBatchFrontend : public ctkCmdLineModuleFrontend
 {
-  return d->ValidationMode;
-}
+public:
+
+  ctkCmdLineModuleBatchFrontend(const ctkCmdLineModuleReference& moduleRef,
+                                const QHash<QString, QVariant>& values)
+    : ctkCmdLineModuleFrontend(moduleRef), Values(values)
+  {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+
+  virtual QVariant value(const QString& parameter, int /*role*/) const
+  {
+    QHash<QString, QVariant>::const_iterator iter = Values.find(parameter);
+    if (iter != Values.end()) return iter.value();
+    return this->moduleReference().description().parameter(parameter).defaultValue();
+  }
+
+  virtual void setValue(const QString& parameter, const QVariant& value, int /*role*/)
+  {
+    Values[parameter] = value;
+  }
+
+private:
+
+  QHash<QString, QVariant> Values;
+};
 
 //----------------------------------------------------------------------------
-void ctkCmdLineModuleManager::registerBackend(ctkCmdLineModuleBackend *backend)
+class ctkCmdLineModuleBatchSlotTask : public QRunnable
 {
-  QMutexLocker lock(&d->Mutex);
+public:
 
-  QList<QString> supportedSchemes = backend->schemes();
+  ctkCmdLineModuleBatchSlotTask(ctkCmdLineModuleManagerPrivate* d,
+                                const QSharedPointer<ctkCmdLineModuleRunBatch>& batch)
+    : d(d), Batch(batch)
+  {}
 
-  // Check if there is already a backend registerd for any of the
-  // supported schemes. We only supported one backend per scheme.
-  foreach (QString scheme, supportedSchemes)
+  void run()
   {
-    if (d->SchemeToBackend.contains(scheme))
+    QFutureInterface<ctkCmdLineModuleBatchResult>& futureInterface = Batch->FutureInterface;
+    const int total = Batch->ParameterSets.size();
+    forever
     {
-      throw ctkInvalidArgumentException(QString("A backend for scheme %1 is already registered.").arg(scheme));
+      // Canceling the batch stops dispatching, runs already started are completed
+      if (futureInterface.isCanceled()) break;
+
+      const int index = Batch->Next.fetchAndAddOrdered(1);
+      if (index >= total) break;
+
+      futureInterface.reportResult(d->runBatchItem(*Batch, index), index);
+      futureInterface.setProgressValue(Batch->Done.fetchAndAddOrdered(1) + 1);
     }
-  }
 
-  // All good
-  foreach (QString scheme, supportedSchemes)
-  {
-    d->SchemeToBackend[scheme] = backend;
+    if (!Batch->ActiveSlots.deref())
+    {
+      futureInterface.reportFinished();
+    }
   }
+
+private:
+
+  ctkCmdLineModuleManagerPrivate* d;
+  QSharedPointer<ctkCmdLineModuleRunBatch> Batch;
+};
+
 }
 
 //----------------------------------------------------------------------------
-ctkCmdLineModuleReference
-ctkCmdLineModuleManager::registerModule(const QUrl &location)
+ctkCmdLineModuleBatchResult ctkCmdLineModuleManagerPrivate::runBatchItem(ctkCmdLineModuleRunBatch& batch,
+                                                                         int index)
 {
-  QByteArray xml;
-  ctkCmdLineModuleBackend* backend = NULL;
+  const QHash<QString, QVariant>& values = batch.ParameterSets.at(index);
+
+  // Back-ends receive a value for every parameter, missing ones use the default value
+  QHash<QString, QVariant> runValues = values;
+  foreach(const ctkCmdLineModuleParameterGroup& group, batch.ModuleRef.description().parameterGroups())
   {
-    QMutexLocker lock(&d->Mutex);
+    foreach(const ctkCmdLineModuleParameter& parameter, group.parameters())
+    {
+      if (!runValues.contains(parameter.name()))
+      {
+        runValues.insert(parameter.name(), parameter.defaultValue());
+      }
+    }
+  }
 
-    d->checkBackends_unlocked(location);
+  QScopedPointer<ctkCmdLineModuleFrontend> frontend;
+  ctkCmdLineModuleFuture future;
+  QString errorString;
+  try
+  {
+    {
+      QMutexLocker lock(&this->Mutex);
+      ctkCmdLineModuleSchedulerSubmission submission(&this->Scheduler, batch.Backend,
+                                                     batch.Priority, batch.Caller);
+      if (!batch.Backend->runBatchItem(batch.ModuleRef, runValues, future))
+      {
+        frontend.reset(new ctkCmdLineModuleBatchFrontend(batch.ModuleRef, runValues));
+        future = batch.Backend->run(frontend.data());
+      }
+    }
 
-    // If the module is already registered, just return the reference
-    if (d->LocationToRef.contains(location))
+    // Re-throws an exception reported by the run
+    future.waitForFinished();
+    if (future.isCanceled())
     {
-      return d->LocationToRef[location];
+      errorString = "Run canceled.";
     }
+  }
+  catch (const ctkException& e)
+  {
+    errorString = e.message();
+  }
+  catch (const std::exception& e)
+  {
+    errorString = e.what();
+  }
 
-    backend = d->SchemeToBackend[location.scheme()];
+  QList<ctkCmdLineModuleResult> results;
+  if (errorString.isNull())
+  {
+    results = future.results();
   }
+  return ctkCmdLineModuleBatchResult(index, values, results, errorString);
+}
 
-  bool fromCache = false;
-  qint64 newTimeStamp = 0;
-  if (d->ModuleCache)
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleManagerPrivate::prepareRegistration(Registration& registration,
+                                                         ctkCmdLineModuleReference& ref)
+{
+  QMutexLocker lock(&this->Mutex);
+
+  this->checkBackends_unlocked(registration.Location);
+
+  // If the module is already registered, just return the reference
+  QHash<QUrl, ctkCmdLineModuleReference>::const_iterator iter = this->LocationToRef.find(registration.Location);
+  if (iter != this->LocationToRef.end())
   {
-    newTimeStamp = backend->timeStamp(location);
-    if (d->ModuleCache->timeStamp(location) < newTimeStamp)
+    ref = iter.value();
+    return true;
+  }
+
+  registration.Backend = this->SchemeToBackend[registration.Location.scheme()];
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerPrivate::fetchXmlDescription(Registration& registration)
+{
+  CTK_TRACE_SCOPE("CommandLineModules", "fetchXmlDescription");
+  const QUrl& location = registration.Location;
+  ctkCmdLineModuleBackend* backend = registration.Backend;
+
+  if (this->ModuleCache)
+  {
+    registration.TimeStamp = backend->timeStamp(location);
+    if (this->ModuleCache->timeStamp(location) < registration.TimeStamp)
     {
       // newly fetch the XML description
       try
       {
-        xml = backend->rawXmlDescription(location);
+        registration.Xml = backend->rawXmlDescription(location);
       }
       catch (...)
       {
         // cache the failed attempt
-        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, QByteArray());
+        this->ModuleCache->cacheXmlDescription(location, registration.TimeStamp, QByteArray());
         throw;
       }
     }
     else
     {
       // use the cached XML description
-      xml = d->ModuleCache->rawXmlDescription(location);
-      fromCache = true;
+      registration.Xml = this->ModuleCache->rawXmlDescription(location);
+      registration.FromCache = true;
     }
   }
   else
   {
-    xml = backend->rawXmlDescription(location);
+    registration.Xml = backend->rawXmlDescription(location);
   }
 
-  if (xml.isEmpty())
+  if (registration.Xml.isEmpty())
   {
-    if (!fromCache && d->ModuleCache)
+    if (!registration.FromCache && this->ModuleCache)
     {
-      d->ModuleCache->cacheXmlDescription(location, newTimeStamp, QByteArray());
+      this->ModuleCache->cacheXmlDescription(location, registration.TimeStamp, QByteArray());
     }
     throw ctkInvalidArgumentException(QString("No XML output available from ") + location.toString());
   }
 
-  ctkCmdLineModuleReference ref;
+  ctkCmdLineModuleReference& ref = registration.Reference;
   ref.d->Location = location;
-  ref.d->RawXmlDescription = xml;
+  ref.d->RawXmlDescription = registration.Xml;
   ref.d->Backend = backend;
 
-  if (d->ValidationMode != SKIP_VALIDATION)
+  if (registration.FromCache && this->ValidationMode != ctkCmdLineModuleManager::SKIP_VALIDATION)
+  {
+    // A cached parsed description has already been validated. In strict mode,
+    // descriptions which failed validation must go through the validator again
+    // to report the error.
+    registration.HasCachedDescription = ref.d->loadCachedDescription(*this->ModuleCache) &&
+        (this->ValidationMode != ctkCmdLineModuleManager::STRICT_VALIDATION ||
+         ref.d->XmlValidationErrorString.isEmpty());
+    if (!registration.HasCachedDescription)
+    {
+      ref.d->XmlValidationErrorString.clear();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleManagerPrivate::needsValidation(const Registration& registration) const
+{
+  return this->ValidationMode != ctkCmdLineModuleManager::SKIP_VALIDATION &&
+      !registration.HasCachedDescription;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleReference ctkCmdLineModuleManagerPrivate::validateAndRegister(Registration& registration)
+{
+  CTK_TRACE_SCOPE("CommandLineModules", "validateAndRegister");
+  const QUrl& location = registration.Location;
+  QByteArray& xml = registration.Xml;
+  ctkCmdLineModuleReference ref = registration.Reference;
+
+  if (this->needsValidation(registration))
   {
     // validate the outputted xml description
     QBuffer input(&xml);
@@ -203,13 +522,13 @@ ctkCmdLineModuleManager::registerModule(const QUrl &location)
     ctkCmdLineModuleXmlValidator validator(&input);
     if (!validator.validateInput())
     {
-      if (d->ModuleCache)
+      if (this->ModuleCache)
       {
         // validation failed, cache the description anyway
-        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml);
+        this->ModuleCache->cacheXmlDescription(location, registration.TimeStamp, xml);
       }
 
-      if (d->ValidationMode == STRICT_VALIDATION)
+      if (this->ValidationMode == ctkCmdLineModuleManager::STRICT_VALIDATION)
       {
         throw ctkInvalidArgumentException(QString("Validating module at %1 failed: %2")
                                           .arg(location.toString()).arg(validator.errorString()));
@@ -217,41 +536,259 @@ ctkCmdLineModuleManager::registerModule(const QUrl &location)
       else
       {
         ref.d->XmlValidationErrorString = validator.errorString();
+        this->cacheParsedDescription(ref);
       }
     }
     else
     {
-      if (d->ModuleCache && newTimeStamp > 0)
+      if (this->ModuleCache && registration.TimeStamp > 0)
       {
-        // successfully validated the xml, cache it
-        d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml);
+        // successfully validated the xml, cache it together with the
+        // parsed description
+        this->ModuleCache->cacheXmlDescription(location, registration.TimeStamp, xml);
+        this->cacheParsedDescription(ref);
       }
     }
   }
-  else
+  else if (this->ValidationMode == ctkCmdLineModuleManager::SKIP_VALIDATION)
   {
-    if (!fromCache && d->ModuleCache)
+    if (!registration.FromCache && this->ModuleCache)
     {
       // cache it
-      d->ModuleCache->cacheXmlDescription(location, newTimeStamp, xml);
+      this->ModuleCache->cacheXmlDescription(location, registration.TimeStamp, xml);
     }
   }
 
   {
-    QMutexLocker lock(&d->Mutex);
+    QMutexLocker lock(&this->Mutex);
     // Check that we don't have a race condition
-    if (d->LocationToRef.contains(location))
+    if (this->LocationToRef.contains(location))
     {
       // Another thread registered a module with the same location
-      return d->LocationToRef[location];
+      return this->LocationToRef[location];
     }
-    d->LocationToRef[location] = ref;
+    this->LocationToRef[location] = ref;
   }
 
-  emit moduleRegistered(ref);
+  emit q->moduleRegistered(ref);
   return ref;
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerPrivate::cacheParsedDescription(const ctkCmdLineModuleReference& ref)
+{
+  // Parse the description now, so later registrations from the cache
+  // neither need to validate nor to parse the XML again.
+  if (this->ModuleCache && ref.d->parseDescription())
+  {
+    this->ModuleCache->cacheModuleDescription(ref.d->Location, ref.d->description(),
+                                              ref.d->XmlValidationErrorString);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerPrivate::flushCache()
+{
+  if (this->ModuleCache && !this->ModuleCache->flush())
+  {
+    qWarning() << "Writing the command line module cache in" << this->ModuleCache->cacheDir() << "failed.";
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerPrivate::reportRegistration(const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                                                        int index, const ctkCmdLineModuleReference& ref)
+{
+  batch->FutureInterface.reportResult(ref, index);
+  const int done = batch->Done.fetchAndAddOrdered(1) + 1;
+  batch->FutureInterface.setProgressValue(done);
+  if (done == batch->Total)
+  {
+    // Persist the cache updates of the whole batch at once
+    this->flushCache();
+    batch->FutureInterface.reportFinished();
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManagerPrivate::reportRegistrationFailure(const QSharedPointer<ctkCmdLineModuleRegistrationBatch>& batch,
+                                                               int index, const QUrl& location,
+                                                               const QString& errorString)
+{
+  emit q->moduleRegistrationFailed(location, errorString);
+  this->reportRegistration(batch, index, ctkCmdLineModuleReference());
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleManager::ctkCmdLineModuleManager(ValidationMode validationMode, const QString& cacheDir)
+  : d(new ctkCmdLineModuleManagerPrivate(this, validationMode, cacheDir))
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleManager::~ctkCmdLineModuleManager()
+{
+  // Probe tasks may still enqueue validation tasks, so wait for
+  // them first.
+  d->ProbePool.waitForDone();
+  d->ValidationPool.waitForDone();
+  // Batch slots submit runs to the scheduler
+  d->BatchPool.waitForDone();
+  d->Scheduler.waitForDone();
+  d->flushCache();
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleManager::ValidationMode ctkCmdLineModuleManager::validationMode() const
+{
+  return d->ValidationMode;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::setMaxParallelProbes(int maxProbes)
+{
+  d->ProbePool.setMaxThreadCount(qMax(1, maxProbes));
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleManager::maxParallelProbes() const
+{
+  return d->ProbePool.maxThreadCount();
+}
+
+//----------------------------------------------------------------------------
+QFuture<ctkCmdLineModuleBatchResult>
+ctkCmdLineModuleManager::runBatch(const ctkCmdLineModuleReference& moduleRef,
+                                  const QList<QHash<QString, QVariant> >& parameterSets,
+                                  int maxConcurrentRuns, int priority)
+{
+  if (!moduleRef)
+  {
+    throw ctkInvalidArgumentException("Cannot run an invalid module reference.");
+  }
+
+  ctkCmdLineModuleBackend* backend = NULL;
+  {
+    QMutexLocker lock(&d->Mutex);
+    d->checkBackends_unlocked(moduleRef.location());
+    backend = d->SchemeToBackend[moduleRef.location().scheme()];
+  }
+
+  if (maxConcurrentRuns < 1)
+  {
+    maxConcurrentRuns = d->Scheduler.maxConcurrentRuns();
+  }
+  const int slotCount = qMax(1, qMin(maxConcurrentRuns, parameterSets.size()));
+
+  QSharedPointer<ctkCmdLineModuleRunBatch> batch(
+        new ctkCmdLineModuleRunBatch(moduleRef, backend, parameterSets, priority, slotCount));
+
+  QFutureInterface<ctkCmdLineModuleBatchResult>& futureInterface = batch->FutureInterface;
+  futureInterface.reportStarted();
+  futureInterface.setProgressRange(0, parameterSets.size());
+  QFuture<ctkCmdLineModuleBatchResult> future = futureInterface.future();
+
+  if (parameterSets.isEmpty())
+  {
+    futureInterface.reportFinished();
+    return future;
+  }
+
+  // Each slot runs one item at a time, so the slot count bounds the
+  // number of concurrent runs of this batch.
+  {
+    QMutexLocker lock(&d->Mutex);
+    d->BatchPool.setMaxThreadCount(qMax(d->BatchPool.maxThreadCount(),
+                                        d->BatchPool.activeThreadCount() + slotCount));
+  }
+  for (int i = 0; i < slotCount; ++i)
+  {
+    d->BatchPool.start(new ctkCmdLineModuleBatchSlotTask(d.data(), batch));
+  }
+  return future;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler* ctkCmdLineModuleManager::scheduler() const
+{
+  return &d->Scheduler;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleManager::registerBackend(ctkCmdLineModuleBackend *backend)
+{
+  QMutexLocker lock(&d->Mutex);
+
+  QList<QString> supportedSchemes = backend->schemes();
+
+  // Check if there is already a backend registerd for any of the
+  // supported schemes. We only supported one backend per scheme.
+  foreach (QString scheme, supportedSchemes)
+  {
+    if (d->SchemeToBackend.contains(scheme))
+    {
+      throw ctkInvalidArgumentException(QString("A backend for scheme %1 is already registered.").arg(scheme));
+    }
+  }
+
+  // All good
+  foreach (QString scheme, supportedSchemes)
+  {
+    d->SchemeToBackend[scheme] = backend;
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleReference
+ctkCmdLineModuleManager::registerModule(const QUrl &location)
+{
+  ctkCmdLineModuleManagerPrivate::Registration registration;
+  registration.Location = location;
+
+  ctkCmdLineModuleReference ref;
+  if (d->prepareRegistration(registration, ref))
+  {
+    return ref;
+  }
+
+  d->fetchXmlDescription(registration);
+  // The cache is written when the manager is destroyed: registering
+  // modules one by one must not re-write the whole cache file each time
+  return d->validateAndRegister(registration);
+}
+
+//----------------------------------------------------------------------------
+QFuture<ctkCmdLineModuleReference>
+ctkCmdLineModuleManager::registerModuleAsync(const QUrl& location)
+{
+  return this->registerModulesAsync(QList<QUrl>() << location);
+}
+
+//----------------------------------------------------------------------------
+QFuture<ctkCmdLineModuleReference>
+ctkCmdLineModuleManager::registerModulesAsync(const QList<QUrl>& locations)
+{
+  QSharedPointer<ctkCmdLineModuleRegistrationBatch> batch(
+        new ctkCmdLineModuleRegistrationBatch(locations.size()));
+
+  QFutureInterface<ctkCmdLineModuleReference>& futureInterface = batch->FutureInterface;
+  futureInterface.reportStarted();
+  futureInterface.setProgressRange(0, locations.size());
+  QFuture<ctkCmdLineModuleReference> future = futureInterface.future();
+
+  if (locations.isEmpty())
+  {
+    futureInterface.reportFinished();
+    return future;
+  }
+
+  for (int i = 0; i < locations.size(); ++i)
+  {
+    d->ProbePool.start(new ctkCmdLineModuleProbeTask(d.data(), batch, i, locations[i]));
+  }
+  return future;
+}
+
 //----------------------------------------------------------------------------
 void ctkCmdLineModuleManager::unregisterModule(const ctkCmdLineModuleReference& ref)
 {
@@ -289,11 +826,23 @@ QList<ctkCmdLineModuleReference> ctkCmdLineModuleManager::moduleReferences() con
 
 //----------------------------------------------------------------------------
 ctkCmdLineModuleFuture ctkCmdLineModuleManager::run(ctkCmdLineModuleFrontend *frontend)
+{
+  return this->run(frontend, 0);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleFuture ctkCmdLineModuleManager::run(ctkCmdLineModuleFrontend *frontend,
+                                                    int priority, const QString& caller)
 {
   QMutexLocker lock(&d->Mutex);
   d->checkBackends_unlocked(frontend->location());
 
-  ctkCmdLineModuleFuture future = d->SchemeToBackend[frontend->location().scheme()]->run(frontend);
+  ctkCmdLineModuleBackend* backend = d->SchemeToBackend[frontend->location().scheme()];
+  ctkCmdLineModuleFuture future;
+  {
+    ctkCmdLineModuleSchedulerSubmission submission(&d->Scheduler, backend, priority, caller);
+    future = backend->run(frontend);
+  }
   frontend->setFuture(future);
   emit frontend->started();
   return future;
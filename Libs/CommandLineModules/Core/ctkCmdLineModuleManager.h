@@ -26,12 +26,15 @@
 
 #include <QStringList>
 #include <QString>
+#include <QFuture>
 #include "ctkCmdLineModuleReference.h"
+#include "ctkCmdLineModuleBatchResult.h"
 
 struct ctkCmdLineModuleBackend;
 struct ctkCmdLineModuleFrontendFactory;
 class ctkCmdLineModuleFrontend;
 class ctkCmdLineModuleFuture;
+class ctkCmdLineModuleScheduler;
 
 struct ctkCmdLineModuleManagerPrivate;
 
@@ -105,6 +108,24 @@ public:
    */
   ValidationMode validationMode() const;
 
+  /**
+   * @brief Set the maximum number of modules which are probed in parallel.
+   * @param maxProbes The maximum number of concurrent XML description requests.
+   *
+   * Asynchronous registrations fetch the XML description of modules
+   * (e.g. by running a local executable with the "--xml" argument) with at most
+   * <code>maxProbes</code> threads. The default is twice the number of CPU cores.
+   *
+   * @see registerModulesAsync()
+   */
+  void setMaxParallelProbes(int maxProbes);
+
+  /**
+   * @brief Get the maximum number of modules which are probed in parallel.
+   * @return The maximum number of concurrent XML description requests.
+   */
+  int maxParallelProbes() const;
+
   /**
    * @brief Registers a new back-end.
    * @param backend The new back-end.
@@ -119,9 +140,39 @@ public:
    * @return A module reference.
    * @throws ctkInvalidArgumentException if no back-end for the given URL scheme was registered
    *         or the XML description for the module is invalid.
+   *
+   * The cache updates of synchronous registrations are written when the manager
+   * is destroyed, or together with the next asynchronous registration batch.
    */
   ctkCmdLineModuleReference registerModule(const QUrl& location);
 
+  /**
+   * @brief Registers a module asynchronously.
+   * @param location The URL for the new module.
+   * @return A future holding the module reference.
+   *
+   * This is a convenience method for registerModulesAsync() with a single location.
+   */
+  QFuture<ctkCmdLineModuleReference> registerModuleAsync(const QUrl& location);
+
+  /**
+   * @brief Registers several modules asynchronously.
+   * @param locations The URLs for the new modules.
+   * @return A future holding one module reference per location, in the order
+   *         of <code>locations</code>.
+   *
+   * This method returns immediately. The XML descriptions are fetched by a pool of
+   * at most maxParallelProbes() threads and validated by a separate pool of worker
+   * threads. Use a QFutureWatcher to get notified about the progress
+   * (<code>progressValueChanged</code>), single results (<code>resultReadyAt</code>)
+   * and the completion (<code>finished</code>) of the registrations.
+   *
+   * Modules which could not be registered yield an invalid module reference and
+   * the moduleRegistrationFailed() signal is emitted for them. Canceling the future
+   * skips all modules which have not been probed yet.
+   */
+  QFuture<ctkCmdLineModuleReference> registerModulesAsync(const QList<QUrl>& locations);
+
   /**
    * @brief Unregister a previously registered module.
    * @param moduleRef The reference for the module to unregister.
@@ -160,6 +211,53 @@ public:
    */
   ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend);
 
+  /**
+   * @brief Run a module front-end with a priority.
+   * @param frontend The module front-end to run.
+   * @param priority Queued runs with a higher priority are started first.
+   * @param caller An arbitrary key identifying the submitter. Queued runs with the same
+   *        priority are started round-robin between callers.
+   * @return A ctkCmdLineModuleFuture object which can be used to interact with the
+   *         running front-end.
+   *
+   * The run is executed by the scheduler returned by scheduler(). If the scheduler's
+   * concurrency limits are reached, the run is queued and the returned future reports
+   * ctkCmdLineModuleFuture::isQueued() until it is started.
+   *
+   * @see run(ctkCmdLineModuleFrontend*)
+   */
+  ctkCmdLineModuleFuture run(ctkCmdLineModuleFrontend* frontend, int priority,
+                             const QString& caller = QString());
+
+  /**
+   * @brief Run a module once for each set of parameter values.
+   * @param moduleRef The module to run.
+   * @param parameterSets The parameter values for each run, keyed by parameter name.
+   *        Parameters without a value use their default value.
+   * @param maxConcurrentRuns The maximum number of concurrent runs of this batch. A value
+   *        smaller than one uses the limit of scheduler().
+   * @param priority The scheduling priority of the runs, see run(ctkCmdLineModuleFrontend*, int, const QString&).
+   * @return A future reporting one ctkCmdLineModuleBatchResult per parameter set, at the
+   *         index of the parameter set. The progress value is the number of finished items.
+   * @throws ctkInvalidArgumentException if \c moduleRef is invalid or no back-end is
+   *         registered for it.
+   *
+   * Failing items do not stop the batch, their error is reported in the item result.
+   * Canceling the returned future stops starting new items; items already running
+   * are completed, but their results are not reported.
+   */
+  QFuture<ctkCmdLineModuleBatchResult> runBatch(const ctkCmdLineModuleReference& moduleRef,
+                                                const QList<QHash<QString, QVariant> >& parameterSets,
+                                                int maxConcurrentRuns = 0, int priority = 0);
+
+  /**
+   * @brief Get the scheduler which executes the runs started by this manager.
+   * @return The scheduler, owned by this manager.
+   *
+   * Use it to configure concurrency limits and to query queue statistics.
+   */
+  ctkCmdLineModuleScheduler* scheduler() const;
+
 Q_SIGNALS:
 
   /**
@@ -172,8 +270,17 @@ Q_SIGNALS:
    */
   void moduleUnregistered(const ctkCmdLineModuleReference&);
 
+  /**
+   * @brief This signal is emitted whenever an asynchronous module registration fails.
+   * @param location The URL of the module.
+   * @param errorString A description of the error.
+   */
+  void moduleRegistrationFailed(const QUrl& location, const QString& errorString);
+
 private:
 
+  friend struct ctkCmdLineModuleManagerPrivate;
+
   QScopedPointer<ctkCmdLineModuleManagerPrivate> d;
 
   Q_DISABLE_COPY(ctkCmdLineModuleManager)
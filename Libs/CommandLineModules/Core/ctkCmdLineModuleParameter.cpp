@@ -295,3 +295,41 @@ QTextStream& operator<<(QTextStream& os, const ctkCmdLineModuleParameter& parame
   os << "      " << "CoordinateSystem: " << parameter.coordinateSystem() << '\n';
   return os;
 }
+
+//----------------------------------------------------------------------------
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleParameterPrivate& parameter)
+{
+  out << parameter.Tag << parameter.Name << parameter.Description << parameter.Label
+      << parameter.Type << parameter.Hidden << parameter.Default << parameter.Flag
+      << parameter.LongFlag << parameter.Constraints << parameter.Minimum
+      << parameter.Maximum << parameter.Step << parameter.Channel
+      << static_cast<qint32>(parameter.Index) << static_cast<qint32>(parameter.Multiple)
+      << parameter.FileExtensionsAsString << parameter.FileExtensions
+      << parameter.CoordinateSystem << parameter.Elements << parameter.FlagAliasesAsString
+      << parameter.DeprecatedFlagAliasesAsString << parameter.LongFlagAliasesAsString
+      << parameter.DeprecatedLongFlagAliasesAsString << parameter.FlagAliases
+      << parameter.DeprecatedFlagAliases << parameter.LongFlagAliases
+      << parameter.DeprecatedLongFlagAliases;
+  return out;
+}
+
+//----------------------------------------------------------------------------
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleParameterPrivate& parameter)
+{
+  qint32 index = -1;
+  qint32 multiple = 0;
+  in >> parameter.Tag >> parameter.Name >> parameter.Description >> parameter.Label
+     >> parameter.Type >> parameter.Hidden >> parameter.Default >> parameter.Flag
+     >> parameter.LongFlag >> parameter.Constraints >> parameter.Minimum
+     >> parameter.Maximum >> parameter.Step >> parameter.Channel
+     >> index >> multiple
+     >> parameter.FileExtensionsAsString >> parameter.FileExtensions
+     >> parameter.CoordinateSystem >> parameter.Elements >> parameter.FlagAliasesAsString
+     >> parameter.DeprecatedFlagAliasesAsString >> parameter.LongFlagAliasesAsString
+     >> parameter.DeprecatedLongFlagAliasesAsString >> parameter.FlagAliases
+     >> parameter.DeprecatedFlagAliases >> parameter.LongFlagAliases
+     >> parameter.DeprecatedLongFlagAliases;
+  parameter.Index = index;
+  parameter.Multiple = multiple;
+  return in;
+}
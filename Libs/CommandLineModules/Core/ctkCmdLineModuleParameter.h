@@ -25,10 +25,12 @@
 
 #include <QSharedDataPointer>
 
+class QDataStream;
 class QTextStream;
 class QStringList;
 
 struct ctkCmdLineModuleParameterPrivate;
+struct ctkCmdLineModuleParameterGroupPrivate;
 
 /** 
  * \class ctkCmdLineModuleParameter
@@ -223,6 +225,8 @@ private:
 
   friend struct ctkCmdLineModuleParameterParser;
   friend class ctkCmdLineModuleXmlParser;
+  friend QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleParameterGroupPrivate& group);
+  friend QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleParameterGroupPrivate& group);
 
   ctkCmdLineModuleParameter();
 
@@ -21,6 +21,7 @@ limitations under the License.
 #include "ctkCmdLineModuleParameterGroup.h"
 
 #include "ctkCmdLineModuleParameter.h"
+#include "ctkCmdLineModuleParameter_p.h"
 #include "ctkCmdLineModuleParameterGroup_p.h"
 
 #include "ctkException.h"
@@ -123,3 +124,31 @@ QTextStream & operator<<(QTextStream &os, const ctkCmdLineModuleParameterGroup &
   }
   return os;
 }
+
+//----------------------------------------------------------------------------
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleParameterGroupPrivate& group)
+{
+  out << group.Label << group.Description << group.Advanced;
+  out << static_cast<qint32>(group.Parameters.size());
+  foreach(const ctkCmdLineModuleParameter& parameter, group.Parameters)
+  {
+    out << *parameter.d;
+  }
+  return out;
+}
+
+//----------------------------------------------------------------------------
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleParameterGroupPrivate& group)
+{
+  in >> group.Label >> group.Description >> group.Advanced;
+  qint32 parameterCount = 0;
+  in >> parameterCount;
+  group.Parameters.clear();
+  for (qint32 i = 0; i < parameterCount && in.status() == QDataStream::Ok; ++i)
+  {
+    ctkCmdLineModuleParameter parameter;
+    in >> *parameter.d;
+    group.Parameters.push_back(parameter);
+  }
+  return in;
+}
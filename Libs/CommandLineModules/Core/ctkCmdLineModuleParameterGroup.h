@@ -26,10 +26,12 @@
 #include <QList>
 #include <QSharedDataPointer>
 
+class QDataStream;
 class QTextStream;
 
 class ctkCmdLineModuleParameter;
 struct ctkCmdLineModuleParameterGroupPrivate;
+struct ctkCmdLineModuleDescriptionPrivate;
 
 /** 
  * \class ctkCmdLineModuleParameterGroup
@@ -63,6 +65,8 @@ public:
 private:
 
   friend class ctkCmdLineModuleXmlParser;
+  friend QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleDescriptionPrivate& description);
+  friend QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleDescriptionPrivate& description);
 
   ctkCmdLineModuleParameterGroup();
 
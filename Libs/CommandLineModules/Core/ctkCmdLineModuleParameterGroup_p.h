@@ -22,6 +22,7 @@
 #ifndef CTKCMDLINEMODULEPARAMETERGROUPPRIVATE_H
 #define CTKCMDLINEMODULEPARAMETERGROUPPRIVATE_H
 
+#include <QDataStream>
 #include <QSharedData>
 #include <QString>
 #include <QList>
@@ -36,4 +37,12 @@ struct ctkCmdLineModuleParameterGroupPrivate : public QSharedData
   QList<ctkCmdLineModuleParameter> Parameters;
 };
 
+/**
+ * Binary serialization of all group fields, including the parameters. Keep
+ * in sync with the fields above and increment
+ * ctkCmdLineModuleDescriptionPrivate::StreamFormatVersion when changing it.
+ */
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleParameterGroupPrivate& group);
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleParameterGroupPrivate& group);
+
 #endif // CTKCMDLINEMODULEPARAMETERGROUPPRIVATE_H
@@ -24,6 +24,7 @@
 
 #include "ctkCmdLineModuleParameter.h"
 
+#include <QDataStream>
 #include <QString>
 #include <QStringList>
 
@@ -66,4 +67,12 @@ struct ctkCmdLineModuleParameterPrivate : public QSharedData
 
 };
 
+/**
+ * Binary serialization of all parameter fields. Keep in sync with the
+ * fields above and increment ctkCmdLineModuleDescriptionPrivate::StreamFormatVersion
+ * when changing it.
+ */
+QDataStream& operator<<(QDataStream& out, const ctkCmdLineModuleParameterPrivate& parameter);
+QDataStream& operator>>(QDataStream& in, ctkCmdLineModuleParameterPrivate& parameter);
+
 #endif // CTKCMDLINEMODULEPARAMETERPRIVATE_H
@@ -21,6 +21,7 @@
 
 #include "ctkCmdLineModuleReference.h"
 #include "ctkCmdLineModuleReference_p.h"
+#include "ctkCmdLineModuleCache_p.h"
 #include "ctkCmdLineModuleXmlParser_p.h"
 #include "ctkCmdLineModuleXmlException.h"
 
@@ -49,6 +50,18 @@ ctkCmdLineModuleDescription ctkCmdLineModuleReferencePrivate::description() cons
     throw *XmlException;
   }
 
+  parseDescription();
+  return Description;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleReferencePrivate::parseDescription() const
+{
+  if (XmlException)
+  {
+    return false;
+  }
+
   // Lazy creation. The title is a required XML element.
   if (Description.title().isNull())
   {
@@ -62,9 +75,16 @@ ctkCmdLineModuleDescription ctkCmdLineModuleReferencePrivate::description() cons
     catch (const ctkCmdLineModuleXmlException& e)
     {
       XmlException = e.clone();
+      return false;
     }
   }
-  return Description;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleReferencePrivate::loadCachedDescription(const ctkCmdLineModuleCache& cache)
+{
+  return cache.moduleDescription(Location, Description, XmlValidationErrorString);
 }
 
 //----------------------------------------------------------------------------
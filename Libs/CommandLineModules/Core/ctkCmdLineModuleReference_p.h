@@ -28,6 +28,7 @@
 #include <QUrl>
 
 struct ctkCmdLineModuleBackend;
+class ctkCmdLineModuleCache;
 class ctkCmdLineModuleXmlException;
 
 struct ctkCmdLineModuleReferencePrivate : public QSharedData
@@ -37,6 +38,19 @@ struct ctkCmdLineModuleReferencePrivate : public QSharedData
 
   ctkCmdLineModuleDescription description() const;
 
+  /**
+   * Parses the XML description, if this has not been done yet.
+   * @return <code>false</code> if the XML description could not be parsed.
+   */
+  bool parseDescription() const;
+
+  /**
+   * Sets the parsed description and the XML validation error string
+   * from the module cache.
+   * @return <code>false</code> if the cache does not contain a parsed description.
+   */
+  bool loadCachedDescription(const ctkCmdLineModuleCache& cache);
+
   ctkCmdLineModuleBackend* Backend;
   QUrl Location;
   QByteArray RawXmlDescription;
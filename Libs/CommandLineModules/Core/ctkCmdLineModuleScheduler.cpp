@@ -0,0 +1,369 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#include "ctkCmdLineModuleScheduler.h"
+#include "ctkCmdLineModuleScheduler_p.h"
+
+#include "ctkCmdLineModuleFutureInterface_p.h"
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadStorage>
+
+namespace {
+
+//----------------------------------------------------------------------------
+struct ctkCmdLineModuleSchedulerContext
+{
+  ctkCmdLineModuleScheduler* Scheduler;
+  ctkCmdLineModuleBackend* Backend;
+  int Priority;
+  QString Caller;
+};
+
+Q_GLOBAL_STATIC(QThreadStorage<ctkCmdLineModuleSchedulerContext*>, currentContext)
+
+//----------------------------------------------------------------------------
+class ctkCmdLineModuleScheduledRun : public QRunnable
+{
+public:
+
+  ctkCmdLineModuleScheduledRun(ctkCmdLineModuleSchedulerPrivate* d, QRunnable* runnable,
+                               ctkCmdLineModuleBackend* backend)
+    : d(d)
+    , Runnable(runnable)
+    , Backend(backend)
+  {}
+
+  void run()
+  {
+    Finisher finisher(this);
+    Runnable->run();
+  }
+
+private:
+
+  // Finishes the run also if the runnable throws
+  struct Finisher
+  {
+    Finisher(ctkCmdLineModuleScheduledRun* run) : Run(run) {}
+
+    ~Finisher()
+    {
+      if (Run->Runnable->autoDelete())
+      {
+        delete Run->Runnable;
+      }
+      // Starts the next queued run, if any, before this thread is returned
+      // to the pool. This keeps ctkCmdLineModuleScheduler::waitForDone() simple.
+      Run->d->runFinished(Run->Backend);
+    }
+
+    ctkCmdLineModuleScheduledRun* const Run;
+  };
+
+  ctkCmdLineModuleSchedulerPrivate* const d;
+  QRunnable* const Runnable;
+  ctkCmdLineModuleBackend* const Backend;
+};
+
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleSchedulerSubmission::ctkCmdLineModuleSchedulerSubmission(
+    ctkCmdLineModuleScheduler* scheduler, ctkCmdLineModuleBackend* backend,
+    int priority, const QString& caller)
+{
+  ctkCmdLineModuleSchedulerContext* context = new ctkCmdLineModuleSchedulerContext;
+  context->Scheduler = scheduler;
+  context->Backend = backend;
+  context->Priority = priority;
+  context->Caller = caller;
+  currentContext()->setLocalData(context);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleSchedulerSubmission::~ctkCmdLineModuleSchedulerSubmission()
+{
+  // deletes the context
+  currentContext()->setLocalData(0);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::Statistics::Statistics()
+  : queueDepth(0)
+  , maxQueueDepth(0)
+  , runningCount(0)
+  , startedCount(0)
+  , totalWaitTime(0)
+  , maxWaitTime(0)
+{
+}
+
+//----------------------------------------------------------------------------
+double ctkCmdLineModuleScheduler::Statistics::averageWaitTime() const
+{
+  return startedCount > 0 ? static_cast<double>(totalWaitTime) / startedCount : 0.0;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleSchedulerPrivate::ctkCmdLineModuleSchedulerPrivate()
+  : MaxConcurrentRuns(QThread::idealThreadCount())
+{
+  Pool.setMaxThreadCount(MaxConcurrentRuns);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleSchedulerPrivate::~ctkCmdLineModuleSchedulerPrivate()
+{
+  // All queued items have been dispatched in ctkCmdLineModuleScheduler::waitForDone()
+  Q_ASSERT(Levels.isEmpty());
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleSchedulerPrivate::start(const ctkCmdLineModuleFutureInterface& futureInterface,
+                                             QRunnable* runnable)
+{
+  ctkCmdLineModuleSchedulerContext* context = currentContext()->hasLocalData()
+      ? currentContext()->localData() : 0;
+  if (context == 0)
+  {
+    QThreadPool::globalInstance()->start(runnable, /*m_priority*/ 0);
+    return;
+  }
+
+  context->Scheduler->d->enqueue(futureInterface, runnable, context->Backend,
+                                 context->Priority, context->Caller);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleSchedulerPrivate::enqueue(const ctkCmdLineModuleFutureInterface& futureInterface,
+                                               QRunnable* runnable, ctkCmdLineModuleBackend* backend,
+                                               int priority, const QString& caller)
+{
+  Item* item = new Item(futureInterface, runnable, backend);
+  item->Future.d->reportQueued();
+
+  QMutexLocker lock(&Mutex);
+
+  Level& level = Levels[priority];
+  QQueue<Item*>& queue = level.Queues[caller];
+  if (queue.isEmpty())
+  {
+    level.Callers.push_back(caller);
+  }
+  queue.enqueue(item);
+
+  ctkCmdLineModuleScheduler::Statistics& backendStats = BackendStatistics[backend];
+  backendStats.maxQueueDepth = qMax(backendStats.maxQueueDepth, ++backendStats.queueDepth);
+  TotalStatistics.maxQueueDepth = qMax(TotalStatistics.maxQueueDepth, ++TotalStatistics.queueDepth);
+
+  this->dispatch_unlocked();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleSchedulerPrivate::runFinished(ctkCmdLineModuleBackend* backend)
+{
+  QMutexLocker lock(&Mutex);
+  --BackendStatistics[backend].runningCount;
+  --TotalStatistics.runningCount;
+  this->dispatch_unlocked();
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleSchedulerPrivate::canStart_unlocked(ctkCmdLineModuleBackend* backend) const
+{
+  const int limit = BackendLimits.value(backend, 0);
+  return limit < 1 || BackendStatistics.value(backend).runningCount < limit;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleSchedulerPrivate::Item* ctkCmdLineModuleSchedulerPrivate::takeNext_unlocked()
+{
+  QMutableMapIterator<int, Level> levelIter(Levels);
+  levelIter.toBack();
+  while (levelIter.hasPrevious())
+  {
+    Level& level = levelIter.previous().value();
+    for (int callerIndex = 0; callerIndex < level.Callers.size(); ++callerIndex)
+    {
+      const QString caller = level.Callers.at(callerIndex);
+      QQueue<Item*>& queue = level.Queues[caller];
+      for (int i = 0; i < queue.size(); ++i)
+      {
+        if (!this->canStart_unlocked(queue.at(i)->Backend)) continue;
+
+        Item* item = queue.takeAt(i);
+        // Move the caller to the end of the round-robin order
+        level.Callers.removeAt(callerIndex);
+        if (queue.isEmpty())
+        {
+          level.Queues.remove(caller);
+        }
+        else
+        {
+          level.Callers.push_back(caller);
+        }
+        if (level.Callers.isEmpty())
+        {
+          levelIter.remove();
+        }
+        return item;
+      }
+    }
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleSchedulerPrivate::dispatch_unlocked()
+{
+  while (TotalStatistics.runningCount < MaxConcurrentRuns)
+  {
+    Item* item = this->takeNext_unlocked();
+    if (item == 0) break;
+
+    ctkCmdLineModuleScheduler::Statistics& backendStats = BackendStatistics[item->Backend];
+    if (item->Future.isCanceled())
+    {
+      // Canceled while queued, do not run it at all
+      --TotalStatistics.queueDepth;
+      --backendStats.queueDepth;
+      item->Future.d->reportDequeued();
+      ctkCmdLineModuleFutureInterface future(item->Future);
+      future.reportFinished();
+      if (item->Runnable->autoDelete())
+      {
+        delete item->Runnable;
+      }
+      delete item;
+      continue;
+    }
+
+    const qint64 waitTime = item->Future.d->reportDequeued();
+
+    ctkCmdLineModuleScheduler::Statistics* stats[] = { &TotalStatistics, &backendStats };
+    for (int i = 0; i < 2; ++i)
+    {
+      --stats[i]->queueDepth;
+      ++stats[i]->runningCount;
+      ++stats[i]->startedCount;
+      stats[i]->totalWaitTime += waitTime;
+      stats[i]->maxWaitTime = qMax(stats[i]->maxWaitTime, waitTime);
+    }
+
+    Pool.start(new ctkCmdLineModuleScheduledRun(this, item->Runnable, item->Backend));
+    delete item;
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::ctkCmdLineModuleScheduler()
+  : d(new ctkCmdLineModuleSchedulerPrivate)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::~ctkCmdLineModuleScheduler()
+{
+  this->waitForDone();
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setMaxConcurrentRuns(int maxRuns)
+{
+  QMutexLocker lock(&d->Mutex);
+  d->MaxConcurrentRuns = qMax(1, maxRuns);
+  // The pool never queues, all queuing happens in the scheduler
+  d->Pool.setMaxThreadCount(qMax(d->Pool.maxThreadCount(), d->MaxConcurrentRuns));
+  d->dispatch_unlocked();
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleScheduler::maxConcurrentRuns() const
+{
+  QMutexLocker lock(&d->Mutex);
+  return d->MaxConcurrentRuns;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::setMaxConcurrentRuns(ctkCmdLineModuleBackend* backend, int maxRuns)
+{
+  QMutexLocker lock(&d->Mutex);
+  if (maxRuns < 1)
+  {
+    d->BackendLimits.remove(backend);
+  }
+  else
+  {
+    d->BackendLimits.insert(backend, maxRuns);
+  }
+  d->dispatch_unlocked();
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleScheduler::maxConcurrentRuns(ctkCmdLineModuleBackend* backend) const
+{
+  QMutexLocker lock(&d->Mutex);
+  return d->BackendLimits.value(backend, 0);
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::Statistics ctkCmdLineModuleScheduler::statistics() const
+{
+  QMutexLocker lock(&d->Mutex);
+  return d->TotalStatistics;
+}
+
+//----------------------------------------------------------------------------
+ctkCmdLineModuleScheduler::Statistics ctkCmdLineModuleScheduler::statistics(ctkCmdLineModuleBackend* backend) const
+{
+  QMutexLocker lock(&d->Mutex);
+  return d->BackendStatistics.value(backend);
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::resetStatistics()
+{
+  QMutexLocker lock(&d->Mutex);
+  QList<Statistics*> stats;
+  stats << &d->TotalStatistics;
+  for (QHash<ctkCmdLineModuleBackend*, Statistics>::iterator iter = d->BackendStatistics.begin();
+       iter != d->BackendStatistics.end(); ++iter)
+  {
+    stats << &iter.value();
+  }
+  foreach(Statistics* s, stats)
+  {
+    Statistics reset;
+    reset.queueDepth = s->queueDepth;
+    reset.maxQueueDepth = s->queueDepth;
+    reset.runningCount = s->runningCount;
+    *s = reset;
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleScheduler::waitForDone()
+{
+  d->Pool.waitForDone();
+}
@@ -0,0 +1,140 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULESCHEDULER_H
+#define CTKCMDLINEMODULESCHEDULER_H
+
+#include "ctkCommandLineModulesCoreExport.h"
+
+#include <QScopedPointer>
+
+struct ctkCmdLineModuleBackend;
+class ctkCmdLineModuleSchedulerPrivate;
+
+/**
+ * \class ctkCmdLineModuleScheduler
+ * \brief Bounded, priority-aware execution queue for module runs.
+ * \ingroup CommandLineModulesCore_API
+ *
+ * Each ctkCmdLineModuleManager owns a scheduler (see ctkCmdLineModuleManager::scheduler())
+ * which executes the tasks started by back-ends from within ctkCmdLineModuleManager::run().
+ * The scheduler limits the number of concurrent runs globally and, optionally, per
+ * back-end. Runs which cannot be started immediately are queued. Queued runs with a higher
+ * priority are started first, runs with the same priority are started round-robin between
+ * the callers which submitted them and in FIFO order for the same caller.
+ *
+ * Back-end tasks must use ctkCmdLineModuleFutureInterface::startRunnable() instead of
+ * starting themselves in QThreadPool::globalInstance() to take part in scheduling.
+ *
+ * All methods are thread-safe.
+ */
+class CTK_CMDLINEMODULECORE_EXPORT ctkCmdLineModuleScheduler
+{
+
+public:
+
+  /**
+   * Accumulated queue statistics. All times are in milliseconds.
+   */
+  struct CTK_CMDLINEMODULECORE_EXPORT Statistics
+  {
+    Statistics();
+
+    /** The number of runs currently waiting in the queue. */
+    int queueDepth;
+    /** The maximum number of runs which waited in the queue at the same time. */
+    int maxQueueDepth;
+    /** The number of runs currently executing. */
+    int runningCount;
+    /** The number of runs started so far. */
+    qint64 startedCount;
+    /** The sum of the queue wait times of all started runs. */
+    qint64 totalWaitTime;
+    /** The longest queue wait time of all started runs. */
+    qint64 maxWaitTime;
+
+    /**
+     * @return The average queue wait time of all started runs.
+     */
+    double averageWaitTime() const;
+  };
+
+  ctkCmdLineModuleScheduler();
+
+  /**
+   * Waits for all queued and running tasks to finish.
+   */
+  ~ctkCmdLineModuleScheduler();
+
+  /**
+   * @brief Set the maximum number of concurrently executing runs.
+   * @param maxRuns The new limit. Values smaller than one are treated as one.
+   *
+   * The default is QThread::idealThreadCount().
+   */
+  void setMaxConcurrentRuns(int maxRuns);
+  int maxConcurrentRuns() const;
+
+  /**
+   * @brief Set the maximum number of concurrently executing runs for a back-end.
+   * @param backend The back-end.
+   * @param maxRuns The new limit. A value smaller than one removes the limit.
+   *
+   * Runs of a back-end are always bounded by the global limit as well.
+   */
+  void setMaxConcurrentRuns(ctkCmdLineModuleBackend* backend, int maxRuns);
+
+  /**
+   * @return The limit set for \c backend or zero if no limit was set.
+   */
+  int maxConcurrentRuns(ctkCmdLineModuleBackend* backend) const;
+
+  /**
+   * @return The statistics for all runs.
+   */
+  Statistics statistics() const;
+
+  /**
+   * @return The statistics for runs of \c backend.
+   */
+  Statistics statistics(ctkCmdLineModuleBackend* backend) const;
+
+  /**
+   * Discards the accumulated statistics. Current queue depths and running
+   * counts are preserved.
+   */
+  void resetStatistics();
+
+  /**
+   * Blocks until all queued and running tasks have finished.
+   */
+  void waitForDone();
+
+private:
+
+  friend class ctkCmdLineModuleSchedulerPrivate;
+
+  QScopedPointer<ctkCmdLineModuleSchedulerPrivate> d;
+
+  Q_DISABLE_COPY(ctkCmdLineModuleScheduler)
+};
+
+#endif // CTKCMDLINEMODULESCHEDULER_H
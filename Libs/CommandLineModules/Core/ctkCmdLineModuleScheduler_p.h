@@ -0,0 +1,114 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+#ifndef CTKCMDLINEMODULESCHEDULER_P_H
+#define CTKCMDLINEMODULESCHEDULER_P_H
+
+#include "ctkCmdLineModuleScheduler.h"
+#include "ctkCmdLineModuleFutureInterface.h"
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
+#include <QStringList>
+#include <QThreadPool>
+
+class QRunnable;
+
+/**
+ * \ingroup CommandLineModulesCore
+ *
+ * Makes a scheduler the target of all ctkCmdLineModuleFutureInterface::startRunnable()
+ * calls from the current thread for the life-time of this object. Used by
+ * ctkCmdLineModuleManager::run() around the call to ctkCmdLineModuleBackend::run().
+ * Submissions do not nest.
+ */
+class ctkCmdLineModuleSchedulerSubmission
+{
+public:
+
+  ctkCmdLineModuleSchedulerSubmission(ctkCmdLineModuleScheduler* scheduler,
+                                      ctkCmdLineModuleBackend* backend,
+                                      int priority, const QString& caller);
+  ~ctkCmdLineModuleSchedulerSubmission();
+
+private:
+
+  Q_DISABLE_COPY(ctkCmdLineModuleSchedulerSubmission)
+};
+
+class ctkCmdLineModuleSchedulerPrivate
+{
+public:
+
+  struct Item
+  {
+    Item(const ctkCmdLineModuleFutureInterface& future, QRunnable* runnable,
+         ctkCmdLineModuleBackend* backend)
+      : Future(future), Runnable(runnable), Backend(backend)
+    {}
+
+    const ctkCmdLineModuleFutureInterface Future;
+    QRunnable* Runnable;
+    ctkCmdLineModuleBackend* Backend;
+  };
+
+  // All queued items of one priority
+  struct Level
+  {
+    // Callers with queued items, in round-robin order
+    QStringList Callers;
+    QHash<QString, QQueue<Item*> > Queues;
+  };
+
+  ctkCmdLineModuleSchedulerPrivate();
+  ~ctkCmdLineModuleSchedulerPrivate();
+
+  /**
+   * Starts \c runnable via the scheduler of the current submission, or in
+   * QThreadPool::globalInstance() if there is none.
+   */
+  static void start(const ctkCmdLineModuleFutureInterface& futureInterface, QRunnable* runnable);
+
+  void enqueue(const ctkCmdLineModuleFutureInterface& futureInterface, QRunnable* runnable,
+               ctkCmdLineModuleBackend* backend, int priority, const QString& caller);
+
+  void runFinished(ctkCmdLineModuleBackend* backend);
+
+  bool canStart_unlocked(ctkCmdLineModuleBackend* backend) const;
+  Item* takeNext_unlocked();
+  void dispatch_unlocked();
+
+  mutable QMutex Mutex;
+  QThreadPool Pool;
+
+  int MaxConcurrentRuns;
+  QHash<ctkCmdLineModuleBackend*, int> BackendLimits;
+
+  // Queued items by priority, the highest priority is the last key
+  QMap<int, Level> Levels;
+
+  ctkCmdLineModuleScheduler::Statistics TotalStatistics;
+  QHash<ctkCmdLineModuleBackend*, ctkCmdLineModuleScheduler::Statistics> BackendStatistics;
+};
+
+#endif // CTKCMDLINEMODULESCHEDULER_P_H
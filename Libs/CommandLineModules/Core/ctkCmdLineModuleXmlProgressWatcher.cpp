@@ -21,21 +21,53 @@
 
 #include "ctkCmdLineModuleXmlProgressWatcher.h"
 
+#include <ctkHighPrecisionTimer.h>
+
 #include <QIODevice>
 #include <QProcess>
+#include <QTimer>
+#include <QVector>
 #include <QXmlStreamReader>
 
 #include <QDebug>
 
 namespace {
 
-static QString FILTER_START = "filter-start";
-static QString FILTER_NAME = "filter-name";
-static QString FILTER_COMMENT = "filter-comment";
-static QString FILTER_PROGRESS = "filter-progress";
-static QString FILTER_PROGRESS_TEXT = "filter-progress-text";
-static QString FILTER_RESULT = "filter-result";
-static QString FILTER_END = "filter-end";
+enum ElementKind
+{
+  OtherElement,
+  FilterStartElement,
+  FilterNameElement,
+  FilterCommentElement,
+  FilterProgressElement,
+  FilterProgressTextElement,
+  FilterResultElement,
+  FilterEndElement
+};
+
+//----------------------------------------------------------------------------
+ElementKind elementKind(const QStringRef& name)
+{
+  static const QString FILTER_START = "filter-start";
+  static const QString FILTER_NAME = "filter-name";
+  static const QString FILTER_COMMENT = "filter-comment";
+  static const QString FILTER_PROGRESS = "filter-progress";
+  static const QString FILTER_PROGRESS_TEXT = "filter-progress-text";
+  static const QString FILTER_RESULT = "filter-result";
+  static const QString FILTER_END = "filter-end";
+
+  // all known elements start with "filter-"
+  if (name.size() < 10 || name.at(0).toLower() != QLatin1Char('f')) return OtherElement;
+
+  if (name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0) return FilterProgressElement;
+  if (name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0) return FilterProgressTextElement;
+  if (name.compare(FILTER_NAME, Qt::CaseInsensitive) == 0) return FilterNameElement;
+  if (name.compare(FILTER_COMMENT, Qt::CaseInsensitive) == 0) return FilterCommentElement;
+  if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0) return FilterStartElement;
+  if (name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0) return FilterResultElement;
+  if (name.compare(FILTER_END, Qt::CaseInsensitive) == 0) return FilterEndElement;
+  return OtherElement;
+}
 
 }
 
@@ -45,29 +77,38 @@ class ctkCmdLineModuleXmlProgressWatcherPrivate
 public:
 
   ctkCmdLineModuleXmlProgressWatcherPrivate(QIODevice* input, ctkCmdLineModuleXmlProgressWatcher* qq)
-    : input(input), process(NULL), readPos(0), q(qq), error(false), currentProgress(0)
+    : input(input), process(NULL), readPos(0), q(qq), error(false), rootSeen(false), currentProgress(0)
+    , maxProgressRate(0), progressEmitted(false), progressPending(false), pendingProgress(0)
   {
-    // wrap the content in an artifical root element
-    reader.addData("<module-root>");
+    init();
   }
 
   ctkCmdLineModuleXmlProgressWatcherPrivate(QProcess* input, ctkCmdLineModuleXmlProgressWatcher* qq)
-    : input(input), process(input), readPos(0), q(qq), error(false), currentProgress(0)
+    : input(input), process(input), readPos(0), q(qq), error(false), rootSeen(false), currentProgress(0)
+    , maxProgressRate(0), progressEmitted(false), progressPending(false), pendingProgress(0)
   {
-    // wrap the content in an artifical root element
+    init();
+  }
+
+  void init()
+  {
+    // Wrap the whole stream in an artifical root element. The data is
+    // then fed to the reader as it arrives, without any re-wrapping.
     reader.addData("<module-root>");
+    flushTimer.setSingleShot(true);
   }
 
   void _q_readyRead()
   {
-    input->seek(readPos);
-
-    QByteArray buffer = input->readAll();
+    if (!input->isSequential())
+    {
+      input->seek(readPos);
+    }
 
-    buffer.prepend("<module-snippet>");
-    buffer.append("</module-snippet>");
+    const QByteArray data = input->readAll();
+    if (data.isEmpty()) return;
 
-    reader.addData(buffer);
+    reader.addData(data);
     readPos = input->pos();
     parseProgressXml();
   }
@@ -77,6 +118,49 @@ public:
     emit q->errorDataAvailable(process->readAllStandardError());
   }
 
+  void _q_flushProgress()
+  {
+    if (!progressPending) return;
+    progressPending = false;
+    emitProgress(pendingProgress, pendingComment);
+  }
+
+  void emitProgress(float progress, const QString& comment)
+  {
+    progressEmitted = true;
+    lastProgressTime.start();
+    emit q->filterProgress(progress, comment);
+  }
+
+  void reportProgress(float progress, const QString& comment)
+  {
+    if (maxProgressRate <= 0)
+    {
+      emit q->filterProgress(progress, comment);
+      return;
+    }
+
+    const qint64 interval = 1000 / maxProgressRate;
+    const qint64 elapsed = progressEmitted ? lastProgressTime.elapsedMilli() : interval;
+    if (elapsed >= interval)
+    {
+      progressPending = false;
+      flushTimer.stop();
+      emitProgress(progress, comment);
+    }
+    else
+    {
+      // keep only the most recent update
+      progressPending = true;
+      pendingProgress = progress;
+      pendingComment = comment;
+      if (!flushTimer.isActive())
+      {
+        flushTimer.start(static_cast<int>(interval - elapsed));
+      }
+    }
+  }
+
   void parseProgressXml()
   {
     QXmlStreamReader::TokenType type = reader.readNext();
@@ -98,26 +182,26 @@ public:
         }
 
         if (stack.size() == 2 &&
-            (stack.front() == FILTER_START || stack.front() == FILTER_END))
+            (stack.front() == FilterStartElement || stack.front() == FilterEndElement))
         {
-          if (stack.back() == FILTER_NAME)
+          if (stack.back() == FilterNameElement)
           {
             currentName = reader.text().toString().trimmed();
           }
-          else if (stack.back() == FILTER_COMMENT)
+          else if (stack.back() == FilterCommentElement)
           {
             currentComment = reader.text().toString().trimmed();
           }
         }
-        else if (stack.size() == 1 && stack.back() == FILTER_PROGRESS)
+        else if (stack.size() == 1 && stack.back() == FilterProgressElement)
         {
           currentProgress = reader.text().toString().toFloat();
         }
-        else if (stack.size() == 1 && stack.back() == FILTER_PROGRESS_TEXT)
+        else if (stack.size() == 1 && stack.back() == FilterProgressTextElement)
         {
           currentComment = reader.text().toString();
         }
-        else if (stack.size() == 1 && stack.back() == FILTER_RESULT)
+        else if (stack.size() == 1 && stack.back() == FilterResultElement)
         {
           currentResultValue = reader.text().toString();
         }
@@ -125,38 +209,38 @@ public:
       }
       case QXmlStreamReader::StartElement:
       {
-        QStringRef name = reader.name();
-        QString parent;
-        if (!stack.empty()) parent = stack.back();
-
-        if (name.compare("module-root") != 0 && name.compare("module-snippet") != 0)
+        if (!rootSeen)
         {
-          stack.push_back(name.toString());
+          // the artificial root element
+          rootSeen = true;
+          break;
         }
 
-        if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0 ||
-            name.compare(FILTER_END, Qt::CaseInsensitive) == 0)
+        const ElementKind kind = elementKind(reader.name());
+        const bool hasParent = !stack.empty();
+        stack.push_back(kind);
+
+        if (kind == FilterStartElement || kind == FilterProgressElement ||
+            kind == FilterProgressTextElement || kind == FilterResultElement ||
+            kind == FilterEndElement)
         {
-          if (!parent.isEmpty())
+          if (hasParent)
           {
-            unexpectedNestedElement(name.toString());
+            unexpectedNestedElement(reader.name().toString());
             break;
           }
 
-          if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0)
+          if (kind == FilterStartElement)
           {
             currentName = QString();
             currentComment = QString();
             currentProgress = 0;
           }
-          else if (name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0)
+          else if (kind == FilterProgressTextElement)
           {
             currentProgress = reader.attributes().value("progress").toString().toFloat();
           }
-          else if (name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0)
+          else if (kind == FilterResultElement)
           {
             currentResultParameter = reader.attributes().value("name").toString();
             currentResultValue.clear();
@@ -166,42 +250,42 @@ public:
       }
       case QXmlStreamReader::EndElement:
       {
-        QStringRef name = reader.name();
+        if (stack.empty()) break;
 
-        QString curr;
-        QString parent;
-        if (!stack.empty())
-        {
-          curr = stack.back();
-          stack.pop_back();
-          if (!stack.empty()) parent = stack.back();
-        }
+        const ElementKind kind = stack.back();
+        stack.pop_back();
 
-        if (parent.isEmpty() && name.compare("module-snippet") != 0)
+        if (stack.empty())
         {
-          if (name.compare(FILTER_START, Qt::CaseInsensitive) == 0)
+          if (kind == FilterProgressElement)
           {
-            emit q->filterStarted(currentName, currentComment);
-            currentComment = QString();
-          }
-          else if (name.compare(FILTER_PROGRESS, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterProgress(currentProgress, QString());
+            reportProgress(currentProgress, QString());
           }
-          else if (name.compare(FILTER_PROGRESS_TEXT, Qt::CaseInsensitive) == 0)
+          else if (kind == FilterProgressTextElement)
           {
-            emit q->filterProgress(currentProgress, currentComment);
+            reportProgress(currentProgress, currentComment);
             currentComment = QString();
           }
-          else if (name.compare(FILTER_RESULT, Qt::CaseInsensitive) == 0)
+          else if (kind != OtherElement)
           {
-            emit q->filterResult(currentResultParameter, currentResultValue);
-          }
-          else if (name.compare(FILTER_END, Qt::CaseInsensitive) == 0)
-          {
-            emit q->filterFinished(currentName, currentComment);
-            currentName = QString();
-            currentComment = QString();
+            // deliver coalesced progress before any other filter signal
+            _q_flushProgress();
+
+            if (kind == FilterStartElement)
+            {
+              emit q->filterStarted(currentName, currentComment);
+              currentComment = QString();
+            }
+            else if (kind == FilterResultElement)
+            {
+              emit q->filterResult(currentResultParameter, currentResultValue);
+            }
+            else if (kind == FilterEndElement)
+            {
+              emit q->filterFinished(currentName, currentComment);
+              currentName = QString();
+              currentComment = QString();
+            }
           }
         }
         break;
@@ -244,13 +328,23 @@ public:
   qint64 readPos;
   ctkCmdLineModuleXmlProgressWatcher* q;
   bool error;
+  bool rootSeen;
   QXmlStreamReader reader;
-  QList<QString> stack;
+  QVector<ElementKind> stack;
   QString currentName;
   QString currentComment;
   float currentProgress;
   QString currentResultParameter;
   QString currentResultValue;
+
+  // progress coalescing
+  int maxProgressRate;
+  QTimer flushTimer;
+  ctkHighPrecisionTimer lastProgressTime;
+  bool progressEmitted;
+  bool progressPending;
+  float pendingProgress;
+  QString pendingComment;
 };
 
 
@@ -265,6 +359,7 @@ ctkCmdLineModuleXmlProgressWatcher::ctkCmdLineModuleXmlProgressWatcher(QIODevice
     input->open(QIODevice::ReadOnly);
   }
   connect(d->input, SIGNAL(readyRead()), SLOT(_q_readyRead()));
+  connect(&d->flushTimer, SIGNAL(timeout()), SLOT(_q_flushProgress()));
 }
 
 //----------------------------------------------------------------------------
@@ -275,6 +370,7 @@ ctkCmdLineModuleXmlProgressWatcher::ctkCmdLineModuleXmlProgressWatcher(QProcess*
 
   connect(input, SIGNAL(readyReadStandardOutput()), SLOT(_q_readyRead()));
   connect(input, SIGNAL(readyReadStandardError()), SLOT(_q_readyReadError()));
+  connect(&d->flushTimer, SIGNAL(timeout()), SLOT(_q_flushProgress()));
 }
 
 //----------------------------------------------------------------------------
@@ -282,4 +378,28 @@ ctkCmdLineModuleXmlProgressWatcher::~ctkCmdLineModuleXmlProgressWatcher()
 {
 }
 
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcher::setMaxProgressRate(int updatesPerSecond)
+{
+  d->maxProgressRate = qBound(0, updatesPerSecond, 1000);
+  if (d->maxProgressRate == 0)
+  {
+    d->flushTimer.stop();
+    d->_q_flushProgress();
+  }
+}
+
+//----------------------------------------------------------------------------
+int ctkCmdLineModuleXmlProgressWatcher::maxProgressRate() const
+{
+  return d->maxProgressRate;
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleXmlProgressWatcher::flushProgress()
+{
+  d->flushTimer.stop();
+  d->_q_flushProgress();
+}
+
 #include "moc_ctkCmdLineModuleXmlProgressWatcher.h"
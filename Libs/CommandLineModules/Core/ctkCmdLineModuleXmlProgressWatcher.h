@@ -50,6 +50,23 @@ public:
   ctkCmdLineModuleXmlProgressWatcher(QProcess* input);
   ~ctkCmdLineModuleXmlProgressWatcher();
 
+  /**
+   * @brief Limit the rate of filterProgress() signals.
+   * @param updatesPerSecond The maximum number of filterProgress() signals per second,
+   *        or zero to emit a signal for each progress element (the default).
+   *
+   * Progress updates arriving faster are coalesced, only the most recent one is emitted
+   * when the interval elapsed. A pending update is always emitted before any other
+   * filter signal, so the order of filter events is preserved.
+   */
+  void setMaxProgressRate(int updatesPerSecond);
+  int maxProgressRate() const;
+
+  /**
+   * @brief Emit a coalesced progress update immediately, if there is one.
+   */
+  void flushProgress();
+
 Q_SIGNALS:
 
   void filterStarted(const QString& name, const QString& comment);
@@ -67,6 +84,7 @@ private:
 
   Q_PRIVATE_SLOT(d, void _q_readyRead())
   Q_PRIVATE_SLOT(d, void _q_readyReadError())
+  Q_PRIVATE_SLOT(d, void _q_flushProgress())
 
   QScopedPointer<ctkCmdLineModuleXmlProgressWatcherPrivate> d;
 };
@@ -0,0 +1,442 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Measures registration, validation, front-end creation and run
+// performance of the command line module back-ends and writes the
+// results as JSON.
+
+#include <ctkCmdLineModuleBatchResult.h>
+#include <ctkCmdLineModuleFrontend.h>
+#include <ctkCmdLineModuleFuture.h>
+#include <ctkCmdLineModuleManager.h>
+#include <ctkCmdLineModuleReference.h>
+#include <ctkCmdLineModuleScheduler.h>
+#include <ctkCmdLineModuleXmlValidator.h>
+
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_LOCALPROCESS
+#include <ctkCmdLineModuleBackendLocalProcess.h>
+#endif
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_FUNCTIONPOINTER
+#include <ctkCmdLineModuleBackendFunctionPointer.h>
+#endif
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_QTGUI
+#include <ctkCmdLineModuleFrontendFactoryQtGui.h>
+#include <ctkCmdLineModuleFrontendQtGui.h>
+#include <QApplication>
+#endif
+
+#include <ctkCommandLineParser.h>
+#include <ctkHighPrecisionTimer.h>
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <QUrl>
+
+#include <cstdlib>
+
+// Benchmark report helpers
+#include "Testing/Cpp/ctkBenchmarkTestHelper.cpp"
+
+namespace {
+
+//----------------------------------------------------------------------------
+class BenchmarkFrontend : public ctkCmdLineModuleFrontend
+{
+public:
+
+  BenchmarkFrontend(const ctkCmdLineModuleReference& moduleRef)
+    : ctkCmdLineModuleFrontend(moduleRef)
+  {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+
+  virtual QVariant value(const QString& parameter, int /*role*/) const
+  {
+    QHash<QString, QVariant>::const_iterator iter = Values.find(parameter);
+    if (iter != Values.end()) return iter.value();
+    return this->moduleReference().description().parameter(parameter).defaultValue();
+  }
+
+  virtual void setValue(const QString& parameter, const QVariant& value, int /*role*/)
+  {
+    Values[parameter] = value;
+  }
+
+private:
+
+  QHash<QString, QVariant> Values;
+};
+
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_FUNCTIONPOINTER
+//----------------------------------------------------------------------------
+void NoOpModule(int value)
+{
+  Q_UNUSED(value)
+}
+#endif
+
+//----------------------------------------------------------------------------
+double elapsedMillis(ctkHighPrecisionTimer& timer)
+{
+  return timer.elapsedMicro() / 1000.0;
+}
+
+//----------------------------------------------------------------------------
+class ctkCmdLineModuleBenchmark
+{
+public:
+
+  ctkCmdLineModuleBenchmark(int iterations, int runs, const QString& modulesDir)
+    : Iterations(iterations), Runs(runs), ModulesDir(modulesDir)
+    , CacheRoot(QDir::temp().absoluteFilePath("ctkCmdLineModuleBenchmark"))
+  {}
+
+  ~ctkCmdLineModuleBenchmark()
+  {
+    removeDir(CacheRoot);
+  }
+
+  void run();
+
+  bool writeJson(const QString& fileName) const;
+
+private:
+
+  ctkBenchmarkMeasurement& measurement(const QString& backend, const QString& module,
+                                       const QString& name, const QString& unit)
+  {
+    ctkBenchmarkMeasurement m = benchmarkMeasurement(name, unit);
+    m.Labels << qMakePair(QString("backend"), backend)
+             << qMakePair(QString("module"), module);
+    Measurements.push_back(m);
+    return Measurements.back();
+  }
+
+  QString cacheDir(const QString& name) const
+  {
+    return CacheRoot + "/" + name;
+  }
+
+  static void removeDir(const QString& path)
+  {
+    QDir dir(path);
+    if (!dir.exists()) return;
+    foreach(const QFileInfo& info, dir.entryInfoList(QDir::NoDotAndDotDot | QDir::AllEntries))
+    {
+      if (info.isDir()) removeDir(info.absoluteFilePath());
+      else QFile::remove(info.absoluteFilePath());
+    }
+    QDir().rmdir(path);
+  }
+
+  void benchmarkRegistration(const QString& backendName, ctkCmdLineModuleBackend* backend,
+                             const QString& moduleName, const QUrl& location);
+  void benchmarkFrontendCreation(const QString& backendName, const ctkCmdLineModuleReference& moduleRef);
+  void benchmarkRuns(const QString& backendName, const QString& name, ctkCmdLineModuleManager& manager,
+                     const ctkCmdLineModuleReference& moduleRef, const QHash<QString, QVariant>& values);
+  void benchmarkBatch(const QString& backendName, ctkCmdLineModuleManager& manager,
+                      const ctkCmdLineModuleReference& moduleRef, const QHash<QString, QVariant>& values);
+
+  const int Iterations;
+  const int Runs;
+  const QString ModulesDir;
+  const QString CacheRoot;
+  QList<ctkBenchmarkMeasurement> Measurements;
+};
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBenchmark::benchmarkRegistration(const QString& backendName,
+                                                      ctkCmdLineModuleBackend* backend,
+                                                      const QString& moduleName,
+                                                      const QUrl& location)
+{
+  ctkHighPrecisionTimer timer;
+
+  // Cold: empty cache, fetch, validate and parse the XML description
+  ctkBenchmarkMeasurement& cold = measurement(backendName, moduleName, "registration.cold", "ms");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    const QString dir = cacheDir(backendName + moduleName + "Cold");
+    removeDir(dir);
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, dir);
+    manager.registerBackend(backend);
+    timer.start();
+    ctkCmdLineModuleReference ref = manager.registerModule(location);
+    cold.Samples << elapsedMillis(timer);
+    if (!ref)
+    {
+      qWarning() << "Registering" << location << "failed";
+      return;
+    }
+  }
+
+  // Cached: the module cache contains the parsed description
+  const QString warmDir = cacheDir(backendName + moduleName + "Warm");
+  {
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, warmDir);
+    manager.registerBackend(backend);
+    manager.registerModule(location);
+  }
+  ctkBenchmarkMeasurement& cached = measurement(backendName, moduleName, "registration.cached", "ms");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, warmDir);
+    manager.registerBackend(backend);
+    timer.start();
+    manager.registerModule(location);
+    cached.Samples << elapsedMillis(timer);
+  }
+
+  // XML schema validation on its own
+  const QByteArray xml = backend->rawXmlDescription(location);
+  ctkBenchmarkMeasurement& validation = measurement(backendName, moduleName, "validation", "ms");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    QBuffer buffer(const_cast<QByteArray*>(&xml));
+    buffer.open(QIODevice::ReadOnly);
+    ctkCmdLineModuleXmlValidator validator(&buffer);
+    timer.start();
+    validator.validateInput();
+    validation.Samples << elapsedMillis(timer);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBenchmark::benchmarkFrontendCreation(const QString& backendName,
+                                                          const ctkCmdLineModuleReference& moduleRef)
+{
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_QTGUI
+  // Includes the XSL transformation and loading the generated UI
+  ctkCmdLineModuleFrontendFactoryQtGui factory;
+  ctkHighPrecisionTimer timer;
+  ctkBenchmarkMeasurement& creation = measurement(backendName, moduleRef.description().title(),
+                                                  "frontend.creation", "ms");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    timer.start();
+    QScopedPointer<ctkCmdLineModuleFrontend> frontend(factory.create(moduleRef));
+    frontend->guiHandle();
+    creation.Samples << elapsedMillis(timer);
+  }
+#else
+  Q_UNUSED(backendName)
+  Q_UNUSED(moduleRef)
+#endif
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBenchmark::benchmarkRuns(const QString& backendName, const QString& name,
+                                              ctkCmdLineModuleManager& manager,
+                                              const ctkCmdLineModuleReference& moduleRef,
+                                              const QHash<QString, QVariant>& values)
+{
+  const QString moduleName = moduleRef.description().title();
+  ctkHighPrecisionTimer timer;
+
+  // Latency: one run at a time, from run() until the future finished
+  ctkBenchmarkMeasurement& latency = measurement(backendName, moduleName, name + ".latency", "ms");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    BenchmarkFrontend frontend(moduleRef);
+    frontend.setValues(values);
+    timer.start();
+    ctkCmdLineModuleFuture future = manager.run(&frontend);
+    future.waitForFinished();
+    latency.Samples << elapsedMillis(timer);
+  }
+
+  // Throughput: all runs submitted at once
+  ctkBenchmarkMeasurement& throughput = measurement(backendName, moduleName, name + ".throughput", "runs/s");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    QList<BenchmarkFrontend*> frontends;
+    QList<ctkCmdLineModuleFuture> futures;
+    timer.start();
+    for (int j = 0; j < Runs; ++j)
+    {
+      BenchmarkFrontend* frontend = new BenchmarkFrontend(moduleRef);
+      frontend->setValues(values);
+      frontends << frontend;
+      futures << manager.run(frontend);
+    }
+    foreach(ctkCmdLineModuleFuture future, futures)
+    {
+      future.waitForFinished();
+    }
+    throughput.Samples << Runs / (elapsedMillis(timer) / 1000.0);
+    qDeleteAll(frontends);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBenchmark::benchmarkBatch(const QString& backendName, ctkCmdLineModuleManager& manager,
+                                               const ctkCmdLineModuleReference& moduleRef,
+                                               const QHash<QString, QVariant>& values)
+{
+  QList<QHash<QString, QVariant> > parameterSets;
+  for (int j = 0; j < Runs; ++j)
+  {
+    parameterSets << values;
+  }
+
+  ctkHighPrecisionTimer timer;
+  ctkBenchmarkMeasurement& throughput = measurement(backendName, moduleRef.description().title(),
+                                                    "batch.throughput", "runs/s");
+  for (int i = 0; i < Iterations; ++i)
+  {
+    timer.start();
+    QFuture<ctkCmdLineModuleBatchResult> future = manager.runBatch(moduleRef, parameterSets);
+    future.waitForFinished();
+    throughput.Samples << Runs / (elapsedMillis(timer) / 1000.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkCmdLineModuleBenchmark::run()
+{
+  removeDir(CacheRoot);
+
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_LOCALPROCESS
+  {
+    const QString backendName = "LocalProcess";
+    ctkCmdLineModuleBackendLocalProcess backend;
+
+    QList<QString> modules;
+    modules << "TestBed" << "Blur2dImage" << "Tour";
+    foreach(const QString& module, modules)
+    {
+      QUrl location = QUrl::fromLocalFile(ModulesDir + "/ctkCmdLineModule" + module);
+      benchmarkRegistration(backendName, &backend, module, location);
+    }
+
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cacheDir("LocalProcessRuns"));
+    manager.registerBackend(&backend);
+    foreach(const QString& module, modules)
+    {
+      ctkCmdLineModuleReference ref = manager.registerModule(
+            QUrl::fromLocalFile(ModulesDir + "/ctkCmdLineModule" + module));
+      if (ref) benchmarkFrontendCreation(backendName, ref);
+    }
+
+    ctkCmdLineModuleReference testBed = manager.moduleReference(
+          QUrl::fromLocalFile(ModulesDir + "/ctkCmdLineModuleTestBed"));
+    if (testBed)
+    {
+      QHash<QString, QVariant> values;
+      values["runtimeVar"] = 0;
+      values["noDelayVar"] = true;
+      values["imageOutput"] = QDir::temp().absoluteFilePath("ctkCmdLineModuleBenchmark.nrrd");
+      benchmarkRuns(backendName, "run", manager, testBed, values);
+
+      // process output parsing with many progress and result messages
+      QHash<QString, QVariant> chattyValues = values;
+      chattyValues["numOutputsVar"] = 1000;
+      benchmarkRuns(backendName, "run.progress1000", manager, testBed, chattyValues);
+
+      // persistent worker processes instead of one process per run
+      backend.setWorkerProcessCount(testBed.location(), QThread::idealThreadCount());
+      benchmarkRuns(backendName, "run.worker", manager, testBed, values);
+      benchmarkBatch(backendName, manager, testBed, values);
+      backend.setWorkerProcessCount(testBed.location(), 0);
+    }
+  }
+#endif
+
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_FUNCTIONPOINTER
+  {
+    const QString backendName = "FunctionPointer";
+    ctkCmdLineModuleBackendFunctionPointer backend;
+    QUrl location = backend.registerFunctionPointer("No-Op", NoOpModule, "Value")->moduleLocation();
+
+    benchmarkRegistration(backendName, &backend, "No-Op", location);
+
+    ctkCmdLineModuleManager manager(ctkCmdLineModuleManager::STRICT_VALIDATION, cacheDir("FunctionPointerRuns"));
+    manager.registerBackend(&backend);
+    ctkCmdLineModuleReference ref = manager.registerModule(location);
+    if (ref)
+    {
+      benchmarkFrontendCreation(backendName, ref);
+
+      QHash<QString, QVariant> values;
+      values["param0"] = 42;
+      benchmarkRuns(backendName, "run", manager, ref, values);
+      benchmarkBatch(backendName, manager, ref, values);
+    }
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool ctkCmdLineModuleBenchmark::writeJson(const QString& fileName) const
+{
+  QVariantMap parameters;
+  parameters["iterations"] = Iterations;
+  parameters["runs"] = Runs;
+  parameters["idealThreadCount"] = QThread::idealThreadCount();
+  return writeBenchmarkJson(fileName, parameters, Measurements);
+}
+
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+#ifdef CTK_CMDLINEMODULE_BENCHMARK_QTGUI
+  QApplication app(argc, argv);
+#else
+  QCoreApplication app(argc, argv);
+#endif
+
+  ctkCommandLineParser parser;
+  parser.setArgumentPrefix("--", "-");
+  parser.addArgument("help", "h", QVariant::Bool, "Show this help text");
+  parser.addArgument("iterations", "i", QVariant::Int, "Number of samples per measurement", 10);
+  parser.addArgument("runs", "r", QVariant::Int, "Number of runs for throughput measurements", 100);
+  parser.addArgument("modules-dir", "", QVariant::String,
+                     "Directory containing the test modules", QCoreApplication::applicationDirPath());
+  parser.addArgument("output", "o", QVariant::String, "JSON output file (default: standard output)");
+
+  QTextStream err(stderr, QIODevice::WriteOnly | QIODevice::Text);
+
+  bool ok = false;
+  QHash<QString, QVariant> args = parser.parseArguments(QCoreApplication::arguments(), &ok);
+  if (!ok)
+  {
+    err << "Error parsing arguments: " << parser.errorString() << endl;
+    return EXIT_FAILURE;
+  }
+  if (args.contains("help"))
+  {
+    err << parser.helpText();
+    return EXIT_SUCCESS;
+  }
+
+  ctkCmdLineModuleBenchmark benchmark(qMax(1, args["iterations"].toInt()),
+                                      qMax(1, args["runs"].toInt()),
+                                      args["modules-dir"].toString());
+  benchmark.run();
+
+  return benchmark.writeJson(args["output"].toString()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
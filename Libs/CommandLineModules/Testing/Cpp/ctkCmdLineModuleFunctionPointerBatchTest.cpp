@@ -0,0 +1,112 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QHash>
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QtAlgorithms>
+#include <QVariant>
+
+// CTK includes
+#include "ctkCmdLineModuleManager.h"
+#include "ctkCmdLineModuleBackendFunctionPointer.h"
+#include "ctkCmdLineModuleBatchResult.h"
+
+#include "ctkTest.h"
+
+// ----------------------------------------------------------------------------
+QMutex BatchCallsMutex;
+QList<QPair<int, int> > BatchCalls;
+void BatchModule(int a, int b)
+{
+  QMutexLocker lock(&BatchCallsMutex);
+  BatchCalls << qMakePair(a, b);
+}
+
+// ----------------------------------------------------------------------------
+class ctkCmdLineModuleFunctionPointerBatchTester: public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+
+  void testBatchRun();
+
+};
+
+// ----------------------------------------------------------------------------
+void ctkCmdLineModuleFunctionPointerBatchTester::testBatchRun()
+{
+  ctkCmdLineModuleManager moduleManager;
+
+  ctkCmdLineModuleBackendFunctionPointer fpBackend;
+  fpBackend.registerFunctionPointer("Batch Module", BatchModule);
+
+  moduleManager.registerBackend(&fpBackend);
+  QUrl url = fpBackend.registeredFunctionPointers().front();
+  ctkCmdLineModuleReference moduleRef = moduleManager.registerModule(url);
+  QVERIFY(moduleRef);
+  QVERIFY(moduleRef.description().hasParameter(
+            ctk::CmdLineModuleBackendFunctionPointer::ParameterName(0)));
+  QVERIFY(moduleRef.description().hasParameter(
+            ctk::CmdLineModuleBackendFunctionPointer::ParameterName(1)));
+
+  const int count = 10;
+  QList<QHash<QString, QVariant> > parameterSets;
+  for (int i = 0; i < count; ++i)
+  {
+    QHash<QString, QVariant> values;
+    values["param0"] = i;
+    values["param1"] = 2 * i;
+    parameterSets << values;
+  }
+  // the missing second parameter uses its (empty) default value
+  QHash<QString, QVariant> values;
+  values["param0"] = count;
+  parameterSets << values;
+
+  QFuture<ctkCmdLineModuleBatchResult> future = moduleManager.runBatch(moduleRef, parameterSets, 2);
+  future.waitForFinished();
+
+  QCOMPARE(future.resultCount(), count + 1);
+  for (int i = 0; i <= count; ++i)
+  {
+    QVERIFY(!future.resultAt(i).hasError());
+    QCOMPARE(future.resultAt(i).parameters(), parameterSets[i]);
+  }
+
+  QList<QPair<int, int> > expectedCalls;
+  for (int i = 0; i < count; ++i)
+  {
+    expectedCalls << qMakePair(i, 2 * i);
+  }
+  expectedCalls << qMakePair(count, 0);
+  qSort(BatchCalls);
+  QCOMPARE(BatchCalls, expectedCalls);
+}
+
+
+// ----------------------------------------------------------------------------
+CTK_TEST_MAIN(ctkCmdLineModuleFunctionPointerBatchTest)
+#include "moc_ctkCmdLineModuleFunctionPointerBatchTest.cpp"
@@ -0,0 +1,235 @@
+/*=============================================================================
+  
+  Library: CTK
+  
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+    
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+  
+    http://www.apache.org/licenses/LICENSE-2.0
+    
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+  
+=============================================================================*/
+
+#include <ctkCmdLineModuleManager.h>
+#include <ctkCmdLineModuleFrontendFactory.h>
+#include <ctkCmdLineModuleFrontend.h>
+#include <ctkCmdLineModuleReference.h>
+#include <ctkCmdLineModuleDescription.h>
+#include <ctkCmdLineModuleParameter.h>
+#include <ctkCmdLineModuleResult.h>
+#include <ctkCmdLineModuleRunException.h>
+#include <ctkCmdLineModuleFuture.h>
+
+#include "ctkCmdLineModuleBackendLocalProcess.h"
+
+#include "ctkTest.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QThread>
+#include <QTime>
+#include <QVariant>
+
+namespace {
+
+//-----------------------------------------------------------------------------
+class ModuleFrontendMockup : public ctkCmdLineModuleFrontend
+{
+public:
+
+  ModuleFrontendMockup(const ctkCmdLineModuleReference& moduleRef)
+    : ctkCmdLineModuleFrontend(moduleRef) {}
+
+  virtual QObject* guiHandle() const { return NULL; }
+
+  virtual QVariant value(const QString& parameter, int role) const
+  {
+    Q_UNUSED(role)
+    QVariant value = currentValues[parameter];
+    if (!value.isValid())
+      return this->moduleReference().description().parameter(parameter).defaultValue();
+    return value;
+  }
+
+  virtual void setValue(const QString& parameter, const QVariant& value, int role = DisplayRole)
+  {
+    Q_UNUSED(role)
+    currentValues[parameter] = value;
+  }
+
+private:
+
+  QHash<QString, QVariant> currentValues;
+};
+
+}
+
+//-----------------------------------------------------------------------------
+class ctkCmdLineModuleWorkerPoolTester : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+
+  void initTestCase();
+  void cleanup();
+
+  void testWorkerResults();
+  void testWorkerError();
+  void testThroughput();
+
+private:
+
+  int runJobs(int count, int numOutputs);
+
+  ctkCmdLineModuleBackendLocalProcess backend;
+  ctkCmdLineModuleManager manager;
+  ctkCmdLineModuleReference moduleRef;
+};
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPoolTester::initTestCase()
+{
+  manager.registerBackend(&backend);
+
+  QUrl moduleUrl = QUrl::fromLocalFile(QCoreApplication::applicationDirPath() + "/ctkCmdLineModuleTestBed");
+  moduleRef = manager.registerModule(moduleUrl);
+  QVERIFY(moduleRef);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPoolTester::cleanup()
+{
+  backend.setWorkerProcessCount(moduleRef.location(), 0);
+}
+
+//-----------------------------------------------------------------------------
+int ctkCmdLineModuleWorkerPoolTester::runJobs(int count, int numOutputs)
+{
+  QList<ctkCmdLineModuleFrontend*> frontends;
+  QList<ctkCmdLineModuleFuture> futures;
+  for (int i = 0; i < count; ++i)
+  {
+    ctkCmdLineModuleFrontend* frontend = new ModuleFrontendMockup(moduleRef);
+    frontend->setValue("runtimeVar", 0);
+    frontend->setValue("numOutputsVar", numOutputs);
+    frontend->setValue("noDelayVar", true);
+    frontend->setValue("imageOutput", QString("/tmp/out%1.nrrd").arg(i));
+    frontends << frontend;
+    futures << manager.run(frontend);
+  }
+
+  int successful = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    futures[i].waitForFinished();
+    QList<ctkCmdLineModuleResult> results = futures[i].results();
+    if (results.contains(ctkCmdLineModuleResult("imageOutput", QString("/tmp/out%1.nrrd").arg(i))))
+    {
+      ++successful;
+    }
+  }
+  qDeleteAll(frontends);
+  return successful;
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPoolTester::testWorkerResults()
+{
+  backend.setWorkerProcessCount(moduleRef.location(), 2);
+  QCOMPARE(backend.workerProcessCount(moduleRef.location()), 2);
+
+  ModuleFrontendMockup frontend(moduleRef);
+  frontend.setValue("numOutputsVar", 2);
+  frontend.setValue("runtimeVar", 0);
+  frontend.setValue("noDelayVar", true);
+
+  // run the same module twice, the second run re-uses the worker
+  for (int run = 0; run < 2; ++run)
+  {
+    ctkCmdLineModuleFuture future = manager.run(&frontend);
+    future.waitForFinished();
+
+    QList<ctkCmdLineModuleResult> results;
+    results << ctkCmdLineModuleResult("resultNumberOutput", 1);
+    results << ctkCmdLineModuleResult("resultNumberOutput", 2);
+    results << ctkCmdLineModuleResult("imageOutput", "/tmp/out.nrrd");
+    results << ctkCmdLineModuleResult("exitStatusOutput", "Normal exit");
+    QCOMPARE(future.results(), results);
+
+    QCOMPARE(future.readAllOutputData().data(), "Output 1\nOutput 2\n");
+    QCOMPARE(future.readAllErrorData().data(), "A superficial error message.\n");
+  }
+
+  QCOMPARE(runJobs(10, 1), 10);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPoolTester::testWorkerError()
+{
+  backend.setWorkerProcessCount(moduleRef.location(), 1);
+
+  ModuleFrontendMockup frontend(moduleRef);
+  frontend.setValue("exitCodeVar", 24);
+  frontend.setValue("errorTextVar", "The job failed.");
+  frontend.setValue("runtimeVar", 0);
+  frontend.setValue("noDelayVar", true);
+
+  ctkCmdLineModuleFuture future = manager.run(&frontend);
+  try
+  {
+    future.waitForFinished();
+    QFAIL("Expected exception not thrown.");
+  }
+  catch (const ctkCmdLineModuleRunException& e)
+  {
+    QCOMPARE(e.errorCode(), 24);
+    // the error of the job, not of the (still running) worker process
+    QCOMPARE(e.errorString(), QString("The job failed."));
+  }
+
+  // the error output of the failed job does not show up in the next one
+  ModuleFrontendMockup nextFrontend(moduleRef);
+  nextFrontend.setValue("runtimeVar", 0);
+  nextFrontend.setValue("noDelayVar", true);
+  ctkCmdLineModuleFuture nextFuture = manager.run(&nextFrontend);
+  nextFuture.waitForFinished();
+  QVERIFY(!nextFuture.readAllErrorData().contains("The job failed."));
+
+  // the worker keeps serving jobs after a failed one
+  QCOMPARE(runJobs(2, 0), 2);
+}
+
+//-----------------------------------------------------------------------------
+void ctkCmdLineModuleWorkerPoolTester::testThroughput()
+{
+  const int jobCount = 100;
+
+  QTime time;
+  time.start();
+  QCOMPARE(runJobs(jobCount, 0), jobCount);
+  const int processPerRunTime = qMax(1, time.elapsed());
+
+  backend.setWorkerProcessCount(moduleRef.location(), QThread::idealThreadCount());
+
+  time.restart();
+  QCOMPARE(runJobs(jobCount, 0), jobCount);
+  const int workerTime = qMax(1, time.elapsed());
+
+  qDebug() << "One process per run:" << processPerRunTime << "ms," << (jobCount * 1000 / processPerRunTime) << "jobs/s";
+  qDebug() << "Worker processes:   " << workerTime << "ms," << (jobCount * 1000 / workerTime) << "jobs/s"
+           << "(including the worker start-up)";
+}
+
+// ----------------------------------------------------------------------------
+CTK_TEST_MAIN(ctkCmdLineModuleWorkerPoolTest)
+#include "moc_ctkCmdLineModuleWorkerPoolTest.cpp"
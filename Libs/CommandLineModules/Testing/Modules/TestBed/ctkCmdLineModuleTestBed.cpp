@@ -47,63 +47,27 @@ void sleep_ms(int ms)
 #endif
 }
 
-int main(int argc, char* argv[])
+void addArguments(ctkCommandLineParser& parser)
 {
-  QCoreApplication app(argc, argv);
-  // This is used by QSettings
-  QCoreApplication::setOrganizationName("CommonTK");
-  QCoreApplication::setApplicationName("CmdLineModuleTestBed");
-
-  ctkCommandLineParser parser;
   // Use Unix-style argument names
   parser.setArgumentPrefix("--", "-");
 
   // Add command line argument names
   parser.addArgument("help", "h", QVariant::Bool, "Show this help text");
   parser.addArgument("xml", "", QVariant::Bool, "Print a XML description of this modules command line interface");
+  parser.addArgument("worker", "", QVariant::Bool, "Run as a persistent worker, reading jobs from stdin");
   parser.addArgument("runtime", "", QVariant::Int, "Runtime in seconds", 1);
   parser.addArgument("numOutputs", "", QVariant::Int, "Number of outpusts", 0);
   parser.addArgument("exitCode", "", QVariant::Int, "Exit code", 0);
   parser.addArgument("exitCrash", "", QVariant::Bool, "Force crash", false);
   parser.addArgument("exitTime", "", QVariant::Int, "Exit time", 0);
   parser.addArgument("errorText", "", QVariant::String, "Error text printed at the end");
+  parser.addArgument("noDelay", "", QVariant::Bool, "Skip the artificial delays", false);
+}
 
-  QTextStream out(stdout, QIODevice::WriteOnly | QIODevice::Text);
-  QTextStream err(stderr, QIODevice::WriteOnly | QIODevice::Text);
-
-  // Parse the command line arguments
-  bool ok = false;
-  QHash<QString, QVariant> parsedArgs = parser.parseArguments(QCoreApplication::arguments(), &ok);
-  if (!ok)
-  {
-    err << "Error parsing arguments:" << parser.errorString() << endl;
-    return EXIT_FAILURE;
-  }
-
-  // Show a help message
-  if (parsedArgs.contains("help") || parsedArgs.contains("h"))
-  {
-    out << parser.helpText();
-    out.setFieldWidth(parser.fieldWidth());
-    out.setFieldAlignment(QTextStream::AlignLeft);
-    out << "  <output-path>" << "Path to the output image" << endl;
-    return EXIT_SUCCESS;
-  }
-
-  if (parsedArgs.contains("xml"))
-  {
-    QFile xmlDescription(":/ctkCmdLineModuleTestBed.xml");
-    xmlDescription.open(QIODevice::ReadOnly);
-    out << xmlDescription.readAll();
-    return EXIT_SUCCESS;
-  }
-
-  if (parser.unparsedArguments().isEmpty())
-  {
-    err << "Error parsing arguments: <output-path> argument missing" << endl;
-    return EXIT_FAILURE;
-  }
-
+int runFilter(const QHash<QString, QVariant>& parsedArgs, const QString& imageOutput,
+              QTextStream& out, QTextStream& err)
+{
   // Do something
 
   float runtime = parsedArgs["runtime"].toFloat();
@@ -113,13 +77,12 @@ int main(int argc, char* argv[])
   int exitCode = parsedArgs["exitCode"].toInt();
   bool exitCrash = parsedArgs["exitCrash"].toBool();
   QString errorText = parsedArgs["errorText"].toString();
-
-  QString imageOutput = parser.unparsedArguments().at(0);
+  int delayMillis = parsedArgs["noDelay"].toBool() ? 0 : 100;
 
   err << "A superficial error message." << endl;
 
   // sleep 500ms to give the "errorReady" signal a chance
-  sleep_ms(500);
+  sleep_ms(5 * delayMillis);
 
   QStringList outputs;
   for (int i = 0; i < numOutputs; ++i)
@@ -178,7 +141,7 @@ int main(int argc, char* argv[])
   }
 
   // sleep 500ms to avoid squashing the last progress event with the finished event
-  sleep_ms(500);
+  sleep_ms(5 * delayMillis);
 
   if (!errorText.isEmpty())
   {
@@ -200,12 +163,119 @@ int main(int argc, char* argv[])
   else
   {
     out << "Normal exit</filter-result>" << endl;
-    sleep_ms(100);
+    sleep_ms(delayMillis);
     out << "<filter-progress>1</filter-progress>" << endl;
-    sleep_ms(100);
+    sleep_ms(delayMillis);
     out << "<filter-end><filter-comment>Finished successfully.</filter-comment></filter-end>" << endl;
-    sleep_ms(100);
+    sleep_ms(delayMillis);
   }
 
   return exitCode;
 }
+
+// Reads jobs from stdin, as sent by the worker mode of the local process
+// back-end. Each job is framed as "<argc>\n" followed by argc arguments
+// encoded as "<byte-count>\n<utf-8 data>\n". The end of the job output is
+// marked by a "<ctk-worker-job-end exit-code=\"...\"/>" line, on the
+// standard output and on the standard error.
+int runWorker(QTextStream& out, QTextStream& err)
+{
+  QFile in;
+  in.open(stdin, QIODevice::ReadOnly);
+
+  forever
+  {
+    QByteArray line = in.readLine();
+    if (line.isEmpty())
+    {
+      // stdin was closed, shut down
+      return EXIT_SUCCESS;
+    }
+
+    QStringList arguments;
+    arguments << QCoreApplication::applicationFilePath();
+    const int argc = line.trimmed().toInt();
+    for (int i = 0; i < argc; ++i)
+    {
+      const int length = in.readLine().trimmed().toInt();
+      arguments << QString::fromUtf8(in.read(length));
+      in.read(1); // skip the trailing newline
+    }
+
+    ctkCommandLineParser parser;
+    addArguments(parser);
+
+    int exitCode = EXIT_FAILURE;
+    bool ok = false;
+    QHash<QString, QVariant> parsedArgs = parser.parseArguments(arguments, &ok);
+    if (!ok)
+    {
+      err << "Error parsing arguments:" << parser.errorString() << endl;
+    }
+    else if (parser.unparsedArguments().isEmpty())
+    {
+      err << "Error parsing arguments: <output-path> argument missing" << endl;
+    }
+    else
+    {
+      exitCode = runFilter(parsedArgs, parser.unparsedArguments().at(0), out, err);
+    }
+
+    err << "<ctk-worker-job-end exit-code=\"" << exitCode << "\"/>" << endl;
+    out << "<ctk-worker-job-end exit-code=\"" << exitCode << "\"/>" << endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  // This is used by QSettings
+  QCoreApplication::setOrganizationName("CommonTK");
+  QCoreApplication::setApplicationName("CmdLineModuleTestBed");
+
+  ctkCommandLineParser parser;
+  addArguments(parser);
+
+  QTextStream out(stdout, QIODevice::WriteOnly | QIODevice::Text);
+  QTextStream err(stderr, QIODevice::WriteOnly | QIODevice::Text);
+
+  // Parse the command line arguments
+  bool ok = false;
+  QHash<QString, QVariant> parsedArgs = parser.parseArguments(QCoreApplication::arguments(), &ok);
+  if (!ok)
+  {
+    err << "Error parsing arguments:" << parser.errorString() << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Show a help message
+  if (parsedArgs.contains("help") || parsedArgs.contains("h"))
+  {
+    out << parser.helpText();
+    out.setFieldWidth(parser.fieldWidth());
+    out.setFieldAlignment(QTextStream::AlignLeft);
+    out << "  <output-path>" << "Path to the output image" << endl;
+    return EXIT_SUCCESS;
+  }
+
+  if (parsedArgs.contains("xml"))
+  {
+    QFile xmlDescription(":/ctkCmdLineModuleTestBed.xml");
+    xmlDescription.open(QIODevice::ReadOnly);
+    out << xmlDescription.readAll();
+    return EXIT_SUCCESS;
+  }
+
+  if (parsedArgs.contains("worker"))
+  {
+    return runWorker(out, err);
+  }
+
+  if (parser.unparsedArguments().isEmpty())
+  {
+    err << "Error parsing arguments: <output-path> argument missing" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return runFilter(parsedArgs, parser.unparsedArguments().at(0), out, err);
+}
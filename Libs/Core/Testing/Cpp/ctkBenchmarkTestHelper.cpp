@@ -0,0 +1,167 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QTextStream>
+#include <QVariant>
+
+// STD includes
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Samples of a benchmarked operation. A measurement without samples is
+// reported as skipped.
+struct ctkBenchmarkMeasurement
+{
+  /// Identify the measured object, e.g. ("backend", "LocalProcess").
+  /// Written before the name, in order.
+  QList<QPair<QString, QString> > Labels;
+  QString Name;
+  QString Unit;
+  QList<double> Samples;
+  /// Additional values reported with the measurement (e.g. counters)
+  QMap<QString, double> Values;
+};
+
+//-----------------------------------------------------------------------------
+ctkBenchmarkMeasurement benchmarkMeasurement(const QString& name, const QString& unit)
+{
+  ctkBenchmarkMeasurement measurement;
+  measurement.Name = name;
+  measurement.Unit = unit;
+  return measurement;
+}
+
+//-----------------------------------------------------------------------------
+QString benchmarkJsonString(const QString& str)
+{
+  QString result = str;
+  result.replace('\\', "\\\\");
+  result.replace('"', "\\\"");
+  return '"' + result + '"';
+}
+
+//-----------------------------------------------------------------------------
+QString benchmarkJsonValue(const QVariant& value)
+{
+  switch (value.type())
+    {
+    case QVariant::Bool:
+      return value.toBool() ? "true" : "false";
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+    case QVariant::Double:
+      return value.toString();
+    default:
+      return benchmarkJsonString(value.toString());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Write the parameters of the run and the statistics of every measurement
+// as JSON so that they can be collected for trend tracking
+void writeBenchmarkJson(QTextStream& out, const QVariantMap& parameters,
+                        const QList<ctkBenchmarkMeasurement>& measurements)
+{
+  out << "{";
+  QVariantMap::const_iterator it;
+  for (it = parameters.constBegin(); it != parameters.constEnd(); ++it)
+    {
+    out << "\n  " << benchmarkJsonString(it.key()) << ": "
+        << benchmarkJsonValue(it.value()) << ",";
+    }
+  out << "\n  \"benchmarks\": [";
+
+  bool first = true;
+  foreach(const ctkBenchmarkMeasurement& measurement, measurements)
+    {
+    out << (first ? "\n" : ",\n") << "    {";
+    first = false;
+    typedef QPair<QString, QString> Label;
+    foreach(const Label& label, measurement.Labels)
+      {
+      out << benchmarkJsonString(label.first) << ": "
+          << benchmarkJsonString(label.second) << ", ";
+      }
+    out << "\"name\": " << benchmarkJsonString(measurement.Name)
+        << ", \"unit\": " << benchmarkJsonString(measurement.Unit);
+
+    QList<double> samples = measurement.Samples;
+    if (samples.isEmpty())
+      {
+      out << ", \"skipped\": true}";
+      continue;
+      }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.;
+    foreach(double sample, samples)
+      {
+      sum += sample;
+      }
+    out << ", \"samples\": " << samples.size()
+        << ", \"min\": " << samples.front()
+        << ", \"median\": " << samples.at(samples.size() / 2)
+        << ", \"mean\": " << sum / samples.size()
+        << ", \"max\": " << samples.back();
+    QMap<QString, double>::const_iterator valueIt;
+    for (valueIt = measurement.Values.constBegin();
+         valueIt != measurement.Values.constEnd(); ++valueIt)
+      {
+      out << ", " << benchmarkJsonString(valueIt.key()) << ": " << valueIt.value();
+      }
+    out << "}";
+    }
+  out << "\n  ]\n}\n";
+}
+
+//-----------------------------------------------------------------------------
+// Write the JSON report in \a fileName, or on the standard output if
+// \a fileName is empty
+bool writeBenchmarkJson(const QString& fileName, const QVariantMap& parameters,
+                        const QList<ctkBenchmarkMeasurement>& measurements)
+{
+  if (fileName.isEmpty())
+    {
+    QTextStream out(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    writeBenchmarkJson(out, parameters, measurements);
+    return true;
+    }
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+    std::cerr << "Cannot write " << qPrintable(fileName) << std::endl;
+    return false;
+    }
+  QTextStream out(&file);
+  writeBenchmarkJson(out, parameters, measurements);
+  return true;
+}
+
+} // end of anonymous namespace
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// CTK includes
+#include "ctkDependencyGraph.h"
+#include "ctkHighPrecisionTimer.h"
+
+// STL includes
+#include <cstdlib>
+#include <iostream>
+#include <list>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// Layered graph: each vertex of a layer depends on 'fanOut' vertices
+// of the next layer.
+void insertLayeredEdges(ctkDependencyGraph& graph, int numberOfLayers, int layerSize, int fanOut)
+{
+  for (int layer = 0; layer < numberOfLayers - 1; ++layer)
+    {
+    for (int i = 0; i < layerSize; ++i)
+      {
+      int from = layer * layerSize + i + 1;
+      for (int j = 0; j < fanOut; ++j)
+        {
+        int to = (layer + 1) * layerSize + (i + j) % layerSize + 1;
+        graph.insertEdge(from, to);
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool benchmarkLayeredGraph(int numberOfLayers, int layerSize, int fanOut)
+{
+  const int numberOfVertices = numberOfLayers * layerSize;
+  ctkHighPrecisionTimer timer;
+
+  ctkDependencyGraph graph(numberOfVertices);
+  timer.start();
+  insertLayeredEdges(graph, numberOfLayers, layerSize, fanOut);
+  qint64 insertTime = timer.elapsedMicro();
+
+  timer.start();
+  bool cycle = graph.checkForCycle();
+  qint64 cycleTime = timer.elapsedMicro();
+
+  std::list<int> sorted;
+  timer.start();
+  bool sortResult = graph.topologicalSort(sorted);
+  qint64 sortTime = timer.elapsedMicro();
+
+  std::list<std::list<int> > levels;
+  timer.start();
+  bool levelsResult = graph.topologicalSortByLevels(levels);
+  qint64 levelsTime = timer.elapsedMicro();
+
+  std::cout << numberOfVertices << " vertices, " << graph.numberOfEdges() << " edges:"
+            << " insertEdge " << insertTime << " us,"
+            << " checkForCycle " << cycleTime << " us,"
+            << " topologicalSort " << sortTime << " us,"
+            << " topologicalSortByLevels " << levelsTime << " us" << std::endl;
+
+  if (cycle || !sortResult || !levelsResult)
+    {
+    std::cerr << "Unexpected cycle in layered graph" << std::endl;
+    return false;
+    }
+  if (static_cast<int>(sorted.size()) != numberOfVertices)
+    {
+    std::cerr << "Wrong number of sorted vertices (expected " << numberOfVertices
+              << " got " << sorted.size() << ")" << std::endl;
+    return false;
+    }
+  if (static_cast<int>(levels.size()) != numberOfLayers)
+    {
+    std::cerr << "Wrong number of levels (expected " << numberOfLayers
+              << " got " << levels.size() << ")" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// A long chain would overflow the stack with a recursive traversal
+bool benchmarkChain(int numberOfVertices)
+{
+  ctkHighPrecisionTimer timer;
+
+  ctkDependencyGraph graph(numberOfVertices);
+  for (int i = 1; i < numberOfVertices; ++i)
+    {
+    graph.insertEdge(i, i + 1);
+    }
+  // close the chain
+  graph.insertEdge(numberOfVertices, 1);
+
+  timer.start();
+  std::list<int> cycle;
+  bool cycleFound = graph.findCycle(cycle);
+  qint64 cycleTime = timer.elapsedMicro();
+
+  std::cout << "chain of " << numberOfVertices << " vertices:"
+            << " findCycle " << cycleTime << " us" << std::endl;
+
+  if (!cycleFound || static_cast<int>(cycle.size()) != numberOfVertices)
+    {
+    std::cerr << "Wrong cycle in chain (expected " << numberOfVertices
+              << " vertices got " << cycle.size() << ")" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkDependencyGraphBenchmark1(int argc, char * argv [] )
+{
+  if (argc > 1)
+    {
+    std::cerr << argv[0] << " expects zero arguments" << std::endl;
+    }
+
+  if (!benchmarkLayeredGraph(10, 100, 4) ||
+      !benchmarkLayeredGraph(100, 100, 4) ||
+      !benchmarkLayeredGraph(100, 1000, 4))
+    {
+    return EXIT_FAILURE;
+    }
+
+  if (!benchmarkChain(100000))
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
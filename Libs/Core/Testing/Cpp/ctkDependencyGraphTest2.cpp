@@ -162,6 +162,25 @@ int ctkDependencyGraphTest2(int argc, char * argv [] )
     return EXIT_FAILURE;
     }
 
+  std::list<int> cycle;
+  if (!graph.findCycle(cycle))
+    {
+    std::cerr << "Problem with findCycle(): no cycle found" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::list<int> expectedCycle;
+  expectedCycle.push_back(2);
+  expectedCycle.push_back(4);
+
+  if (cycle != expectedCycle)
+    {
+    std::cerr << "Problem with findCycle()" << std::endl;
+    printIntegerList("cycle:", cycle);
+    printIntegerList("expectedCycle:", expectedCycle);
+    return EXIT_FAILURE;
+    }
+
   }
 
   // check that cycle detection works on disconnected graphs
@@ -470,6 +489,62 @@ int ctkDependencyGraphTest2(int argc, char * argv [] )
     return EXIT_FAILURE;
   }
 
+  std::list<std::list<int> > levels;
+  graph.topologicalSortByLevels(levels);
+
+  std::list<std::list<int> > expectedLevels(4);
+  std::list<std::list<int> >::iterator expectedLevelsIterator = expectedLevels.begin();
+  expectedLevelsIterator->push_back(1);
+  expectedLevelsIterator->push_back(5);
+  expectedLevelsIterator->push_back(10);
+  expectedLevelsIterator->push_back(12);
+  expectedLevelsIterator->push_back(13);
+  ++expectedLevelsIterator;
+  expectedLevelsIterator->push_back(2);
+  expectedLevelsIterator->push_back(6);
+  expectedLevelsIterator->push_back(11);
+  ++expectedLevelsIterator;
+  expectedLevelsIterator->push_back(3);
+  expectedLevelsIterator->push_back(4);
+  expectedLevelsIterator->push_back(7);
+  expectedLevelsIterator->push_back(8);
+  ++expectedLevelsIterator;
+  expectedLevelsIterator->push_back(9);
+
+  if (levels != expectedLevels)
+  {
+    std::cerr << "Problem with topologicalSortByLevels(levels)" << std::endl;
+    std::list<std::list<int> >::const_iterator levelsIterator;
+    for (levelsIterator = levels.begin(); levelsIterator != levels.end(); ++levelsIterator)
+      {
+      printIntegerList("level:", *levelsIterator);
+      }
+    return EXIT_FAILURE;
+  }
+
+  std::list<std::list<int> > subLevels10;
+  graph.topologicalSortByLevels(subLevels10, 10);
+
+  std::list<std::list<int> > expectedSubLevels10(3);
+  expectedLevelsIterator = expectedSubLevels10.begin();
+  expectedLevelsIterator->push_back(10);
+  ++expectedLevelsIterator;
+  expectedLevelsIterator->push_back(8);
+  expectedLevelsIterator->push_back(11);
+  ++expectedLevelsIterator;
+  expectedLevelsIterator->push_back(9);
+
+  if (subLevels10 != expectedSubLevels10)
+  {
+    std::cerr << "Problem with topologicalSortByLevels(subLevels10, 10)" << std::endl;
+    std::list<std::list<int> >::const_iterator levelsIterator;
+    for (levelsIterator = subLevels10.begin(); levelsIterator != subLevels10.end(); ++levelsIterator)
+      {
+      printIntegerList("level:", *levelsIterator);
+      }
+    return EXIT_FAILURE;
+  }
+
   std::list<int> subSort12;
   graph.topologicalSort(subSort12, 12);
 
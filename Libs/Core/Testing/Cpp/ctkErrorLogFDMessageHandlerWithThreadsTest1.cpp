@@ -73,7 +73,8 @@ int ctkErrorLogFDMessageHandlerWithThreadsTest1(int argc, char * argv [])
     // --------------------------------------------------------------------------
     // Monitor FD messages
 
-    model.registerMsgHandler(new ctkErrorLogFDMessageHandler);
+    ctkErrorLogFDMessageHandler * fdMessageHandler = new ctkErrorLogFDMessageHandler;
+    model.registerMsgHandler(fdMessageHandler);
     model.setMsgHandlerEnabled(ctkErrorLogFDMessageHandler::HandlerName, true);
 
     int threadCount = 15;
@@ -95,6 +96,58 @@ int ctkErrorLogFDMessageHandlerWithThreadsTest1(int argc, char * argv [])
       printTextMessages(model);
       return EXIT_FAILURE;
       }
+
+    errorMsg = checkInteger(__LINE__, "droppedMessageCount", fdMessageHandler->droppedMessageCount(), 0);
+    if (!errorMsg.isEmpty())
+      {
+      model.disableAllMsgHandler();
+      printErrorMessage(errorMsg);
+      return EXIT_FAILURE;
+      }
+
+    // --------------------------------------------------------------------------
+    // Synchronous logging: each chunk of lines is added as one batch
+    foreach(const QSharedPointer<LogMessageThread>& thread, ThreadList)
+      {
+      thread->wait();
+      }
+    ThreadList.clear();
+    model.clear();
+    model.setAsynchronousLogging(false);
+
+    startLogMessageThreads<LogFDMessageThread>(threadCount, maxIteration);
+
+    QTimer::singleShot(1500, qApp, SLOT(quit()));
+    app.exec();
+
+    errorMsg = checkRowCount(__LINE__, model.rowCount(), /* expected = */ expectedMessageCount);
+    if (!errorMsg.isEmpty())
+      {
+      model.disableAllMsgHandler();
+      printErrorMessage(errorMsg);
+      printTextMessages(model);
+      return EXIT_FAILURE;
+      }
+
+    // --------------------------------------------------------------------------
+    // Synchronous logging: disabling the handler from the model thread while
+    // lines are being delivered does not dead lock
+    foreach(const QSharedPointer<LogMessageThread>& thread, ThreadList)
+      {
+      thread->wait();
+      }
+    ThreadList.clear();
+    for (int i = 0; i < 1000; ++i)
+      {
+      fprintf(stdout, "Pending message %d\n", i);
+      }
+    fflush(stdout);
+    model.disableAllMsgHandler();
+    if (fdMessageHandler->enabled())
+      {
+      printErrorMessage(QString("Line %1 - Failed to disable the handler\n").arg(__LINE__));
+      return EXIT_FAILURE;
+      }
     }
   catch (const char* error)
     {
@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+
+// CTK includes
+#include "ctkErrorLogModel.h"
+#include "ctkHighPrecisionTimer.h"
+
+// STL includes
+#include <cstdlib>
+#include <iostream>
+
+// Helper functions
+#include "Testing/Cpp/ctkErrorLogModelTestHelper.cpp"
+
+namespace
+{
+//-----------------------------------------------------------------------------
+class BenchmarkMessageHandler : public ctkErrorLogAbstractMessageHandler
+{
+public:
+  static QString HandlerName;
+
+  virtual QString handlerName()const { return BenchmarkMessageHandler::HandlerName; }
+  virtual void setEnabledInternal(bool value) { Q_UNUSED(value); }
+};
+
+QString BenchmarkMessageHandler::HandlerName = QLatin1String("Benchmark");
+
+BenchmarkMessageHandler* MessageHandler = 0;
+
+//-----------------------------------------------------------------------------
+class LogBenchmarkMessageThread : public LogMessageThread
+{
+public:
+  LogBenchmarkMessageThread(int id, int maxIteration) : LogMessageThread(id, maxIteration){}
+
+  virtual void logMessage(const QDateTime& dateTime, int threadId, int counterIdx)
+  {
+    Q_UNUSED(dateTime);
+    MessageHandler->handleMessage(QString::number(threadId), ctkErrorLogLevel::Info,
+                                  QLatin1String("Benchmark"),
+                                  QString("counterIdx:%1 - Message from thread: %2")
+                                  .arg(counterIdx).arg(threadId));
+  }
+};
+
+}
+
+//-----------------------------------------------------------------------------
+int ctkErrorLogModelBenchmark1(int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  // The default size keeps the test run short, pass a message count
+  // (e.g. 1000000) and a maximum entry count to benchmark larger logs.
+  // A maximum entry count of 0 keeps all the entries.
+  int threadCount = 8;
+  int messageCount = 20000;
+  int maximumEntryCount = 1000;
+  if (argc > 1)
+    {
+    messageCount = QString(argv[1]).toInt();
+    }
+  if (argc > 2)
+    {
+    maximumEntryCount = qMax(QString(argv[2]).toInt(), 0);
+    }
+  int messagesPerThread = messageCount / threadCount;
+  int expectedMessageCount = messagesPerThread * threadCount;
+
+  ctkErrorLogModel model;
+  model.setMaximumEntryCount(maximumEntryCount);
+
+  MessageHandler = new BenchmarkMessageHandler;
+  model.registerMsgHandler(MessageHandler);
+  model.setMsgHandlerEnabled(BenchmarkMessageHandler::HandlerName, true);
+
+  ctkHighPrecisionTimer timer;
+  timer.start();
+
+  startLogMessageThreads<LogBenchmarkMessageThread>(threadCount, messagesPerThread);
+
+  // Add the posted entries while the threads are logging
+  foreach(const QSharedPointer<LogMessageThread>& thread, ThreadList)
+    {
+    while (!thread->wait(10))
+      {
+      QCoreApplication::processEvents();
+      }
+    }
+  QCoreApplication::sendPostedEvents(&model, 0);
+
+  qint64 elapsed = timer.elapsedMilli();
+  std::cout << "Logged " << expectedMessageCount << " messages from " << threadCount
+            << " threads in " << elapsed << " ms ("
+            << (elapsed > 0 ? expectedMessageCount * 1000 / elapsed : expectedMessageCount)
+            << " messages/s)" << std::endl;
+
+  model.disableAllMsgHandler();
+
+  int expectedEntryCount = maximumEntryCount > 0 ?
+    qMin(expectedMessageCount, maximumEntryCount) : expectedMessageCount;
+  QString errorMsg = checkRowCount(__LINE__, model.logEntryCount(),
+                                   /* expected = */ expectedEntryCount);
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return EXIT_FAILURE;
+    }
+
+  // The most recent entry is the last message of one of the threads
+  QString lastDescription = model.logEntryDescription(model.logEntryCount() - 1);
+  if (!lastDescription.startsWith(QString("counterIdx:%1 ").arg(messagesPerThread - 1)))
+    {
+    printErrorMessage(QString("Line %1 - Unexpected last entry: %2\n").arg(__LINE__).arg(lastDescription));
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
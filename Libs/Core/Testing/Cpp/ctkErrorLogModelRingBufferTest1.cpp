@@ -0,0 +1,273 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QDate>
+#include <QDateTime>
+#include <QStringList>
+#include <QTime>
+
+// CTK includes
+#include "ctkErrorLogModel.h"
+#include "ctkModelTester.h"
+
+// STL includes
+#include <cstdlib>
+#include <iostream>
+
+// Helper functions
+#include "Testing/Cpp/ctkErrorLogModelTestHelper.cpp"
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Check the full description of every entry, in row order
+QString checkEntries(int line, const ctkErrorLogModel& model, const QStringList& expectedEntries)
+{
+  QString errorMsg = checkRowCount(line, model.logEntryCount(), expectedEntries.count());
+  if (!errorMsg.isEmpty())
+    {
+    return errorMsg;
+    }
+  for (int row = 0; row < expectedEntries.count(); ++row)
+    {
+    if (model.logEntryDescription(row) != expectedEntries.at(row))
+      {
+      return QString("Line %1 - Problem with row %2 !\n"
+                     "\tExpected [%3]\n\tCurrent [%4]\n")
+          .arg(line).arg(row).arg(expectedEntries.at(row)).arg(model.logEntryDescription(row));
+      }
+    }
+  return QString();
+}
+
+//-----------------------------------------------------------------------------
+void addEntry(ctkErrorLogModel& model, const QDateTime& dateTime,
+              const QString& threadId, const QString& text)
+{
+  model.addEntry(dateTime, threadId, ctkErrorLogLevel::Info, QLatin1String("Test"), text);
+}
+
+//-----------------------------------------------------------------------------
+void postEntry(ctkErrorLogModel& model, const QDateTime& dateTime,
+               const QString& threadId, const QString& text)
+{
+  model.postEntry(dateTime, threadId, ctkErrorLogLevel::Info, QLatin1String("Test"), text);
+}
+
+//-----------------------------------------------------------------------------
+bool testGroupingWithRingBuffer()
+{
+  ctkErrorLogModel model;
+  ctkModelTester modelTester;
+  modelTester.setVerbose(false);
+  modelTester.setModel(&model);
+
+  model.setLogEntryGrouping(true);
+  model.setMaximumEntryCount(3);
+
+  // Grouping compares the time of day, use a time far from midnight
+  QDateTime now(QDate(2012, 6, 1), QTime(12, 0));
+
+  // Entries of the same thread are grouped, the oldest group is removed
+  addEntry(model, now, "1", "A1");
+  addEntry(model, now, "1", "A2");
+  addEntry(model, now, "2", "B");
+  addEntry(model, now, "3", "C");
+  addEntry(model, now, "4", "D1");
+
+  QString errorMsg = checkEntries(__LINE__, model, QStringList() << "B" << "C" << "D1");
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Grouping into the last entry of a full buffer does not remove a row
+  addEntry(model, now, "4", "D2");
+  errorMsg = checkEntries(__LINE__, model, QStringList() << "B" << "C" << "D1\nD2");
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // A posted batch is grouped with the last entry before the buffer wraps
+  postEntry(model, now, "4", "D3");
+  postEntry(model, now, "5", "E");
+  QCoreApplication::sendPostedEvents(&model, 0);
+  errorMsg = checkEntries(__LINE__, model, QStringList() << "C" << "D1\nD2\nD3" << "E");
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // A posted batch larger than the buffer only keeps its most recent groups
+  postEntry(model, now, "5", "E2");
+  postEntry(model, now, "6", "F1");
+  postEntry(model, now, "6", "F2");
+  postEntry(model, now, "7", "G");
+  postEntry(model, now, "8", "H");
+  postEntry(model, now, "9", "I");
+  QCoreApplication::sendPostedEvents(&model, 0);
+  errorMsg = checkEntries(__LINE__, model, QStringList() << "G" << "H" << "I");
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Entries logged more than a second apart are not grouped
+  addEntry(model, now.addSecs(5), "9", "I2");
+  errorMsg = checkEntries(__LINE__, model, QStringList() << "H" << "I" << "I2");
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool testShrinkMaximumEntryCount()
+{
+  ctkErrorLogModel model;
+  ctkModelTester modelTester;
+  modelTester.setVerbose(false);
+  modelTester.setModel(&model);
+
+  QDateTime now(QDate(2012, 6, 1), QTime(12, 0));
+  QStringList messages;
+  for (int i = 0; i < 10; ++i)
+    {
+    messages << QString("Message %1").arg(i);
+    addEntry(model, now, QString::number(i), messages.last());
+    }
+
+  QString errorMsg = checkEntries(__LINE__, model, messages);
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Shrinking keeps the most recent entries
+  model.setMaximumEntryCount(4);
+  errorMsg = checkInteger(__LINE__, "maximumEntryCount", model.maximumEntryCount(), 4);
+  if (errorMsg.isEmpty())
+    {
+    errorMsg = checkEntries(__LINE__, model, messages.mid(6));
+    }
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Wrap the ring buffer so that the oldest entry is not stored first
+  for (int i = 10; i < 13; ++i)
+    {
+    messages << QString("Message %1").arg(i);
+    addEntry(model, now, QString::number(i), messages.last());
+    }
+  errorMsg = checkEntries(__LINE__, model, messages.mid(9));
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Shrinking a wrapped buffer
+  model.setMaximumEntryCount(2);
+  errorMsg = checkEntries(__LINE__, model, messages.mid(11));
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Growing keeps all the entries and fills up before removing any
+  model.setMaximumEntryCount(5);
+  for (int i = 13; i < 17; ++i)
+    {
+    messages << QString("Message %1").arg(i);
+    addEntry(model, now, QString::number(i), messages.last());
+    }
+  errorMsg = checkEntries(__LINE__, model, messages.mid(12));
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Removing the limit keeps all the entries
+  model.setMaximumEntryCount(0);
+  messages << QString("Message 17");
+  addEntry(model, now, "17", messages.last());
+  errorMsg = checkEntries(__LINE__, model, messages.mid(12));
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  // Changing the limit of an empty model
+  model.clear();
+  model.setMaximumEntryCount(1);
+  errorMsg = checkEntries(__LINE__, model, QStringList());
+  if (!errorMsg.isEmpty())
+    {
+    printErrorMessage(errorMsg);
+    return false;
+    }
+
+  return true;
+}
+
+}
+
+//-----------------------------------------------------------------------------
+int ctkErrorLogModelRingBufferTest1(int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+  Q_UNUSED(app);
+
+  try
+    {
+    if (!testGroupingWithRingBuffer())
+      {
+      return EXIT_FAILURE;
+      }
+    if (!testShrinkMaximumEntryCount())
+      {
+      return EXIT_FAILURE;
+      }
+    }
+  catch (const char* error)
+    {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QList>
+#include <QThread>
+#include <QVariant>
+
+// CTK includes
+#include "ctkTracer.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+class TraceThread : public QThread
+{
+public:
+  TraceThread(int iterations) : Iterations(iterations){}
+
+  virtual void run()
+  {
+    for (int i = 0; i < this->Iterations; ++i)
+      {
+      CTK_TRACE_SCOPE("test", "iteration");
+      CTK_TRACE_COUNTER("iterations", 1);
+      }
+  }
+
+  int Iterations;
+};
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkTracerTest1(int argc, char * argv [] )
+{
+  QCoreApplication app(argc, argv);
+
+  ctkTracer* tracer = ctkTracer::instance();
+  if (!tracer)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with ctkTracer::instance()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Nothing is recorded while disabled
+  tracer->setEnabled(false);
+  {
+  CTK_TRACE_SCOPE("test", "disabled");
+  CTK_TRACE_COUNTER("disabled", 1);
+  }
+  if (tracer->spanStatistics("disabled").Count != 0 || tracer->counter("disabled") != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with setEnabled(false)" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->setEnabled(true);
+  if (!ctkTracer::isEnabled())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with setEnabled(true)" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const int threadCount = 4;
+  const int iterations = 1000;
+  QList<TraceThread*> threads;
+  for (int i = 0; i < threadCount; ++i)
+    {
+    threads << new TraceThread(iterations);
+    threads.last()->start();
+    }
+  {
+  CTK_TRACE_SCOPE("test", "wait");
+  foreach(TraceThread* thread, threads)
+    {
+    thread->wait();
+    delete thread;
+    }
+  }
+
+  ctkTracer::SpanStatistics stats = tracer->spanStatistics("iteration");
+  if (stats.Count != threadCount * iterations ||
+      stats.MinimumTime > stats.MaximumTime ||
+      stats.TotalTime < stats.MaximumTime)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with spanStatistics():\n"
+              << " Count: " << stats.Count << "\n"
+              << " MinimumTime: " << stats.MinimumTime << "\n"
+              << " MaximumTime: " << stats.MaximumTime << "\n"
+              << " TotalTime: " << stats.TotalTime << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  int histogramCount = 0;
+  foreach(int count, stats.Histogram)
+    {
+    histogramCount += count;
+    }
+  if (histogramCount != stats.Count ||
+      stats.percentileTime(0.5) > stats.percentileTime(0.95) ||
+      stats.percentileTime(1.) != stats.MaximumTime)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with the span histogram" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (tracer->counter("iterations") != threadCount * iterations)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with counter(): "
+              << tracer->counter("iterations") << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (tracer->spanStatistics("wait").Count != 1 || tracer->spanStatistics().size() != 2)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with spanStatistics()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (!tracer->summary().contains("iteration"))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with summary():\n"
+              << qPrintable(tracer->summary()) << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  QBuffer trace;
+  trace.open(QIODevice::WriteOnly);
+  if (!tracer->writeTraceEvents(&trace) ||
+      !trace.data().startsWith("{\"traceEvents\":[") ||
+      trace.data().count("\"ph\":\"X\"") != threadCount * iterations + 1 ||
+      trace.data().count("\"ph\":\"C\"") != threadCount * iterations)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with writeTraceEvents()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->clear();
+  if (tracer->spanStatistics().size() != 0 || tracer->counters().size() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with clear()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Names built at run time, span arguments and extra top-level members
+  QVariantMap args;
+  args["id"] = 42;
+  tracer->addSpan("test", QString("dynamic %1").arg(1), tracer->now(), tracer->now(), args);
+  QVariantMap extraMembers;
+  extraMembers["statistics"] = QVariantList() << QVariantMap();
+  trace.close();
+  trace.setData(QByteArray());
+  trace.open(QIODevice::WriteOnly);
+  if (tracer->spanStatistics("dynamic 1").Count != 1 ||
+      !tracer->writeTraceEvents(&trace, extraMembers) ||
+      !trace.data().contains("\"name\":\"dynamic 1\"") ||
+      !trace.data().contains("\"args\":{\"id\":42}") ||
+      !trace.data().trimmed().endsWith(",\"statistics\":[{}]}"))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addSpan(QString):\n"
+              << trace.data().constData() << std::endl;
+    return EXIT_FAILURE;
+    }
+  tracer->clear();
+
+  // Thread buffers are bounded, counters stay exact. Each iteration
+  // records a counter event and a span.
+  tracer->setMaximumEventCount(10);
+  for (int i = 0; i < 20; ++i)
+    {
+    CTK_TRACE_SCOPE("test", "bounded");
+    CTK_TRACE_COUNTER("bounded", 1);
+    }
+  if (tracer->maximumEventCount() != 10 ||
+      tracer->spanStatistics("bounded").Count != 5 ||
+      tracer->droppedEventCount() != 30 ||
+      tracer->counter("bounded") != 20)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with setMaximumEventCount(): "
+              << tracer->droppedEventCount() << " dropped events" << std::endl;
+    return EXIT_FAILURE;
+    }
+  tracer->clear();
+  if (tracer->droppedEventCount() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with clear()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->setEnabled(false);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+
+// Qt includes
+#include <QCoreApplication>
+#include <QList>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+#include "ctkWorkflow.h"
+#include "ctkWorkflowStep.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// The workflow logs each transition with qDebug(), keep the output readable
+void silentDebugMessageHandler(QtMsgType type, const char* msg)
+{
+  if (type != QtDebugMsg)
+    {
+    std::cerr << msg << std::endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool checkCurrentStep(ctkWorkflow* workflow, ctkWorkflowStep* expectedStep, int line)
+{
+  if (workflow->currentStep() != expectedStep)
+    {
+    std::cerr << "Line " << line << " - Wrong current step (expected "
+              << qPrintable(expectedStep->id()) << " got "
+              << (workflow->currentStep() ? qPrintable(workflow->currentStep()->id()) : "none")
+              << ")" << std::endl;
+    return false;
+    }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkWorkflowBenchmark1(int argc, char * argv [] )
+{
+  QCoreApplication app(argc, argv);
+  QtMsgHandler previousMessageHandler = qInstallMsgHandler(silentDebugMessageHandler);
+
+  const int numberOfSteps = 1000;
+  ctkHighPrecisionTimer timer;
+
+  ctkWorkflow* workflow = new ctkWorkflow;
+  QList<ctkWorkflowStep*> steps;
+  for (int i = 0; i < numberOfSteps; ++i)
+    {
+    steps << new ctkWorkflowStep(QString("step%1").arg(i));
+    }
+
+  timer.start();
+  for (int i = 0; i < numberOfSteps - 1; ++i)
+    {
+    workflow->addTransition(steps[i], steps[i + 1]);
+    }
+  qint64 addTransitionTime = timer.elapsedMicro();
+
+  if (workflow->steps().count() != numberOfSteps ||
+      workflow->step("STEP500") != steps[500])
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with addTransition()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  workflow->start();
+  workflow->processPendingTransitions();
+  if (!checkCurrentStep(workflow, steps.first(), __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Go through the workflow one step at a time
+  timer.start();
+  for (int i = 1; i < numberOfSteps; ++i)
+    {
+    workflow->goForward();
+    workflow->processPendingTransitions();
+    }
+  qint64 goForwardTime = timer.elapsedMicro();
+  if (!checkCurrentStep(workflow, steps.last(), __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  timer.start();
+  int distance = workflow->backwardDistanceToStep();
+  qint64 distanceTime = timer.elapsedMicro();
+  if (distance != numberOfSteps - 1)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with backwardDistanceToStep(): "
+              << distance << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  timer.start();
+  for (int i = 1; i < numberOfSteps; ++i)
+    {
+    workflow->goBackward();
+    workflow->processPendingTransitions();
+    }
+  qint64 goBackwardTime = timer.elapsedMicro();
+  if (!checkCurrentStep(workflow, steps.first(), __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Go to the last step and come back to the first step in a single call
+  timer.start();
+  workflow->goToStep(steps.last()->id());
+  workflow->processPendingTransitions();
+  qint64 goToStepTime = timer.elapsedMicro();
+  if (!checkCurrentStep(workflow, steps.first(), __LINE__) ||
+      steps.first()->statusText().isEmpty())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with goToStep()" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  workflow->stop();
+  delete workflow;
+
+  qInstallMsgHandler(previousMessageHandler);
+
+  std::cout << numberOfSteps << " steps:\n"
+            << " addTransition: " << addTransitionTime << " us\n"
+            << " goForward: " << goForwardTime / (numberOfSteps - 1) << " us/transition\n"
+            << " goBackward: " << goBackwardTime / (numberOfSteps - 1) << " us/transition\n"
+            << " goToStep: " << goToStepTime << " us\n"
+            << " backwardDistanceToStep: " << distanceTime << " us" << std::endl;
+
+  return EXIT_SUCCESS;
+}
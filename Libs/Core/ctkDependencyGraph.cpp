@@ -27,14 +27,9 @@
 #include <algorithm>
 #include <vector>
 #include <set>
-#include <map>
 #include <list>
-#include <queue>
 #include <cassert>
 
-#define MAXV 100
-#define MAXDEGREE 200
-
 //----------------------------------------------------------------------------
 class ctkDependencyGraphPrivate
 {
@@ -45,60 +40,74 @@ public:
 
   ctkDependencyGraphPrivate(ctkDependencyGraph& p);
   ~ctkDependencyGraphPrivate();
-  
-  /// Compute outdegree
-  void computeOutdegrees(std::vector<int>& computedOutdegrees);
-  
-  /// Traverse tree using Depth-first_search
+
+  /// Rebuild the compact adjacency arrays if edges have been inserted
+  /// since the last update.
+  void updateAdjacency()const;
+
+  /// Traverse tree using Depth-first_search. Vertices already processed
+  /// by a previous traversal are not visited again.
   void traverseUsingDFS(int v);
-  
+
   /// Called each time an edge is visited
-  void processEdge(int from, int to); 
-  
+  void processEdge(int from, int to);
+
   /// Called each time a vertex is processed
   void processVertex(int v);
 
   /// Retrieve the path between two vertices
   void findPathDFS(int from, int to, std::list<int>& path);
 
-  /// Recursive function used by findPaths to retrieve the path between two vertices
-  void findPathsRec(int from, int to, std::list<int>* path, std::list<std::list<int>* >& paths);
-  
-  void setEdge(int vertice, int degree, int value);
+  /// Function used by findPaths to retrieve the paths between two vertices
+  void findAllPaths(int from, int to, std::list<int>* path, std::list<std::list<int>* >& paths);
+
   int edge(int vertice, int degree)const;
 
   void verticesWithIndegree(int indegree, std::list<int>& list);
 
-  int subgraphSize(int rootId);
-  void subgraphSizeRec(int rootId, std::set<int>& uniqueVertices);
+  /// Mark the vertices reachable from rootId (including rootId) and
+  /// return their number.
+  int reachableVertices(int rootId, std::vector<bool>& reachable)const;
+
+  /// Sort the vertices using Kahn's algorithm. The vertices of a level are
+  /// stored in sorted between levelStarts[i] and levelStarts[i+1].
+  /// If rootId > 0, only the vertices reachable from rootId are sorted.
+  /// Return false if the (sub)graph contains cycles.
+  bool sortByLevels(int rootId, std::vector<int>& sorted, std::vector<size_t>& levelStarts)const;
+
+  void resetTraversal();
 
-  void subgraphInsert(ctkDependencyGraph& subgraph, int rootId,
-                      std::map<int,int>& subgraphIdToGlobal, std::map<int,int>& globalIdToSubgraph);
+  /// Edges in insertion order
+  /// See http://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_.28CSR_or_CRS.29
+  std::vector<int> EdgeFrom;
+  std::vector<int> EdgeTo;
 
-  int getOrGenerateSubgraphId(std::map<int, int>& subgraphIdToGlobal,
-                      std::map<int, int>& globalIdToSubgraph,
-                      int globalId);
+  /// Compressed sparse row representation of the adjacency lists: the
+  /// successors of vertex v are AdjacencyTargets[AdjacencyOffsets[v]] up to
+  /// AdjacencyTargets[AdjacencyOffsets[v+1]], in insertion order.
+  mutable std::vector<int> AdjacencyOffsets;
+  mutable std::vector<int> AdjacencyTargets;
+  mutable bool AdjacencyModified;
 
-  /// See http://en.wikipedia.org/wiki/Adjacency_list
-  std::vector<std::vector<int>* > Edges;
   std::vector<int> OutDegree;
   std::vector<int> InDegree;
   int NVertices;
   int NEdges;
-  
+
   /// Structure used by DFS
   /// See http://en.wikipedia.org/wiki/Depth-first_search
-  std::vector<bool> Processed;	// processed vertices
+  std::vector<bool> Processed;  // processed vertices
   std::vector<bool> Discovered; // discovered vertices
-  std::vector<int>  Parent;	    // relation discovered
-  
-  bool    Abort;	// Flag indicating if traverse should be aborted
-  bool    Verbose; 
-  bool    CycleDetected; 
-  int     CycleOrigin; 
+  std::vector<int>  Parent;     // relation discovered
+
+  bool    Abort;  // Flag indicating if traverse should be aborted
+  bool    Verbose;
+  bool    CycleDetected;
+  int     CycleOrigin;
   int     CycleEnd;
-  
+
   std::list<int> ListOfEdgeToExclude;
+  std::set<int> EdgesToExclude;
 
 };
 
@@ -118,40 +127,6 @@ std::string listToString(const std::list<T>& list)
   return outputString.str();
 }
 
-//----------------------------------------------------------------------------
-// Returns true if the map contains the key and false otherwise.
-template<class T1, class T2>
-bool mapContainsKey(const std::map<T1, T2>& map, const T1& key)
-{
-  bool result = false;
-
-  if (map.find(key) != map.end())
-    {
-    result = true;
-    }
-
-  return result;
-}
-
-//----------------------------------------------------------------------------
-// Returns true if the list contains the value and false otherwise.
-template<class T>
-bool listContainsValue(const std::list<T>& list, const T& value)
-{
-  bool result = false;
-
-  typename std::list<T>::const_iterator iter;
-  for (iter = list.begin(); iter != list.end(); iter++)
-    {
-    if ((*iter) == value)
-      {
-      result = true;
-      break;
-      }
-    }
-  return result;
-}
-
 //----------------------------------------------------------------------------
 // ctkInternal methods
 
@@ -159,8 +134,9 @@ bool listContainsValue(const std::list<T>& list, const T& value)
 ctkDependencyGraphPrivate::ctkDependencyGraphPrivate(ctkDependencyGraph& object)
   :q_ptr(&object)
 {
-  this->NVertices = 0; 
-  this->NEdges = 0; 
+  this->AdjacencyModified = false;
+  this->NVertices = 0;
+  this->NEdges = 0;
   this->Abort = false;
   this->Verbose = false;
   this->CycleDetected = false;
@@ -170,71 +146,85 @@ ctkDependencyGraphPrivate::ctkDependencyGraphPrivate(ctkDependencyGraph& object)
 
 ctkDependencyGraphPrivate::~ctkDependencyGraphPrivate()
 {
-  std::vector<std::vector<int>* >::iterator edgesIterator;
-  for (edgesIterator = this->Edges.begin(); edgesIterator != this->Edges.end(); edgesIterator++)
-    {
-    if (*edgesIterator != NULL)
-      {
-      delete *edgesIterator;
-      }
-    }
 }
 
 //----------------------------------------------------------------------------
-void ctkDependencyGraphPrivate::computeOutdegrees(std::vector<int>& computedOutdegrees)
+void ctkDependencyGraphPrivate::updateAdjacency()const
 {
-	for (int i=1; i <= this->NVertices; i++)
-	  {
-    computedOutdegrees[i] = 0;
-	  }
+  if (!this->AdjacencyModified)
+    {
+    return;
+    }
 
-	for (int i=1; i <= this->NVertices; i++) 
-	  {
-    for (int j=0; j < this->OutDegree[i]; j++)
-		  {
-      computedOutdegrees[ this->edge(i,j) ] ++;
-		  }
-		}
+  // Counting sort of the edges by origin, keeping the insertion order
+  this->AdjacencyOffsets.assign(this->NVertices + 2, 0);
+  for (int v = 1; v <= this->NVertices; ++v)
+    {
+    this->AdjacencyOffsets[v + 1] = this->AdjacencyOffsets[v] + this->OutDegree[v];
+    }
+
+  this->AdjacencyTargets.resize(this->NEdges);
+  std::vector<int> insertPosition(this->AdjacencyOffsets.begin(), this->AdjacencyOffsets.end() - 1);
+  for (int i = 0; i < this->NEdges; ++i)
+    {
+    this->AdjacencyTargets[insertPosition[this->EdgeFrom[i]]++] = this->EdgeTo[i];
+    }
+
+  this->AdjacencyModified = false;
 }
 
 //----------------------------------------------------------------------------
 void ctkDependencyGraphPrivate::traverseUsingDFS(int v)
 {
   // allow for search termination
-	if (this->Abort)
-	  {
-	  return;
-	  }
-
-	this->Discovered[v] = true;
-	this->processVertex(v);
-
-  int y; // successor vertex
-  for (int i=0; i<this->OutDegree[v]; i++)
-	  {
-		y = this->edge(v, i);
-		if (q_ptr->shouldExcludeEdge(this->edge(v, i)) == false)
-		  {
-      this->Parent[y] = v;
-			if (this->Discovered[y] == false)
-			  {
-				this->traverseUsingDFS(y);
-			  } 
-			else 
-			  {
-				if (this->Processed[y] == false)
-				  {
-					this->processEdge(v,y);
-					}
-			  }
-		  }
-		if (this->Abort)
-		  {
-		  return;
-		  }
-	}
-
-	this->Processed[v] = true;
+  if (this->Abort || this->Discovered[v])
+    {
+    return;
+    }
+
+  // Explicit stack of (vertex, index of the next edge to visit) so that
+  // deep graphs cannot overflow the call stack
+  std::vector<std::pair<int, int> > stack;
+
+  this->Discovered[v] = true;
+  this->processVertex(v);
+  stack.push_back(std::make_pair(v, 0));
+
+  while (!stack.empty())
+    {
+    int current = stack.back().first;
+    int i = stack.back().second;
+    if (i >= this->OutDegree[current])
+      {
+      this->Processed[current] = true;
+      stack.pop_back();
+      continue;
+      }
+    ++stack.back().second;
+
+    int y = this->edge(current, i); // successor vertex
+    if (q_ptr->shouldExcludeEdge(y) == false)
+      {
+      this->Parent[y] = current;
+      if (this->Discovered[y] == false)
+        {
+        this->Discovered[y] = true;
+        this->processVertex(y);
+        stack.push_back(std::make_pair(y, 0));
+        }
+      else
+        {
+        if (this->Processed[y] == false)
+          {
+          this->processEdge(current, y);
+          }
+        }
+      }
+    if (this->Abort)
+      {
+      return;
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -243,7 +233,7 @@ void ctkDependencyGraphPrivate::processEdge(int from, int to)
   if (this->Discovered[to] == true)
     {
     this->CycleDetected = true;
-    this->CycleOrigin = to; 
+    this->CycleOrigin = to;
     this->CycleEnd = from;
     if (this->Verbose)
       {
@@ -262,72 +252,93 @@ void ctkDependencyGraphPrivate::processEdge(int from, int to)
 //----------------------------------------------------------------------------
 void ctkDependencyGraphPrivate::processVertex(int v)
 {
-	if (this->Verbose)
-	  {
-	  std::cout << "processed vertex " << v << std::endl;
-	  }
-}
-
-//----------------------------------------------------------------------------
-void ctkDependencyGraphPrivate::setEdge(int vertice, int degree, int value)
-{
-  assert(vertice <= this->NVertices);
-  assert(degree < MAXDEGREE);
-  (*this->Edges[vertice])[degree] = value; 
+  if (this->Verbose)
+    {
+    std::cout << "processed vertex " << v << std::endl;
+    }
 }
 
 //----------------------------------------------------------------------------
 int ctkDependencyGraphPrivate::edge(int vertice, int degree)const
 {
   assert(vertice <= this->NVertices);
-  assert(degree < MAXDEGREE);
-  return (*this->Edges[vertice])[degree];
+  assert(degree < this->OutDegree[vertice]);
+  assert(!this->AdjacencyModified);
+  return this->AdjacencyTargets[this->AdjacencyOffsets[vertice] + degree];
 }
 
 //----------------------------------------------------------------------------
 void ctkDependencyGraphPrivate::findPathDFS(int from, int to, std::list<int>& path)
 {
-  if ((from == to) || (to == -1))
+  // Walk back the parent relation from 'to' until 'from' is reached
+  int vertex = to;
+  int visited = 0;
+  while (vertex != from && vertex != -1 && visited <= this->NVertices)
     {
-    path.push_back(from);
-    }
-  else 
-    {
-    this->findPathDFS(from, this->Parent[to], path);
-    path.push_back(to);
+    path.push_front(vertex);
+    vertex = this->Parent[vertex];
+    ++visited;
     }
+  path.push_front(from);
 }
 
 //----------------------------------------------------------------------------
-void ctkDependencyGraphPrivate::findPathsRec(
+void ctkDependencyGraphPrivate::findAllPaths(
   int from, int to, std::list<int>* path, std::list<std::list<int>* >& paths)
 {
   if (from == to)
     {
     return;
     }
-  
-  std::list<int> branch;
-  branch = *path;
 
-  int child = from;
-  for (int j=0; j < this->OutDegree[child]; j++)
+  // The first successor extends the current path, each other successor
+  // starts a new path from a copy of the path as it was when the vertex was reached.
+  struct Frame
+  {
+    int Vertex;
+    int NextEdge;
+    std::list<int>* Path;
+    std::list<int> Branch;
+  };
+
+  std::list<Frame> stack;
+  stack.push_back(Frame());
+  stack.back().Vertex = from;
+  stack.back().NextEdge = 0;
+  stack.back().Path = path;
+  stack.back().Branch = *path;
+
+  while (!stack.empty())
     {
+    Frame& frame = stack.back();
+    if (frame.NextEdge >= this->OutDegree[frame.Vertex])
+      {
+      stack.pop_back();
+      continue;
+      }
+
+    int j = frame.NextEdge++;
+    int parent = this->edge(frame.Vertex, j);
+    std::list<int>* parentPath = 0;
     if (j == 0)
       {
-      int parent = this->edge(child, j);
-      (*path).push_back(parent);
-      this->findPathsRec(parent, to, path, paths);
+      parentPath = frame.Path;
       }
     else
       {
-      int parent = this->edge(child, j);
       // Copy path and add it to the list
-      std::list<int>* pathCopy = new std::list<int>();
-      *pathCopy = branch;
-      paths.push_back(pathCopy);
-      (*pathCopy).push_back(parent);
-      this->findPathsRec(parent, to, pathCopy, paths);
+      parentPath = new std::list<int>(frame.Branch);
+      paths.push_back(parentPath);
+      }
+    parentPath->push_back(parent);
+
+    if (parent != to)
+      {
+      stack.push_back(Frame());
+      stack.back().Vertex = parent;
+      stack.back().NextEdge = 0;
+      stack.back().Path = parentPath;
+      stack.back().Branch = *parentPath;
       }
     }
 }
@@ -347,64 +358,106 @@ void ctkDependencyGraphPrivate::verticesWithIndegree(int indegree, std::list<int
 }
 
 //----------------------------------------------------------------------------
-void ctkDependencyGraphPrivate::subgraphSizeRec(int rootId, std::set<int>& uniqueVertices)
+int ctkDependencyGraphPrivate::reachableVertices(int rootId, std::vector<bool>& reachable)const
 {
-  assert(rootId > 0);
+  assert(rootId > 0 && rootId <= this->NVertices);
+
+  reachable.assign(this->NVertices + 1, false);
+  reachable[rootId] = true;
+  int count = 1;
 
-  for (int i = 0; i < this->OutDegree[rootId]; ++i)
+  std::vector<int> stack;
+  stack.push_back(rootId);
+  while (!stack.empty())
     {
-    int child = this->edge(rootId, i);
-    uniqueVertices.insert(child);
-    subgraphSizeRec(child, uniqueVertices);
+    int vertex = stack.back();
+    stack.pop_back();
+    for (int i = 0; i < this->OutDegree[vertex]; ++i)
+      {
+      int child = this->edge(vertex, i);
+      if (!reachable[child])
+        {
+        reachable[child] = true;
+        ++count;
+        stack.push_back(child);
+        }
+      }
     }
+  return count;
 }
 
 //----------------------------------------------------------------------------
-int ctkDependencyGraphPrivate::subgraphSize(int rootId)
+bool ctkDependencyGraphPrivate::sortByLevels(int rootId,
+                                             std::vector<int>& sorted,
+                                             std::vector<size_t>& levelStarts)const
 {
-  assert(rootId > 0);
+  this->updateAdjacency();
 
-  std::set<int> vertices;
-  vertices.insert(rootId);
-  this->subgraphSizeRec(rootId, vertices);
-  return static_cast<int>(vertices.size());
-}
+  std::vector<bool> reachable;
+  int numberOfVertices = this->NVertices;
+  if (rootId > 0)
+    {
+    numberOfVertices = this->reachableVertices(rootId, reachable);
+    }
+  else
+    {
+    reachable.assign(this->NVertices + 1, true);
+    }
 
-void ctkDependencyGraphPrivate::subgraphInsert(
-    ctkDependencyGraph& subgraph, int rootId,
-    std::map<int,int>& subgraphIdToGlobal, std::map<int,int>& globalIdToSubgraph)
-{
-  int from = this->getOrGenerateSubgraphId(subgraphIdToGlobal, globalIdToSubgraph, rootId);
-  for (int i = 0; i < this->OutDegree[rootId]; ++i)
-  {
-    int childId = this->edge(rootId, i);
-    int to = this->getOrGenerateSubgraphId(subgraphIdToGlobal, globalIdToSubgraph,
-                                           childId);
+  // Indegree of each vertex within the (sub)graph
+  std::vector<int> indegree(this->NVertices + 1, 0);
+  for (int v = 1; v <= this->NVertices; ++v)
+    {
+    if (!reachable[v])
+      {
+      continue;
+      }
+    for (int i = 0; i < this->OutDegree[v]; ++i)
+      {
+      ++indegree[this->edge(v, i)];
+      }
+    }
 
-    subgraph.insertEdge(from, to);
-    this->subgraphInsert(subgraph, childId, subgraphIdToGlobal, globalIdToSubgraph);
-  }
-}
+  sorted.clear();
+  sorted.reserve(numberOfVertices);
+  levelStarts.clear();
 
-//----------------------------------------------------------------------------
-int ctkDependencyGraphPrivate::getOrGenerateSubgraphId(
-    std::map<int, int>& subgraphIdToGlobal,
-    std::map<int, int>& globalIdToSubgraph,
-    int globalId)
-{
-  // If needed, generate vertex id
-  int subgraphId = -1;
-  if (!mapContainsKey<int, int>(globalIdToSubgraph,globalId))
+  // 'sorted' is used as the queue of the vertices with indegree 0
+  for (int v = 1; v <= this->NVertices; ++v)
     {
-    subgraphId = static_cast<int>(globalIdToSubgraph.size()) + 1;
-    globalIdToSubgraph[globalId] = subgraphId;
-    subgraphIdToGlobal[subgraphId] = globalId;
+    if (reachable[v] && indegree[v] == 0)
+      {
+      sorted.push_back(v);
+      }
     }
-  else
+
+  size_t head = 0;
+  while (head < sorted.size())
     {
-    subgraphId = globalIdToSubgraph[globalId];
+    levelStarts.push_back(head);
+    size_t levelEnd = sorted.size();
+    for (; head < levelEnd; ++head)
+      {
+      int x = sorted[head];
+      for (int i = 0; i < this->OutDegree[x]; ++i)
+        {
+        int y = this->edge(x, i);
+        if (--indegree[y] == 0)
+          {
+          sorted.push_back(y);
+          }
+        }
+      }
     }
-  return subgraphId;
+
+  return static_cast<int>(sorted.size()) == numberOfVertices;
+}
+
+//----------------------------------------------------------------------------
+void ctkDependencyGraphPrivate::resetTraversal()
+{
+  std::fill(this->Processed.begin(), this->Processed.end(), false);
+  std::fill(this->Discovered.begin(), this->Discovered.end(), false);
 }
 
 //----------------------------------------------------------------------------
@@ -415,35 +468,14 @@ ctkDependencyGraph::ctkDependencyGraph(int nvertices)
   :d_ptr(new ctkDependencyGraphPrivate(*this))
 {
   d_ptr->NVertices = nvertices;
-  
+
   // Resize internal array
-  d_ptr->Processed.resize(nvertices + 1);
-  d_ptr->Discovered.resize(nvertices + 1);
-  d_ptr->Parent.resize(nvertices + 1);
-  d_ptr->Edges.resize(nvertices + 1);
-  d_ptr->OutDegree.resize(nvertices + 1);
-  d_ptr->InDegree.resize(nvertices + 1);
-
-  for (int i=1; i <= nvertices; i++)
-    {
-    d_ptr->OutDegree[i] = 0;
-    d_ptr->InDegree[i] = 0;
-    }
-    
-  // initialize Edge adjacency list
-  for (int i=0; i <= nvertices; i++)
-    {
-    d_ptr->Edges[i] = new std::vector<int>();
-    d_ptr->Edges[i]->resize(MAXDEGREE);
-    }
-    
-  // initialize search
-  for (int i=1; i <= nvertices; i++)
-    {
-    d_ptr->Processed[i] = false;
-    d_ptr->Discovered[i] = false;
-    d_ptr->Parent[i] = -1;
-    }
+  d_ptr->Processed.resize(nvertices + 1, false);
+  d_ptr->Discovered.resize(nvertices + 1, false);
+  d_ptr->Parent.resize(nvertices + 1, -1);
+  d_ptr->OutDegree.resize(nvertices + 1, 0);
+  d_ptr->InDegree.resize(nvertices + 1, 0);
+  d_ptr->AdjacencyOffsets.resize(nvertices + 2, 0);
 }
 
 //----------------------------------------------------------------------------
@@ -485,6 +517,7 @@ void ctkDependencyGraph::printAdditionalInfo()const
 //----------------------------------------------------------------------------
 void ctkDependencyGraph::printGraph()const
 {
+  d_ptr->updateAdjacency();
   for(int i=1; i <= d_ptr->NVertices; i++)
     {
     std::cout << i << ":";
@@ -518,12 +551,13 @@ void ctkDependencyGraph::setVerbose(bool verbose)
 void ctkDependencyGraph::setEdgeListToExclude(const std::list<int>& list)
 {
   d_ptr->ListOfEdgeToExclude = list;
+  d_ptr->EdgesToExclude = std::set<int>(list.begin(), list.end());
 }
 
 //----------------------------------------------------------------------------
 bool ctkDependencyGraph::shouldExcludeEdge(int edge)const
 {
-  return listContainsValue(d_ptr->ListOfEdgeToExclude, edge);
+  return d_ptr->EdgesToExclude.find(edge) != d_ptr->EdgesToExclude.end();
 }
 
 //----------------------------------------------------------------------------
@@ -531,14 +565,11 @@ bool ctkDependencyGraph::checkForCycle()
 {
   if (d_ptr->NEdges > 0)
     {
-    // Store unprocessed vertex ids
-    std::list<int> uncheckedVertices;
-    for (int i = 1; i <= d_ptr->NVertices; ++i)
-      {
-        uncheckedVertices.push_back(i);
-      }
+    d_ptr->updateAdjacency();
+    d_ptr->resetTraversal();
 
-    // Start the cycle detection on the source vertices
+    // Start the cycle detection on the source vertices. Vertices processed
+    // by a previous traversal are cycle free and are not visited again.
     std::list<int> sources;
     this->sourceVertices(sources);
     std::list<int>::const_iterator sourcesIterator;
@@ -546,38 +577,21 @@ bool ctkDependencyGraph::checkForCycle()
       {
       d_ptr->traverseUsingDFS(*sourcesIterator);
       if (this->cycleDetected()) return true;
-
-      for (unsigned int i=0; i < d_ptr->Processed.size(); i++)
-        {
-          if (d_ptr->Processed[i] == true)
-            {
-            uncheckedVertices.remove(i);
-            }
-
-          d_ptr->Discovered[i] = false;
-          d_ptr->Processed[i] = false;
-        }
       }
 
     // If a component does not have a source vertex,
     // i.e. it is a cycle a -> b -> a, check all non
-    // processed vertices.
-    while (!uncheckedVertices.empty())
+    // processed vertices, starting with the highest id.
+    for (int i = d_ptr->NVertices; i > 0; --i)
       {
-      d_ptr->traverseUsingDFS((*uncheckedVertices.rbegin()));
-      if (this->cycleDetected()) return true;
-
-      for (unsigned int i=0; i < d_ptr->Processed.size(); i++)
+      if (!d_ptr->Processed[i])
         {
-          if (d_ptr->Processed[i] == true)
-            {
-            uncheckedVertices.remove(i);
-            }
-
-          d_ptr->Discovered[i] = false;
-          d_ptr->Processed[i] = false;
+        d_ptr->traverseUsingDFS(i);
+        if (this->cycleDetected()) return true;
         }
       }
+
+    d_ptr->resetTraversal();
     }
   return this->cycleDetected();
 }
@@ -600,20 +614,28 @@ int ctkDependencyGraph::cycleEnd()const
   return d_ptr->CycleEnd;
 }
 
+//----------------------------------------------------------------------------
+bool ctkDependencyGraph::findCycle(std::list<int>& cycle)
+{
+  if (!this->checkForCycle())
+    {
+    return false;
+    }
+  // The DFS parent relation leads from the origin to the end of the cycle
+  d_ptr->findPathDFS(d_ptr->CycleOrigin, d_ptr->CycleEnd, cycle);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void ctkDependencyGraph::insertEdge(int from, int to)
 {
   assert(from > 0 && from <= d_ptr->NVertices);
   assert(to > 0 && to <= d_ptr->NVertices);
-  
-  // resize if needed
-  size_t capacity = d_ptr->Edges[from]->capacity();
-  if (d_ptr->OutDegree[from] > static_cast<int>(capacity))
-    {
-    d_ptr->Edges[from]->resize(capacity + capacity * 0.3);
-    }
 
-  d_ptr->setEdge(from, d_ptr->OutDegree[from], to);
+  d_ptr->EdgeFrom.push_back(from);
+  d_ptr->EdgeTo.push_back(to);
+  d_ptr->AdjacencyModified = true;
+
   d_ptr->OutDegree[from]++;
   d_ptr->InDegree[to]++;
 
@@ -623,10 +645,12 @@ void ctkDependencyGraph::insertEdge(int from, int to)
 //----------------------------------------------------------------------------
 void ctkDependencyGraph::findPaths(int from, int to, std::list<std::list<int>* >& paths)
 {
+  d_ptr->updateAdjacency();
+
   std::list<int>* path = new std::list<int>;
   (*path).push_back(from);
   (paths).push_back(path);
-  d_ptr->findPathsRec(from, to, path, paths);
+  d_ptr->findAllPaths(from, to, path, paths);
 
   // Remove lists not ending with the requested element
   std::list<std::list<int>* >::iterator pathsIterator;
@@ -639,6 +663,7 @@ void ctkDependencyGraph::findPaths(int from, int to, std::list<std::list<int>* >
 
     if (*(pathToCheck->rbegin()) != to)
       {
+      delete pathToCheck;
       pathsIterator = paths.erase(pathsIterator);
       }
     else
@@ -676,70 +701,26 @@ void ctkDependencyGraph::findPath(int from, int to, std::list<int>& path)
 //----------------------------------------------------------------------------
 bool ctkDependencyGraph::topologicalSort(std::list<int>& sorted, int rootId)
 {
-  if (rootId > 0)
+  std::vector<int> sortedVertices;
+  std::vector<size_t> levelStarts;
+  bool result = d_ptr->sortByLevels(rootId, sortedVertices, levelStarts);
+  sorted.insert(sorted.end(), sortedVertices.begin(), sortedVertices.end());
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool ctkDependencyGraph::topologicalSortByLevels(std::list<std::list<int> >& levels, int rootId)
+{
+  std::vector<int> sortedVertices;
+  std::vector<size_t> levelStarts;
+  bool result = d_ptr->sortByLevels(rootId, sortedVertices, levelStarts);
+  for (size_t level = 0; level < levelStarts.size(); ++level)
     {
-    ctkDependencyGraph subgraph(d_ptr->subgraphSize(rootId));
-    std::map<int,int> subgraphIdToGlobal;
-    std::map<int,int> globalIdToSubgraph;
-    d_ptr->subgraphInsert(subgraph, rootId, subgraphIdToGlobal, globalIdToSubgraph);
-
-    std::list<int> subgraphSorted;
-    bool result = subgraph.topologicalSort(subgraphSorted);
-    std::list<int>::const_iterator subgraphSortedIterator;
-    for (subgraphSortedIterator = subgraphSorted.begin(); subgraphSortedIterator != subgraphSorted.end(); subgraphSortedIterator++)
-      {
-      sorted.push_back(subgraphIdToGlobal[*subgraphSortedIterator]);
-      }
-    return result;
+    size_t levelEnd = level + 1 < levelStarts.size() ? levelStarts[level + 1] : sortedVertices.size();
+    levels.push_back(std::list<int>(sortedVertices.begin() + levelStarts[level],
+                                    sortedVertices.begin() + levelEnd));
     }
-
-  std::vector<int> outdegree; // outdegree of each vertex
-  outdegree.resize(MAXV);
-  std::queue<int> zeroout;	  // vertices of outdegree 0
-	int x, y;			        // current and next vertex
-  
-  outdegree.resize(d_ptr->NVertices + 1);
-	
-	// resize if needed
-	if (d_ptr->NVertices > MAXV)
-	  {
-    outdegree.resize(d_ptr->NVertices);
-	  }
-
-	d_ptr->computeOutdegrees(outdegree);
-	
-	for (int i=1; i <= d_ptr->NVertices; i++)
-	  {
-    if (outdegree[i] == 0)
-		  {
-      zeroout.push(i);
-		  }
-		}
-
-	int j=0;
-  while (zeroout.empty() == false)
-	  {
-		j = j+1;
-    x = zeroout.front();
-    zeroout.pop();
-		sorted.push_back(x);
-    for (int i=0; i < d_ptr->OutDegree[x]; i++)
-		  {
-			y = d_ptr->edge(x, i);
-      outdegree[y] --;
-      if (outdegree[y] == 0)
-			  {
-        zeroout.push(y);
-			  }
-		  }
-	  }
-
-	if (j != d_ptr->NVertices)
-	  {
-		return false;
-		}
-		
-  return true;
+  return result;
 }
 
 //----------------------------------------------------------------------------
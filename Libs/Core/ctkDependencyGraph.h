@@ -61,6 +61,12 @@ public:
   
   /// If a cycle has been detected, return the end of the cycle otherwise 0.
   int cycleEnd()const;
+
+  /// Traverse graph and retrieve the vertices of the first detected cycle.
+  /// The cycle starts with cycleOrigin() and ends with cycleEnd(), the edge
+  /// (cycleEnd, cycleOrigin) closes the cycle.
+  /// Return false if the graph does not contain any cycle.
+  bool findCycle(std::list<int>& cycle);
   
   // The traverse of the tree will print information on standard output
   void setVerbose(bool verbose);
@@ -94,6 +100,14 @@ public:
   /// See cycleDetected, cycleOrigin, cycleEnd
   bool topologicalSort(std::list<int>& sorted, int rootId = -1);
 
+  /// Perform a topological sort and group the vertices by level: the
+  /// vertices of a level only depend on vertices of the previous levels and
+  /// can be processed in parallel. Concatenating the levels gives the
+  /// same order as topologicalSort.
+  /// Return false if the graph contains cycles
+  /// If a rootId is given, the subgraph starting at the root id is sorted
+  bool topologicalSortByLevels(std::list<std::list<int> >& levels, int rootId = -1);
+
   /// Retrieve all vertices with indegree 0
   void sourceVertices(std::list<int>& sources);
 
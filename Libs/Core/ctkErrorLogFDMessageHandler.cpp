@@ -19,6 +19,7 @@
 =========================================================================*/
 
 // Qt includes
+#include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
 
@@ -29,6 +30,7 @@
 
 // STD includes
 #include <cstdio>
+#include <cstring> // For memchr
 #ifdef Q_OS_WIN32
 # include <fcntl.h>  // For _O_TEXT
 # include <io.h>     // For _pipe, _dup and _dup2
@@ -36,6 +38,27 @@
 # include <unistd.h> // For pipe, dup and dup2
 #endif
 
+// --------------------------------------------------------------------------
+// ctkFDHandlerDispatcher methods
+
+// --------------------------------------------------------------------------
+ctkFDHandlerDispatcher::ctkFDHandlerDispatcher(ctkFDHandler* fdHandler)
+  : FDHandler(fdHandler)
+{
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandlerDispatcher::run()
+{
+  QString threadId = ctk::qtHandleToString(QThread::currentThreadId());
+  QStringList lines;
+  while (this->FDHandler->takePendingLines(lines))
+    {
+    this->FDHandler->deliver(threadId, lines);
+    lines.clear();
+    }
+}
+
 // --------------------------------------------------------------------------
 // ctkFDHandler methods
 // See http://stackoverflow.com/questions/5419356/redirect-stdout-stderr-to-a-string
@@ -45,12 +68,17 @@
 ctkFDHandler::ctkFDHandler(ctkErrorLogFDMessageHandler* messageHandler,
                            ctkErrorLogLevel::LogLevel logLevel,
                            ctkErrorLogModel::TerminalOutput terminalOutput)
+  : Dispatcher(this)
 {
   this->MessageHandler = messageHandler;
   this->LogLevel = logLevel;
   this->TerminalOutput = terminalOutput;
   this->SavedFDNumber = 0;
   this->Enabled = false;
+  this->Dispatching = false;
+  this->FlushInterval = 10;
+  this->MaximumLatency = 100;
+  this->MaximumPendingMessageCount = 100000;
 }
 
 // --------------------------------------------------------------------------
@@ -106,6 +134,8 @@ void ctkFDHandler::setEnabled(bool value)
     close(this->Pipe[1]);
 #endif
 
+    this->startDispatching();
+
     // Start polling thread
     this->Enabled = true;
     this->start();
@@ -138,6 +168,9 @@ void ctkFDHandler::setEnabled(bool value)
     // Wait the polling thread graciously terminates
     this->wait();
 
+    // Deliver the remaining lines while the terminal output is still redirected
+    this->stopDispatching();
+
     // Close files and restore standard output to stdout or stderr - which should be the terminal
 #ifdef Q_OS_WIN32
     _dup2(this->SavedFDNumber, _fileno(this->terminalOutputFile()));
@@ -174,41 +207,191 @@ bool ctkFDHandler::enabled()const
   return this->Enabled;
 }
 
+// --------------------------------------------------------------------------
+int ctkFDHandler::flushInterval()const
+{
+  QMutexLocker locker(&this->PendingMutex);
+  return this->FlushInterval;
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::setFlushInterval(int msecs)
+{
+  QMutexLocker locker(&this->PendingMutex);
+  this->FlushInterval = qMax(0, msecs);
+}
+
+// --------------------------------------------------------------------------
+int ctkFDHandler::maximumLatency()const
+{
+  QMutexLocker locker(&this->PendingMutex);
+  return this->MaximumLatency;
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::setMaximumLatency(int msecs)
+{
+  QMutexLocker locker(&this->PendingMutex);
+  this->MaximumLatency = qMax(0, msecs);
+}
+
+// --------------------------------------------------------------------------
+int ctkFDHandler::maximumPendingMessageCount()const
+{
+  QMutexLocker locker(&this->PendingMutex);
+  return this->MaximumPendingMessageCount;
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::setMaximumPendingMessageCount(int count)
+{
+  QMutexLocker locker(&this->PendingMutex);
+  this->MaximumPendingMessageCount = qMax(1, count);
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::startDispatching()
+{
+  {
+    QMutexLocker locker(&this->PendingMutex);
+    this->Dispatching = true;
+  }
+  this->Dispatcher.start();
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::stopDispatching()
+{
+  {
+    QMutexLocker locker(&this->PendingMutex);
+    this->Dispatching = false;
+    this->PendingCondition.wakeAll();
+  }
+  // In synchronous logging mode, the dispatcher blocks until the thread of
+  // the model has added the lines. If it is the current thread, handle these
+  // calls while waiting.
+  while (!this->Dispatcher.wait(10))
+    {
+    QCoreApplication::sendPostedEvents(0, QEvent::MetaCall);
+    }
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::appendPendingLines(const QStringList& lines)
+{
+  QMutexLocker locker(&this->PendingMutex);
+  int available = qMax(0, this->MaximumPendingMessageCount - this->PendingLines.count());
+  if (available == 0)
+    {
+    this->DroppedMessageCount.fetchAndAddRelaxed(lines.count());
+    return;
+    }
+  if (this->PendingLines.isEmpty())
+    {
+    this->FirstPendingLineTime.start();
+    }
+  if (lines.count() > available)
+    {
+    this->PendingLines << lines.mid(0, available);
+    this->DroppedMessageCount.fetchAndAddRelaxed(lines.count() - available);
+    }
+  else
+    {
+    this->PendingLines << lines;
+    }
+  this->PendingCondition.wakeOne();
+}
+
+// --------------------------------------------------------------------------
+bool ctkFDHandler::takePendingLines(QStringList& lines)
+{
+  QMutexLocker locker(&this->PendingMutex);
+  while (this->Dispatching && this->PendingLines.isEmpty())
+    {
+    this->PendingCondition.wait(&this->PendingMutex);
+    }
+
+  // Collect the output until it pauses for FlushInterval or until the oldest
+  // line has been waiting for MaximumLatency.
+  while (this->Dispatching)
+    {
+    int remainingLatency = this->MaximumLatency - this->FirstPendingLineTime.elapsed();
+    if (remainingLatency <= 0
+        || !this->PendingCondition.wait(&this->PendingMutex, qMin(this->FlushInterval, remainingLatency)))
+      {
+      break;
+      }
+    }
+
+  bool dispatching = this->Dispatching || !this->PendingLines.isEmpty();
+  lines = this->PendingLines;
+  this->PendingLines.clear();
+  return dispatching;
+}
+
+// --------------------------------------------------------------------------
+void ctkFDHandler::deliver(const QString& threadId, const QStringList& lines)
+{
+  Q_ASSERT(this->MessageHandler);
+  // One call per chunk, the model adds the lines as a single batch
+  this->MessageHandler->handleMessages(threadId, this->LogLevel,
+                                       this->MessageHandler->handlerPrettyName(), lines);
+}
+
 // --------------------------------------------------------------------------
 void ctkFDHandler::run()
 {
+  const int bufferSize = 65536;
+  QByteArray buffer(bufferSize, '\0');
+  QByteArray partialLine;
   while(true)
     {
-    char c = '\0';
-    QString line;
-    while(c != '\n')
-      {
 #ifdef Q_OS_WIN32
-      int res = _read(this->Pipe[0], &c, 1); // When used with pipe, read() is blocking
+    int res = _read(this->Pipe[0], buffer.data(), bufferSize); // When used with pipe, read() is blocking
 #else
-      ssize_t res = read(this->Pipe[0], &c, 1); // When used with pipe, read() is blocking
+    ssize_t res = read(this->Pipe[0], buffer.data(), bufferSize); // When used with pipe, read() is blocking
 #endif
-      if (res == -1)
+
+    if (!this->enabled() || res == 0)
+      {
+      break;
+      }
+    if (res == -1)
+      {
+      continue;
+      }
+    if (res == bufferSize)
+      {
+      // More output is likely waiting in the pipe
+      this->BackpressureCount.ref();
+      }
+
+    // Split the chunk into lines. The last line may be completed by the next chunk.
+    QStringList lines;
+    const char* begin = buffer.constData();
+    const char* end = begin + res;
+    const char* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+    while (newline)
+      {
+      if (partialLine.isEmpty())
         {
-        break;
+        lines << QString::fromLocal8Bit(begin, newline - begin);
         }
-      if (c != '\n')
+      else
         {
-        line += c;
+        partialLine.append(begin, newline - begin);
+        lines << QString::fromLocal8Bit(partialLine.constData(), partialLine.size());
+        partialLine.clear();
         }
+      begin = newline + 1;
+      newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
       }
+    partialLine.append(begin, end - begin);
 
-    if (!this->enabled())
+    if (!lines.isEmpty())
       {
-      break;
+      this->appendPendingLines(lines);
       }
-
-    Q_ASSERT(this->MessageHandler);
-    this->MessageHandler->handleMessage(
-      ctk::qtHandleToString(QThread::currentThreadId()),
-      this->LogLevel,
-      this->MessageHandler->handlerPrettyName(),
-      line);
     }
 }
 
@@ -274,3 +457,72 @@ void ctkErrorLogFDMessageHandler::setEnabledInternal(bool value)
   d->StdOutFDHandler->setEnabled(value);
   d->StdErrFDHandler->setEnabled(value);
 }
+
+// --------------------------------------------------------------------------
+int ctkErrorLogFDMessageHandler::flushInterval()const
+{
+  Q_D(const ctkErrorLogFDMessageHandler);
+  return d->StdOutFDHandler->flushInterval();
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogFDMessageHandler::setFlushInterval(int msecs)
+{
+  Q_D(ctkErrorLogFDMessageHandler);
+  d->StdOutFDHandler->setFlushInterval(msecs);
+  d->StdErrFDHandler->setFlushInterval(msecs);
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogFDMessageHandler::maximumLatency()const
+{
+  Q_D(const ctkErrorLogFDMessageHandler);
+  return d->StdOutFDHandler->maximumLatency();
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogFDMessageHandler::setMaximumLatency(int msecs)
+{
+  Q_D(ctkErrorLogFDMessageHandler);
+  d->StdOutFDHandler->setMaximumLatency(msecs);
+  d->StdErrFDHandler->setMaximumLatency(msecs);
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogFDMessageHandler::maximumPendingMessageCount()const
+{
+  Q_D(const ctkErrorLogFDMessageHandler);
+  return d->StdOutFDHandler->maximumPendingMessageCount();
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogFDMessageHandler::setMaximumPendingMessageCount(int count)
+{
+  Q_D(ctkErrorLogFDMessageHandler);
+  d->StdOutFDHandler->setMaximumPendingMessageCount(count);
+  d->StdErrFDHandler->setMaximumPendingMessageCount(count);
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogFDMessageHandler::droppedMessageCount()const
+{
+  Q_D(const ctkErrorLogFDMessageHandler);
+  return d->StdOutFDHandler->DroppedMessageCount + d->StdErrFDHandler->DroppedMessageCount;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogFDMessageHandler::backpressureCount()const
+{
+  Q_D(const ctkErrorLogFDMessageHandler);
+  return d->StdOutFDHandler->BackpressureCount + d->StdErrFDHandler->BackpressureCount;
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogFDMessageHandler::resetCounters()
+{
+  Q_D(ctkErrorLogFDMessageHandler);
+  d->StdOutFDHandler->DroppedMessageCount = 0;
+  d->StdOutFDHandler->BackpressureCount = 0;
+  d->StdErrFDHandler->DroppedMessageCount = 0;
+  d->StdErrFDHandler->BackpressureCount = 0;
+}
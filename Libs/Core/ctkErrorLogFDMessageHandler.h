@@ -29,6 +29,11 @@ class ctkErrorLogFDMessageHandlerPrivate;
 
 //------------------------------------------------------------------------------
 /// \ingroup Core
+/// Capture the output written to the stdout and stderr file descriptors.
+///
+/// The output is read in large chunks by a dedicated thread and split into
+/// lines. A second thread delivers the lines to the error log model in batches,
+/// so that the threads writing the output never wait on the model.
 class CTK_CORE_EXPORT ctkErrorLogFDMessageHandler : public ctkErrorLogAbstractMessageHandler
 {
 public:
@@ -42,6 +47,33 @@ public:
   virtual QString handlerName()const;
   virtual void setEnabledInternal(bool value);
 
+  /// Pending lines are delivered once no output has been read for
+  /// \a msecs milliseconds. Default is 10.
+  int flushInterval()const;
+  void setFlushInterval(int msecs);
+
+  /// While output keeps arriving, pending lines are delivered at the latest
+  /// \a msecs milliseconds after the oldest of them has been read. Default is 100.
+  int maximumLatency()const;
+  void setMaximumLatency(int msecs);
+
+  /// Maximum number of lines waiting to be delivered, for each of stdout and
+  /// stderr. Lines read while this limit is reached are dropped.
+  /// Default is 100000.
+  /// \sa droppedMessageCount()
+  int maximumPendingMessageCount()const;
+  void setMaximumPendingMessageCount(int count);
+
+  /// Return the number of lines dropped because the delivery did not keep up.
+  int droppedMessageCount()const;
+
+  /// Return the number of times more output was waiting in the pipe than
+  /// could be read at once, i.e. the output was written faster than it was read.
+  int backpressureCount()const;
+
+  /// Reset droppedMessageCount() and backpressureCount() to 0.
+  void resetCounters();
+
 protected:
   QScopedPointer<ctkErrorLogFDMessageHandlerPrivate> d_ptr;
 
@@ -22,8 +22,12 @@
 #define __ctkErrorLogFDMessageHandler_p_h
 
 // Qt includes
+#include <QAtomicInt>
 #include <QMutex>
+#include <QStringList>
 #include <QThread>
+#include <QTime>
+#include <QWaitCondition>
 
 // CTK includes
 #include "ctkErrorLogModel.h"
@@ -32,6 +36,25 @@
 #include <cstdio>
 
 class ctkErrorLogFDMessageHandler;
+class ctkFDHandler;
+
+// --------------------------------------------------------------------------
+// ctkFDHandlerDispatcher
+
+// --------------------------------------------------------------------------
+/// \ingroup Core
+/// Thread delivering the lines read by a ctkFDHandler in batches.
+class ctkFDHandlerDispatcher : public QThread
+{
+public:
+  ctkFDHandlerDispatcher(ctkFDHandler* fdHandler);
+
+protected:
+  void run();
+
+private:
+  ctkFDHandler * FDHandler;
+};
 
 // --------------------------------------------------------------------------
 // ctkFDHandler
@@ -58,9 +81,36 @@ public:
 
   FILE* terminalOutputFile();
 
+  int flushInterval()const;
+  void setFlushInterval(int msecs);
+
+  int maximumLatency()const;
+  void setMaximumLatency(int msecs);
+
+  int maximumPendingMessageCount()const;
+  void setMaximumPendingMessageCount(int count);
+
+  /// Queue \a lines for delivery. Lines exceeding the maximum pending
+  /// message count are dropped. Called by the reading thread.
+  void appendPendingLines(const QStringList& lines);
+
+  /// Wait until pending lines should be delivered and move them to \a lines.
+  /// Return false once the dispatching is stopped and all lines have been taken.
+  /// Called by the dispatcher thread.
+  bool takePendingLines(QStringList& lines);
+
+  /// Forward \a lines to the message handler.
+  void deliver(const QString& threadId, const QStringList& lines);
+
+  QAtomicInt DroppedMessageCount;
+  QAtomicInt BackpressureCount;
+
 protected:
   void setupPipe();
 
+  void startDispatching();
+  void stopDispatching();
+
   void run();
 
 private:
@@ -78,6 +128,17 @@ private:
 
   mutable QMutex EnableMutex;
   bool Enabled;
+
+  ctkFDHandlerDispatcher Dispatcher;
+
+  mutable QMutex PendingMutex;
+  QWaitCondition PendingCondition;
+  QStringList PendingLines;
+  QTime FirstPendingLineTime;
+  bool Dispatching;
+  int FlushInterval;
+  int MaximumLatency;
+  int MaximumPendingMessageCount;
 };
 
 
@@ -19,7 +19,9 @@
 =========================================================================*/
 
 // Qt includes
+#include <QAbstractTableModel>
 #include <QApplication>
+#include <QAtomicPointer>
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
@@ -28,8 +30,9 @@
 #include <QMetaType>
 #include <QMutexLocker>
 #include <QPointer>
-#include <QStandardItem>
 #include <QStatusBar>
+#include <QThread>
+#include <QVector>
 
 // CTK includes
 #include "ctkErrorLogModel.h"
@@ -172,6 +175,265 @@ void ctkErrorLogTerminalOutput::output(const QString& text)
   }
 }
 
+// --------------------------------------------------------------------------
+// ctkErrorLogEntry
+
+// --------------------------------------------------------------------------
+/// Compact representation of a log entry. The cells displayed by the views
+/// are only formatted when requested in ctkErrorLogTableModel::data().
+struct ctkErrorLogEntry
+{
+  QDateTime DateTime;
+  QString ThreadId;
+  ctkErrorLogLevel::LogLevel LogLevel;
+  QString Origin;
+  /// Messages grouped with the first one are appended to the text.
+  QString Text;
+  int FirstTextLength;
+};
+
+// --------------------------------------------------------------------------
+/// Node of the lock-free stack used by ctkErrorLogModel::postEntry().
+struct ctkErrorLogPendingEntry
+{
+  ctkErrorLogEntry Entry;
+  ctkErrorLogPendingEntry* Next;
+};
+
+// --------------------------------------------------------------------------
+// ctkErrorLogTableModel
+
+// --------------------------------------------------------------------------
+/// Table model storing the log entries in a ring buffer. If the capacity is 0,
+/// the buffer grows without limit.
+class ctkErrorLogTableModel : public QAbstractTableModel
+{
+public:
+  ctkErrorLogTableModel();
+
+  virtual int rowCount(const QModelIndex& parent = QModelIndex()) const;
+  virtual int columnCount(const QModelIndex& parent = QModelIndex()) const;
+  virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+  virtual Qt::ItemFlags flags(const QModelIndex& index) const;
+
+  int capacity() const;
+  void setCapacity(int capacity);
+
+  /// Append \a entries as new rows. If the capacity is exceeded, the oldest
+  /// rows are removed first.
+  void appendEntries(const QList<ctkErrorLogEntry>& entries);
+
+  /// Return the entry of the last row or 0 if the model is empty.
+  ctkErrorLogEntry* lastEntry();
+
+  /// Notify the views that the entry returned by lastEntry() has been modified.
+  void lastEntryChanged();
+
+  void clear();
+
+private:
+  int physicalIndex(int row) const;
+
+  QVector<ctkErrorLogEntry> Entries;
+  int First;
+  int Count;
+  int Capacity;
+};
+
+// --------------------------------------------------------------------------
+ctkErrorLogTableModel::ctkErrorLogTableModel()
+  : First(0), Count(0), Capacity(0)
+{
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogTableModel::physicalIndex(int row) const
+{
+  return this->Capacity > 0 ? (this->First + row) % this->Capacity : row;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogTableModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : this->Count;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogTableModel::columnCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : ctkErrorLogModel::MaxColumn + 1;
+}
+
+// --------------------------------------------------------------------------
+QVariant ctkErrorLogTableModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid() || index.row() >= this->Count)
+    {
+    return QVariant();
+    }
+  const ctkErrorLogEntry& entry = this->Entries.at(this->physicalIndex(index.row()));
+
+  if (role == Qt::DisplayRole || role == Qt::EditRole)
+    {
+    switch (index.column())
+      {
+      case ctkErrorLogModel::TimeColumn:
+        return entry.DateTime.toString("dd.MM.yyyy hh:mm:ss");
+      case ctkErrorLogModel::ThreadIdColumn:
+        return entry.ThreadId;
+      case ctkErrorLogModel::LogLevelColumn:
+        return ctkErrorLogLevel::logLevelAsString(entry.LogLevel);
+      case ctkErrorLogModel::OriginColumn:
+        return entry.Origin;
+      case ctkErrorLogModel::DescriptionColumn:
+        {
+        QString displayText = entry.Text.left(qMin(160, entry.FirstTextLength));
+        // Append '...' if the text is truncated or if entries have been grouped
+        if (entry.FirstTextLength > 160 || entry.Text.size() > entry.FirstTextLength)
+          {
+          displayText.append("...");
+          }
+        return displayText;
+        }
+      default:
+        return QVariant();
+      }
+    }
+  else if (role == ctkErrorLogModel::DescriptionTextRole
+           && index.column() == ctkErrorLogModel::DescriptionColumn)
+    {
+    return entry.Text;
+    }
+  return QVariant();
+}
+
+// --------------------------------------------------------------------------
+Qt::ItemFlags ctkErrorLogTableModel::flags(const QModelIndex& index) const
+{
+  if (!index.isValid())
+    {
+    return Qt::NoItemFlags;
+    }
+  return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+// --------------------------------------------------------------------------
+int ctkErrorLogTableModel::capacity() const
+{
+  return this->Capacity;
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogTableModel::setCapacity(int capacity)
+{
+  capacity = qMax(0, capacity);
+  if (capacity == this->Capacity)
+    {
+    return;
+    }
+
+  this->beginResetModel();
+  // Keep the most recent entries and store them starting at index 0
+  int keep = capacity > 0 ? qMin(this->Count, capacity) : this->Count;
+  QVector<ctkErrorLogEntry> entries;
+  entries.reserve(keep);
+  for (int row = this->Count - keep; row < this->Count; ++row)
+    {
+    entries.append(this->Entries.at(this->physicalIndex(row)));
+    }
+  this->Entries = entries;
+  this->First = 0;
+  this->Count = keep;
+  this->Capacity = capacity;
+  this->endResetModel();
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogTableModel::appendEntries(const QList<ctkErrorLogEntry>& entries)
+{
+  int offset = 0;
+  int count = entries.count();
+  if (this->Capacity > 0 && count > this->Capacity)
+    {
+    // Entries that would be removed right away are not inserted at all
+    offset = count - this->Capacity;
+    count = this->Capacity;
+    }
+  if (count == 0)
+    {
+    return;
+    }
+
+  if (this->Capacity > 0)
+    {
+    int overflow = this->Count + count - this->Capacity;
+    if (overflow > 0)
+      {
+      this->beginRemoveRows(QModelIndex(), 0, overflow - 1);
+      for (int row = 0; row < overflow; ++row)
+        {
+        // Release the strings right away
+        this->Entries[this->physicalIndex(row)] = ctkErrorLogEntry();
+        }
+      this->First = (this->First + overflow) % this->Capacity;
+      this->Count -= overflow;
+      this->endRemoveRows();
+      }
+    }
+
+  this->beginInsertRows(QModelIndex(), this->Count, this->Count + count - 1);
+  for (int i = offset; i < entries.count(); ++i)
+    {
+    int index = this->physicalIndex(this->Count);
+    if (index == this->Entries.size())
+      {
+      this->Entries.append(entries.at(i));
+      }
+    else
+      {
+      this->Entries[index] = entries.at(i);
+      }
+    ++this->Count;
+    }
+  this->endInsertRows();
+}
+
+// --------------------------------------------------------------------------
+ctkErrorLogEntry* ctkErrorLogTableModel::lastEntry()
+{
+  if (this->Count == 0)
+    {
+    return 0;
+    }
+  return &this->Entries[this->physicalIndex(this->Count - 1)];
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogTableModel::lastEntryChanged()
+{
+  if (this->Count == 0)
+    {
+    return;
+    }
+  QModelIndex lastRowDescriptionIndex =
+      this->index(this->Count - 1, ctkErrorLogModel::DescriptionColumn);
+  emit this->dataChanged(lastRowDescriptionIndex, lastRowDescriptionIndex);
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogTableModel::clear()
+{
+  if (this->Count == 0)
+    {
+    return;
+    }
+  this->beginRemoveRows(QModelIndex(), 0, this->Count - 1);
+  this->Entries.clear();
+  this->First = 0;
+  this->Count = 0;
+  this->endRemoveRows();
+}
+
 // --------------------------------------------------------------------------
 // ctkErrorLogModelPrivate
 
@@ -192,7 +454,27 @@ public:
 
   void setMessageHandlerConnection(ctkErrorLogAbstractMessageHandler * msgHandler, bool asynchronous);
 
-  QStandardItemModel StandardItemModel;
+  /// Add \a entries to the table model, grouping them if needed.
+  /// \sa ctkErrorLogModel::addEntry()
+  void addEntries(const QList<ctkErrorLogEntry>& entries);
+
+  /// Add all the entries queued by ctkErrorLogModel::postEntry().
+  void addPendingEntries();
+
+  /// Queue the chain of entries from \a first (most recent) to \a last
+  /// (oldest) with a single atomic operation.
+  void pushPendingEntries(ctkErrorLogPendingEntry* first, ctkErrorLogPendingEntry* last);
+
+  static ctkErrorLogPendingEntry* newPendingEntry(const QDateTime& currentDateTime, const QString& threadId,
+                                                  ctkErrorLogLevel::LogLevel logLevel,
+                                                  const QString& origin, const QString& text);
+
+  static QEvent::Type addPendingEntriesEventType();
+
+  ctkErrorLogTableModel TableModel;
+
+  /// Entries posted from any thread, most recent first.
+  QAtomicPointer<ctkErrorLogPendingEntry> PendingEntries;
 
   QHash<QString, ctkErrorLogAbstractMessageHandler*> RegisteredHandlers;
 
@@ -215,9 +497,8 @@ public:
 
 // --------------------------------------------------------------------------
 ctkErrorLogModelPrivate::ctkErrorLogModelPrivate(ctkErrorLogModel& object)
-  : q_ptr(&object)
+  : q_ptr(&object), PendingEntries(0)
 {
-  this->StandardItemModel.setColumnCount(ctkErrorLogModel::MaxColumn);
   this->LogEntryGrouping = false;
   this->AsynchronousLogging = true;
   this->AddingEntry = false;
@@ -234,6 +515,14 @@ ctkErrorLogModelPrivate::~ctkErrorLogModelPrivate()
     msgHandler->setEnabled(false);
     delete msgHandler;
     }
+
+  ctkErrorLogPendingEntry* pendingEntry = this->PendingEntries.fetchAndStoreAcquire(0);
+  while (pendingEntry)
+    {
+    ctkErrorLogPendingEntry* next = pendingEntry->Next;
+    delete pendingEntry;
+    pendingEntry = next;
+    }
 }
 
 // --------------------------------------------------------------------------
@@ -244,7 +533,7 @@ void ctkErrorLogModelPrivate::init()
   //
   // WARNING - Using a QSortFilterProxyModel slows down the insertion of rows by a factor 10
   //
-  q->setSourceModel(&this->StandardItemModel);
+  q->setSourceModel(&this->TableModel);
   q->setFilterKeyColumn(ctkErrorLogModel::LogLevelColumn);
 }
 
@@ -267,12 +556,146 @@ void ctkErrorLogModelPrivate::setMessageHandlerConnection(
 
   msgHandler->disconnect();
 
-  QObject::connect(msgHandler,
-        SIGNAL(messageHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
-        q, SLOT(addEntry(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
-        asynchronous ? Qt::QueuedConnection : Qt::BlockingQueuedConnection);
+  // In asynchronous mode, the messages are directly posted from the thread
+  // that handled them and added in batches by the model thread.
+  if (asynchronous)
+    {
+    QObject::connect(msgHandler,
+          SIGNAL(messageHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
+          q, SLOT(postEntry(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
+          Qt::DirectConnection);
+    QObject::connect(msgHandler,
+          SIGNAL(messagesHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QStringList)),
+          q, SLOT(postEntries(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QStringList)),
+          Qt::DirectConnection);
+    }
+  else
+    {
+    QObject::connect(msgHandler,
+          SIGNAL(messageHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
+          q, SLOT(addEntry(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QString)),
+          Qt::BlockingQueuedConnection);
+    // A batch of messages blocks the handling thread only once
+    QObject::connect(msgHandler,
+          SIGNAL(messagesHandled(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QStringList)),
+          q, SLOT(addEntries(QDateTime,QString,ctkErrorLogLevel::LogLevel,QString,QStringList)),
+          Qt::BlockingQueuedConnection);
+    }
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogModelPrivate::addEntries(const QList<ctkErrorLogEntry>& entries)
+{
+  int groupingIntervalInMsecs = 1000;
+
+  QList<ctkErrorLogEntry> newEntries;
+  bool lastEntryChanged = false;
+  foreach(const ctkErrorLogEntry& entry, entries)
+    {
+    ctkErrorLogEntry* lastEntry =
+        newEntries.isEmpty() ? this->TableModel.lastEntry() : &newEntries.last();
+
+    bool groupEntry = this->LogEntryGrouping && lastEntry
+        && entry.ThreadId == lastEntry->ThreadId
+        && entry.LogLevel == lastEntry->LogLevel
+        && entry.Origin == lastEntry->Origin
+        && lastEntry->DateTime.time().msecsTo(entry.DateTime.time()) <= groupingIntervalInMsecs;
+
+    if (groupEntry)
+      {
+      lastEntry->Text.append("\n").append(entry.Text);
+      lastEntryChanged = lastEntryChanged || newEntries.isEmpty();
+      }
+    else
+      {
+      newEntries << entry;
+      }
+    }
+
+  if (lastEntryChanged)
+    {
+    this->TableModel.lastEntryChanged();
+    }
+  this->TableModel.appendEntries(newEntries);
 }
 
+// --------------------------------------------------------------------------
+void ctkErrorLogModelPrivate::addPendingEntries()
+{
+  Q_Q(ctkErrorLogModel);
+
+  // Take all the queued entries at once and restore their posting order
+  ctkErrorLogPendingEntry* pendingEntry = this->PendingEntries.fetchAndStoreAcquire(0);
+  ctkErrorLogPendingEntry* reversedEntries = 0;
+  while (pendingEntry)
+    {
+    ctkErrorLogPendingEntry* next = pendingEntry->Next;
+    pendingEntry->Next = reversedEntries;
+    reversedEntries = pendingEntry;
+    pendingEntry = next;
+    }
+
+  QList<ctkErrorLogEntry> entries;
+  while (reversedEntries)
+    {
+    ctkErrorLogPendingEntry* next = reversedEntries->Next;
+    entries << reversedEntries->Entry;
+    delete reversedEntries;
+    reversedEntries = next;
+    }
+
+  this->AddingEntry = true;
+  this->addEntries(entries);
+  this->AddingEntry = false;
+
+  foreach(const ctkErrorLogEntry& entry, entries)
+    {
+    emit q->entryAdded(entry.LogLevel);
+    }
+}
+
+// --------------------------------------------------------------------------
+void ctkErrorLogModelPrivate::pushPendingEntries(ctkErrorLogPendingEntry* first,
+                                                 ctkErrorLogPendingEntry* last)
+{
+  Q_Q(ctkErrorLogModel);
+
+  ctkErrorLogPendingEntry* head = 0;
+  do
+    {
+    head = this->PendingEntries;
+    last->Next = head;
+    }
+  while (!this->PendingEntries.testAndSetRelease(head, first));
+
+  // Only the producer filling an empty queue schedules the batch insertion
+  if (!head)
+    {
+    QCoreApplication::postEvent(q, new QEvent(ctkErrorLogModelPrivate::addPendingEntriesEventType()));
+    }
+}
+
+// --------------------------------------------------------------------------
+ctkErrorLogPendingEntry* ctkErrorLogModelPrivate::newPendingEntry(
+    const QDateTime& currentDateTime, const QString& threadId,
+    ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QString& text)
+{
+  ctkErrorLogPendingEntry* pendingEntry = new ctkErrorLogPendingEntry;
+  pendingEntry->Entry.DateTime = currentDateTime;
+  pendingEntry->Entry.ThreadId = threadId;
+  pendingEntry->Entry.LogLevel = logLevel;
+  pendingEntry->Entry.Origin = origin;
+  pendingEntry->Entry.Text = text;
+  pendingEntry->Entry.FirstTextLength = text.size();
+  return pendingEntry;
+}
+
+// --------------------------------------------------------------------------
+QEvent::Type ctkErrorLogModelPrivate::addPendingEntriesEventType()
+{
+  static QEvent::Type eventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+  return eventType;
+}
 // --------------------------------------------------------------------------
 // ctkErrorLogModel methods
 
@@ -409,6 +832,20 @@ void ctkErrorLogModel::setTerminalOutputs(
   d->StdOutTerminalOutput.setEnabled(terminalOutput & ctkErrorLogModel::StandardError);
 }
 
+//------------------------------------------------------------------------------
+int ctkErrorLogModel::maximumEntryCount()const
+{
+  Q_D(const ctkErrorLogModel);
+  return d->TableModel.capacity();
+}
+
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::setMaximumEntryCount(int count)
+{
+  Q_D(ctkErrorLogModel);
+  d->TableModel.setCapacity(count);
+}
+
 //------------------------------------------------------------------------------
 void ctkErrorLogModel::addEntry(const QDateTime& currentDateTime, const QString& threadId,
                                 ctkErrorLogLevel::LogLevel logLevel,
@@ -433,95 +870,122 @@ void ctkErrorLogModel::addEntry(const QDateTime& currentDateTime, const QString&
 
   d->AddingEntry = true;
 
-  QString timeFormat("dd.MM.yyyy hh:mm:ss");
+  ctkErrorLogEntry entry;
+  entry.DateTime = currentDateTime;
+  entry.ThreadId = threadId;
+  entry.LogLevel = logLevel;
+  entry.Origin = origin;
+  entry.Text = text;
+  entry.FirstTextLength = text.size();
+  d->addEntries(QList<ctkErrorLogEntry>() << entry);
 
-  bool groupEntry = false;
-  if (d->LogEntryGrouping)
-    {
-    int lastRowIndex = d->StandardItemModel.rowCount() - 1;
+  d->AddingEntry = false;
 
-    QString lastRowThreadId = this->logEntryData(lastRowIndex, Self::ThreadIdColumn).toString();
-    bool threadIdMatched = threadId == lastRowThreadId;
+  emit this->entryAdded(logLevel);
+}
 
-    QString lastRowLogLevel = this->logEntryData(lastRowIndex, Self::LogLevelColumn).toString();
-    bool logLevelMatched = d->ErrorLogLevel(logLevel) == lastRowLogLevel;
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::addEntries(const QDateTime& currentDateTime, const QString& threadId,
+                                  ctkErrorLogLevel::LogLevel logLevel,
+                                  const QString& origin, const QStringList& texts)
+{
+  Q_D(ctkErrorLogModel);
 
-    QString lastRowOrigin = this->logEntryData(lastRowIndex, Self::OriginColumn).toString();
-    bool originMatched = origin == lastRowOrigin;
+  if (d->AddingEntry || texts.isEmpty())
+    {
+    return;
+    }
 
-    QDateTime lastRowDateTime =
-        QDateTime::fromString(this->logEntryData(lastRowIndex, Self::TimeColumn).toString(), timeFormat);
-    int groupingIntervalInMsecs = 1000;
-    bool withinGroupingInterval = lastRowDateTime.time().msecsTo(currentDateTime.time()) <= groupingIntervalInMsecs;
+  d->AddingEntry = true;
 
-    groupEntry = threadIdMatched && logLevelMatched && originMatched && withinGroupingInterval;
+  QList<ctkErrorLogEntry> entries;
+  foreach(const QString& text, texts)
+    {
+    ctkErrorLogEntry entry;
+    entry.DateTime = currentDateTime;
+    entry.ThreadId = threadId;
+    entry.LogLevel = logLevel;
+    entry.Origin = origin;
+    entry.Text = text;
+    entry.FirstTextLength = text.size();
+    entries << entry;
     }
+  d->addEntries(entries);
 
-  if (!groupEntry)
-    {
-    QList<QStandardItem*> itemList;
+  d->AddingEntry = false;
 
-    // Time item
-    QStandardItem * timeItem = new QStandardItem(currentDateTime.toString(timeFormat));
-    timeItem->setEditable(false);
-    itemList << timeItem;
+  for (int i = 0; i < texts.count(); ++i)
+    {
+    emit this->entryAdded(logLevel);
+    }
+}
 
-    // ThreadId item
-    QStandardItem * threadIdItem = new QStandardItem(threadId);
-    threadIdItem->setEditable(false);
-    itemList << threadIdItem;
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::postEntry(const QDateTime& currentDateTime, const QString& threadId,
+                                 ctkErrorLogLevel::LogLevel logLevel,
+                                 const QString& origin, const QString& text)
+{
+  Q_D(ctkErrorLogModel);
 
-    // LogLevel item
-    QStandardItem * logLevelItem = new QStandardItem(d->ErrorLogLevel(logLevel));
-    logLevelItem->setEditable(false);
-    itemList << logLevelItem;
+  // Messages reported while entries are being added by the model thread
+  // are discarded, as done in addEntry().
+  if (QThread::currentThread() == this->thread() && d->AddingEntry)
+    {
+    return;
+    }
 
-    // Origin item
-    QStandardItem * originItem = new QStandardItem(origin);
-    originItem->setEditable(false);
-    itemList << originItem;
+  ctkErrorLogPendingEntry* pendingEntry =
+      ctkErrorLogModelPrivate::newPendingEntry(currentDateTime, threadId, logLevel, origin, text);
+  d->pushPendingEntries(pendingEntry, pendingEntry);
+}
 
-    // Description item
-    QStandardItem * descriptionItem = new QStandardItem();
-    QString descriptionText(text);
-    descriptionItem->setData(descriptionText.left(160).append((descriptionText.size() > 160) ? "..." : ""), Qt::DisplayRole);
-    descriptionItem->setData(descriptionText, ctkErrorLogModel::DescriptionTextRole);
-    descriptionItem->setEditable(false);
-    itemList << descriptionItem;
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::postEntries(const QDateTime& currentDateTime, const QString& threadId,
+                                   ctkErrorLogLevel::LogLevel logLevel,
+                                   const QString& origin, const QStringList& texts)
+{
+  Q_D(ctkErrorLogModel);
 
-    d->StandardItemModel.invisibleRootItem()->appendRow(itemList);
-    }
-  else
+  if (texts.isEmpty()
+      || (QThread::currentThread() == this->thread() && d->AddingEntry))
     {
-    // Retrieve description associated with last row
-    QModelIndex lastRowDescriptionIndex =
-        d->StandardItemModel.index(d->StandardItemModel.rowCount() - 1, ctkErrorLogModel::DescriptionColumn);
-
-    QStringList updatedDescription;
-    updatedDescription << lastRowDescriptionIndex.data(ctkErrorLogModel::DescriptionTextRole).toString();
-    updatedDescription << text;
-
-    d->StandardItemModel.setData(lastRowDescriptionIndex, updatedDescription.join("\n"),
-                                 ctkErrorLogModel::DescriptionTextRole);
+    return;
+    }
 
-    // Append '...' to displayText if needed
-    QString displayText = lastRowDescriptionIndex.data().toString();
-    if (!displayText.endsWith("..."))
+  // Chain the entries most recent first, as expected by the pending queue
+  ctkErrorLogPendingEntry* last = 0;
+  ctkErrorLogPendingEntry* first = 0;
+  foreach(const QString& text, texts)
+    {
+    ctkErrorLogPendingEntry* pendingEntry =
+        ctkErrorLogModelPrivate::newPendingEntry(currentDateTime, threadId, logLevel, origin, text);
+    pendingEntry->Next = first;
+    first = pendingEntry;
+    if (!last)
       {
-      d->StandardItemModel.setData(lastRowDescriptionIndex, displayText.append("..."), Qt::DisplayRole);
+      last = pendingEntry;
       }
     }
+  d->pushPendingEntries(first, last);
+}
 
-  d->AddingEntry = false;
-
-  emit this->entryAdded(logLevel);
+//------------------------------------------------------------------------------
+void ctkErrorLogModel::customEvent(QEvent* event)
+{
+  Q_D(ctkErrorLogModel);
+  if (event->type() == ctkErrorLogModelPrivate::addPendingEntriesEventType())
+    {
+    d->addPendingEntries();
+    return;
+    }
+  this->Superclass::customEvent(event);
 }
 
 //------------------------------------------------------------------------------
 void ctkErrorLogModel::clear()
 {
   Q_D(ctkErrorLogModel);
-  d->StandardItemModel.invisibleRootItem()->removeRows(0, d->StandardItemModel.rowCount());
+  d->TableModel.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -655,7 +1119,7 @@ QVariant ctkErrorLogModel::logEntryData(int row, int column, int role) const
     {
     return QVariant();
     }
-  QModelIndex rowDescriptionIndex = d->StandardItemModel.index(row, column);
+  QModelIndex rowDescriptionIndex = d->TableModel.index(row, column);
   return rowDescriptionIndex.data(role);
 }
 
@@ -669,7 +1133,7 @@ QString ctkErrorLogModel::logEntryDescription(int row) const
 int ctkErrorLogModel::logEntryCount()const
 {
   Q_D(const ctkErrorLogModel);
-  return d->StandardItemModel.rowCount();
+  return d->TableModel.rowCount();
 }
 
 // --------------------------------------------------------------------------
@@ -779,6 +1243,28 @@ void ctkErrorLogAbstractMessageHandler::handleMessage(const QString& threadId,
   emit this->messageHandled(QDateTime::currentDateTime(), threadId, logLevel, origin, text);
 }
 
+// --------------------------------------------------------------------------
+void ctkErrorLogAbstractMessageHandler::handleMessages(const QString& threadId,
+                                                       ctkErrorLogLevel::LogLevel logLevel,
+                                                       const QString& origin, const QStringList& texts)
+{
+  Q_D(ctkErrorLogAbstractMessageHandler);
+  if (texts.isEmpty())
+    {
+    return;
+    }
+  ctkErrorLogTerminalOutput* terminalOutput = d->TerminalOutputs.value(
+        logLevel <= ctkErrorLogLevel::Info ? ctkErrorLogModel::StandardOutput : ctkErrorLogModel::StandardError);
+  if (terminalOutput)
+    {
+    foreach(const QString& text, texts)
+      {
+      terminalOutput->output(text);
+      }
+    }
+  emit this->messagesHandled(QDateTime::currentDateTime(), threadId, logLevel, origin, texts);
+}
+
 // --------------------------------------------------------------------------
 ctkErrorLogTerminalOutput* ctkErrorLogAbstractMessageHandler::terminalOutput(
     ctkErrorLogModel::TerminalOutput terminalOutputType)const
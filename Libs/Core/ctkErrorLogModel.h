@@ -98,6 +98,7 @@ class CTK_CORE_EXPORT ctkErrorLogModel : public QSortFilterProxyModel
   Q_PROPERTY(bool logEntryGrouping READ logEntryGrouping WRITE setLogEntryGrouping)
   Q_PROPERTY(TerminalOutput terminalOutputs READ terminalOutputs WRITE  setTerminalOutputs)
   Q_PROPERTY(bool asynchronousLogging READ asynchronousLogging WRITE  setAsynchronousLogging)
+  Q_PROPERTY(int maximumEntryCount READ maximumEntryCount WRITE setMaximumEntryCount)
 public:
   typedef QSortFilterProxyModel Superclass;
   typedef ctkErrorLogModel Self;
@@ -167,6 +168,16 @@ public:
   bool asynchronousLogging()const;
   void setAsynchronousLogging(bool value);
 
+  /// Return the maximum number of log entries kept by the model.
+  /// 0 (the default) means the number of entries is not limited.
+  /// \sa setMaximumEntryCount()
+  int maximumEntryCount()const;
+
+  /// Keep at most \a count log entries. Entries are stored in a ring buffer,
+  /// once it is full the oldest entries are removed when new ones are added.
+  /// Setting a value of 0 removes the limit.
+  void setMaximumEntryCount(int count);
+
   /// Return log entry information associated with \a row and \a column.
   /// \internal
   QVariant logEntryData(int row,
@@ -190,6 +201,23 @@ public Q_SLOTS:
   void addEntry(const QDateTime& currentDateTime, const QString& threadId,
                 ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QString& text);
 
+  /// Queue an entry for addition. This method is thread-safe and does not block:
+  /// entries posted from any thread are collected in a lock-free queue and added
+  /// in batches when control returns to the event loop of the model thread.
+  /// \sa addEntry(), asynchronousLogging()
+  void postEntry(const QDateTime& currentDateTime, const QString& threadId,
+                 ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QString& text);
+
+  /// Add an entry for each of \a texts in a single batch.
+  /// \sa addEntry()
+  void addEntries(const QDateTime& currentDateTime, const QString& threadId,
+                  ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QStringList& texts);
+
+  /// Queue an entry for each of \a texts with a single atomic operation.
+  /// \sa postEntry()
+  void postEntries(const QDateTime& currentDateTime, const QString& threadId,
+                   ctkErrorLogLevel::LogLevel logLevel, const QString& origin, const QStringList& texts);
+
 Q_SIGNALS:
   void logLevelFilterChanged();
 
@@ -197,6 +225,8 @@ Q_SIGNALS:
   void entryAdded(ctkErrorLogLevel::LogLevel logLevel);
 
 protected:
+  virtual void customEvent(QEvent* event);
+
   QScopedPointer<ctkErrorLogModelPrivate> d_ptr;
 
 private:
@@ -229,6 +259,11 @@ public:
   void handleMessage(const QString& threadId, ctkErrorLogLevel::LogLevel logLevel,
                      const QString& origin, const QString& text);
 
+  /// Handle several messages at once. The model adds them in a single batch,
+  /// which in synchronous mode blocks the calling thread only once.
+  void handleMessages(const QString& threadId, ctkErrorLogLevel::LogLevel logLevel,
+                      const QString& origin, const QStringList& texts);
+
   ctkErrorLogTerminalOutput* terminalOutput(ctkErrorLogModel::TerminalOutput terminalOutputType)const;
   void setTerminalOutput(ctkErrorLogModel::TerminalOutput terminalOutputType,
                          ctkErrorLogTerminalOutput * terminalOutput);
@@ -237,6 +272,9 @@ Q_SIGNALS:
   void messageHandled(const QDateTime& currentDateTime, const QString& threadId,
                       ctkErrorLogLevel::LogLevel logLevel, const QString& origin,
                       const QString& text);
+  void messagesHandled(const QDateTime& currentDateTime, const QString& threadId,
+                       ctkErrorLogLevel::LogLevel logLevel, const QString& origin,
+                       const QStringList& texts);
 
 protected:
   void setHandlerPrettyName(const QString& newHandlerPrettyName);
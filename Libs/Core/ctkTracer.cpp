@@ -0,0 +1,649 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QFile>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadStorage>
+#include <QVariant>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+#include "ctkTracer.h"
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+struct ctkTraceEvent
+{
+  const char* Category;
+  const char* Name; // 0 if the name is OwnedName
+  qint64 Start;
+  qint64 Value; // duration of a span or delta of a counter
+  bool IsCounter;
+  QString OwnedName;
+  QVariantMap Args;
+};
+
+//----------------------------------------------------------------------------
+QString ctkTraceEventName(const ctkTraceEvent& event)
+{
+  return event.Name ? QString::fromUtf8(event.Name) : event.OwnedName;
+}
+
+//----------------------------------------------------------------------------
+bool ctkTraceEventLessThan(const ctkTraceEvent& event1, const ctkTraceEvent& event2)
+{
+  return event1.Start < event2.Start;
+}
+
+//----------------------------------------------------------------------------
+// Events recorded by a single thread. The mutex is only contended when
+// the tracer collects or clears the events.
+struct ctkTraceBuffer
+{
+  ctkTraceBuffer()
+    : ThreadId(reinterpret_cast<quintptr>(QThread::currentThreadId()))
+    , Retired(false)
+    , DroppedEventCount(0)
+  {
+  }
+
+  QMutex Mutex;
+  QVector<ctkTraceEvent> Events;
+  /// Sum of the deltas of each counter, kept even when Events is full
+  QHash<const char*, qint64> CounterTotals;
+  quintptr ThreadId;
+  bool Retired; // the thread has finished
+  qint64 DroppedEventCount;
+};
+
+typedef QSharedPointer<ctkTraceBuffer> ctkTraceBufferPointer;
+
+//----------------------------------------------------------------------------
+// Owned by the QThreadStorage, flags the buffer when its thread finishes.
+// The buffer itself is kept by the tracer until it is cleared.
+struct ctkTraceBufferHolder
+{
+  ~ctkTraceBufferHolder()
+  {
+    QMutexLocker lock(&this->Buffer->Mutex);
+    this->Buffer->Retired = true;
+  }
+
+  ctkTraceBufferPointer Buffer;
+};
+
+const int HistogramSize = 32;
+
+//----------------------------------------------------------------------------
+int histogramBucket(qint64 duration)
+{
+  int bucket = 0;
+  while (duration > 0 && bucket < HistogramSize - 1)
+    {
+    duration >>= 1;
+    ++bucket;
+    }
+  return bucket;
+}
+
+//----------------------------------------------------------------------------
+QString jsonString(const QString& str)
+{
+  QString result;
+  result.reserve(str.size() + 2);
+  result += '"';
+  for (int i = 0; i < str.size(); ++i)
+    {
+    const QChar c = str.at(i);
+    switch (c.unicode())
+      {
+      case '"':  result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\r': result += "\\r"; break;
+      case '\t': result += "\\t"; break;
+      default:
+        if (c.unicode() < 0x20)
+          {
+          result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+          }
+        else
+          {
+          result += c;
+          }
+      }
+    }
+  result += '"';
+  return result;
+}
+
+//----------------------------------------------------------------------------
+QString jsonValue(const QVariant& value)
+{
+  switch (value.type())
+    {
+    case QVariant::Bool:
+      return value.toBool() ? "true" : "false";
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+    case QVariant::Double:
+      return value.toString();
+    case QVariant::List:
+    case QVariant::StringList:
+      {
+      QStringList items;
+      foreach(const QVariant& item, value.toList())
+        {
+        items << jsonValue(item);
+        }
+      return "[" + items.join(",") + "]";
+      }
+    case QVariant::Map:
+      {
+      QStringList members;
+      QVariantMap map = value.toMap();
+      for (QVariantMap::const_iterator it = map.constBegin(); it != map.constEnd(); ++it)
+        {
+        members << jsonString(it.key()) + ":" + jsonValue(it.value());
+        }
+      return "{" + members.join(",") + "}";
+      }
+    default:
+      return jsonString(value.toString());
+    }
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+class ctkTracerPrivate
+{
+public:
+  ctkTracerPrivate();
+
+  /// Buffer of the calling thread, created on first use.
+  ctkTraceBuffer* currentBuffer();
+
+  /// Append the event to the buffer of the calling thread unless it is full.
+  void record(const ctkTraceEvent& event);
+
+  /// Copy of the events of all threads, grouped by thread id.
+  QList<QPair<quintptr, QVector<ctkTraceEvent> > > events()const;
+
+  QMap<QString, ctkTracer::SpanStatistics> computeSpanStatistics()const;
+
+  mutable ctkHighPrecisionTimer Timer;
+
+  QThreadStorage<ctkTraceBufferHolder*> CurrentBuffer;
+
+  mutable QMutex BuffersMutex;
+  QList<ctkTraceBufferPointer> Buffers;
+
+  QAtomicInt MaximumEventCount;
+
+  /// Written when the tracer is destroyed, see CTK_TRACE_FILE
+  QString TraceFile;
+};
+
+//----------------------------------------------------------------------------
+// ctkTracerPrivate methods
+
+//----------------------------------------------------------------------------
+ctkTracerPrivate::ctkTracerPrivate()
+  : MaximumEventCount(262144)
+{
+  this->Timer.start();
+}
+
+//----------------------------------------------------------------------------
+ctkTraceBuffer* ctkTracerPrivate::currentBuffer()
+{
+  if (!this->CurrentBuffer.hasLocalData())
+    {
+    ctkTraceBufferHolder* holder = new ctkTraceBufferHolder;
+    holder->Buffer = ctkTraceBufferPointer(new ctkTraceBuffer);
+    this->CurrentBuffer.setLocalData(holder);
+
+    QMutexLocker lock(&this->BuffersMutex);
+    this->Buffers.push_back(holder->Buffer);
+    }
+  return this->CurrentBuffer.localData()->Buffer.data();
+}
+
+//----------------------------------------------------------------------------
+void ctkTracerPrivate::record(const ctkTraceEvent& event)
+{
+  ctkTraceBuffer* buffer = this->currentBuffer();
+  const int maximumEventCount = this->MaximumEventCount;
+  QMutexLocker lock(&buffer->Mutex);
+  if (event.IsCounter)
+    {
+    buffer->CounterTotals[event.Name] += event.Value;
+    }
+  if (maximumEventCount > 0 && buffer->Events.size() >= maximumEventCount)
+    {
+    ++buffer->DroppedEventCount;
+    return;
+    }
+  buffer->Events.push_back(event);
+}
+
+//----------------------------------------------------------------------------
+QList<QPair<quintptr, QVector<ctkTraceEvent> > > ctkTracerPrivate::events()const
+{
+  QList<ctkTraceBufferPointer> buffers;
+  {
+    QMutexLocker lock(&this->BuffersMutex);
+    buffers = this->Buffers;
+  }
+
+  QList<QPair<quintptr, QVector<ctkTraceEvent> > > events;
+  foreach(const ctkTraceBufferPointer& buffer, buffers)
+    {
+    QMutexLocker lock(&buffer->Mutex);
+    events.push_back(qMakePair(buffer->ThreadId, buffer->Events));
+    }
+  return events;
+}
+
+//----------------------------------------------------------------------------
+QMap<QString, ctkTracer::SpanStatistics> ctkTracerPrivate::computeSpanStatistics()const
+{
+  QMap<QString, ctkTracer::SpanStatistics> statistics;
+  // Names are usually string literals, avoid converting them for each event
+  QHash<const char*, ctkTracer::SpanStatistics*> statisticsByName;
+
+  typedef QPair<quintptr, QVector<ctkTraceEvent> > ThreadEvents;
+  foreach(const ThreadEvents& threadEvents, this->events())
+    {
+    foreach(const ctkTraceEvent& event, threadEvents.second)
+      {
+      if (event.IsCounter)
+        {
+        continue;
+        }
+      ctkTracer::SpanStatistics* stats = event.Name ? statisticsByName.value(event.Name, 0) : 0;
+      if (!stats)
+        {
+        QString name = ctkTraceEventName(event);
+        stats = &statistics[name];
+        stats->Name = name;
+        if (event.Name)
+          {
+          statisticsByName.insert(event.Name, stats);
+          }
+        }
+      if (stats->Count == 0 || event.Value < stats->MinimumTime)
+        {
+        stats->MinimumTime = event.Value;
+        }
+      stats->MaximumTime = qMax(stats->MaximumTime, event.Value);
+      stats->TotalTime += event.Value;
+      ++stats->Count;
+      ++stats->Histogram[histogramBucket(event.Value)];
+      }
+    }
+  return statistics;
+}
+
+//----------------------------------------------------------------------------
+// ctkTracer::SpanStatistics methods
+
+//----------------------------------------------------------------------------
+ctkTracer::SpanStatistics::SpanStatistics()
+  : Count(0)
+  , TotalTime(0)
+  , MinimumTime(0)
+  , MaximumTime(0)
+  , Histogram(HistogramSize, 0)
+{
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkTracer::SpanStatistics::meanTime()const
+{
+  return this->Count > 0 ? this->TotalTime / this->Count : 0;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkTracer::SpanStatistics::percentileTime(double fraction)const
+{
+  if (this->Count == 0)
+    {
+    return 0;
+    }
+  int threshold = qBound(1, static_cast<int>(std::ceil(fraction * this->Count)), this->Count);
+  int count = 0;
+  for (int bucket = 0; bucket < this->Histogram.size(); ++bucket)
+    {
+    count += this->Histogram[bucket];
+    if (count >= threshold)
+      {
+      qint64 upperBound = bucket == 0 ? 0 : (Q_INT64_C(1) << bucket) - 1;
+      return qBound(this->MinimumTime, upperBound, this->MaximumTime);
+      }
+    }
+  return this->MaximumTime;
+}
+
+//----------------------------------------------------------------------------
+// ctkTracer methods
+
+QBasicAtomicInt ctkTracer::Enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+CTK_SINGLETON_DEFINE(ctkTracer)
+
+//----------------------------------------------------------------------------
+ctkTracer::ctkTracer()
+  : d_ptr(new ctkTracerPrivate)
+{
+  Q_D(ctkTracer);
+  d->TraceFile = QString::fromLocal8Bit(qgetenv("CTK_TRACE_FILE"));
+  if (!d->TraceFile.isEmpty())
+    {
+    this->setEnabled(true);
+    }
+}
+
+//----------------------------------------------------------------------------
+ctkTracer::~ctkTracer()
+{
+  Q_D(ctkTracer);
+  Enabled.fetchAndStoreOrdered(0);
+  if (!d->TraceFile.isEmpty())
+    {
+    this->writeTraceEvents(d->TraceFile);
+    }
+}
+
+//----------------------------------------------------------------------------
+ctkTracer* ctkTracer::instance()
+{
+  return Self::Instance;
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::setEnabled(bool enable)
+{
+  Enabled.fetchAndStoreOrdered(enable ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkTracer::now()const
+{
+  Q_D(const ctkTracer);
+  return d->Timer.elapsedMicro();
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::addSpan(const char* category, const char* name, qint64 start, qint64 end)
+{
+  Q_D(ctkTracer);
+  ctkTraceEvent event = { category, name, start, end - start, false, QString(), QVariantMap() };
+  d->record(event);
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::addSpan(const char* category, const QString& name, qint64 start, qint64 end,
+                        const QVariantMap& args)
+{
+  Q_D(ctkTracer);
+  ctkTraceEvent event = { category, 0, start, end - start, false, name, args };
+  d->record(event);
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::addCounter(const char* name, qint64 delta)
+{
+  Q_D(ctkTracer);
+  ctkTraceEvent event = { "counter", name, this->now(), delta, true, QString(), QVariantMap() };
+  d->record(event);
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkTracer::counter(const QString& name)const
+{
+  return this->counters().value(name, 0);
+}
+
+//----------------------------------------------------------------------------
+QHash<QString, qint64> ctkTracer::counters()const
+{
+  Q_D(const ctkTracer);
+  QList<ctkTraceBufferPointer> buffers;
+  {
+    QMutexLocker lock(&d->BuffersMutex);
+    buffers = d->Buffers;
+  }
+
+  QHash<QString, qint64> counters;
+  foreach(const ctkTraceBufferPointer& buffer, buffers)
+    {
+    QMutexLocker lock(&buffer->Mutex);
+    QHash<const char*, qint64>::const_iterator it;
+    for (it = buffer->CounterTotals.constBegin(); it != buffer->CounterTotals.constEnd(); ++it)
+      {
+      counters[QString::fromUtf8(it.key())] += it.value();
+      }
+    }
+  return counters;
+}
+
+//----------------------------------------------------------------------------
+QList<ctkTracer::SpanStatistics> ctkTracer::spanStatistics()const
+{
+  Q_D(const ctkTracer);
+  return d->computeSpanStatistics().values();
+}
+
+//----------------------------------------------------------------------------
+ctkTracer::SpanStatistics ctkTracer::spanStatistics(const QString& name)const
+{
+  Q_D(const ctkTracer);
+  return d->computeSpanStatistics().value(name);
+}
+
+//----------------------------------------------------------------------------
+QString ctkTracer::summary()const
+{
+  QList<SpanStatistics> statistics = this->spanStatistics();
+  // Sort by decreasing total time
+  QMap<qint64, SpanStatistics> sortedStatistics;
+  foreach(const SpanStatistics& stats, statistics)
+    {
+    sortedStatistics.insertMulti(-stats.TotalTime, stats);
+    }
+
+  QString summary;
+  QTextStream out(&summary);
+  out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+         .arg("Name", -32).arg("Count", 8).arg("Total(us)", 12).arg("Mean(us)", 10)
+         .arg("Min(us)", 10).arg("Max(us)", 10).arg("P50(us)", 10).arg("P95(us)", 10);
+  foreach(const SpanStatistics& stats, sortedStatistics)
+    {
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+           .arg(stats.Name, -32).arg(stats.Count, 8).arg(stats.TotalTime, 12)
+           .arg(stats.meanTime(), 10).arg(stats.MinimumTime, 10).arg(stats.MaximumTime, 10)
+           .arg(stats.percentileTime(0.5), 10).arg(stats.percentileTime(0.95), 10);
+    }
+
+  QHash<QString, qint64> counters = this->counters();
+  QStringList counterNames = counters.keys();
+  counterNames.sort();
+  foreach(const QString& name, counterNames)
+    {
+    out << QString("%1 %2\n").arg(name, -32).arg(counters.value(name), 8);
+    }
+  out.flush();
+  return summary;
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::clear()
+{
+  Q_D(ctkTracer);
+  QMutexLocker lock(&d->BuffersMutex);
+  QList<ctkTraceBufferPointer>::iterator it = d->Buffers.begin();
+  while (it != d->Buffers.end())
+    {
+    QMutexLocker bufferLock(&(*it)->Mutex);
+    (*it)->Events.clear();
+    (*it)->CounterTotals.clear();
+    (*it)->DroppedEventCount = 0;
+    if ((*it)->Retired)
+      {
+      bufferLock.unlock();
+      it = d->Buffers.erase(it);
+      }
+    else
+      {
+      ++it;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void ctkTracer::setMaximumEventCount(int count)
+{
+  Q_D(ctkTracer);
+  d->MaximumEventCount.fetchAndStoreOrdered(qMax(0, count));
+}
+
+//----------------------------------------------------------------------------
+int ctkTracer::maximumEventCount()const
+{
+  Q_D(const ctkTracer);
+  return d->MaximumEventCount;
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkTracer::droppedEventCount()const
+{
+  Q_D(const ctkTracer);
+  QMutexLocker lock(&d->BuffersMutex);
+  qint64 count = 0;
+  foreach(const ctkTraceBufferPointer& buffer, d->Buffers)
+    {
+    QMutexLocker bufferLock(&buffer->Mutex);
+    count += buffer->DroppedEventCount;
+    }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+bool ctkTracer::writeTraceEvents(QIODevice* device, const QVariantMap& extraMembers)const
+{
+  Q_D(const ctkTracer);
+  if (!device || !device->isWritable())
+    {
+    return false;
+    }
+
+  const qint64 pid = QCoreApplication::applicationPid();
+
+  QTextStream out(device);
+  out.setCodec("UTF-8");
+  out << "{\"traceEvents\":[";
+
+  bool first = true;
+  QVector<ctkTraceEvent> counterEvents;
+  typedef QPair<quintptr, QVector<ctkTraceEvent> > ThreadEvents;
+  foreach(const ThreadEvents& threadEvents, d->events())
+    {
+    foreach(const ctkTraceEvent& event, threadEvents.second)
+      {
+      if (event.IsCounter)
+        {
+        counterEvents.push_back(event);
+        continue;
+        }
+      out << (first ? "" : ",")
+          << "\n{\"name\":" << jsonString(ctkTraceEventName(event))
+          << ",\"cat\":" << jsonString(QString::fromUtf8(event.Category))
+          << ",\"ph\":\"X\""
+          << ",\"ts\":" << event.Start
+          << ",\"dur\":" << event.Value
+          << ",\"pid\":" << pid
+          << ",\"tid\":" << threadEvents.first;
+      if (!event.Args.isEmpty())
+        {
+        out << ",\"args\":" << jsonValue(event.Args);
+        }
+      out << "}";
+      first = false;
+      }
+    }
+
+  // Counters are displayed with their value, accumulate the deltas of all
+  // threads in chronological order.
+  std::stable_sort(counterEvents.begin(), counterEvents.end(), ctkTraceEventLessThan);
+  QHash<QString, qint64> counterValues;
+  foreach(const ctkTraceEvent& event, counterEvents)
+    {
+    QString name = QString::fromUtf8(event.Name);
+    qint64& value = counterValues[name];
+    value += event.Value;
+    out << (first ? "" : ",")
+        << "\n{\"name\":" << jsonString(name)
+        << ",\"ph\":\"C\""
+        << ",\"ts\":" << event.Start
+        << ",\"pid\":" << pid
+        << ",\"args\":{\"value\":" << value << "}"
+        << "}";
+    first = false;
+    }
+
+  out << "\n],\"displayTimeUnit\":\"ms\"";
+  for (QVariantMap::const_iterator it = extraMembers.constBegin(); it != extraMembers.constEnd(); ++it)
+    {
+    out << "," << jsonString(it.key()) << ":" << jsonValue(it.value());
+    }
+  out << "}\n";
+  out.flush();
+
+  return out.status() == QTextStream::Ok;
+}
+
+//----------------------------------------------------------------------------
+bool ctkTracer::writeTraceEvents(const QString& fileName, const QVariantMap& extraMembers)const
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+    return false;
+    }
+  return this->writeTraceEvents(&file, extraMembers);
+}
@@ -0,0 +1,208 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+#ifndef __ctkTracer_h
+#define __ctkTracer_h
+
+// Qt includes
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+// CTK includes
+#include "ctkSingleton.h"
+#include "ctkCoreExport.h"
+
+class QIODevice;
+class ctkTracerPrivate;
+
+/// \ingroup Core
+/// Records named timed spans and counters.
+///
+/// Spans and counters are stored in per-thread buffers, recording an event
+/// only locks a mutex owned by the calling thread. When the tracer is
+/// disabled (the default), CTK_TRACE_SCOPE and CTK_TRACE_COUNTER only test
+/// a flag.
+///
+/// The recorded data can be written in the Chrome trace-event JSON format
+/// (see chrome://tracing) and summarized per span name to check for
+/// performance regressions in tests:
+/// \code
+/// ctkTracer::instance()->setEnabled(true);
+/// {
+///   CTK_TRACE_SCOPE("DICOM", "addDirectory");
+///   indexer.addDirectory(database, directory);
+/// }
+/// ctkTracer::SpanStatistics stats = ctkTracer::instance()->spanStatistics("addDirectory");
+/// \endcode
+///
+/// Setting the environment variable CTK_TRACE_FILE enables the tracer at
+/// startup. The trace is written to the given file at exit.
+///
+/// Each thread records at most maximumEventCount() events, later events
+/// are dropped (see droppedEventCount()) but counters stay exact.
+///
+/// \note Categories and names are not copied, they must be string literals
+/// or strings that outlive the tracer. Use the addSpan() overload taking a
+/// QString for names built at run time.
+class CTK_CORE_EXPORT ctkTracer
+{
+public:
+
+  /// Accumulated durations of all the spans sharing a name.
+  struct CTK_CORE_EXPORT SpanStatistics
+  {
+    SpanStatistics();
+
+    QString Name;
+    int Count;
+    qint64 TotalTime;   // in micro seconds
+    qint64 MinimumTime; // in micro seconds
+    qint64 MaximumTime; // in micro seconds
+    /// Histogram of the durations using power of two buckets:
+    /// Histogram[0] counts the spans shorter than 1us and Histogram[i]
+    /// the spans lasting between 2^(i-1) and 2^i - 1 us.
+    QVector<int> Histogram;
+
+    qint64 meanTime()const;
+
+    /// Estimate the duration below which the given fraction (between 0 and
+    /// 1) of the spans completed. The upper bound of the matching histogram
+    /// bucket is returned, clamped to MaximumTime.
+    qint64 percentileTime(double fraction)const;
+  };
+
+  static ctkTracer* instance();
+
+  /// Inlined so that the cost of the instrumentation stays negligible when
+  /// tracing is disabled.
+  static inline bool isEnabled();
+
+  void setEnabled(bool enable);
+
+  /// Micro seconds elapsed since the creation of the tracer.
+  qint64 now()const;
+
+  /// Record a span of the calling thread. start and end are given by now().
+  void addSpan(const char* category, const char* name, qint64 start, qint64 end);
+
+  /// Record a span whose name is built at run time. The arguments are
+  /// written in the "args" member of the trace event.
+  void addSpan(const char* category, const QString& name, qint64 start, qint64 end,
+               const QVariantMap& args = QVariantMap());
+
+  /// Add delta to the counter of the calling thread.
+  void addCounter(const char* name, qint64 delta);
+
+  /// Sum of the counter deltas of all the threads.
+  qint64 counter(const QString& name)const;
+  QHash<QString, qint64> counters()const;
+
+  QList<SpanStatistics> spanStatistics()const;
+  /// Return empty statistics (Count == 0) if no span has the given name.
+  SpanStatistics spanStatistics(const QString& name)const;
+
+  /// Human readable table of the span statistics, sorted by total time.
+  QString summary()const;
+
+  /// Discard all the recorded spans and counters.
+  void clear();
+
+  /// Maximum number of events recorded by each thread, 262144 by default.
+  /// 0 means unlimited.
+  void setMaximumEventCount(int count);
+  int maximumEventCount()const;
+
+  /// Number of events dropped because a thread buffer was full.
+  qint64 droppedEventCount()const;
+
+  /// Write all recorded data in the Chrome trace-event JSON format.
+  /// \a extraMembers are appended to the top-level object, e.g. to add
+  /// application specific statistics.
+  /// Return false if the device could not be written.
+  bool writeTraceEvents(QIODevice* device, const QVariantMap& extraMembers = QVariantMap())const;
+  bool writeTraceEvents(const QString& fileName, const QVariantMap& extraMembers = QVariantMap())const;
+
+protected:
+  ctkTracer();
+  virtual ~ctkTracer();
+
+  QScopedPointer<ctkTracerPrivate> d_ptr;
+  static QBasicAtomicInt Enabled;
+
+  CTK_SINGLETON_DECLARE(ctkTracer)
+
+private:
+  Q_DECLARE_PRIVATE(ctkTracer);
+  Q_DISABLE_COPY(ctkTracer);
+};
+CTK_SINGLETON_DECLARE_INITIALIZER(CTK_CORE_EXPORT, ctkTracer)
+
+//----------------------------------------------------------------------------
+bool ctkTracer::isEnabled()
+{
+  return Enabled != 0;
+}
+
+/// \ingroup Core
+/// Record a span lasting from the construction to the destruction of
+/// the object. See CTK_TRACE_SCOPE.
+class ctkTraceScope
+{
+public:
+  inline ctkTraceScope(const char* category, const char* name)
+    : Category(category), Name(name)
+    , Start(ctkTracer::isEnabled() ? ctkTracer::instance()->now() : -1)
+  {
+  }
+
+  inline ~ctkTraceScope()
+  {
+    if (this->Start >= 0)
+      {
+      ctkTracer* tracer = ctkTracer::instance();
+      tracer->addSpan(this->Category, this->Name, this->Start, tracer->now());
+      }
+  }
+
+private:
+  Q_DISABLE_COPY(ctkTraceScope);
+
+  const char* Category;
+  const char* Name;
+  qint64 Start;
+};
+
+#define CTK_TRACE_CONCAT_IMPL(a, b) a##b
+#define CTK_TRACE_CONCAT(a, b) CTK_TRACE_CONCAT_IMPL(a, b)
+
+/// Record a span named \a name for the rest of the enclosing scope
+#define CTK_TRACE_SCOPE(category, name) \
+  ctkTraceScope CTK_TRACE_CONCAT(ctkTraceScope_, __LINE__)(category, name)
+
+/// Add \a delta to the counter named \a name
+#define CTK_TRACE_COUNTER(name, delta) \
+  do { if (ctkTracer::isEnabled()) { ctkTracer::instance()->addCounter(name, delta); } } while (0)
+
+#endif
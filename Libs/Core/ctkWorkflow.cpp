@@ -19,7 +19,9 @@
 =========================================================================*/
 
 // Qt includes
+#include <QCoreApplication>
 #include <QDebug>
+#include <QSet>
 #include <QStateMachine>
 #include <QState>
 
@@ -59,6 +61,8 @@ ctkWorkflowPrivate::ctkWorkflowPrivate(ctkWorkflow& object)
   // By default, go back to the origin step upon success of the goToStep(targetId) attempt.
   this->GoBackToOriginStepUponSuccess = true;
 
+  this->PostedEventCount = 0;
+
   this->ARTIFICIAL_BRANCH_ID_PREFIX = "ctkWorkflowArtificialBranchId_";
 }
 
@@ -92,6 +96,7 @@ bool ctkWorkflowPrivate::addStep(ctkWorkflowStep* step)
     this->RegisteredSteps << step;
     emit q->stepRegistered(step);
     }
+  this->StepIdToStepMap.insert(step->id().toLower(), step);
 
   // Add the states, creating them if necessary
   this->StateMachine->addState(step->processingState());
@@ -299,15 +304,14 @@ void ctkWorkflowPrivate::createTransitionToPreviousStartingStep(ctkWorkflowStep*
 // --------------------------------------------------------------------------
 ctkWorkflowStep* ctkWorkflowPrivate::stepFromId(const QString& id)const
 {
-  foreach(ctkWorkflowStep* step, this->StepToForwardAndBackwardStepMap.keys())
-    {
-    Q_ASSERT(step);
-    if (QString::compare(step->id(), id, Qt::CaseInsensitive) == 0)
-      {
-      return step;
-      }
-    }
-  return 0;
+  return this->StepIdToStepMap.value(id.toLower(), 0);
+}
+
+// --------------------------------------------------------------------------
+void ctkWorkflowPrivate::postEvent(QEvent* event)
+{
+  ++this->PostedEventCount;
+  this->StateMachine->postEvent(event);
 }
 
 // --------------------------------------------------------------------------
@@ -622,6 +626,8 @@ bool ctkWorkflow::addTransition(ctkWorkflowStep* origin, ctkWorkflowStep* destin
       }
     }
 
+  d->BackwardDistanceCache.clear();
+
   if (origin && destination)
     {
     // ensure we haven't already added a transition with the same origin, destination and directionality
@@ -863,7 +869,7 @@ void ctkWorkflow::goForward(const QString& desiredBranchId)
   d->DesiredBranchId = desiredBranchId;
 
   logger.info("goForward - posting ValidationTransition");
-  d->StateMachine->postEvent(
+  d->postEvent(
       new ctkWorkflowIntrastepTransitionEvent(ctkWorkflowIntrastepTransition::ValidationTransition));
 }
 
@@ -892,7 +898,7 @@ void ctkWorkflow::goBackward(const QString& desiredBranchId)
   d->DesiredBranchId = desiredBranchId;
 
   logger.info("goBackward - posting TransitionToPreviousStep");
-  d->StateMachine->postEvent(
+  d->postEvent(
                              new ctkWorkflowInterstepTransitionEvent(ctkWorkflowInterstepTransition::TransitionToPreviousStep, branchId));
 }
 
@@ -900,6 +906,21 @@ void ctkWorkflow::goBackward(const QString& desiredBranchId)
 CTK_GET_CPP(ctkWorkflow, bool, goBackToOriginStepUponSuccess, GoBackToOriginStepUponSuccess);
 CTK_SET_CPP(ctkWorkflow, bool, setGoBackToOriginStepUponSuccess, GoBackToOriginStepUponSuccess);
 
+// --------------------------------------------------------------------------
+void ctkWorkflow::processPendingTransitions()
+{
+  Q_D(ctkWorkflow);
+  // QStateMachine processes its posted events from a queued invocation.
+  // Entering a step can post new events (e.g. goToStep()), process them
+  // until the workflow is idle.
+  int postedEventCount = -1;
+  while (postedEventCount != d->PostedEventCount)
+    {
+    postedEventCount = d->PostedEventCount;
+    QCoreApplication::sendPostedEvents(d->StateMachine, QEvent::MetaCall);
+    }
+}
+
 // --------------------------------------------------------------------------
 void ctkWorkflow::goToStep(const QString& targetId)
 {
@@ -1026,7 +1047,7 @@ void ctkWorkflow::goToNextStepAfterSuccessfulValidation(const QString& branchId)
     return;
     }
 
-  d->StateMachine->postEvent(new ctkWorkflowInterstepTransitionEvent(ctkWorkflowInterstepTransition::TransitionToNextStep, transitionBranchId));
+  d->postEvent(new ctkWorkflowInterstepTransitionEvent(ctkWorkflowInterstepTransition::TransitionToNextStep, transitionBranchId));
 }
 
 // --------------------------------------------------------------------------
@@ -1041,7 +1062,7 @@ void ctkWorkflow::goToProcessingStateAfterValidationFailed()
     }
 
   logger.info("goToNextStepAfterSuccessfulValidation - Posting ValidationFailedTransition");
-  d->StateMachine->postEvent(new ctkWorkflowIntrastepTransitionEvent(ctkWorkflowIntrastepTransition::ValidationFailedTransition));
+  d->postEvent(new ctkWorkflowIntrastepTransitionEvent(ctkWorkflowIntrastepTransition::ValidationFailedTransition));
 }
 
 // --------------------------------------------------------------------------
@@ -1107,7 +1128,7 @@ void ctkWorkflow::goFromGoToStepToStartingStep()
 {
   Q_D(ctkWorkflow);
   logger.info("goFromGoToStepToStartingStep - Posting TransitionToPreviousStartingStep");
-  d->StateMachine->postEvent(new ctkWorkflowInterstepTransitionEvent(ctkWorkflowInterstepTransition::TransitionToPreviousStartingStepAfterSuccessfulGoToFinishStep));
+  d->postEvent(new ctkWorkflowInterstepTransitionEvent(ctkWorkflowInterstepTransition::TransitionToPreviousStartingStepAfterSuccessfulGoToFinishStep));
 }
 
 // --------------------------------------------------------------------------
@@ -1150,27 +1171,60 @@ int ctkWorkflow::backwardDistanceToStep(ctkWorkflowStep* fromStep,
     return -1;
     }
 
+  Q_D(const ctkWorkflow);
+  ctkWorkflowPrivate::StepPairType key(fromStep, origin);
+  QHash<ctkWorkflowPrivate::StepPairType, int>::const_iterator cached =
+    d->BackwardDistanceCache.find(key);
+  if (cached != d->BackwardDistanceCache.end())
+    {
+    return cached.value();
+    }
+
+  int distance = -1;
+  QSet<ctkWorkflowStep*> visitedSteps;
   QQueue< std::pair<ctkWorkflowStep*, int> > queue;
   queue.append(std::make_pair(fromStep, 0));
+  visitedSteps.insert(fromStep);
   while (! queue.isEmpty())
     {
     std::pair<ctkWorkflowStep*, int> p = queue.dequeue();
     ctkWorkflowStep* step = p.first;
     if (! step)
       {
-      return -1;
+      break;
       }
 
     if (step->id() == origin->id())
       {
-      return p.second;
+      distance = p.second;
+      break;
       }
 
     foreach(ctkWorkflowStep* previousStep, this->backwardSteps(step))
       {
-      queue.append(std::make_pair(previousStep, p.second + 1));
+      // Steps reached through another path are already queued with a
+      // shorter or equal distance
+      if (!visitedSteps.contains(previousStep))
+        {
+        visitedSteps.insert(previousStep);
+        queue.append(std::make_pair(previousStep, p.second + 1));
+        }
       }
     }
 
-  return -1;
+  d->BackwardDistanceCache.insert(key, distance);
+  return distance;
+}
+
+// --------------------------------------------------------------------------
+void ctkWorkflow::stepIdChanged(ctkWorkflowStep* step, const QString& oldId)
+{
+  Q_D(ctkWorkflow);
+  QString oldKey = oldId.toLower();
+  if (d->StepIdToStepMap.value(oldKey) != step)
+    {
+    return;
+    }
+  d->StepIdToStepMap.remove(oldKey);
+  d->StepIdToStepMap.insert(step->id().toLower(), step);
 }
@@ -184,6 +184,18 @@ public:
   bool goBackToOriginStepUponSuccess()const;
   void setGoBackToOriginStepUponSuccess(bool flag);
 
+  /// \brief Process the transitions posted by goForward(), goBackward() and goToStep()
+  /// without running an event loop.
+  ///
+  /// The state machine driving the workflow only processes its events from
+  /// the event loop. When a workflow is run headlessly (e.g. generated workflows
+  /// for batch processing), calling this method after goForward(), goBackward()
+  /// or goToStep() performs the transitions synchronously, without spinning the
+  /// whole event loop.
+  /// \note Steps completing their onEntry/onExit/validate asynchronously
+  /// still require an event loop.
+  Q_INVOKABLE void processPendingTransitions();
+
 public Q_SLOTS:
 
   /// Use this to trigger evaluation of the processing state of the current step, and subsequent
@@ -242,6 +254,11 @@ protected:
   QScopedPointer<ctkWorkflowPrivate> d_ptr;
 
 private:
+  friend class ctkWorkflowStep; // For access to stepIdChanged
+
+  /// Called by ctkWorkflowStep::setId() to keep the step lookup up-to-date
+  void stepIdChanged(ctkWorkflowStep* step, const QString& oldId);
+
   Q_DECLARE_PRIVATE(ctkWorkflow);
   Q_DISABLE_COPY(ctkWorkflow);
 };
@@ -168,7 +168,12 @@ void ctkWorkflowStep::setId(const QString& newId)
                          "Step already added to a workflow !").arg(this->id()).arg(newId));
     return;
     }
+  QString oldId = d->Id;
   d->Id = newId;
+  if (d->Workflow)
+    {
+    d->Workflow->stepIdChanged(this, oldId);
+    }
 }
 
 // --------------------------------------------------------------------------
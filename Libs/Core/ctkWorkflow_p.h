@@ -24,13 +24,16 @@
 // Qt includes
 #include <QObject>
 #include <QString>
+#include <QHash>
 #include <QList>
 #include <QMap>
+#include <QPair>
 
 // CTK includes
 #include "ctkWorkflow.h"
 #include "ctkWorkflowTransitions.h"
 
+class QEvent;
 class QStateMachine;
 class ctkWorkflowStep;
 //class ctkWorkflow;
@@ -64,12 +67,25 @@ struct forwardAndBackwardSteps
 
   void appendForwardStep(ctkWorkflowStep* step, QString id)
   {
+    // Only the first occurrence is indexed, as QList::indexOf would find it
+    if (!this->ForwardStepToIndex.contains(step))
+      {
+      this->ForwardStepToIndex.insert(step, this->ForwardSteps.size());
+      }
+    if (!this->ForwardBranchIdToIndex.contains(id))
+      {
+      this->ForwardBranchIdToIndex.insert(id, this->ForwardBranchIds.size());
+      }
     this->ForwardSteps.append(step);
     this->ForwardBranchIds.append(id);
   }
 
   void appendBackwardStep(ctkWorkflowStep* step, QString id)
   {
+    if (!this->BackwardStepToIndex.contains(step))
+      {
+      this->BackwardStepToIndex.insert(step, this->BackwardSteps.size());
+      }
     this->BackwardSteps.append(step);
     this->BackwardBranchIds.append(id);
   }
@@ -88,7 +104,7 @@ struct forwardAndBackwardSteps
 
   ctkWorkflowStep* forwardStep(QString branchId)
   {
-    int index = this->ForwardBranchIds.indexOf(branchId);
+    int index = this->ForwardBranchIdToIndex.value(branchId, -1);
     if (index != -1)
       {
       return ForwardSteps.at(index);
@@ -101,7 +117,7 @@ struct forwardAndBackwardSteps
 
   QString backwardBranchId(ctkWorkflowStep* step)
   {
-    int index = this->BackwardSteps.indexOf(step);
+    int index = this->BackwardStepToIndex.value(step, -1);
     if (index != -1)
       {
       return BackwardBranchIds.at(index);
@@ -114,7 +130,7 @@ struct forwardAndBackwardSteps
 
   QString forwardBranchId(ctkWorkflowStep* step)
   {
-    int index = this->ForwardSteps.indexOf(step);
+    int index = this->ForwardStepToIndex.value(step, -1);
     if (index != -1)
       {
       return ForwardBranchIds.at(index);
@@ -132,6 +148,11 @@ private:
   QList<QString> ForwardBranchIds;
   QList<QString> BackwardBranchIds;
 
+  // Index of the steps and branch ids in the lists above
+  QHash<ctkWorkflowStep*, int> ForwardStepToIndex;
+  QHash<ctkWorkflowStep*, int> BackwardStepToIndex;
+  QHash<QString, int>          ForwardBranchIdToIndex;
+
 };
 
 // --------------------------------------------------------------------------
@@ -223,6 +244,9 @@ public:
   /// Get the step in the workflow with a given id.
   ctkWorkflowStep* stepFromId(const QString& id)const;
 
+  /// Post an event to the state machine, see processPendingTransitions()
+  void postEvent(QEvent* event);
+
   /// Get the step that a state belongs to (if any)
   ctkWorkflowStep* stepFromState(const QAbstractState* state);
 
@@ -269,6 +293,17 @@ public:
   // Register a list of pointers to the steps in the worflow for cleaning purpose
   StepListType RegisteredSteps;
 
+  // Steps of the workflow by id. Ids are case insensitive, the keys are lower case.
+  QHash<QString, ctkWorkflowStep*> StepIdToStepMap;
+
+  // Distances computed by ctkWorkflow::backwardDistanceToStep(), they
+  // are discarded when a transition is added.
+  typedef QPair<ctkWorkflowStep*, ctkWorkflowStep*> StepPairType;
+  mutable QHash<StepPairType, int> BackwardDistanceCache;
+
+  // Number of events posted to the state machine
+  int PostedEventCount;
+
   // Maintain a map of <state, step> key/value pairs, to find the step
   // that a given state belongs to
   typedef QMap<const QAbstractState*, ctkWorkflowStep*>           StateToStepMapType;
@@ -34,6 +34,7 @@
 
 // ctkDICOM includes
 #include "ctkLogger.h"
+#include "ctkTracer.h"
 #include "ctkDICOMIndexer.h"
 #include "ctkDICOMIndexer_p.h"
 #include "ctkDICOMDatabase.h"
@@ -90,6 +91,7 @@ void ctkDICOMIndexer::addFile(ctkDICOMDatabase& database,
                                    const QString filePath,
                                    const QString& destinationDirectoryName)
 {
+  CTK_TRACE_SCOPE("DICOM", "addFile");
   std::cout << filePath.toStdString();
   if (!destinationDirectoryName.isEmpty())
   {
@@ -106,6 +108,7 @@ void ctkDICOMIndexer::addDirectory(ctkDICOMDatabase& ctkDICOMDatabase,
                                    const QString& directoryName,
                                    const QString& destinationDirectoryName)
 {
+  CTK_TRACE_SCOPE("DICOM", "addDirectory");
   QStringList listOfFiles;
   QDir directory(directoryName);
 
@@ -114,6 +114,22 @@ void ctkEventAdminPerfTestSuite::sendEvents()
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkEventAdminPerfTestSuite::sendCompactEvents()
+{
+  ctkEvent event1("org/bla/1", ctkEventProperties());
+  for (int i = 0; i < nSendEvents; ++i)
+  {
+    eventAdmin->sendEvent(event1);
+  }
+
+  for (int i = 0; i < nSendEvents; ++i)
+  {
+    ctkEvent event2("org/bla/2", ctkEventProperties().insert("name", "bla").insert("level", i));
+    eventAdmin->sendEvent(event2);
+  }
+}
+
 //----------------------------------------------------------------------------
 void ctkEventAdminPerfTestSuite::postEvents()
 {
@@ -160,6 +176,21 @@ void ctkEventAdminPerfTestSuite::testSendEvents()
   qDebug() << "Sending" << 2*nSendEvents << "synchronous events took" << ms << "ms";
 }
 
+//----------------------------------------------------------------------------
+void ctkEventAdminPerfTestSuite::testSendCompactEvents()
+{
+  nEvent1Handled = 0;
+  nEvent2Handled = 0;
+
+  QTime t;
+  t.start();
+  sendCompactEvents();
+  int ms = t.elapsed();
+  QCOMPARE(nEvent1Handled, nSendEvents * nHandlers);
+  QCOMPARE(nEvent2Handled, nSendEvents * nHandlers * 3);
+  qDebug() << "Sending" << 2*nSendEvents << "synchronous compact events took" << ms << "ms";
+}
+
 //----------------------------------------------------------------------------
 void ctkEventAdminPerfTestSuite::testPostEvents()
 {
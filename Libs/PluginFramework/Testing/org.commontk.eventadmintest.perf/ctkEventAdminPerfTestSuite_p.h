@@ -63,12 +63,14 @@ private:
   void removeHandlers();
 
   void sendEvents();
+  void sendCompactEvents();
   void postEvents();
 
 private Q_SLOTS:
 
   void initTestCase();
   void testSendEvents();
+  void testSendCompactEvents();
   void testPostEvents();
   void cleanupTestCase();
 };
@@ -0,0 +1,124 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkEAEventTestSuite_p.h"
+
+#include <ctkLDAPSearchFilter.h>
+#include <service/event/ctkEvent.h>
+#include <service/event/ctkEventConstants.h>
+
+#include <QTest>
+
+namespace {
+
+//----------------------------------------------------------------------------
+ctkEvent inlineEvent()
+{
+  return ctkEvent("org/commontk/eatest/inline",
+                  ctkEventProperties().insert("name", "bla").insert("level", 3));
+}
+
+//----------------------------------------------------------------------------
+ctkEvent overflowEvent()
+{
+  ctkEventProperties props;
+  for (int i = 0; i < ctkEventProperties::InlineCapacity + 2; ++i)
+  {
+    props.insert(QString("p%1").arg(i), i);
+  }
+  props.insert("name", "blub");
+  return ctkEvent("org/commontk/eatest/overflow", props);
+}
+
+//----------------------------------------------------------------------------
+ctkEvent dictionaryEvent()
+{
+  ctkDictionary props;
+  props.insert("name", "bla");
+  props.insert("level", 7);
+  return ctkEvent("org/commontk/eatest/dictionary", props);
+}
+
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventTestSuite::testEventProperties()
+{
+  ctkEvent event = overflowEvent();
+  for (int i = 0; i < ctkEventProperties::InlineCapacity + 2; ++i)
+  {
+    QString name = QString("p%1").arg(i);
+    QVERIFY(event.containsProperty(name));
+    QCOMPARE(event.getProperty(name).toInt(), i);
+  }
+  QCOMPARE(event.getProperty("name").toString(), QString("blub"));
+  QVERIFY(!event.containsProperty("P0"));
+  QVERIFY(!event.getProperty("missing").isValid());
+  QCOMPARE(event.getProperty(ctkEventConstants::EVENT_TOPIC).toString(),
+           QString("org/commontk/eatest/overflow"));
+  QCOMPARE(event.getPropertyNames().size(), ctkEventProperties::InlineCapacity + 4);
+
+  // replacing a property does not add a new one
+  ctkEvent replaced("org/commontk/eatest/inline",
+                    ctkEventProperties().insert("name", "bla").insert("name", "blub"));
+  QCOMPARE(replaced.getProperty("name").toString(), QString("blub"));
+  QCOMPARE(replaced.getPropertyNames().size(), 2);
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventTestSuite::testMatches_data()
+{
+  QTest::addColumn<ctkEvent>("event");
+  QTest::addColumn<QString>("filter");
+  QTest::addColumn<bool>("expected");
+
+  QTest::newRow("inline property") << inlineEvent() << "(name=bla)" << true;
+  QTest::newRow("inline property mismatch") << inlineEvent() << "(name=blub)" << false;
+  QTest::newRow("inline property case") << inlineEvent() << "(Name=bla)" << false;
+  QTest::newRow("inline wildcard") << inlineEvent() << "(name=b*)" << true;
+  QTest::newRow("inline number") << inlineEvent() << "(level>=2)" << true;
+  QTest::newRow("inline and") << inlineEvent() << "(&(name=bla)(level<=2))" << false;
+  QTest::newRow("inline or") << inlineEvent() << "(|(name=blub)(level=3))" << true;
+  QTest::newRow("inline not") << inlineEvent() << "(!(name=bla))" << false;
+  QTest::newRow("missing property") << inlineEvent() << "(missing=*)" << false;
+  QTest::newRow("not missing property") << inlineEvent() << "(!(missing=x))" << true;
+  QTest::newRow("topic") << inlineEvent()
+      << QString("(%1=org/commontk/eatest/*)").arg(ctkEventConstants::EVENT_TOPIC) << true;
+  QTest::newRow("overflow property") << overflowEvent() << "(&(p5=5)(name=blub))" << true;
+  QTest::newRow("overflow property mismatch") << overflowEvent() << "(p5=4)" << false;
+  QTest::newRow("dictionary property") << dictionaryEvent() << "(level=7)" << true;
+  QTest::newRow("dictionary property case") << dictionaryEvent() << "(LEVEL=7)" << false;
+  QTest::newRow("dictionary topic") << dictionaryEvent()
+      << QString("(%1=org/commontk/eatest/dictionary)").arg(ctkEventConstants::EVENT_TOPIC) << true;
+}
+
+//----------------------------------------------------------------------------
+void ctkEAEventTestSuite::testMatches()
+{
+  QFETCH(ctkEvent, event);
+  QFETCH(QString, filter);
+  QFETCH(bool, expected);
+
+  ctkLDAPSearchFilter ldapFilter(filter);
+  QCOMPARE(event.matches(ldapFilter), expected);
+  QCOMPARE(ldapFilter.matchCase(event.getProperties()), expected);
+}
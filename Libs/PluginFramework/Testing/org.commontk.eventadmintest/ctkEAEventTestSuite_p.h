@@ -0,0 +1,54 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKEAEVENTTESTSUITE_P_H
+#define CTKEAEVENTTESTSUITE_P_H
+
+#include <QObject>
+
+#include <ctkTestSuiteInterface.h>
+
+class ctkEAEventTestSuite : public QObject,
+    public ctkTestSuiteInterface
+{
+  Q_OBJECT
+  Q_INTERFACES(ctkTestSuiteInterface)
+
+private Q_SLOTS:
+
+  /*
+   * Ensures the properties of events created from a ctkEventProperties
+   * object, inline and overflowing, are found by name.
+   */
+  void testEventProperties();
+
+  /*
+   * Ensures ctkEvent::matches() evaluates filters against the topic and the
+   * event properties, respecting case, and agrees with a match on the
+   * property dictionary.
+   */
+  void testMatches();
+  void testMatches_data();
+
+};
+
+#endif // CTKEAEVENTTESTSUITE_P_H
@@ -27,6 +27,7 @@
 #include <QtPlugin>
 #include <QStringList>
 
+#include "ctkEAEventTestSuite_p.h"
 #include "ctkEATopicWildcardTestSuite_p.h"
 #include "ctkEAScenario1TestSuite_p.h"
 #include "ctkEAScenario2TestSuite_p.h"
@@ -35,7 +36,8 @@
 
 //----------------------------------------------------------------------------
 ctkEventAdminTestActivator::ctkEventAdminTestActivator()
-  : topicWildcardTestSuite(0)
+  : eventTestSuite(0)
+  , topicWildcardTestSuite(0)
   , topicWildcardTestSuiteSS(0)
   , scenario1TestSuite(0)
   , scenario1TestSuiteSS(0)
@@ -49,6 +51,7 @@ ctkEventAdminTestActivator::ctkEventAdminTestActivator()
 //----------------------------------------------------------------------------
 ctkEventAdminTestActivator::~ctkEventAdminTestActivator()
 {
+  delete eventTestSuite;
   delete topicWildcardTestSuite;
   delete topicWildcardTestSuiteSS;
   delete scenario1TestSuite;
@@ -85,6 +88,9 @@ void ctkEventAdminTestActivator::start(ctkPluginContext* context)
     throw ctkRuntimeException(msg);
   }
 
+  eventTestSuite = new ctkEAEventTestSuite();
+  context->registerService<ctkTestSuiteInterface>(eventTestSuite);
+
   topicWildcardTestSuite = new ctkEATopicWildcardTestSuite(context, eventPluginId, false);
   context->registerService<ctkTestSuiteInterface>(topicWildcardTestSuite);
 
@@ -112,6 +118,7 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
 {
   Q_UNUSED(context);
 
+  delete eventTestSuite;
   delete topicWildcardTestSuite;
   delete topicWildcardTestSuiteSS;
   delete scenario1TestSuite;
@@ -120,6 +127,7 @@ void ctkEventAdminTestActivator::stop(ctkPluginContext* context)
   delete scenario3TestSuite;
   delete scenario4TestSuite;
 
+  eventTestSuite = 0;
   topicWildcardTestSuite = 0;
   topicWildcardTestSuiteSS = 0;
   scenario1TestSuite = 0;
@@ -42,6 +42,7 @@ public:
 
 private:
 
+  QObject* eventTestSuite;
   QObject* topicWildcardTestSuite;
   QObject* topicWildcardTestSuiteSS;
   QObject* scenario1TestSuite;
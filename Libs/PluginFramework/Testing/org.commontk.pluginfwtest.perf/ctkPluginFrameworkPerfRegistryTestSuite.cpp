@@ -194,6 +194,30 @@ void ctkPluginFrameworkPerfRegistryTestSuite::unregisterServices()
   regs.clear();
 }
 
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkPerfRegistryTestSuite::testRegisterServicesTransaction()
+{
+  qDebug() << "Register services in a transaction, and check that we get #of services ("
+           << nServices << ") * #of listeners (" << nListeners << ")  REGISTERED events"
+           << " after the commit";
+
+  nRegistered = 0;
+  nUnregistering = 0;
+
+  ctkHighPrecisionTimer t;
+  t.start();
+  pc->beginServiceRegistrations();
+  registerServices(nServices);
+  QVERIFY2(nRegistered == 0, "REGISTERED events must be held back until the commit");
+  pc->commitServiceRegistrations();
+  int ms = t.elapsedMilli();
+  log() << "register in transaction took" << ms << "ms";
+  QVERIFY2(nServices * listeners.size() == nRegistered,
+           "# REGISTERED events must be same as # of registered services  * # of listeners");
+
+  unregisterServices();
+  QVERIFY2(nServices * listeners.size() == nUnregistering, "# UNREGISTERING events must be same as # of (un)registered services * # of listeners");
+}
 
 //----------------------------------------------------------------------------
 ctkServiceListener::ctkServiceListener(ctkPluginFrameworkPerfRegistryTestSuite* ts)
@@ -81,6 +81,8 @@ private Q_SLOTS:
 
   void testModifyServices();
   void testUnregisterServices();
+
+  void testRegisterServicesTransaction();
 };
 
 class ctkServiceListener : public QObject
@@ -0,0 +1,143 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+// Starts a profiled framework, installs and starts a test plugin and checks
+// the trace file written when the framework stops.
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+
+#include <ctkException.h>
+#include <ctkPlugin.h>
+#include <ctkPluginConstants.h>
+#include <ctkPluginContext.h>
+#include <ctkPluginFramework.h>
+#include <ctkPluginFrameworkFactory.h>
+#include <ctkTracer.h>
+
+#include "ctkPluginFrameworkTestUtil.h"
+
+#include <cstdlib>
+
+//----------------------------------------------------------------------------
+int checkProfile(const QString& profileFile)
+{
+  QFile file(profileFile);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  {
+    qCritical() << "The plugin framework profile" << profileFile << "was not written";
+    return EXIT_FAILURE;
+  }
+  QString json = QString::fromUtf8(file.readAll());
+  file.close();
+  QFile::remove(profileFile);
+
+  QStringList expected;
+  expected << "\"traceEvents\"" << "\"serviceStatistics\""
+           << "\"start pluginA_test\"" << "\"cat\":\"plugin\""
+           << "\"cat\":\"listeners\"" << "\"service.id\"";
+  foreach(const QString& str, expected)
+  {
+    if (!json.contains(str))
+    {
+      qCritical() << "The plugin framework profile does not contain" << str;
+      return EXIT_FAILURE;
+    }
+  }
+
+  json = json.trimmed();
+  if (!json.startsWith("{\"traceEvents\":[") || !json.endsWith("]}"))
+  {
+    qCritical() << "The plugin framework profile is not valid JSON";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+
+  app.setOrganizationName("CTK");
+  app.setOrganizationDomain("commontk.org");
+  app.setApplicationName("ctkPluginFrameworkProfileCppTests");
+
+  QString pluginDir;
+#ifdef CMAKE_INTDIR
+  pluginDir = qApp->applicationDirPath() + "/../test_plugins/" CMAKE_INTDIR "/";
+#else
+  pluginDir = qApp->applicationDirPath() + "/test_plugins/";
+#endif
+
+  QString profileFile = QDir::temp().filePath("ctkPluginFrameworkProfileCppTests.json");
+  QFile::remove(profileFile);
+
+  ctkProperties fwProps;
+  fwProps.insert(ctkPluginConstants::FRAMEWORK_STORAGE_CLEAN, ctkPluginConstants::FRAMEWORK_STORAGE_CLEAN_ONFIRSTINIT);
+  fwProps.insert("pluginfw.testDir", pluginDir);
+  fwProps.insert("org.commontk.pluginfw.debug.profile", true);
+  fwProps.insert("org.commontk.pluginfw.debug.profile.file", profileFile);
+
+#if defined(Q_CC_GNU) && ((__GNUC__ < 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ < 5)))
+  fwProps.insert(ctkPluginConstants::FRAMEWORK_PLUGIN_LOAD_HINTS, QVariant::fromValue<QLibrary::LoadHints>(QLibrary::ExportExternalSymbolsHint));
+#endif
+
+  {
+    ctkPluginFrameworkFactory fwFactory(fwProps);
+    QSharedPointer<ctkPluginFramework> framework = fwFactory.getFramework();
+    try
+    {
+      framework->init();
+      framework->start();
+      if (!ctkTracer::isEnabled())
+      {
+        qCritical() << "The profiler did not enable the tracer";
+        return EXIT_FAILURE;
+      }
+
+      // The test plugin registers a service when it starts
+      QSharedPointer<ctkPlugin> plugin =
+          ctkPluginFrameworkTestUtil::installPlugin(framework->getPluginContext(), "pluginA_test");
+      plugin->start();
+      plugin->stop();
+    }
+    catch (const ctkException& e)
+    {
+      qCritical() << e.printStackTrace();
+      return EXIT_FAILURE;
+    }
+
+    framework->stop();
+    framework->waitForStop(30000);
+  }
+
+  // The tracer is restored to its state before the framework was created
+  if (ctkTracer::isEnabled())
+  {
+    qCritical() << "The profiler did not restore the tracer state";
+    return EXIT_FAILURE;
+  }
+
+  return checkProfile(profileFile);
+}
@@ -316,6 +316,53 @@ void ctkServiceListenerTestSuite::frameSL25a()
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkServiceListenerTestSuite::frameSL30a()
+{
+  const QString clazz("org.commontk.pluginfwtest.TransactionService");
+  ctkServiceListener sListen(pc, false);
+  try
+  {
+    pc->connectServiceListener(&sListen, "serviceChanged",
+                               QString("(%1=%2)").arg(ctkPluginConstants::OBJECTCLASS).arg(clazz));
+  }
+  catch (const ctkIllegalStateException& ise)
+  {
+    qDebug() << "service listener registration failed " << ise.what();
+    QFAIL("service listener registration failed");
+  }
+
+  QObject serviceA;
+  QObject serviceB;
+  QList<ctkServiceEvent::Type> expectedServiceEventTypes;
+
+  pc->beginServiceRegistrations();
+  ctkServiceRegistration regA = pc->registerService(clazz.toAscii().data(), &serviceA);
+  ctkServiceRegistration regB = pc->registerService(clazz.toAscii().data(), &serviceB);
+  QVERIFY(sListen.checkEvents(expectedServiceEventTypes));
+
+  // The held back REGISTERED event of A is delivered before MODIFIED
+  regA.setProperties(ctkDictionary());
+  expectedServiceEventTypes << ctkServiceEvent::REGISTERED;
+  expectedServiceEventTypes << ctkServiceEvent::MODIFIED;
+  QVERIFY(sListen.checkEvents(expectedServiceEventTypes));
+
+  // B is unregistered before the listener heard of it: no event at all
+  regB.unregister();
+  QVERIFY(sListen.checkEvents(expectedServiceEventTypes));
+
+  // The commit does not deliver the REGISTERED events again
+  pc->commitServiceRegistrations();
+  QVERIFY(sListen.checkEvents(expectedServiceEventTypes));
+
+  regA.unregister();
+  expectedServiceEventTypes << ctkServiceEvent::UNREGISTERING;
+  QVERIFY(sListen.checkEvents(expectedServiceEventTypes));
+  QVERIFY2(sListen.teststatus, "Service listener checks");
+
+  pc->disconnectServiceListener(&sListen, "serviceChanged");
+}
+
 //----------------------------------------------------------------------------
 bool ctkServiceListenerTestSuite::runStartStopTest(
   const QString& tcName, int cnt, QSharedPointer<ctkPlugin> targetPlugin,
@@ -63,6 +63,11 @@ private Q_SLOTS:
 //    void frameSL20a();
     void frameSL25a();
 
+    // Checks the order of the service events sent to
+    // a service listener when services are modified or
+    // unregistered inside a registration transaction.
+    void frameSL30a();
+
 private:
 
     ctkPluginContext* pc;
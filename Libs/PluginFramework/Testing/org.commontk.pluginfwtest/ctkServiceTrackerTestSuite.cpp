@@ -220,6 +220,89 @@ void ctkServiceTrackerTestSuite::runTest()
   delete st1;
 }
 
+//----------------------------------------------------------------------------
+namespace {
+
+class ctkServiceTrackerCountingCustomizer : public ctkServiceTrackerCustomizer<QObject*>
+{
+public:
+
+  ctkServiceTrackerCountingCustomizer(ctkPluginContext* pc)
+    : pc(pc), addedCount(0), modifiedCount(0), removedCount(0)
+  {}
+
+  QObject* addingService(const ctkServiceReference& reference)
+  {
+    ++addedCount;
+    return pc->getService(reference);
+  }
+
+  void modifiedService(const ctkServiceReference& reference, QObject* service)
+  {
+    Q_UNUSED(reference)
+    Q_UNUSED(service)
+    ++modifiedCount;
+  }
+
+  void removedService(const ctkServiceReference& reference, QObject* service)
+  {
+    Q_UNUSED(service)
+    ++removedCount;
+    pc->ungetService(reference);
+  }
+
+  ctkPluginContext* pc;
+  int addedCount;
+  int modifiedCount;
+  int removedCount;
+};
+
+}
+
+//----------------------------------------------------------------------------
+void ctkServiceTrackerTestSuite::runBatchTest()
+{
+  const QString clazz("org.commontk.pluginfwtest.BatchService");
+  const int nServices = 50;
+
+  ctkServiceTrackerCountingCustomizer customizer(pc);
+  ctkServiceTracker<> tracker(pc, clazz, &customizer);
+  tracker.open();
+  QVERIFY(tracker.isEmpty());
+  int trackingCount = tracker.getTrackingCount();
+
+  QList<QObject*> services;
+  QList<ctkServiceRegistration> regs;
+  pc->beginServiceRegistrations();
+  for (int i = 0; i < nServices; ++i)
+  {
+    services << new QObject();
+    regs << pc->registerService(clazz.toAscii().data(), services.back());
+  }
+  // the REGISTERED events are held back until the commit
+  QCOMPARE(tracker.size(), 0);
+  pc->commitServiceRegistrations();
+
+  QCOMPARE(customizer.addedCount, nServices);
+  QCOMPARE(customizer.modifiedCount, 0);
+  QCOMPARE(tracker.size(), nServices);
+  QCOMPARE(tracker.getServices().size(), nServices);
+  QCOMPARE(tracker.getTrackingCount(), trackingCount + nServices);
+  QVERIFY(tracker.getService() != 0);
+
+  foreach(ctkServiceRegistration reg, regs)
+  {
+    reg.unregister();
+  }
+  QCOMPARE(customizer.removedCount, nServices);
+  QVERIFY(tracker.isEmpty());
+  QVERIFY(tracker.getService() == 0);
+
+  tracker.close();
+  qDeleteAll(services);
+}
+
+//----------------------------------------------------------------------------
 ctkServiceTrackerTestWorker::ctkServiceTrackerTestWorker(ctkPluginContext* pc)
   : waitSuccess(false), pc(pc)
 {
@@ -54,6 +54,10 @@ private Q_SLOTS:
     // service in the stop()-method.
     void runTest();
 
+    // Checks that a batch of REGISTERED events delivered by a
+    // service registration transaction adds each service once.
+    void runBatchTest();
+
 Q_SIGNALS:
 
     void serviceControl(int service, const QString operation, long rank);
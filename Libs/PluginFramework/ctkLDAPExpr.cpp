@@ -310,6 +310,33 @@ bool ctkLDAPExpr::evaluate( const ctkServiceProperties &p, bool matchCase ) cons
   }
 }
 
+//----------------------------------------------------------------------------
+bool ctkLDAPExpr::evaluate( const ctkLDAPPropertyLookup &p ) const
+{
+  if ((d->m_operator & SIMPLE) != 0) {
+    return compare(p.value(d->m_attrName), d->m_operator, d->m_attrValue);
+  } else { // (d->m_operator & COMPLEX) != 0
+    switch (d->m_operator) {
+    case AND:
+      for (int i = 0; i < d->m_args.length( ); i++) {
+        if (!d->m_args[i].evaluate(p))
+          return false;
+      }
+      return true;
+    case OR:
+      for (int i = 0; i < d->m_args.length( ); i++) {
+        if (d->m_args[i].evaluate(p))
+          return true;
+      }
+      return false;
+    case NOT:
+      return !d->m_args[0].evaluate(p);
+    default:
+      return false; // Cannot happen
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 bool ctkLDAPExpr::compare( const QVariant &obj, int op, const QString &s ) const
 {
@@ -33,6 +33,24 @@ limitations under the License.
 
 class ctkLDAPExprData;
 
+/**
+\ingroup PluginFramework
+\brief Looks up the attribute values of a property set on demand, for
+properties which are not stored in a ctkServiceProperties object.
+*/
+class ctkLDAPPropertyLookup
+{
+public:
+
+  virtual ~ctkLDAPPropertyLookup() {}
+
+  /**
+   * Returns the value of the attribute named exactly <code>key</code>,
+   * or an invalid QVariant if there is no such attribute.
+   */
+  virtual QVariant value(const QString& key) const = 0;
+};
+
 /**
 \ingroup PluginFramework
 \brief LDAP Expression
@@ -126,6 +144,9 @@ public:
   //! Evaluate this LDAP filter.
   bool evaluate(const ctkServiceProperties &p, bool matchCase) const;
 
+  //! Evaluate this LDAP filter, looking up the attributes case sensitively.
+  bool evaluate(const ctkLDAPPropertyLookup &p) const;
+
   //!
   const QString toString() const;
 
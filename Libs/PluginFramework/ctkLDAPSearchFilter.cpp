@@ -91,6 +91,12 @@ bool ctkLDAPSearchFilter::matchCase(const ctkDictionary& dictionary) const
   return d->ldapExpr.evaluate(dictionary, true);
 }
 
+//----------------------------------------------------------------------------
+bool ctkLDAPSearchFilter::matchCase(const ctkLDAPPropertyLookup& lookup) const
+{
+  return d->ldapExpr.evaluate(lookup);
+}
+
 //----------------------------------------------------------------------------
 QString ctkLDAPSearchFilter::toString() const
 {
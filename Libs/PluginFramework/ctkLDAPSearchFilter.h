@@ -31,6 +31,7 @@
 #include <QDebug>
 
 class ctkLDAPSearchFilterData;
+class ctkLDAPPropertyLookup;
 
 /**
  * \ingroup PluginFramework
@@ -157,6 +158,15 @@ protected:
 
   QSharedDataPointer<ctkLDAPSearchFilterData> d;
 
+private:
+
+  friend class ctkEvent;
+
+  /**
+   * Filter using properties which are looked up on demand, respecting case.
+   */
+  bool matchCase(const ctkLDAPPropertyLookup& lookup) const;
+
 };
 
 /**
@@ -90,6 +90,9 @@ void ctkPlugin::start(const StartOptions& options)
     return;
   }
 
+  ctkPluginFrameworkProfiler::Scope profile(&d->fwCtx->profiler, "plugin", "start " + d->symbolicName);
+  profile.setArg("plugin.id", static_cast<qlonglong>(d->id));
+
   //3: Record non-transient start requests.
   if ((options & START_TRANSIENT) == 0)
   {
@@ -147,8 +150,12 @@ void ctkPlugin::stop(const StopOptions& options)
 
   case ACTIVE:
   case STARTING: // Lazy start...
+  {
+    ctkPluginFrameworkProfiler::Scope profile(&d->fwCtx->profiler, "plugin", "stop " + d->symbolicName);
+    profile.setArg("plugin.id", static_cast<qlonglong>(d->id));
     savedException = d->stop0();
     break;
+  }
   };
 
   if (savedException != 0)
@@ -238,6 +238,105 @@ void ctkPluginAbstractTracked<S,T,R>::untrack(S item, R related)
    */
 }
 
+//----------------------------------------------------------------------------
+template<class S, class T, class R>
+void ctkPluginAbstractTracked<S,T,R>::trackBatch(const QList<Change>& changes)
+{
+  /* keep the last change of each item, in the order of their first change */
+  QList<Change> lastChanges;
+  QHash<S, int> changeIndex;
+  foreach (const Change& change, changes)
+  {
+    typename QHash<S, int>::ConstIterator it = changeIndex.find(change.item);
+    if (it == changeIndex.end())
+    {
+      changeIndex.insert(change.item, lastChanges.size());
+      lastChanges.push_back(change);
+    }
+    else
+    {
+      lastChanges[it.value()] = change;
+    }
+  }
+
+  QList<Change> added;
+  QList<QPair<Change, T> > changed;
+  QList<QPair<Change, T> > removed;
+  {
+    QMutexLocker lock(this);
+    foreach (const Change& change, lastChanges)
+    {
+      if (change.track)
+      {
+        if (closed)
+        {
+          continue;
+        }
+        T object = tracked.value(change.item);
+        if (object)
+        { /* we are currently tracking this item */
+          modified(); /* increment modification count */
+          changed.push_back(qMakePair(change, object));
+        }
+        else if (!adding.contains(change.item))
+        { /* mark this item is being added */
+          adding.push_back(change.item);
+          added.push_back(change);
+        }
+      }
+      else
+      {
+        if (initial.removeOne(change.item) || adding.removeOne(change.item))
+        { /* it will not be processed or is untracked while being added */
+          continue;
+        }
+        T object = tracked.take(change.item);
+        if (object)
+        {
+          modified(); /* increment modification count */
+          removed.push_back(qMakePair(change, object));
+        }
+      }
+    }
+  }
+  if (DEBUG)
+  {
+    qDebug() << "ctkPluginAbstractTracked::trackBatch: added" << added.size()
+             << "modified" << changed.size() << "removed" << removed.size();
+  }
+
+  /* Call customizer outside of synchronized region */
+  int addedCount = 0;
+  try
+  {
+    for (int i = 0; i < removed.size(); ++i)
+    {
+      customizerRemoved(removed[i].first.item, removed[i].first.related, removed[i].second);
+    }
+    for (int i = 0; i < changed.size(); ++i)
+    {
+      customizerModified(changed[i].first.item, changed[i].first.related, changed[i].second);
+    }
+    for (; addedCount < added.size(); ++addedCount)
+    {
+      trackAdding(added[addedCount].item, added[addedCount].related);
+    }
+  }
+  catch (...)
+  {
+    /*
+     * If the customizer throws an exception, the items which were
+     * not added yet must not stay in the adding list.
+     */
+    QMutexLocker lock(this);
+    for (int i = addedCount; i < added.size(); ++i)
+    {
+      adding.removeOne(added[i].item);
+    }
+    throw;
+  }
+}
+
 //----------------------------------------------------------------------------
 template<class S, class T, class R>
 int ctkPluginAbstractTracked<S,T,R>::size() const
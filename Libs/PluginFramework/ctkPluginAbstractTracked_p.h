@@ -107,6 +107,30 @@ public:
    */
   void untrack(S item, R related);
 
+  /**
+   * A change of the tracking state of an item, as processed by
+   * <code>trackBatch</code>.
+   */
+  struct Change
+  {
+    /** The item to track or untrack. */
+    S item;
+    /** Action related object. */
+    R related;
+    /** true to begin tracking the item, false to discontinue it. */
+    bool track;
+  };
+
+  /**
+   * Begin or discontinue tracking several items at once. Only the last
+   * change of each item is applied. The tracked items are updated while
+   * holding the lock once for the whole batch, then the customizer is
+   * called for every removed, modified and added item.
+   *
+   * @param changes Changes to apply, in order.
+   */
+  void trackBatch(const QList<Change>& changes);
+
   /**
    * Returns the number of tracked items.
    *
@@ -135,6 +135,22 @@ ctkServiceRegistration ctkPluginContext::registerService(const char* clazz, QObj
   return d->plugin->fwCtx->services->registerService(d->plugin, clazzes, service, properties);
 }
 
+//----------------------------------------------------------------------------
+void ctkPluginContext::beginServiceRegistrations()
+{
+  Q_D(ctkPluginContext);
+  d->isPluginContextValid();
+  d->plugin->fwCtx->services->beginRegistrationTransaction(d->plugin);
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginContext::commitServiceRegistrations()
+{
+  Q_D(ctkPluginContext);
+  d->isPluginContextValid();
+  d->plugin->fwCtx->services->commitRegistrationTransaction(d->plugin);
+}
+
 //----------------------------------------------------------------------------
 QList<ctkServiceReference> ctkPluginContext::getServiceReferences(const QString& clazz, const QString& filter)
 {
@@ -250,6 +250,45 @@ public:
     return registerService(clazz, service, properties);
   }
 
+  /**
+   * Starts a service registration transaction for the context plugin.
+   *
+   * <p>
+   * Until the matching call to commitServiceRegistrations(), services
+   * registered by the context plugin are added to the Framework service
+   * registry immediately, but the {@link ctkServiceEvent#REGISTERED} service
+   * events are held back. Committing the transaction delivers the held back
+   * events in one batch: each service listener receives all its matching
+   * events in a row, and <code>ctkServiceTracker</code> objects process
+   * the whole batch before invalidating their cached service. This
+   * considerably reduces the event dispatching overhead when a plugin
+   * registers many services, e.g. in its activator.
+   *
+   * <p>
+   * Transactions can be nested. The held back events are delivered when
+   * the outermost transaction is committed. A service unregistered before
+   * the commit gets neither a {@link ctkServiceEvent#REGISTERED} nor an
+   * {@link ctkServiceEvent#UNREGISTERING} event. If the properties of a
+   * service are modified before the commit, its held back
+   * {@link ctkServiceEvent#REGISTERED} event is delivered before the
+   * {@link ctkServiceEvent#MODIFIED} one. An open transaction is
+   * discarded when the context plugin is stopped.
+   *
+   * @throws ctkIllegalStateException If this ctkPluginContext is no longer valid.
+   * @see commitServiceRegistrations()
+   */
+  void beginServiceRegistrations();
+
+  /**
+   * Commits a service registration transaction started with
+   * beginServiceRegistrations().
+   *
+   * @throws ctkIllegalStateException If this ctkPluginContext is no longer
+   *         valid or if there is no open transaction for the context plugin.
+   * @see beginServiceRegistrations()
+   */
+  void commitServiceRegistrations();
+
   /**
    * Returns a list of <code>ctkServiceReference</code> objects. The returned
    * list contains services that
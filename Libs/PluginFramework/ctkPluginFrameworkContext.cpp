@@ -37,7 +37,7 @@ ctkPluginFrameworkContext::ctkPluginFrameworkContext(
     const ctkProperties& initProps)
   : plugins(0), listeners(this), services(0), systemPlugin(new ctkPluginFramework()),
     storage(0), firstInit(true), props(initProps), debug(props),
-    initialized(false)
+    profiler(debug.profile), initialized(false)
 {
 
   {
@@ -154,6 +154,14 @@ void ctkPluginFrameworkContext::uninit()
 
   log() << "uninit";
 
+  if (profiler.isEnabled() && !debug.profile_file.isEmpty())
+  {
+    if (!profiler.writeTraceEvents(debug.profile_file))
+    {
+      qWarning() << "Writing the plugin framework profile to" << debug.profile_file << "failed";
+    }
+  }
+
   ctkPluginFrameworkPrivate* const systemPluginPrivate = systemPlugin->d_func();
   systemPluginPrivate->uninitSystemPlugin();
 
@@ -206,6 +214,9 @@ QDebug ctkPluginFrameworkContext::log() const
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkContext::resolvePlugin(ctkPluginPrivate* plugin)
 {
+  ctkPluginFrameworkProfiler::Scope profile(&profiler, "plugin", "resolve " + plugin->symbolicName);
+  profile.setArg("plugin.id", static_cast<qlonglong>(plugin->id));
+
   if (debug.resolve)
   {
     qDebug() << "resolve:" << plugin->symbolicName << "[" << plugin->id << "]";
@@ -31,6 +31,8 @@ QString ctkPluginFrameworkDebug::SERVICE_REFERENCE_PROP = "org.commontk.pluginfw
 QString ctkPluginFrameworkDebug::STARTLEVEL_PROP = "org.commontk.pluginfw.debug.startlevel";
 QString ctkPluginFrameworkDebug::URL_PROP = "org.commontk.pluginfw.debug.url";
 QString ctkPluginFrameworkDebug::RESOLVE_PROP = "org.commontk.pluginfw.debug.resolve";
+QString ctkPluginFrameworkDebug::PROFILE_PROP = "org.commontk.pluginfw.debug.profile";
+QString ctkPluginFrameworkDebug::PROFILE_FILE_PROP = "org.commontk.pluginfw.debug.profile.file";
 
 //----------------------------------------------------------------------------
 ctkPluginFrameworkDebug::ctkPluginFrameworkDebug(ctkProperties& props)
@@ -44,6 +46,7 @@ ctkPluginFrameworkDebug::ctkPluginFrameworkDebug(ctkProperties& props)
   setPropertyIfNotSet(props, STARTLEVEL_PROP, false);
   setPropertyIfNotSet(props, URL_PROP, false);
   setPropertyIfNotSet(props, RESOLVE_PROP, false);
+  setPropertyIfNotSet(props, PROFILE_PROP, false);
   errors = props.value(ERRORS_PROP).toBool();
   framework = props.value(FRAMEWORK_PROP).toBool();
   hooks = props.value(HOOKS_PROP).toBool();
@@ -53,6 +56,8 @@ ctkPluginFrameworkDebug::ctkPluginFrameworkDebug(ctkProperties& props)
   startlevel = props.value(STARTLEVEL_PROP).toBool();
   url = props.value(URL_PROP).toBool();
   resolve = props.value(RESOLVE_PROP).toBool();
+  profile = props.value(PROFILE_PROP).toBool();
+  profile_file = props.value(PROFILE_FILE_PROP).toString();
 }
 
 //----------------------------------------------------------------------------
@@ -90,6 +90,20 @@ public:
   static QString RESOLVE_PROP; // = "org.commontk.pluginfw.debug.resolve";
   bool resolve;
 
+  /**
+   * Record timing data for plug-in life-cycle operations,
+   * service usage and service event dispatching.
+   */
+  static QString PROFILE_PROP; // = "org.commontk.pluginfw.debug.profile";
+  bool profile;
+
+  /**
+   * File name for writing the recorded timing data as a
+   * Chrome trace-event JSON file during framework shut down.
+   */
+  static QString PROFILE_FILE_PROP; // = "org.commontk.pluginfw.debug.profile.file";
+  QString profile_file;
+
 private:
 
   void setPropertyIfNotSet(ctkProperties& props, const QString& key, const QVariant& val);
@@ -26,6 +26,7 @@
 #include "ctkPluginConstants.h"
 #include "ctkLDAPExpr_p.h"
 #include "ctkServiceReference_p.h"
+#include "ctkPlugin.h"
 
 #include <QStringListIterator>
 #include <QDebug>
@@ -200,6 +201,23 @@ void ctkPluginFrameworkListeners::serviceChanged(
   //QStringList classes = sr.getProperty(ctkPluginConstants::OBJECTCLASS).toStringList();
   int n = 0;
 
+  ctkPluginFrameworkProfiler& profiler = pluginFw->profiler;
+  QString eventName;
+  if (profiler.isEnabled())
+  {
+    QDebug(&eventName) << evt.getType();
+    eventName = "serviceChanged " + eventName.trimmed();
+  }
+  ctkPluginFrameworkProfiler::Scope profile(&profiler, "listeners", eventName);
+  // Don't query the service properties when profiling is disabled: this
+  // is a hot path
+  if (profiler.isEnabled())
+  {
+    profile.setArg("service.id", sr.getProperty(ctkPluginConstants::SERVICE_ID));
+    profile.setArg("objectclass", sr.getProperty(ctkPluginConstants::OBJECTCLASS));
+    profile.setArg("receivers", receivers.size());
+  }
+
   //framework.hooks.filterServiceEventReceivers(evt, receivers);
 
   foreach (ctkServiceSlotEntry l, receivers)
@@ -216,7 +234,22 @@ void ctkPluginFrameworkListeners::serviceChanged(
     try
     {
       ++n;
-      l.invokeSlot(evt);
+      if (profiler.isEnabled())
+      {
+        const qint64 start = profiler.now();
+        l.invokeSlot(evt);
+        QVariantMap args;
+        QSharedPointer<ctkPlugin> plugin = l.getPlugin();
+        if (plugin)
+        {
+          args.insert("plugin", plugin->getSymbolicName());
+        }
+        profiler.addEvent("listeners", "invokeSlot", start, profiler.now(), args);
+      }
+      else
+      {
+        l.invokeSlot(evt);
+      }
     }
     catch (const ctkException& pe)
     {
@@ -238,6 +271,40 @@ void ctkPluginFrameworkListeners::serviceChanged(
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkListeners::serviceChanged(const QList<ctkServiceEvent>& events)
+{
+  ctkPluginFrameworkProfiler::Scope profile(&pluginFw->profiler, "listeners", "serviceChanged batch");
+  profile.setArg("events", events.size());
+
+  // Group the events by receiver, keeping the order in which
+  // the receivers were first matched
+  QList<ctkServiceSlotEntry> receivers;
+  QHash<ctkServiceSlotEntry, QList<ctkServiceEvent> > receiverEvents;
+  foreach (const ctkServiceEvent& evt, events)
+  {
+    foreach (const ctkServiceSlotEntry& sse, getMatchingServiceSlots(evt.getServiceReference()))
+    {
+      QList<ctkServiceEvent>& l = receiverEvents[sse];
+      if (l.isEmpty())
+      {
+        receivers.push_back(sse);
+      }
+      l.push_back(evt);
+    }
+  }
+
+  foreach (ctkServiceSlotEntry l, receivers)
+  {
+    l.invokeSlot(receiverEvents.value(l), this);
+  }
+
+  if (pluginFw->debug.ldap)
+  {
+    qDebug() << "Notified" << receivers.size() << "listeners of" << events.size() << "events";
+  }
+}
+
 //----------------------------------------------------------------------------
 void ctkPluginFrameworkListeners::removeFromCache(const ctkServiceSlotEntry& sse)
 {
@@ -94,6 +94,16 @@ public:
   void serviceChanged(const QSet<ctkServiceSlotEntry>& receivers,
                       const ctkServiceEvent& evt);
 
+  /**
+   * Deliver a batch of service events. The events matching a receiver
+   * are delivered to it in a single call (see
+   * ctkServiceSlotEntry::invokeSlot(const QList<ctkServiceEvent>&, ctkPluginFrameworkListeners*)),
+   * preserving their relative order.
+   *
+   * @param events The service events to deliver.
+   */
+  void serviceChanged(const QList<ctkServiceEvent>& events);
+
   void emitPluginChanged(const ctkPluginEvent& event);
 
   void emitFrameworkEvent(const ctkPluginFrameworkEvent& event);
@@ -0,0 +1,192 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#include "ctkPluginFrameworkProfiler_p.h"
+
+#include <ctkTracer.h>
+
+#include <QMutexLocker>
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::ServiceStatistics::ServiceStatistics()
+  : serviceId(-1), getCount(0), ungetCount(0), getTime(0), ungetTime(0)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::Scope::Scope(ctkPluginFrameworkProfiler* profiler,
+                                         const char* category,
+                                         const QString& name)
+  : profiler(profiler->isEnabled() ? profiler : 0), category(category), start(0)
+{
+  if (this->profiler)
+  {
+    this->name = name;
+    start = this->profiler->now();
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::Scope::~Scope()
+{
+  if (profiler)
+  {
+    profiler->addEvent(category, name, start, profiler->now(), args);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkProfiler::Scope::setArg(const QString& key, const QVariant& value)
+{
+  if (profiler)
+  {
+    args.insert(key, value);
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::ctkPluginFrameworkProfiler(bool enabled)
+  : enabled(enabled), tracerWasEnabled(ctkTracer::isEnabled())
+{
+  if (enabled)
+  {
+    ctkTracer::instance()->setEnabled(true);
+  }
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::~ctkPluginFrameworkProfiler()
+{
+  if (enabled && !tracerWasEnabled)
+  {
+    ctkTracer::instance()->setEnabled(false);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginFrameworkProfiler::isEnabled() const
+{
+  return enabled && ctkTracer::isEnabled();
+}
+
+//----------------------------------------------------------------------------
+qint64 ctkPluginFrameworkProfiler::now() const
+{
+  return ctkTracer::instance()->now();
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkProfiler::addEvent(const char* category, const QString& name,
+                                          qint64 start, qint64 end,
+                                          const QVariantMap& args)
+{
+  if (!isEnabled()) return;
+
+  ctkTracer::instance()->addSpan(category, name, start, end, args);
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkProfiler::addGetService(qlonglong serviceId,
+                                               const QStringList& objectClasses,
+                                               qint64 start, qint64 end)
+{
+  if (!isEnabled()) return;
+
+  QMutexLocker lock(&mutex);
+  ServiceStatistics& stats = serviceStatistics_unlocked(serviceId, objectClasses);
+  ++stats.getCount;
+  stats.getTime += end - start;
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkProfiler::addUngetService(qlonglong serviceId,
+                                                 const QStringList& objectClasses,
+                                                 qint64 start, qint64 end)
+{
+  if (!isEnabled()) return;
+
+  QMutexLocker lock(&mutex);
+  ServiceStatistics& stats = serviceStatistics_unlocked(serviceId, objectClasses);
+  ++stats.ungetCount;
+  stats.ungetTime += end - start;
+}
+
+//----------------------------------------------------------------------------
+ctkPluginFrameworkProfiler::ServiceStatistics&
+ctkPluginFrameworkProfiler::serviceStatistics_unlocked(qlonglong serviceId,
+                                                       const QStringList& objectClasses)
+{
+  ServiceStatistics& stats = services[serviceId];
+  if (stats.serviceId < 0)
+  {
+    stats.serviceId = serviceId;
+    stats.objectClasses = objectClasses;
+  }
+  return stats;
+}
+
+//----------------------------------------------------------------------------
+QList<ctkPluginFrameworkProfiler::ServiceStatistics> ctkPluginFrameworkProfiler::getServiceStatistics() const
+{
+  QMutexLocker lock(&mutex);
+  return services.values();
+}
+
+//----------------------------------------------------------------------------
+void ctkPluginFrameworkProfiler::clear()
+{
+  QMutexLocker lock(&mutex);
+  services.clear();
+}
+
+//----------------------------------------------------------------------------
+QVariantMap ctkPluginFrameworkProfiler::traceMembers() const
+{
+  QVariantList serviceStatistics;
+  foreach(const ServiceStatistics& stats, getServiceStatistics())
+  {
+    QVariantMap service;
+    service["service.id"] = stats.serviceId;
+    service["objectclass"] = stats.objectClasses;
+    service["getCount"] = stats.getCount;
+    service["getTime"] = stats.getTime;
+    service["ungetCount"] = stats.ungetCount;
+    service["ungetTime"] = stats.ungetTime;
+    serviceStatistics << service;
+  }
+
+  QVariantMap members;
+  members["serviceStatistics"] = serviceStatistics;
+  return members;
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginFrameworkProfiler::writeTraceEvents(QIODevice* device) const
+{
+  return ctkTracer::instance()->writeTraceEvents(device, traceMembers());
+}
+
+//----------------------------------------------------------------------------
+bool ctkPluginFrameworkProfiler::writeTraceEvents(const QString& fileName) const
+{
+  return ctkTracer::instance()->writeTraceEvents(fileName, traceMembers());
+}
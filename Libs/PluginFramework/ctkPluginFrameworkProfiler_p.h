@@ -0,0 +1,159 @@
+/*=============================================================================
+
+  Library: CTK
+
+  Copyright (c) German Cancer Research Center,
+    Division of Medical and Biological Informatics
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=============================================================================*/
+
+
+#ifndef CTKPLUGINFRAMEWORKPROFILER_P_H
+#define CTKPLUGINFRAMEWORKPROFILER_P_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class QIODevice;
+
+/**
+ * \ingroup PluginFramework
+ *
+ * Collects timing data about the plugin life-cycle, service usage and
+ * service event dispatching.
+ *
+ * The profiler is switched on with the framework property
+ * <code>org.commontk.pluginfw.debug.profile</code>. If
+ * <code>org.commontk.pluginfw.debug.profile.file</code> is set as well,
+ * the recorded data is written as a Chrome trace-event JSON file (which
+ * can be loaded in chrome://tracing) when the framework is shut down.
+ *
+ * Timed operations are recorded as spans of the ctkTracer, which is
+ * enabled for the life-time of an enabled profiler and restored to its
+ * previous state afterwards. The written file therefore also contains
+ * the spans recorded with CTK_TRACE_SCOPE by other libraries.
+ *
+ * All methods are thread-safe. When the profiler is disabled, the
+ * recording methods return immediately.
+ */
+class ctkPluginFrameworkProfiler
+{
+
+public:
+
+  /**
+   * Accumulated getService/ungetService data for one service.
+   */
+  struct ServiceStatistics
+  {
+    ServiceStatistics();
+
+    qlonglong serviceId;
+    QStringList objectClasses;
+    int getCount;
+    int ungetCount;
+    qint64 getTime; // in micro seconds
+    qint64 ungetTime; // in micro seconds
+  };
+
+  /**
+   * Measures the life-time of a scope and records it as a ctkTracer span.
+   * The category must be a string literal.
+   */
+  class Scope
+  {
+  public:
+    Scope(ctkPluginFrameworkProfiler* profiler, const char* category,
+          const QString& name);
+    ~Scope();
+
+    /**
+     * Attach an argument to the recorded span. Does nothing if
+     * the profiler is disabled.
+     */
+    void setArg(const QString& key, const QVariant& value);
+
+  private:
+    Q_DISABLE_COPY(Scope)
+
+    ctkPluginFrameworkProfiler* profiler;
+    const char* category;
+    QString name;
+    qint64 start;
+    QVariantMap args;
+  };
+
+  ctkPluginFrameworkProfiler(bool enabled);
+  ~ctkPluginFrameworkProfiler();
+
+  bool isEnabled() const;
+
+  /**
+   * @return The micro seconds elapsed since the creation of the ctkTracer.
+   */
+  qint64 now() const;
+
+  /**
+   * Record a span in the ctkTracer. The category must be a string literal.
+   */
+  void addEvent(const char* category, const QString& name,
+                qint64 start, qint64 end,
+                const QVariantMap& args = QVariantMap());
+
+  void addGetService(qlonglong serviceId, const QStringList& objectClasses,
+                     qint64 start, qint64 end);
+
+  void addUngetService(qlonglong serviceId, const QStringList& objectClasses,
+                       qint64 start, qint64 end);
+
+  QList<ServiceStatistics> getServiceStatistics() const;
+
+  /**
+   * Discard the service statistics. The spans are owned by the ctkTracer.
+   */
+  void clear();
+
+  /**
+   * Write the spans of the ctkTracer in the Chrome trace-event JSON format.
+   * Service statistics are written in an additional top-level
+   * <code>serviceStatistics</code> array which is ignored by trace viewers.
+   *
+   * @return <code>true</code> on success, <code>false</code> otherwise.
+   */
+  bool writeTraceEvents(QIODevice* device) const;
+
+  bool writeTraceEvents(const QString& fileName) const;
+
+private:
+
+  Q_DISABLE_COPY(ctkPluginFrameworkProfiler)
+
+  ServiceStatistics& serviceStatistics_unlocked(qlonglong serviceId,
+                                                const QStringList& objectClasses);
+
+  QVariantMap traceMembers() const;
+
+  const bool enabled;
+  const bool tracerWasEnabled;
+
+  mutable QMutex mutex;
+  QHash<qlonglong, ServiceStatistics> services;
+};
+
+#endif // CTKPLUGINFRAMEWORKPROFILER_P_H
@@ -796,6 +796,9 @@ void ctkPluginPrivate::removePluginResources()
   // automatic disconnect due to Qt signal slot
   //fwCtx->listeners.removeAllListeners(this);
 
+  // Drop a registration transaction left open by the plugin
+  fwCtx->services->clearRegistrationTransaction(this);
+
   QList<ctkServiceRegistration> srs = fwCtx->services->getRegisteredByPlugin(this);
   QMutableListIterator<ctkServiceRegistration> i(srs);
   while (i.hasNext())
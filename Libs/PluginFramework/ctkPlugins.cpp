@@ -60,6 +60,9 @@ QSharedPointer<ctkPlugin> ctkPlugins::install(const QUrl& location, QIODevice* i
 {
   checkIllegalState();
 
+  ctkPluginFrameworkProfiler::Scope profile(&fwCtx->profiler, "plugin", "install");
+  profile.setArg("location", location.toString());
+
   QSharedPointer<ctkPlugin> res;
   {
     QMutexLocker lock(&objectLock);
@@ -121,6 +124,7 @@ QSharedPointer<ctkPlugin> ctkPlugins::install(const QUrl& location, QIODevice* i
       res = QSharedPointer<ctkPlugin>(new ctkPlugin());
       res->init(res, fwCtx, pa);
       plugins.insert(location.toString(), res);
+      profile.setArg("plugin", res->getSymbolicName());
     }
     catch (const ctkException& e)
     {
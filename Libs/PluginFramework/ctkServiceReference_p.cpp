@@ -48,6 +48,23 @@ ctkServiceReferencePrivate::~ctkServiceReferencePrivate()
 
 //----------------------------------------------------------------------------
 QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin)
+{
+  ctkPluginFrameworkProfiler& profiler = plugin->d_func()->fwCtx->profiler;
+  if (!profiler.isEnabled())
+  {
+    return getService0(plugin);
+  }
+
+  const qint64 start = profiler.now();
+  QObject* s = getService0(plugin);
+  profiler.addGetService(getProperty(ctkPluginConstants::SERVICE_ID, true).toLongLong(),
+                         getProperty(ctkPluginConstants::OBJECTCLASS, true).toStringList(),
+                         start, profiler.now());
+  return s;
+}
+
+//----------------------------------------------------------------------------
+QObject* ctkServiceReferencePrivate::getService0(QSharedPointer<ctkPlugin> plugin)
 {
   QObject* s = 0;
   {
@@ -118,6 +135,23 @@ QObject* ctkServiceReferencePrivate::getService(QSharedPointer<ctkPlugin> plugin
 
 //----------------------------------------------------------------------------
 bool ctkServiceReferencePrivate::ungetService(QSharedPointer<ctkPlugin> plugin, bool checkRefCounter)
+{
+  ctkPluginFrameworkProfiler& profiler = plugin->d_func()->fwCtx->profiler;
+  if (!profiler.isEnabled())
+  {
+    return ungetService0(plugin, checkRefCounter);
+  }
+
+  const qint64 start = profiler.now();
+  bool hadReferences = ungetService0(plugin, checkRefCounter);
+  profiler.addUngetService(getProperty(ctkPluginConstants::SERVICE_ID, true).toLongLong(),
+                           getProperty(ctkPluginConstants::OBJECTCLASS, true).toStringList(),
+                           start, profiler.now());
+  return hadReferences;
+}
+
+//----------------------------------------------------------------------------
+bool ctkServiceReferencePrivate::ungetService0(QSharedPointer<ctkPlugin> plugin, bool checkRefCounter)
 {
   QMutexLocker lock(&registration->propsLock);
   bool hadReferences = false;
@@ -107,6 +107,10 @@ public:
 private:
 
   Q_DISABLE_COPY(ctkServiceReferencePrivate)
+
+  QObject* getService0(QSharedPointer<ctkPlugin> plugin);
+
+  bool ungetService0(QSharedPointer<ctkPlugin> plugin, bool checkRefCounter);
 };
 
 #endif // CTKSERVICEREFERENCEPRIVATE_H
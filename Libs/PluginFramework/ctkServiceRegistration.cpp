@@ -107,6 +107,16 @@ void ctkServiceRegistration::setProperties(const ctkDictionary& props)
 
   QMutexLocker lock(&d->eventLock);
 
+  // A REGISTERED event queued by an open registration transaction is
+  // delivered first, listeners must not see MODIFIED before it
+  if (d->available && d->plugin &&
+      d->plugin->fwCtx->services->removePendingRegistration(*this))
+  {
+    d->plugin->fwCtx->listeners.serviceChanged(
+        d->plugin->fwCtx->listeners.getMatchingServiceSlots(d->reference),
+        ctkServiceEvent(ctkServiceEvent::REGISTERED, d->reference));
+  }
+
   QSet<ctkServiceSlotEntry> before;
   // TBD, optimize the locking of services
   {
@@ -148,6 +158,10 @@ void ctkServiceRegistration::unregister()
   if (!d) throw ctkIllegalStateException("ctkServiceRegistration object invalid");
 
   if (d->unregistering) return; // Silently ignore redundant unregistration.
+  // True if the REGISTERED event is still queued by an open registration
+  // transaction: listeners never heard of the service, so they get neither
+  // event
+  bool wasPending = false;
   {
     QMutexLocker lock(&d->eventLock);
     if (d->unregistering) return;
@@ -157,6 +171,7 @@ void ctkServiceRegistration::unregister()
     {
       if (d->plugin)
       {
+        wasPending = d->plugin->fwCtx->services->removePendingRegistration(*this);
         d->plugin->fwCtx->services->removeServiceRegistration(*this);
       }
     }
@@ -166,7 +181,7 @@ void ctkServiceRegistration::unregister()
     }
   }
 
-  if (d->plugin)
+  if (d->plugin && !wasPending)
   {
      d->plugin->fwCtx->listeners.serviceChanged(
          d->plugin->fwCtx->listeners.getMatchingServiceSlots(d->reference),
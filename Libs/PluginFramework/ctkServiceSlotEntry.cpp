@@ -24,7 +24,9 @@
 
 #include "ctkLDAPExpr_p.h"
 #include "ctkPlugin.h"
+#include "ctkPluginFrameworkListeners_p.h"
 #include "ctkException.h"
+#include "ctkTrackedServiceListener_p.h"
 
 #include <QSharedData>
 
@@ -134,6 +136,47 @@ void ctkServiceSlotEntry::invokeSlot(const ctkServiceEvent &event)
   }
 }
 
+//----------------------------------------------------------------------------
+void ctkServiceSlotEntry::invokeSlot(const QList<ctkServiceEvent>& events,
+                                     ctkPluginFrameworkListeners* listeners)
+{
+  // Service trackers process the whole batch at once
+  ctkTrackedServiceListener* trackedListener = qobject_cast<ctkTrackedServiceListener*>(d->receiver);
+  if (trackedListener && d->slot && std::strcmp(d->slot, "serviceChanged") == 0)
+  {
+    try
+    {
+      trackedListener->serviceChanged(events);
+    }
+    catch (const ctkException& pe)
+    {
+      listeners->frameworkError(d->plugin, pe);
+    }
+    catch (const std::exception& e)
+    {
+      listeners->frameworkError(d->plugin, ctkRuntimeException(e.what()));
+    }
+    return;
+  }
+
+  // A failing event must not prevent the delivery of the following ones
+  foreach (const ctkServiceEvent& event, events)
+  {
+    try
+    {
+      invokeSlot(event);
+    }
+    catch (const ctkException& pe)
+    {
+      listeners->frameworkError(d->plugin, pe);
+    }
+    catch (const std::exception& e)
+    {
+      listeners->frameworkError(d->plugin, ctkRuntimeException(e.what()));
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void ctkServiceSlotEntry::setRemoved(bool removed)
 {
@@ -34,6 +34,7 @@
 #include "ctkLDAPExpr_p.h"
 
 class ctkPlugin;
+class ctkPluginFrameworkListeners;
 class ctkServiceSlotEntryData;
 
 class QObject;
@@ -66,6 +67,16 @@ public:
 
   void invokeSlot(const ctkServiceEvent& event);
 
+  /**
+   * Deliver a batch of events. Receivers which are service trackers
+   * get the whole batch in one call, other receivers get one slot
+   * invocation per event. An exception thrown for an event is reported
+   * with ctkPluginFrameworkListeners::frameworkError() and the remaining
+   * events are still delivered.
+   */
+  void invokeSlot(const QList<ctkServiceEvent>& events,
+                  ctkPluginFrameworkListeners* listeners);
+
   void setRemoved(bool removed);
 
   bool isRemoved() const;
@@ -126,6 +126,13 @@ ctkServiceRegistration ctkServices::registerService(ctkPluginPrivate* plugin,
           std::lower_bound(s.begin(), s.end(), res, ServiceRegistrationComparator());
       s.insert(ip, res);
     }
+
+    if (transactionDepth.value(plugin) > 0)
+    {
+      // The event is delivered by commitRegistrationTransaction()
+      pendingRegistrations[plugin].push_back(res);
+      return res;
+    }
   }
 
   ctkServiceReference r = res.getReference();
@@ -135,6 +142,69 @@ ctkServiceRegistration ctkServices::registerService(ctkPluginPrivate* plugin,
   return res;
 }
 
+//----------------------------------------------------------------------------
+void ctkServices::beginRegistrationTransaction(ctkPluginPrivate* plugin)
+{
+  QMutexLocker lock(&mutex);
+  ++transactionDepth[plugin];
+}
+
+//----------------------------------------------------------------------------
+void ctkServices::commitRegistrationTransaction(ctkPluginPrivate* plugin)
+{
+  QList<ctkServiceEvent> events;
+  {
+    QMutexLocker lock(&mutex);
+    QHash<ctkPluginPrivate*, int>::iterator depth = transactionDepth.find(plugin);
+    if (depth == transactionDepth.end())
+    {
+      throw ctkIllegalStateException("No service registration transaction to commit");
+    }
+    if (--depth.value() > 0)
+    {
+      return;
+    }
+    transactionDepth.erase(depth);
+
+    QList<ctkServiceRegistration> registrations = pendingRegistrations.take(plugin);
+    events.reserve(registrations.size());
+    foreach (const ctkServiceRegistration& sr, registrations)
+    {
+      // Skip services which were unregistered during the transaction
+      if (services.contains(sr) && sr.d_func()->available)
+      {
+        events.push_back(ctkServiceEvent(ctkServiceEvent::REGISTERED, sr.getReference()));
+      }
+    }
+  }
+
+  if (!events.isEmpty())
+  {
+    plugin->fwCtx->listeners.serviceChanged(events);
+  }
+}
+
+//----------------------------------------------------------------------------
+void ctkServices::clearRegistrationTransaction(ctkPluginPrivate* plugin)
+{
+  QMutexLocker lock(&mutex);
+  transactionDepth.remove(plugin);
+  pendingRegistrations.remove(plugin);
+}
+
+//----------------------------------------------------------------------------
+bool ctkServices::removePendingRegistration(const ctkServiceRegistration& sr)
+{
+  QMutexLocker lock(&mutex);
+  QHash<ctkPluginPrivate*, QList<ctkServiceRegistration> >::iterator pending =
+      pendingRegistrations.find(sr.d_func()->plugin);
+  if (pending == pendingRegistrations.end())
+  {
+    return false;
+  }
+  return pending.value().removeOne(sr);
+}
+
 //----------------------------------------------------------------------------
 void ctkServices::updateServiceRegistrationOrder(const ctkServiceRegistration& sr,
                                               const QStringList& classes)
@@ -100,6 +100,49 @@ public:
                                const ctkDictionary& properties);
 
 
+  /**
+   * Start a registration transaction for the given plugin. Until the
+   * matching call to commitRegistrationTransaction(), the REGISTERED
+   * service events for services registered by the plugin are queued.
+   * Transactions can be nested; the events are delivered when the
+   * outermost transaction is committed.
+   *
+   * @param plugin The plugin registering the services.
+   */
+  void beginRegistrationTransaction(ctkPluginPrivate* plugin);
+
+  /**
+   * Commit a registration transaction for the given plugin. When the
+   * outermost transaction is committed, the queued REGISTERED service
+   * events for services which are still registered are delivered in a
+   * single batch, see ctkPluginFrameworkListeners::serviceChanged(const QList<ctkServiceEvent>&).
+   *
+   * @param plugin The plugin registering the services.
+   * @exception ctkIllegalStateException If there is no open transaction
+   *            for the plugin.
+   */
+  void commitRegistrationTransaction(ctkPluginPrivate* plugin);
+
+  /**
+   * Discard any open registration transaction of the given plugin without
+   * delivering its queued events. Used when the plugin is stopped.
+   *
+   * @param plugin The plugin whose transactions are discarded.
+   */
+  void clearRegistrationTransaction(ctkPluginPrivate* plugin);
+
+  /**
+   * Remove a service registration from the queued REGISTERED events of
+   * an open registration transaction. Called before a MODIFIED or an
+   * UNREGISTERING event is sent for the service, so that listeners never
+   * see these events before the REGISTERED one.
+   *
+   * @param sr The ctkServiceRegistration object.
+   * @return <code>true</code> if the REGISTERED event for the service was
+   *         still queued, <code>false</code> otherwise.
+   */
+  bool removePendingRegistration(const ctkServiceRegistration& sr);
+
   /**
    * Service ranking changed, reorder registered services
    * according to ranking.
@@ -181,6 +224,17 @@ public:
 
 private:
 
+  /**
+   * Nesting depth of open registration transactions per plugin.
+   */
+  QHash<ctkPluginPrivate*, int> transactionDepth;
+
+  /**
+   * Services registered during an open registration transaction
+   * per plugin, in registration order.
+   */
+  QHash<ctkPluginPrivate*, QList<ctkServiceRegistration> > pendingRegistrations;
+
   QList<ctkServiceReference> get_unlocked(const QString& clazz, const QString& filter,
                                           ctkPluginPrivate* plugin) const;
 
@@ -25,7 +25,8 @@
 template<class S, class T>
 ctkTrackedService<S,T>::ctkTrackedService(ctkServiceTracker<S,T>* serviceTracker,
                   ctkServiceTrackerCustomizer<T>* customizer)
-  : serviceTracker(serviceTracker), customizer(customizer)
+  : serviceTracker(serviceTracker), customizer(customizer),
+    batchDepth(0), batchModified(false)
 {
 
 }
@@ -95,12 +96,91 @@ void ctkTrackedService<S,T>::serviceChanged(const ctkServiceEvent& event)
   }
 }
 
+//----------------------------------------------------------------------------
+template<class S, class T>
+void ctkTrackedService<S,T>::serviceChanged(const QList<ctkServiceEvent>& events)
+{
+  if (this->closed)
+  {
+    return;
+  }
+
+  if (serviceTracker->d_func()->DEBUG)
+  {
+    qDebug() << "ctkTrackedService::serviceChanged[batch]:" << events.size() << "events";
+  }
+
+  {
+    QMutexLocker lock(this);
+    ++batchDepth;
+  }
+
+  QList<typename Superclass::Change> changes;
+  foreach (const ctkServiceEvent& event, events)
+  {
+    typename Superclass::Change change;
+    change.item = event.getServiceReference();
+    change.related = event;
+    switch (event.getType())
+    {
+    case ctkServiceEvent::REGISTERED :
+    case ctkServiceEvent::MODIFIED :
+      // a service listener added with a filter only receives matching events
+      change.track = !serviceTracker->d_func()->listenerFilter.isNull() ||
+                     serviceTracker->d_func()->filter.match(change.item);
+      break;
+    case ctkServiceEvent::MODIFIED_ENDMATCH :
+    case ctkServiceEvent::UNREGISTERING :
+    default:
+      change.track = false;
+      break;
+    }
+    changes.push_back(change);
+  }
+
+  try
+  {
+    /*
+     * Track and untrack the references of the whole batch at once. If
+     * the customizer throws an unchecked exception, it is safe to let it
+     * propagate
+     */
+    this->trackBatch(changes);
+  }
+  catch (...)
+  {
+    endBatch();
+    throw;
+  }
+  endBatch();
+}
+
+//----------------------------------------------------------------------------
+template<class S, class T>
+void ctkTrackedService<S,T>::endBatch()
+{
+  QMutexLocker lock(this);
+  if (--batchDepth == 0 && batchModified)
+  {
+    batchModified = false;
+    serviceTracker->d_func()->modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 template<class S, class T>
 void ctkTrackedService<S,T>::modified()
 {
   Superclass::modified(); /* increment the modification count */
-  serviceTracker->d_func()->modified();
+  if (batchDepth > 0)
+  {
+    /* the tracker is notified at the end of the batch */
+    batchModified = true;
+  }
+  else
+  {
+    serviceTracker->d_func()->modified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -24,6 +24,7 @@
 #define CTKTRACKEDSERVICELISTENER_P_H
 
 #include <QObject>
+#include <QList>
 
 #include "ctkServiceEvent.h"
 
@@ -50,6 +51,17 @@ public Q_SLOTS:
    */
   virtual void serviceChanged(const ctkServiceEvent& event) = 0;
 
+public:
+
+  /**
+   * Receives a batch of service events, delivered when a service
+   * registration transaction is committed.
+   *
+   * @param events The <code>ctkServiceEvent</code> objects from the framework,
+   *        in the order they occurred.
+   */
+  virtual void serviceChanged(const QList<ctkServiceEvent>& events) = 0;
+
 };
 
 #endif // CTKTRACKEDSERVICELISTENER_P_H
@@ -48,6 +48,16 @@ public:
    */
   void serviceChanged(const ctkServiceEvent& event);
 
+  /**
+   * Process a batch of service events. Only the last event of each
+   * service reference is tracked, the tracked references are updated
+   * at once and the tracker's cached service reference and object are
+   * only invalidated after the whole batch.
+   *
+   * @param events <code>ctkServiceEvent</code> objects from the framework.
+   */
+  void serviceChanged(const QList<ctkServiceEvent>& events);
+
 private:
 
   typedef ctkPluginAbstractTracked<ctkServiceReference, T, ctkServiceEvent> Superclass;
@@ -55,6 +65,26 @@ private:
   ctkServiceTracker<S,T>* serviceTracker;
   ctkServiceTrackerCustomizer<T>* customizer;
 
+  /**
+   * Number of batches currently being processed.
+   *
+   * @GuardedBy this
+   */
+  int batchDepth;
+
+  /**
+   * Set if a modification happened while processing a batch.
+   *
+   * @GuardedBy this
+   */
+  bool batchModified;
+
+  /**
+   * Finish processing a batch and invalidate the tracker's cache
+   * if a modification happened during the batch.
+   */
+  void endBatch();
+
   /**
    * Increment the tracking count and tell the tracker there was a
    * modification.
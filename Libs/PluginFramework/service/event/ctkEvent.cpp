@@ -24,6 +24,95 @@
 #include "ctkEventConstants.h"
 
 #include <ctkException.h>
+#include <ctkLDAPExpr_p.h>
+
+#include <QAtomicPointer>
+#include <QReadWriteLock>
+#include <QSet>
+
+namespace {
+
+// Upper bound for the number of interned strings, protecting
+// against unbounded growth with dynamically generated names.
+const int MaxInternedStrings = 4096;
+
+QReadWriteLock internLock;
+QSet<QString> internedKeys;
+QSet<QString> validatedTopics;
+
+//----------------------------------------------------------------------------
+// Returns a string sharing its data with all previously interned
+// equal strings from the given table.
+QString intern(QSet<QString>& table, const QString& str)
+{
+  {
+    QReadLocker lock(&internLock);
+    QSet<QString>::const_iterator it = table.constFind(str);
+    if (it != table.constEnd()) return *it;
+  }
+
+  QWriteLocker lock(&internLock);
+  if (table.size() >= MaxInternedStrings) return str;
+  return *table.insert(str);
+}
+
+}
+
+//----------------------------------------------------------------------------
+ctkEventProperties::ctkEventProperties()
+  : inlineCount(0)
+{
+}
+
+//----------------------------------------------------------------------------
+ctkEventProperties& ctkEventProperties::insert(const QString& key, const QVariant& value)
+{
+  for (int i = 0; i < inlineCount; ++i)
+  {
+    if (inlineKeys[i] == key)
+    {
+      inlineValues[i] = value;
+      return *this;
+    }
+  }
+
+  if (inlineCount < InlineCapacity)
+  {
+    inlineKeys[inlineCount] = intern(internedKeys, key);
+    inlineValues[inlineCount] = value;
+    ++inlineCount;
+  }
+  else
+  {
+    overflow.insert(key, value);
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+int ctkEventProperties::size() const
+{
+  return inlineCount + overflow.size();
+}
+
+//----------------------------------------------------------------------------
+const QVariant* ctkEventProperties::find(const QString& key) const
+{
+  for (int i = 0; i < inlineCount; ++i)
+  {
+    if (inlineKeys[i] == key)
+    {
+      return &inlineValues[i];
+    }
+  }
+
+  ctkDictionary::const_iterator it = overflow.constFind(key);
+  if (it != overflow.constEnd())
+  {
+    return &it.value();
+  }
+  return 0;
+}
 
 class ctkEventData : public QSharedData
 {
@@ -31,10 +120,41 @@ class ctkEventData : public QSharedData
 public:
 
   ctkEventData(const QString& topic, const ctkDictionary& properties)
-    : topic(topic), properties(properties)
+    : topic(internTopic(topic)), dictionary(0)
+  {
+    // Implicitly shared, no copy of the hash table is made
+    this->properties.overflow = properties;
+  }
+
+  ctkEventData(const QString& topic, const ctkEventProperties& properties)
+    : topic(internTopic(topic)), properties(properties), dictionary(0)
   {
+  }
+
+  ctkEventData(const ctkEventData& other)
+    : QSharedData(other), topic(other.topic), properties(other.properties),
+      dictionary(0)
+  {
+  }
+
+  ~ctkEventData()
+  {
+    delete static_cast<ctkDictionary*>(dictionary);
+  }
+
+  /**
+   * Validates the topic name, unless it was validated before, and
+   * returns the interned topic.
+   */
+  static QString internTopic(const QString& topic)
+  {
+    {
+      QReadLocker lock(&internLock);
+      QSet<QString>::const_iterator it = validatedTopics.constFind(topic);
+      if (it != validatedTopics.constEnd()) return *it;
+    }
     validateTopicName(topic);
-    this->properties.insert(ctkEventConstants::EVENT_TOPIC, topic);
+    return intern(validatedTopics, topic);
   }
 
   static void validateTopicName(const QString& topic)
@@ -66,9 +186,62 @@ public:
     }
   }
 
+  /**
+   * Returns all properties including the topic. The dictionary is created
+   * lazily and shared by all handlers receiving this event.
+   */
+  const ctkDictionary& getDictionary() const
+  {
+    ctkDictionary* dict = dictionary;
+    if (dict) return *dict;
+
+    dict = new ctkDictionary(properties.overflow);
+    for (int i = 0; i < properties.inlineCount; ++i)
+    {
+      dict->insert(properties.inlineKeys[i], properties.inlineValues[i]);
+    }
+    dict->insert(ctkEventConstants::EVENT_TOPIC, topic);
+
+    if (!dictionary.testAndSetOrdered(0, dict))
+    {
+      // Another thread was faster
+      delete dict;
+      dict = dictionary;
+    }
+    return *dict;
+  }
+
   const QString topic;
-  ctkDictionary properties;
+  ctkEventProperties properties;
+
+  mutable QAtomicPointer<ctkDictionary> dictionary;
+
+};
+
+//----------------------------------------------------------------------------
+// Reads the event properties matched by a filter without building
+// the full property dictionary.
+class ctkEventPropertyLookup : public ctkLDAPPropertyLookup
+{
+public:
+
+  ctkEventPropertyLookup(const ctkEventData& data)
+    : data(data)
+  {}
+
+  QVariant value(const QString& key) const
+  {
+    if (ctkEventConstants::EVENT_TOPIC == key)
+    {
+      return data.topic;
+    }
+    const QVariant* value = data.properties.find(key);
+    return value ? *value : QVariant();
+  }
 
+private:
+
+  const ctkEventData& data;
 };
 
 //----------------------------------------------------------------------------
@@ -85,6 +258,13 @@ ctkEvent::ctkEvent(const QString& topic, const ctkDictionary& properties)
 
 }
 
+//----------------------------------------------------------------------------
+ctkEvent::ctkEvent(const QString& topic, const ctkEventProperties& properties)
+  : d(new ctkEventData(topic, properties))
+{
+
+}
+
 //----------------------------------------------------------------------------
 // This is fast thanks to implicit sharing
 ctkEvent::ctkEvent(const ctkEvent &event)
@@ -117,8 +297,11 @@ bool ctkEvent::operator==(const ctkEvent& other) const
   if (d == other.d)
     return true;
 
+  if (!d || !other.d)
+    return false;
+
   if (d->topic == other.d->topic &&
-      d->properties == other.d->properties)
+      d->getDictionary() == other.d->getDictionary())
     return true;
 
   return false;
@@ -127,7 +310,12 @@ bool ctkEvent::operator==(const ctkEvent& other) const
 //----------------------------------------------------------------------------
 QVariant ctkEvent::getProperty(const QString& name) const
 {
-  return d->properties[name];
+  if (ctkEventConstants::EVENT_TOPIC == name)
+  {
+    return d->topic;
+  }
+  const QVariant* value = d->properties.find(name);
+  return value ? *value : QVariant();
 }
 
 //----------------------------------------------------------------------------
@@ -137,13 +325,19 @@ bool ctkEvent::containsProperty(const QString& name) const
   {
    return true;
   }
-  return d->properties.contains(name);
+  return d->properties.find(name) != 0;
 }
 
 //----------------------------------------------------------------------------
 QStringList ctkEvent::getPropertyNames() const
 {
-  return d->properties.keys();
+  return d->getDictionary().keys();
+}
+
+//----------------------------------------------------------------------------
+ctkDictionary ctkEvent::getProperties() const
+{
+  return d->getDictionary();
 }
 
 //----------------------------------------------------------------------------
@@ -155,5 +349,5 @@ const QString& ctkEvent::getTopic() const
 //----------------------------------------------------------------------------
 bool ctkEvent::matches(const ctkLDAPSearchFilter& filter) const
 {
-  return filter.matchCase(d->properties);
+  return filter.matchCase(ctkEventPropertyLookup(*d));
 }
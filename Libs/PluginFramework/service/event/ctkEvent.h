@@ -33,6 +33,63 @@
 
 class ctkEventData;
 
+/**
+ * \ingroup EventAdmin
+ *
+ * A compact set of event properties.
+ *
+ * Up to <code>InlineCapacity</code> properties are stored inline, without
+ * allocating a hash table. Property names are interned, so equal names
+ * share their string data and compare quickly. Use this class instead of a
+ * <code>ctkDictionary</code> to create high-rate events with a handful of
+ * (scalar) properties:
+ *
+ * \code
+ * ctkEvent event("org/commontk/progress",
+ *                ctkEventProperties().insert("value", 42).insert("done", false));
+ * \endcode
+ *
+ * Properties exceeding the inline capacity are stored in a
+ * <code>ctkDictionary</code>.
+ */
+class CTK_PLUGINFW_EXPORT ctkEventProperties
+{
+
+public:
+
+  enum { InlineCapacity = 4 };
+
+  ctkEventProperties();
+
+  /**
+   * Inserts a property. An existing property with the same name
+   * is replaced.
+   *
+   * @param key The property name.
+   * @param value The property value.
+   * @return A reference to this object.
+   */
+  ctkEventProperties& insert(const QString& key, const QVariant& value);
+
+  /**
+   * @return The number of properties.
+   */
+  int size() const;
+
+private:
+
+  friend class ctkEvent;
+  friend class ctkEventData;
+
+  const QVariant* find(const QString& key) const;
+
+  int inlineCount;
+  QString inlineKeys[InlineCapacity];
+  QVariant inlineValues[InlineCapacity];
+
+  ctkDictionary overflow;
+};
+
 /**
  * \ingroup EventAdmin
  *
@@ -72,6 +129,18 @@ public:
    * @throws ctkInvalidArgumentException If topic is not a valid topic name.
    */
   ctkEvent(const QString& topic, const ctkDictionary& properties = ctkDictionary());
+
+  /**
+   * Constructs an event with compactly stored properties. This avoids
+   * creating a hash table for each event and is the preferred way for
+   * creating high-rate events.
+   *
+   * @param topic The topic of the event.
+   * @param properties The event's properties.
+   * @throws ctkInvalidArgumentException If topic is not a valid topic name.
+   */
+  ctkEvent(const QString& topic, const ctkEventProperties& properties);
+
   ctkEvent(const ctkEvent& event);
 
   ctkEvent& operator=(const ctkEvent& other);
@@ -117,6 +186,16 @@ public:
    */
   QStringList getPropertyNames() const;
 
+  /**
+   * Returns all properties of this event, including the event topic
+   * property &quot;event.topics&quot;. For events constructed from
+   * <code>ctkEventProperties</code>, the dictionary is created on the
+   * first call and shared afterwards.
+   *
+   * @return The properties of this event.
+   */
+  ctkDictionary getProperties() const;
+
   /**
    * Returns the topic of this event.
    *
@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QColor>
+#include <QCoreApplication>
+#include <QList>
+
+// CTKVTK includes
+#include "ctkVTKColorTransferFunction.h"
+#include "ctkVTKPiecewiseFunction.h"
+
+// VTK includes
+#include <vtkColorTransferFunction.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkVTKColorTransferFunctionTest2( int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+
+  //----------------------------------------------------------------------
+  // Color transfer function with many points
+  //----------------------------------------------------------------------
+  vtkSmartPointer<vtkColorTransferFunction> colorTransferFunction =
+    vtkSmartPointer<vtkColorTransferFunction>::New();
+  for (int i = 0; i <= 1000; ++i)
+    {
+    colorTransferFunction->AddRGBPoint(i, i / 1000., i / 1000., 1. - i / 1000.);
+    }
+  ctkVTKColorTransferFunction colorFunction(colorTransferFunction);
+
+  if (colorFunction.colorTable().count() != ctkVTKColorTransferFunction::tableSize())
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with colorTable(): "
+              << colorFunction.colorTable().count() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  qreal minRange = 0.;
+  qreal maxRange = 0.;
+  colorFunction.range(minRange, maxRange);
+  if (minRange != 0. || maxRange != 1000.)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with range(): "
+              << minRange << " " << maxRange << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if (colorFunction.minValue().value<QColor>() != QColor::fromRgbF(0., 0., 1.) ||
+      colorFunction.maxValue().value<QColor>() != QColor::fromRgbF(1., 1., 0.))
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with minValue()/maxValue()"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // value() evaluates the function, whatever the color space and the
+  // midpoint and sharpness of the nodes.
+  vtkSmartPointer<vtkColorTransferFunction> sharpTransferFunction =
+    vtkSmartPointer<vtkColorTransferFunction>::New();
+  sharpTransferFunction->AddRGBPoint(0., 1., 0., 0., 0.2, 0.8);
+  sharpTransferFunction->AddRGBPoint(100., 0., 1., 0., 0.7, 0.3);
+  sharpTransferFunction->AddRGBPoint(200., 0., 0., 1.);
+  ctkVTKColorTransferFunction sharpFunction(sharpTransferFunction);
+  QList<vtkColorTransferFunction*> transferFunctions;
+  transferFunctions << colorTransferFunction << sharpTransferFunction;
+  QList<ctkVTKColorTransferFunction*> functions;
+  functions << &colorFunction << &sharpFunction;
+  for (int colorSpace = VTK_CTF_RGB; colorSpace <= VTK_CTF_LAB; ++colorSpace)
+    {
+    for (int f = 0; f < functions.count(); ++f)
+      {
+      transferFunctions[f]->SetColorSpace(colorSpace);
+      for (qreal pos = -10.; pos <= 1010.; pos += 0.37)
+        {
+        double rgb[3];
+        transferFunctions[f]->GetColor(pos, rgb);
+        if (functions[f]->value(pos).value<QColor>() != QColor::fromRgbF(rgb[0], rgb[1], rgb[2]))
+          {
+          std::cerr << "Line " << __LINE__ << " - Problem with value(" << pos << ")"
+                    << " in color space " << colorSpace << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  colorTransferFunction->SetColorSpaceToRGB();
+
+  // Modifying the function invalidates the table
+  int version = colorFunction.tableVersion();
+  colorTransferFunction->RemoveAllPoints();
+  colorTransferFunction->AddRGBPoint(-10., 0., 0., 0.);
+  colorTransferFunction->AddRGBPoint(10., 1., 0.5, 0.);
+  if (colorFunction.tableVersion() <= version)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with tableVersion()" << std::endl;
+    return EXIT_FAILURE;
+    }
+  colorFunction.range(minRange, maxRange);
+  QColor middleColor = colorFunction.value(0.).value<QColor>();
+  if (minRange != -10. || maxRange != 10. ||
+      std::abs(middleColor.redF() - 0.5) > 0.01 ||
+      std::abs(middleColor.greenF() - 0.25) > 0.01 ||
+      colorFunction.colorTable().last() != qRgb(255, 128, 0))
+    {
+    std::cerr << "Line " << __LINE__ << " - Table not updated: "
+              << minRange << " " << maxRange << " "
+              << middleColor.redF() << " " << middleColor.greenF() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //----------------------------------------------------------------------
+  // Piecewise function
+  //----------------------------------------------------------------------
+  vtkSmartPointer<vtkPiecewiseFunction> piecewiseFunction =
+    vtkSmartPointer<vtkPiecewiseFunction>::New();
+  piecewiseFunction->AddPoint(0., 0.2);
+  piecewiseFunction->AddPoint(100., 0.8);
+  ctkVTKPiecewiseFunction opacityFunction(piecewiseFunction);
+
+  if (opacityFunction.table().count() != ctkVTKPiecewiseFunction::tableSize() ||
+      opacityFunction.minValue().toDouble() != 0.2 ||
+      opacityFunction.maxValue().toDouble() != 0.8 ||
+      std::abs(opacityFunction.value(50.).toDouble() - 0.5) > 1e-6)
+    {
+    std::cerr << "Line " << __LINE__ << " - Problem with ctkVTKPiecewiseFunction: "
+              << opacityFunction.value(50.).toDouble() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  version = opacityFunction.tableVersion();
+  piecewiseFunction->AddPoint(50., 1.);
+  if (opacityFunction.tableVersion() <= version ||
+      opacityFunction.maxValue().toDouble() != 1. ||
+      opacityFunction.value(50.).toDouble() != 1.)
+    {
+    std::cerr << "Line " << __LINE__ << " - Table not updated: "
+              << opacityFunction.value(50.).toDouble() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  piecewiseFunction->RemoveAllPoints();
+  piecewiseFunction->AddPoint(0., 0.2, 0.3, 0.9);
+  piecewiseFunction->AddPoint(100., 0.8, 0.5, 0.);
+  for (qreal pos = -10.; pos <= 110.; pos += 0.37)
+    {
+    if (opacityFunction.value(pos).toDouble() != piecewiseFunction->GetValue(pos))
+      {
+      std::cerr << "Line " << __LINE__ << " - Problem with value(" << pos << ")"
+                << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
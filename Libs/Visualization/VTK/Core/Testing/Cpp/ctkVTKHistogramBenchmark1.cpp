@@ -0,0 +1,139 @@
+
+// Qt includes
+#include <QCoreApplication>
+#include <QScopedPointer>
+#include <QVector>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+
+// CTKVTK includes
+#include "ctkVTKHistogram.h"
+
+// VTK includes
+#include <vtkSmartPointer.h>
+#include <vtkDataArray.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// Smooth volume with some noise, similar to an image intensity distribution
+template <class T>
+void fillVolume(T* ptr, int dimension, double scale)
+{
+  unsigned int seed = 1;
+  for (int k = 0; k < dimension; ++k)
+    {
+    for (int j = 0; j < dimension; ++j)
+      {
+      for (int i = 0; i < dimension; ++i)
+        {
+        seed = seed * 1103515245u + 12345u;
+        double noise = static_cast<double>((seed >> 16) & 0xff) / 255.;
+        double value = (static_cast<double>(i + j + k) / (3 * dimension) * 0.8 + noise * 0.2) * scale;
+        *ptr++ = static_cast<T>(value);
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+QVector<int> bins(ctkVTKHistogram& histogram)
+{
+  QVector<int> values(histogram.count());
+  for (int i = 0; i < histogram.count(); ++i)
+    {
+    QScopedPointer<ctkControlPoint> point(histogram.controlPoint(i));
+    values[i] = point->value().toInt();
+    }
+  return values;
+}
+
+//-----------------------------------------------------------------------------
+qint64 buildTime(ctkVTKHistogram& histogram, int numberOfThreads, int samplingStride)
+{
+  histogram.setNumberOfThreads(numberOfThreads);
+  histogram.setSamplingStride(samplingStride);
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  histogram.build();
+  return timer.elapsedMicro();
+}
+
+//-----------------------------------------------------------------------------
+bool benchmarkVolume(int dataType, int dimension, double scale, int numberOfBins)
+{
+  vtkSmartPointer<vtkDataArray> dataArray;
+  dataArray.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  const vtkIdType numberOfTuples = static_cast<vtkIdType>(dimension) * dimension * dimension;
+  dataArray->SetNumberOfTuples(numberOfTuples);
+  switch(dataType)
+    {
+    vtkTemplateMacro(fillVolume<VTK_TT>(
+      static_cast<VTK_TT*>(dataArray->GetVoidPointer(0)), dimension, scale));
+    }
+
+  ctkVTKHistogram histogram(dataArray);
+  histogram.setNumberOfBins(numberOfBins);
+
+  qint64 singleThreadTime = buildTime(histogram, 1, 1);
+  QVector<int> referenceBins = bins(histogram);
+
+  qint64 multiThreadTime = buildTime(histogram, 0, 1);
+  if (bins(histogram) != referenceBins)
+    {
+    std::cerr << "Multithreaded histogram of " << dataArray->GetDataTypeAsString()
+              << " differs from the single threaded histogram" << std::endl;
+    return false;
+    }
+
+  vtkIdType binSum = 0;
+  foreach(int count, referenceBins)
+    {
+    binSum += count;
+    }
+  if (binSum != numberOfTuples)
+    {
+    std::cerr << "Wrong number of values in the histogram of " << dataArray->GetDataTypeAsString()
+              << " (expected " << numberOfTuples << " got " << binSum << ")" << std::endl;
+    return false;
+    }
+
+  const int samplingStride = 8;
+  qint64 sampledTime = buildTime(histogram, 0, samplingStride);
+
+  std::cout << dataArray->GetDataTypeAsString() << " " << dimension << "^3, "
+            << histogram.count() << " bins:"
+            << " 1 thread " << singleThreadTime << " us,"
+            << " all threads " << multiThreadTime << " us,"
+            << " sampled 1/" << samplingStride << " " << sampledTime << " us" << std::endl;
+  return true;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkVTKHistogramBenchmark1( int argc, char * argv [])
+{
+  QCoreApplication app(argc, argv);
+
+  const int dimensions[] = {64, 128, 256};
+  for (int i = 0; i < 3; ++i)
+    {
+    // Regular bins (one bin per value) and irregular bins
+    if (!benchmarkVolume(VTK_UNSIGNED_CHAR, dimensions[i], 255., -1) ||
+        !benchmarkVolume(VTK_SHORT, dimensions[i], 4095., -1) ||
+        !benchmarkVolume(VTK_SHORT, dimensions[i], 4095., 256) ||
+        !benchmarkVolume(VTK_FLOAT, dimensions[i], 1000., 256))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
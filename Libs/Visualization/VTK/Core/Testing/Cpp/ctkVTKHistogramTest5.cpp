@@ -0,0 +1,168 @@
+
+// Qt includes
+#include <QCoreApplication>
+
+// CTKVTK includes
+#include "ctkVTKHistogram.h"
+
+// VTK includes
+#include <vtkSmartPointer.h>
+#include <vtkShortArray.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+bool checkSameBins(ctkVTKHistogram& histogram, ctkVTKHistogram& reference, int line)
+{
+  if (histogram.count() != reference.count())
+    {
+    std::cerr << "Line : " << line << " - Wrong number of bins: "
+              << histogram.count() << " instead of " << reference.count()
+              << std::endl;
+    return false;
+    }
+  for (int value = 0; value < 100; ++value)
+    {
+    if (histogram.value(value).toInt() != reference.value(value).toInt())
+      {
+      std::cerr << "Line : " << line << " - Wrong bin for " << value << ": "
+                << histogram.value(value).toInt() << " instead of "
+                << reference.value(value).toInt() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKHistogramTest5( int argc, char * argv [])
+{
+  Q_UNUSED(argc);
+  Q_UNUSED(argv);
+
+//---------------------------------------------------
+// test 5 : incremental updates and percentiles
+//---------------------------------------------------
+
+  // 10x10x10 image, values between 0 and 99. The extent does not start
+  // at 0, like the extent of a cropped image.
+  const int wholeExtent[6] = {-5, 4, 10, 19, 0, 9};
+  const int dimensions[3] = {10, 10, 10};
+  vtkSmartPointer<vtkShortArray> dataArray = vtkSmartPointer<vtkShortArray>::New();
+  for (int i = 0; i < 1000; ++i)
+    {
+    dataArray->InsertNextValue(i % 100);
+    }
+
+  ctkVTKHistogram histogram;
+  histogram.setDataArray(dataArray);
+  histogram.build();
+
+  //------Test aboutToModifyTuples-------------------
+  histogram.aboutToModifyTuples(10, 10);
+  for (int i = 10; i < 20; ++i)
+    {
+    dataArray->SetValue(i, 50);
+    }
+  histogram.build();
+
+  ctkVTKHistogram reference;
+  reference.setDataArray(dataArray);
+  reference.build();
+  if (!checkSameBins(histogram, reference, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+  if (histogram.value(50).toInt() != 20 || histogram.value(15).toInt() != 9)
+    {
+    std::cerr << "Line : " << __LINE__ << " - Wrong incremental update: "
+              << histogram.value(50).toInt() << " "
+              << histogram.value(15).toInt() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //------Test aboutToModifyExtent-------------------
+  const int extent[6] = {-3, -1, 13, 15, 1, 2};
+  histogram.aboutToModifyExtent(extent, wholeExtent);
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      for (int i = extent[0]; i <= extent[1]; ++i)
+        {
+        dataArray->SetValue(((k - wholeExtent[4]) * dimensions[1] + (j - wholeExtent[2]))
+                            * dimensions[0] + (i - wholeExtent[0]), 7);
+        }
+      }
+    }
+  histogram.build();
+  reference.build();
+  if (!checkSameBins(histogram, reference, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  //------Test overlapping modifications-------------
+  // The tuples 25 to 34 are modified twice, 30 to 34 three times, and the
+  // extent covers the tuples 40 to 49 which are already modified
+  histogram.aboutToModifyTuples(20, 15);
+  histogram.aboutToModifyTuples(25, 25);
+  histogram.aboutToModifyTuples(30, 5);
+  const int rowExtent[6] = {-5, 4, 14, 14, 0, 0};
+  histogram.aboutToModifyExtent(rowExtent, wholeExtent);
+  for (int i = 20; i < 50; ++i)
+    {
+    dataArray->SetValue(i, 3);
+    }
+  histogram.build();
+  reference.build();
+  if (!checkSameBins(histogram, reference, __LINE__))
+    {
+    return EXIT_FAILURE;
+    }
+
+  //------Test out of range value: full rebuild------
+  histogram.aboutToModifyTuples(0, 1);
+  dataArray->SetValue(0, 200);
+  histogram.build();
+  reference.build();
+  if (!checkSameBins(histogram, reference, __LINE__) ||
+      histogram.value(200).toInt() != 1)
+    {
+    std::cerr << "Line : " << __LINE__ << " - Failed to rebuild histogram"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  //------Test percentileValue-----------------------
+  dataArray->SetValue(0, 0);
+  histogram.build();
+  for (int i = 0; i < 1000; ++i)
+    {
+    dataArray->SetValue(i, i % 100);
+    }
+  histogram.build();
+  if (histogram.percentileValue(0.) != 0. ||
+      histogram.percentileValue(50.) != 49. ||
+      histogram.percentileValue(100.) != 99.)
+    {
+    std::cerr << "Line : " << __LINE__ << " - Wrong percentiles: "
+              << histogram.percentileValue(0.) << " "
+              << histogram.percentileValue(50.) << " "
+              << histogram.percentileValue(100.) << std::endl;
+    return EXIT_FAILURE;
+    }
+  qreal minValue = 0.;
+  qreal maxValue = 0.;
+  histogram.percentileRange(1., 99., minValue, maxValue);
+  if (minValue != 0. || maxValue != 98.)
+    {
+    std::cerr << "Line : " << __LINE__ << " - Wrong percentile range: "
+              << minValue << " " << maxValue << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTimer>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+
+// CTKVTK includes
+#include "ctkVTKObjectEventsObserver.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkObject.h>
+#include <vtkSmartPointer.h>
+
+//-----------------------------------------------------------------------------
+int ctkVTKObjectEventsObserverBenchmark1( int argc, char * argv [] )
+{
+  QCoreApplication app(argc, argv);
+
+  // 100k observers: 10k objects observed for 10 events each, by one
+  // receiver per object
+  const int numberOfObjects = 10000;
+  const int numberOfEvents = 10;
+  const int numberOfConnections = numberOfObjects * numberOfEvents;
+
+  QList<vtkSmartPointer<vtkObject> > objects;
+  QObject receivers;
+  QList<QTimer*> slotObjects;
+  for (int i = 0; i < numberOfObjects; ++i)
+    {
+    objects << vtkSmartPointer<vtkObject>::New();
+    slotObjects << new QTimer(&receivers);
+    }
+  ctkVTKObjectEventsObserver observer;
+
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  QStringList ids;
+  for (int i = 0; i < numberOfObjects; ++i)
+    {
+    for (int event = 0; event < numberOfEvents; ++event)
+      {
+      ids << observer.addConnection(objects[i], vtkCommand::UserEvent + event,
+                                    slotObjects[i], SLOT(stop()));
+      }
+    }
+  qint64 connectTime = timer.elapsedMilli();
+  if (ids.count() != numberOfConnections || ids.contains(QString()))
+    {
+    std::cerr << "Failed to add connections" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Duplicate connections are rejected, spaces in the slot are ignored
+  if (!observer.addConnection(objects[0], vtkCommand::UserEvent,
+                              slotObjects[0], SLOT(stop( ))).isEmpty() ||
+      !observer.containsConnection(objects[numberOfObjects - 1],
+                                   vtkCommand::UserEvent + numberOfEvents - 1,
+                                   slotObjects[numberOfObjects - 1], SLOT(stop())) ||
+      observer.containsConnection(objects[0], vtkCommand::UserEvent,
+                                  slotObjects[1], SLOT(stop())))
+    {
+    std::cerr << "Failed to find connections" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  timer.start();
+  foreach(const QString& id, ids)
+    {
+    observer.blockConnection(id, true);
+    }
+  qint64 blockTime = timer.elapsedMilli();
+
+  timer.start();
+  int removedConnections = 0;
+  for (int i = 0; i < numberOfObjects; ++i)
+    {
+    for (int event = 0; event < numberOfEvents; ++event)
+      {
+      removedConnections += observer.removeConnection(
+        objects[i], vtkCommand::UserEvent + event, slotObjects[i], SLOT(stop()));
+      }
+    }
+  qint64 disconnectTime = timer.elapsedMilli();
+  if (removedConnections != numberOfConnections ||
+      observer.containsConnection(objects[0]) ||
+      observer.blockConnection(ids[0], false))
+    {
+    std::cerr << "Failed to remove connections: " << removedConnections
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Reconnect every slot to another object, like qvtkReconnect() does when
+  // the observed object of a receiver changes: the previous connection of
+  // the slot is looked up without vtkObject.
+  for (int i = 0; i < numberOfObjects; ++i)
+    {
+    for (int event = 0; event < numberOfEvents; ++event)
+      {
+      observer.addConnection(objects[i], vtkCommand::UserEvent + event,
+                             slotObjects[i], SLOT(stop()));
+      }
+    }
+  timer.start();
+  int reconnections = 0;
+  for (int i = 0; i < numberOfObjects; ++i)
+    {
+    for (int event = 0; event < numberOfEvents; ++event)
+      {
+      reconnections += observer.reconnection(
+        objects[(i + 1) % numberOfObjects], vtkCommand::UserEvent + event,
+        slotObjects[i], SLOT(stop())).isEmpty() ? 0 : 1;
+      }
+    }
+  qint64 reconnectTime = timer.elapsedMilli();
+  if (reconnections != numberOfConnections ||
+      observer.containsConnection(objects[0], vtkCommand::UserEvent,
+                                  slotObjects[0], SLOT(stop())) ||
+      !observer.containsConnection(objects[1], vtkCommand::UserEvent,
+                                   slotObjects[0], SLOT(stop())) ||
+      observer.removeAllConnections() != numberOfConnections)
+    {
+    std::cerr << "Failed to reconnect: " << reconnections << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << numberOfConnections << " connections: "
+            << "connect " << connectTime << " ms, "
+            << "block by id " << blockTime << " ms, "
+            << "disconnect " << disconnectTime << " ms, "
+            << "reconnect " << reconnectTime << " ms" << std::endl;
+  return EXIT_SUCCESS;
+}
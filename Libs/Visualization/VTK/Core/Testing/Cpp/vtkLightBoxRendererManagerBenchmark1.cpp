@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// VTK includes
+#include <vtkActor2D.h>
+#include <vtkImageData.h>
+#include <vtkImageMapper.h>
+#include <vtkNew.h>
+#include <vtkProperty2D.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkVersion.h>
+
+// STD includes
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Helper functions
+#include "vtkLightBoxRendererManagerBenchmarkHelper.cpp"
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+double meanTime(const QList<double>& times)
+{
+  double sum = 0.;
+  foreach(double time, times)
+    {
+    sum += time;
+    }
+  return times.isEmpty() ? 0. : sum / times.count();
+}
+
+//----------------------------------------------------------------------------
+bool samePixels(vtkRenderWindow* renderWindow, unsigned char* expectedPixels)
+{
+  int* size = renderWindow->GetSize();
+  unsigned char* pixels = renderWindow->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1);
+  bool same = memcmp(pixels, expectedPixels, size[0] * size[1] * 3) == 0;
+  delete [] pixels;
+  return same;
+}
+
+//----------------------------------------------------------------------------
+// Pixels of the viewport of the item at (row, column) in a window of the
+// given size, bottom to top like vtkRenderWindow::GetPixelData()
+unsigned char* itemPixels(vtkRenderWindow* renderWindow, int rowCount, int columnCount,
+                          int row, int column)
+{
+  int* size = renderWindow->GetSize();
+  const int width = size[0] / columnCount;
+  const int height = size[1] / rowCount;
+  const int x = column * width;
+  const int y = (rowCount - 1 - row) * height;
+  return renderWindow->GetPixelData(x, y, x + width - 1, y + height - 1, 1);
+}
+
+//----------------------------------------------------------------------------
+// Render the item at (row, column) the way vtkLightBoxRendererManager did
+// before caching the slices: a vtkImageMapper window/levels the original
+// image. Return the pixels of the item.
+unsigned char* referenceItemPixels(vtkImageData* image, int* size,
+                                   int rowCount, int columnCount, int row, int column,
+                                   double colorWindow, double colorLevel)
+{
+  vtkNew<vtkImageMapper> imageMapper;
+#if VTK_MAJOR_VERSION <= 5
+  imageMapper->SetInput(image);
+#else
+  imageMapper->SetInputData(image);
+#endif
+  imageMapper->SetColorWindow(colorWindow);
+  imageMapper->SetColorLevel(colorLevel);
+  imageMapper->SetZSlice(row * columnCount + column);
+
+  vtkNew<vtkActor2D> actor2D;
+  actor2D->SetMapper(imageMapper.GetPointer());
+  actor2D->GetProperty()->SetDisplayLocationToBackground();
+
+  const double viewportWidth = 1. / columnCount;
+  const double viewportHeight = 1. / rowCount;
+  const double xMin = column * viewportWidth;
+  const double yMin = (rowCount - 1 - row) * viewportHeight;
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0., 0., 0.);
+  renderer->SetViewport(xMin, yMin, xMin + viewportWidth, yMin + viewportHeight);
+  renderer->AddActor2D(actor2D.GetPointer());
+
+  vtkSmartPointer<vtkRenderWindow> renderWindow =
+    createOffScreenRenderWindow(size[0], size[1]);
+  renderWindow->AddRenderer(renderer.GetPointer());
+  renderWindow->Render();
+  return itemPixels(renderWindow, rowCount, columnCount, row, column);
+}
+
+//----------------------------------------------------------------------------
+// Compare the item with its reference rendering. vtkImageMapper
+// window/levels with fixed-point arithmetic, a channel may differ by 1.
+bool sameAsReference(vtkRenderWindow* renderWindow, vtkImageData* image,
+                     int rowCount, int columnCount, int row, int column,
+                     double colorWindow, double colorLevel)
+{
+  int* size = renderWindow->GetSize();
+  unsigned char* pixels = itemPixels(renderWindow, rowCount, columnCount, row, column);
+  unsigned char* expectedPixels = referenceItemPixels(
+    image, size, rowCount, columnCount, row, column, colorWindow, colorLevel);
+  const int count = (size[0] / columnCount) * (size[1] / rowCount) * 3;
+  int maximumDifference = 0;
+  for (int i = 0; i < count; ++i)
+    {
+    maximumDifference = std::max(maximumDifference, std::abs(pixels[i] - expectedPixels[i]));
+    }
+  delete [] pixels;
+  delete [] expectedPixels;
+  if (maximumDifference > 1)
+    {
+    std::cerr << "Item (" << row << ", " << column << ") differs from the "
+              << "vtkImageMapper window/level by " << maximumDifference << std::endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+//----------------------------------------------------------------------------
+int vtkLightBoxRendererManagerBenchmark1(int /*argc*/, char* /*argv*/[])
+{
+  if (!canRender())
+    {
+    std::cout << "No display, the light box benchmark is skipped" << std::endl;
+    return EXIT_SUCCESS;
+    }
+
+  // 8x8 light box of a short volume, rendered off screen so that the
+  // benchmark runs without a GPU (e.g. with Mesa)
+  const int rowCount = 8;
+  const int columnCount = 8;
+  const int renderCount = 20;
+
+  vtkSmartPointer<vtkImageData> image =
+    createBenchmarkVolume(256, 256, rowCount * columnCount);
+  vtkSmartPointer<vtkRenderWindow> renderWindow = createOffScreenRenderWindow(1024, 1024);
+
+  vtkNew<vtkLightBoxRendererManager> lightBox;
+  lightBox->Initialize(renderWindow);
+  lightBox->SetImageData(image);
+  lightBox->SetRenderWindowLayout(rowCount, columnCount);
+  lightBox->SetColorWindowAndLevel(1024, 512);
+  lightBox->ResetCamera();
+
+  // The first render computes the slice of every item
+  double firstRenderTime = renderTime(renderWindow);
+
+  // The slices must be window/leveled as vtkImageMapper did
+  if (!sameAsReference(renderWindow, image, rowCount, columnCount, 0, 0, 1024, 512) ||
+      !sameAsReference(renderWindow, image,
+                       rowCount, columnCount, rowCount - 1, columnCount - 1, 1024, 512))
+    {
+    std::cerr << "line " << __LINE__ << " - Slices differ from the original rendering"
+              << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  int* size = renderWindow->GetSize();
+  unsigned char* expectedPixels =
+    renderWindow->GetPixelData(0, 0, size[0] - 1, size[1] - 1, 1);
+
+  double highlightTime =
+    meanTime(lightBoxHighlightRenderTimes(lightBox.GetPointer(), renderWindow, renderCount));
+
+  // The cached slices must be rendered as the original ones
+  renderWindow->Render();
+  if (!samePixels(renderWindow, expectedPixels))
+    {
+    std::cerr << "line " << __LINE__ << " - Cached slices differ from the original ones"
+              << std::endl;
+    delete [] expectedPixels;
+    return EXIT_FAILURE;
+    }
+
+  double singleItemTime =
+    meanTime(lightBoxUpdateItemRenderTimes(lightBox.GetPointer(), renderWindow, renderCount));
+
+  if (!samePixels(renderWindow, expectedPixels))
+    {
+    std::cerr << "line " << __LINE__ << " - Updated slices differ from the original ones"
+              << std::endl;
+    delete [] expectedPixels;
+    return EXIT_FAILURE;
+    }
+  delete [] expectedPixels;
+
+  double windowLevelTime =
+    meanTime(lightBoxWindowLevelRenderTimes(lightBox.GetPointer(), renderWindow, renderCount));
+
+  if (!sameAsReference(renderWindow, image, rowCount, columnCount, 1, 2,
+                       lightBox->GetColorWindow(), lightBox->GetColorLevel()))
+    {
+    std::cerr << "line " << __LINE__ << " - Slices differ from the original rendering"
+              << " after a window/level change" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  double unchangedTime = meanTime(lightBoxUnchangedRenderTimes(renderWindow, renderCount));
+
+  std::cout << rowCount << "x" << columnCount << " light box, "
+            << size[0] << "x" << size[1] << " pixels: "
+            << "first render " << firstRenderTime << " ms, "
+            << "highlight change " << highlightTime << " ms, "
+            << "single item update " << singleItemTime << " ms, "
+            << "window/level change " << windowLevelTime << " ms, "
+            << "unchanged " << unchangedTime << " ms" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QList>
+#include <QtGlobal>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+
+// CTKVTK includes
+#include "vtkLightBoxRendererManager.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkRenderWindow.h>
+#include <vtkSmartPointer.h>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Render windows need a display with X11, even off screen (unless VTK
+// is built with OSMesa)
+bool canRender()
+{
+#ifdef Q_WS_X11
+  return !qgetenv("DISPLAY").isEmpty();
+#else
+  return true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+// Rendered off screen so that no GPU is needed (e.g. with Mesa)
+vtkSmartPointer<vtkRenderWindow> createOffScreenRenderWindow(int width, int height)
+{
+  vtkSmartPointer<vtkRenderWindow> renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+  renderWindow->SetOffScreenRendering(1);
+  renderWindow->SetSize(width, height);
+  renderWindow->SetMultiSamples(0);
+  return renderWindow;
+}
+
+//----------------------------------------------------------------------------
+// Smooth short volume with some noise, similar to an image intensity
+// distribution
+vtkSmartPointer<vtkImageData> createBenchmarkVolume(int width, int height, int depth)
+{
+  vtkSmartPointer<vtkImageData> volume = vtkSmartPointer<vtkImageData>::New();
+  volume->SetDimensions(width, height, depth);
+  volume->SetScalarTypeToShort();
+  volume->SetNumberOfScalarComponents(1);
+  volume->AllocateScalars();
+  short* voxel = static_cast<short*>(volume->GetScalarPointer());
+  unsigned int seed = 1;
+  for (int k = 0; k < depth; ++k)
+    {
+    for (int j = 0; j < height; ++j)
+      {
+      for (int i = 0; i < width; ++i)
+        {
+        seed = seed * 1103515245u + 12345u;
+        *voxel++ = static_cast<short>((i + j + k) * 2 + ((seed >> 16) & 0x3f));
+        }
+      }
+    }
+  return volume;
+}
+
+//----------------------------------------------------------------------------
+// Return the render time in milliseconds
+double renderTime(vtkRenderWindow* renderWindow)
+{
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  renderWindow->Render();
+  return static_cast<double>(timer.elapsedMicro()) / 1000.;
+}
+
+//----------------------------------------------------------------------------
+// The light box steps below render \a count times and return the render
+// times in milliseconds.
+
+//----------------------------------------------------------------------------
+// Only the highlighted box changes: all the slices are cached
+QList<double> lightBoxHighlightRenderTimes(vtkLightBoxRendererManager* lightBox,
+                                           vtkRenderWindow* renderWindow, int count)
+{
+  QList<double> times;
+  for (int i = 0; i < count; ++i)
+    {
+    const int id = i % lightBox->GetRenderWindowItemCount();
+    lightBox->SetHighlightedById(id, true);
+    times << renderTime(renderWindow);
+    lightBox->SetHighlightedById(id, false);
+    }
+  return times;
+}
+
+//----------------------------------------------------------------------------
+// A single item is updated
+QList<double> lightBoxUpdateItemRenderTimes(vtkLightBoxRendererManager* lightBox,
+                                            vtkRenderWindow* renderWindow, int count)
+{
+  QList<double> times;
+  for (int i = 0; i < count; ++i)
+    {
+    lightBox->UpdateRenderWindowItem(i % lightBox->GetRenderWindowItemCount());
+    times << renderTime(renderWindow);
+    }
+  return times;
+}
+
+//----------------------------------------------------------------------------
+// The window grows by one at each render: every slice is computed again
+QList<double> lightBoxWindowLevelRenderTimes(vtkLightBoxRendererManager* lightBox,
+                                             vtkRenderWindow* renderWindow, int count)
+{
+  QList<double> times;
+  const double colorWindow = lightBox->GetColorWindow();
+  const double colorLevel = lightBox->GetColorLevel();
+  for (int i = 1; i <= count; ++i)
+    {
+    lightBox->SetColorWindowAndLevel(colorWindow + i, colorLevel);
+    times << renderTime(renderWindow);
+    }
+  return times;
+}
+
+//----------------------------------------------------------------------------
+// Nothing changes
+QList<double> lightBoxUnchangedRenderTimes(vtkRenderWindow* renderWindow, int count)
+{
+  QList<double> times;
+  for (int i = 0; i < count; ++i)
+    {
+    times << renderTime(renderWindow);
+    }
+  return times;
+}
+
+} // end of anonymous namespace
@@ -38,9 +38,92 @@ static ctkLogger logger("org.commontk.libs.visualization.core.ctkVTKColorTransfe
 class ctkVTKColorTransferFunctionPrivate
 {
 public:
+  ctkVTKColorTransferFunctionPrivate();
+  /// Sample the function again if it has been modified
+  void updateTable()const;
+
   vtkSmartPointer<vtkColorTransferFunction> ColorTransferFunction;
+
+  static const int TableSize = 1024;
+  mutable bool TableModified;
+  int TableVersion;
+  mutable QVector<QRgb> ColorTable;
+  mutable double Range[2];
+  mutable QColor MinValue;
+  mutable QColor MaxValue;
 };
 
+//-----------------------------------------------------------------------------
+ctkVTKColorTransferFunctionPrivate::ctkVTKColorTransferFunctionPrivate()
+{
+  this->TableModified = true;
+  this->TableVersion = 0;
+  this->Range[0] = 1.;
+  this->Range[1] = 0.;
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKColorTransferFunctionPrivate::updateTable()const
+{
+  if (!this->TableModified)
+    {
+    return;
+    }
+  this->TableModified = false;
+  this->ColorTable.clear();
+  this->Range[0] = 1.;
+  this->Range[1] = 0.;
+  this->MinValue = QColor::fromRgbF(1.,1.,1.);
+  this->MaxValue = QColor::fromRgbF(0.,0.,0.);
+  if (this->ColorTransferFunction.GetPointer() == 0)
+    {
+    return;
+    }
+  this->ColorTransferFunction->GetRange(this->Range);
+  // Darkest and brightest colors of the nodes
+  int minGray = qGray(this->MinValue.rgb());
+  int maxGray = qGray(this->MaxValue.rgb());
+  const int count = this->ColorTransferFunction->GetSize();
+  for (int i = 0; i < count; ++i)
+    {
+    double values[6];
+    this->ColorTransferFunction->GetNodeValue(i, values);
+    Q_ASSERT(values[1] >= 0. && values[1] <= 1. &&
+             values[2] >= 0. && values[2] <= 1. &&
+             values[3] >= 0. && values[3] <= 1.);
+    const QRgb rgb = qRgb(qRound(values[1] * 255.),
+                          qRound(values[2] * 255.),
+                          qRound(values[3] * 255.));
+    const int gray = qGray(rgb);
+    if (gray < minGray)
+      {
+      minGray = gray;
+      this->MinValue = QColor::fromRgbF(values[1], values[2], values[3]);
+      }
+    if (gray > maxGray)
+      {
+      maxGray = gray;
+      this->MaxValue = QColor::fromRgbF(values[1], values[2], values[3]);
+      }
+    }
+  if (count == 0)
+    {
+    return;
+    }
+  // RGB triplets
+  QVector<double> table(3 * TableSize);
+  this->ColorTransferFunction->GetTable(this->Range[0], this->Range[1],
+                                        TableSize, table.data());
+  this->ColorTable.resize(TableSize);
+  const double* rgb = table.constData();
+  for (int i = 0; i < TableSize; ++i, rgb += 3)
+    {
+    this->ColorTable[i] = qRgb(qRound(rgb[0] * 255.),
+                               qRound(rgb[1] * 255.),
+                               qRound(rgb[2] * 255.));
+    }
+}
+
 //-----------------------------------------------------------------------------
 ctkVTKColorTransferFunction::ctkVTKColorTransferFunction(QObject* parentObject)
   :ctkTransferFunction(parentObject)
@@ -97,10 +180,9 @@ void ctkVTKColorTransferFunction::range(qreal& minRange, qreal& maxRange)const
     maxRange = 0.;
     return;
     }
-  double rangeValues[2];
-  d->ColorTransferFunction->GetRange(rangeValues);
-  minRange = rangeValues[0];
-  maxRange = rangeValues[1];
+  d->updateTable();
+  minRange = d->Range[0];
+  maxRange = d->Range[1];
 }
 
 //-----------------------------------------------------------------------------
@@ -113,22 +195,8 @@ QVariant ctkVTKColorTransferFunction::minValue()const
     logger.warn("no ColorTransferFunction");
     return -1;
     }
-  double rgb[3];
-  QColor minValue = QColor::fromRgbF(1.,1.,1.);
-  for (int i = 0; i < this->count(); ++i)
-    {
-    d->ColorTransferFunction->GetColor(i, rgb);
-    Q_ASSERT(rgb[0] >= 0. && rgb[0] <= 1. &&
-             rgb[1] >= 0. && rgb[1] <= 1. &&
-             rgb[2] >= 0. && rgb[2] <= 1.);
-    QColor color = QColor::fromRgbF(rgb[0], rgb[1], rgb[2]);
-    if ( qGray(color.red(), color.green(), color.blue()) <
-         qGray(minValue.red(), minValue.green(), minValue.blue()))
-      {
-      minValue = color;
-      }
-    }
-  return minValue;
+  d->updateTable();
+  return d->MinValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -141,22 +209,8 @@ QVariant ctkVTKColorTransferFunction::maxValue()const
     logger.warn("no ColorTransferFunction");
     return -1;
     }
-  double rgb[3];
-  QColor minValue = QColor::fromRgbF(0.,0.,0.);
-  for (int i = 0; i < this->count(); ++i)
-    {
-    d->ColorTransferFunction->GetColor(i, rgb);
-    Q_ASSERT(rgb[0] >= 0. && rgb[0] <= 1. &&
-             rgb[1] >= 0. && rgb[1] <= 1. &&
-             rgb[2] >= 0. && rgb[2] <= 1.);
-    QColor color = QColor::fromRgbF(rgb[0], rgb[1], rgb[2]);
-    if ( qGray(color.red(), color.green(), color.blue()) >
-         qGray(minValue.red(), minValue.green(), minValue.blue()))
-      {
-      minValue = color;
-      }
-    }
-  return minValue;
+  d->updateTable();
+  return d->MaxValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -299,12 +353,43 @@ void ctkVTKColorTransferFunction::setControlPointValue(int index, const QVariant
 void ctkVTKColorTransferFunction::setColorTransferFunction(vtkColorTransferFunction* colorTransferFunction)
 {
   Q_D(ctkVTKColorTransferFunction);
+  this->qvtkReconnect(d->ColorTransferFunction, colorTransferFunction,
+                      vtkCommand::ModifiedEvent,
+                      this, SLOT(onColorTransferFunctionModified()));
   d->ColorTransferFunction = colorTransferFunction;
-  this->qvtkReconnect(d->ColorTransferFunction,vtkCommand::ModifiedEvent,
-                      this, SIGNAL(changed()));
+  this->onColorTransferFunctionModified();
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKColorTransferFunction::onColorTransferFunctionModified()
+{
+  Q_D(ctkVTKColorTransferFunction);
+  d->TableModified = true;
+  ++d->TableVersion;
   emit changed();
 }
 
+//-----------------------------------------------------------------------------
+QVector<QRgb> ctkVTKColorTransferFunction::colorTable()const
+{
+  Q_D(const ctkVTKColorTransferFunction);
+  d->updateTable();
+  return d->ColorTable;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKColorTransferFunction::tableSize()
+{
+  return ctkVTKColorTransferFunctionPrivate::TableSize;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKColorTransferFunction::tableVersion()const
+{
+  Q_D(const ctkVTKColorTransferFunction);
+  return d->TableVersion;
+}
+
 //-----------------------------------------------------------------------------
 vtkColorTransferFunction* ctkVTKColorTransferFunction::colorTransferFunction()const
 {
@@ -21,6 +21,10 @@
 #ifndef __ctkVTKColorTransferFunction_h
 #define __ctkVTKColorTransferFunction_h
 
+// Qt includes
+#include <QColor>
+#include <QVector>
+
 // CTK includes
 #include "ctkTransferFunction.h"
 #include "ctkPimpl.h"
@@ -68,6 +72,22 @@ public:
 
   void setColorTransferFunction(vtkColorTransferFunction* colorTransferFunction);
   vtkColorTransferFunction* colorTransferFunction()const;
+
+  /// Return the colors of the function sampled at tableSize() regularly
+  /// spaced positions over its range, e.g. to draw a preview.
+  /// The table is computed once and kept until the function is modified;
+  /// range(), minValue() and maxValue() are served from it. value() always
+  /// evaluates the function: it is exact whatever the color space, midpoints
+  /// and sharpness of the nodes. Use the table to sample many positions.
+  QVector<QRgb> colorTable()const;
+  static int tableSize();
+  /// Incremented each time the function is modified and the table
+  /// invalidated.
+  int tableVersion()const;
+
+protected Q_SLOTS:
+  void onColorTransferFunctionModified();
+
 protected:
   QScopedPointer<ctkVTKColorTransferFunctionPrivate> d_ptr;
 
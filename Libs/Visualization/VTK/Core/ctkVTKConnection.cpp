@@ -20,8 +20,10 @@
 
 // Qt includes
 #include <QDebug>
+#include <QHash>
+#include <QMetaObject>
+#include <QMutex>
 #include <QPointer>
-#include <QRegExp>
 #include <QString>
 #include <QTextStream>
 
@@ -167,35 +169,10 @@ void ctkVTKConnectionPrivate::disconnect()
 }
 
 //-----------------------------------------------------------------------------
-bool ctkVTKConnectionPrivate::IsSameQtSlot(const char* qt_slot)const
+bool ctkVTKConnectionPrivate::IsSameQtSlot(const QByteArray& normalized_qt_slot)const
 {
-  if (qt_slot == 0)
-    {
-    return true;
-    }
-  const char* ptr = qt_slot;
-  for (QString::const_iterator it = this->QtSlot.begin();
-       it != this->QtSlot.end() && *ptr != '\0'; )
-    {
-    if (*it == *ptr)
-      {
-      ++it;
-      ++ptr;
-      }
-    else if (*it == ' ')
-      {
-      ++it;
-      }
-    else if (*ptr == ' ')
-      {
-      ++ptr;
-      }
-    else
-      {
-      return false;
-      }
-    }
-  return true;
+  return normalized_qt_slot.isNull() ||
+    this->NormalizedQtSlot == normalized_qt_slot;
 }
 
 //-----------------------------------------------------------------------------
@@ -306,10 +283,11 @@ void ctkVTKConnection::setup(vtkObject* vtk_obj, unsigned long vtk_event,
   d->QtObject = qt_obj;
   d->VTKEvent = vtk_event;
   d->QtSlot = qt_slot;
+  d->NormalizedQtSlot = ctkVTKConnection::normalizedSlot(qt_slot);
   d->Priority = priority;
   d->ConnectionType = connectionType;
 
-  if (d->QtSlot.contains(QRegExp(QString("\\( ?vtkObject ?\\* ?, ?vtkObject ?\\* ?\\)"))))
+  if (d->NormalizedQtSlot.contains("(vtkObject*,vtkObject*)"))
     {
     d->SlotType = ctkVTKConnectionPrivate::ARG_VTKOBJECT_AND_VTKOBJECT;
     }
@@ -337,6 +315,14 @@ bool ctkVTKConnection::isBlocked()const
 //-----------------------------------------------------------------------------
 bool ctkVTKConnection::isEqual(vtkObject* vtk_obj, unsigned long vtk_event,
     const QObject* qt_obj, const char* qt_slot)const
+{
+  return this->isEqual(vtk_obj, vtk_event, qt_obj,
+                       ctkVTKConnection::normalizedSlot(qt_slot));
+}
+
+//-----------------------------------------------------------------------------
+bool ctkVTKConnection::isEqual(vtkObject* vtk_obj, unsigned long vtk_event,
+    const QObject* qt_obj, const QByteArray& normalized_qt_slot)const
 {
   Q_D(const ctkVTKConnection);
   
@@ -352,13 +338,36 @@ bool ctkVTKConnection::isEqual(vtkObject* vtk_obj, unsigned long vtk_event,
     {
     return false;
     }
-  if (!d->IsSameQtSlot(qt_slot))
+  if (!d->IsSameQtSlot(normalized_qt_slot))
     {
     return false;
     }
   return true;
 }
 
+//-----------------------------------------------------------------------------
+QByteArray ctkVTKConnection::normalizedSlot(const char* qt_slot)
+{
+  if (qt_slot == 0)
+    {
+    return QByteArray();
+    }
+  // Slots are most often the same few SLOT() strings: cache their
+  // normalization, which also shares the normalized strings.
+  static QMutex mutex;
+  static QHash<QByteArray, QByteArray> normalizedSlots;
+  const QByteArray slot = QByteArray::fromRawData(qt_slot, qstrlen(qt_slot));
+  QMutexLocker locker(&mutex);
+  QHash<QByteArray, QByteArray>::const_iterator it = normalizedSlots.constFind(slot);
+  if (it != normalizedSlots.constEnd())
+    {
+    return it.value();
+    }
+  QByteArray normalized = QMetaObject::normalizedSignature(qt_slot);
+  normalizedSlots.insert(QByteArray(qt_slot), normalized);
+  return normalized;
+}
+
 //-----------------------------------------------------------------------------
 void ctkVTKConnectionPrivate::DoCallback(vtkObject* vtk_obj, unsigned long event,
                                  void* client_data, void* call_data)
@@ -82,6 +82,15 @@ public:
   /// 
   bool isEqual(vtkObject* vtk_obj, unsigned long vtk_event,
                const QObject* qt_obj, const char* qt_slot)const;
+  /// Same as above with a slot already normalized with normalizedSlot().
+  /// A null \a normalized_qt_slot matches any slot.
+  bool isEqual(vtkObject* vtk_obj, unsigned long vtk_event,
+               const QObject* qt_obj, const QByteArray& normalized_qt_slot)const;
+
+  /// Return the normalized signature (see QMetaObject::normalizedSignature())
+  /// of \a qt_slot. Normalized slots are computed once and shared between
+  /// the connections.
+  static QByteArray normalizedSlot(const char* qt_slot);
 
   /// 
   /// Return a string uniquely identifying the connection within the current process
@@ -55,7 +55,7 @@ public:
   void connect();
   void disconnect();
 
-  bool IsSameQtSlot(const char* qt_slot)const;
+  bool IsSameQtSlot(const QByteArray& normalized_qt_slot)const;
 
   /// 
   /// VTK Callback
@@ -71,6 +71,7 @@ public:
   const QObject*                      QtObject;
   unsigned long                       VTKEvent;
   QString                             QtSlot;
+  QByteArray                          NormalizedQtSlot;
   float                               Priority;
   Qt::ConnectionType                  ConnectionType;
   int                                 SlotType;
@@ -21,6 +21,12 @@
 /// Qt includes
 #include <QColor>
 #include <QDebug>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QThread>
+#include <QtConcurrentMap>
+#include <QVector>
 
 /// CTK includes
 #include "ctkVTKHistogram.h"
@@ -33,6 +39,7 @@
 #include <vtkSmartPointer.h>
 
 /// STL include
+#include <cmath>
 #include <limits>
 
 //--------------------------------------------------------------------------
@@ -48,11 +55,28 @@ public:
   vtkSmartPointer<vtkIntArray>  Bins;
   int                           UserNumberOfBins;
   int                           Component;
+  int                           NumberOfThreads;
+  int                           SamplingStride;
   mutable double                Range[2];
   int                           MinBin;
   int                           MaxBin;
 
+  /// True if the bins match the data array and the settings
+  bool                          Built;
+  /// Tuples removed from the bins by aboutToModifyTuples(), to bin again
+  /// in the next build(). Disjoint [begin, end) intervals, keyed by begin.
+  QMap<vtkIdType, vtkIdType>    ModifiedTuples;
+  bool                          FullBuildNeeded;
+  /// Cumulative histogram, empty when out of date
+  mutable QVector<qint64>       CumulativeBins;
+
   int computeNumberOfBins()const;
+  void invalidate();
+  /// Add the tuples [begin, end) to ModifiedTuples and return the intervals
+  /// which were not already in it.
+  QList<QPair<vtkIdType, vtkIdType> > addModifiedTuples(vtkIdType begin, vtkIdType end);
+  void updateMinMaxBins();
+  const QVector<qint64>& cumulativeBins()const;
 };
 
 //-----------------------------------------------------------------------------
@@ -61,9 +85,13 @@ ctkVTKHistogramPrivate::ctkVTKHistogramPrivate()
   this->Bins = vtkSmartPointer<vtkIntArray>::New();
   this->UserNumberOfBins = -1;
   this->Component = 0;
+  this->NumberOfThreads = 0;
+  this->SamplingStride = 1;
   this->Range[0] = this->Range[1] = 0.;
   this->MinBin = 0;
   this->MaxBin = 0;
+  this->Built = false;
+  this->FullBuildNeeded = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -102,6 +130,90 @@ int ctkVTKHistogramPrivate::computeNumberOfBins()const
   return static_cast<int>(this->Range[1] - this->Range[0]) + 1;
 }
 
+//-----------------------------------------------------------------------------
+void ctkVTKHistogramPrivate::invalidate()
+{
+  this->Built = false;
+  this->FullBuildNeeded = false;
+  this->ModifiedTuples.clear();
+  this->CumulativeBins.clear();
+}
+
+//-----------------------------------------------------------------------------
+QList<QPair<vtkIdType, vtkIdType> > ctkVTKHistogramPrivate::addModifiedTuples(vtkIdType begin, vtkIdType end)
+{
+  QList<QPair<vtkIdType, vtkIdType> > newTuples;
+  // First interval which overlaps or touches [begin, end)
+  QMap<vtkIdType, vtkIdType>::iterator it = this->ModifiedTuples.upperBound(begin);
+  if (it != this->ModifiedTuples.begin())
+    {
+    QMap<vtkIdType, vtkIdType>::iterator previous = it;
+    --previous;
+    if (previous.value() >= begin)
+      {
+      it = previous;
+      }
+    }
+  vtkIdType mergedBegin = begin;
+  vtkIdType mergedEnd = end;
+  vtkIdType current = begin;
+  while (it != this->ModifiedTuples.end() && it.key() <= end)
+    {
+    if (it.key() > current)
+      {
+      newTuples << qMakePair(current, it.key());
+      }
+    current = qMax(current, it.value());
+    mergedBegin = qMin(mergedBegin, it.key());
+    mergedEnd = qMax(mergedEnd, it.value());
+    it = this->ModifiedTuples.erase(it);
+    }
+  if (current < end)
+    {
+    newTuples << qMakePair(current, end);
+    }
+  this->ModifiedTuples.insert(mergedBegin, mergedEnd);
+  return newTuples;
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogramPrivate::updateMinMaxBins()
+{
+  const int binCount = this->Bins->GetNumberOfTuples();
+  if (binCount <= 0)
+    {
+    this->MinBin = 0;
+    this->MaxBin = 0;
+    return;
+    }
+  int* binPtr = this->Bins->GetPointer(0);
+  int* endPtr = this->Bins->GetPointer(binCount-1);
+  this->MinBin = *endPtr;
+  this->MaxBin = *endPtr;
+  for (;binPtr < endPtr; ++binPtr)
+    {
+    this->MinBin = qMin(*binPtr, this->MinBin);
+    this->MaxBin = qMax(*binPtr, this->MaxBin);
+    }
+}
+
+//-----------------------------------------------------------------------------
+const QVector<qint64>& ctkVTKHistogramPrivate::cumulativeBins()const
+{
+  const int binCount = this->Bins->GetNumberOfTuples();
+  if (this->CumulativeBins.size() != binCount)
+    {
+    this->CumulativeBins.resize(binCount);
+    qint64 sum = 0;
+    for (int bin = 0; bin < binCount; ++bin)
+      {
+      sum += this->Bins->GetValue(bin);
+      this->CumulativeBins[bin] = sum;
+      }
+    }
+  return this->CumulativeBins;
+}
+
 //-----------------------------------------------------------------------------
 ctkVTKHistogram::ctkVTKHistogram(QObject* parentObject)
   :ctkHistogram(parentObject)
@@ -203,6 +315,7 @@ int ctkVTKHistogram::posToIndex(qreal pos)const
 void ctkVTKHistogram::setDataArray(vtkDataArray* newDataArray)
 {
   Q_D(ctkVTKHistogram);
+  d->invalidate();
   d->DataArray = newDataArray;
   this->qvtkReconnect(d->DataArray,vtkCommand::ModifiedEvent,
                       this, SIGNAL(changed()));
@@ -220,6 +333,7 @@ vtkDataArray* ctkVTKHistogram::dataArray()const
 void ctkVTKHistogram::setComponent(int component)
 {
   Q_D(ctkVTKHistogram);
+  d->invalidate();
   d->Component = component;
   // need rebuild
 }
@@ -235,74 +349,368 @@ int ctkVTKHistogram::component()const
 void ctkVTKHistogram::setNumberOfBins(int number)
 {
   Q_D(ctkVTKHistogram);
+  d->invalidate();
   d->UserNumberOfBins = number;
 }
 
 //-----------------------------------------------------------------------------
-template <class T>
-void populateBins(vtkIntArray* bins, const ctkVTKHistogram* histogram)
+void ctkVTKHistogram::setNumberOfThreads(int number)
 {
-  vtkDataArray* scalars = histogram->dataArray();
-  int* binsPtr = bins->WritePointer(0, bins->GetNumberOfTuples());
+  Q_D(ctkVTKHistogram);
+  d->NumberOfThreads = qMax(0, number);
+}
 
-  // reset bins to 0
-  memset(binsPtr, 0, bins->GetNumberOfComponents()*bins->GetNumberOfTuples()*sizeof(int));
+//-----------------------------------------------------------------------------
+int ctkVTKHistogram::numberOfThreads()const
+{
+  Q_D(const ctkVTKHistogram);
+  return d->NumberOfThreads;
+}
 
-  const vtkIdType componentNumber = scalars->GetNumberOfComponents();
-  const vtkIdType tupleNumber = scalars->GetNumberOfTuples();
-  int component = histogram->component();
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::setSamplingStride(int stride)
+{
+  Q_D(ctkVTKHistogram);
+  d->invalidate();
+  d->SamplingStride = qMax(1, stride);
+}
 
-  double range[2];
-  histogram->range(range[0], range[1]);
-  T offset = static_cast<T>(range[0]);
+//-----------------------------------------------------------------------------
+int ctkVTKHistogram::samplingStride()const
+{
+  Q_D(const ctkVTKHistogram);
+  return d->SamplingStride;
+}
 
-  T* ptr = static_cast<T*>(scalars->WriteVoidPointer(0, tupleNumber));
-  T* endPtr = ptr + tupleNumber * componentNumber;
-  ptr += component;
-  for (; ptr < endPtr; ptr += componentNumber)
+namespace
+{
+
+// Below this number of samples per thread, threading costs more than it saves
+const vtkIdType MinimumNumberOfSamplesPerThread = 65536;
+
+//-----------------------------------------------------------------------------
+// value >= offset: truncation is equivalent to vtkMath::Floor.
+// The maximum value falls in the last bin.
+inline int irregularBin(double value, double offset, double binWidth, int lastBin)
+{
+  return qBound(0, static_cast<int>((value - offset) * binWidth), lastBin);
+}
+
+//-----------------------------------------------------------------------------
+// Bins of a contiguous range of the data array, populated by a single thread.
+template <class T>
+struct ctkVTKHistogramChunk
+{
+  const T*     Begin;
+  const T*     End;
+  vtkIdType    Stride;
+  bool         RegularBins;
+  double       Offset;
+  double       BinWidth;
+  int          NumberOfBins;
+  QVector<int> Bins;
+
+  void populate();
+  void populateRegularBins(int* binsPtr)const;
+  void populateIrregularBins(int* binsPtr)const;
+};
+
+//-----------------------------------------------------------------------------
+template <class T>
+void ctkVTKHistogramChunk<T>::populate()
+{
+  this->Bins.fill(0, this->NumberOfBins);
+  if (this->RegularBins)
     {
-    Q_ASSERT( (static_cast<long long>(*ptr) - offset) == 
+    this->populateRegularBins(this->Bins.data());
+    }
+  else
+    {
+    this->populateIrregularBins(this->Bins.data());
+    }
+}
+
+//-----------------------------------------------------------------------------
+template <class T>
+void ctkVTKHistogramChunk<T>::populateRegularBins(int* binsPtr)const
+{
+  const T offset = static_cast<T>(this->Offset);
+  const T* ptr = this->Begin;
+  const T* endPtr = this->End;
+  if (this->Stride == 1)
+    {
+    // Contiguous values, unrolled to help the compiler interleave the loads
+    for (; ptr + 4 <= endPtr; ptr += 4)
+      {
+      const int bin0 = static_cast<int>(ptr[0] - offset);
+      const int bin1 = static_cast<int>(ptr[1] - offset);
+      const int bin2 = static_cast<int>(ptr[2] - offset);
+      const int bin3 = static_cast<int>(ptr[3] - offset);
+      ++binsPtr[bin0];
+      ++binsPtr[bin1];
+      ++binsPtr[bin2];
+      ++binsPtr[bin3];
+      }
+    }
+  for (; ptr < endPtr; ptr += this->Stride)
+    {
+    Q_ASSERT( (static_cast<long long>(*ptr) - offset) ==
               (static_cast<int>(*ptr) - offset));
-    binsPtr[static_cast<int>(*ptr - offset)]++;
+    ++binsPtr[static_cast<int>(*ptr - offset)];
     }
 }
 
 //-----------------------------------------------------------------------------
 template <class T>
-void populateIrregularBins(vtkIntArray* bins, const ctkVTKHistogram* histogram)
+void ctkVTKHistogramChunk<T>::populateIrregularBins(int* binsPtr)const
 {
-  vtkDataArray* scalars = histogram->dataArray();
+  const double offset = this->Offset;
+  const double binWidth = this->BinWidth;
+  const int lastBin = this->NumberOfBins - 1;
+  for (const T* ptr = this->Begin; ptr < this->End; ptr += this->Stride)
+    {
+    const double value = static_cast<double>(*ptr);
+    if (std::numeric_limits<T>::has_quiet_NaN && value != value)
+      {
+      continue;
+      }
+    ++binsPtr[irregularBin(value, offset, binWidth, lastBin)];
+    }
+}
 
-  int* binsPtr = bins->WritePointer(0, bins->GetNumberOfComponents()*bins->GetNumberOfTuples());
-  // reset bins to 0
-  memset(binsPtr, 0, bins->GetNumberOfTuples() * sizeof(int));
+//-----------------------------------------------------------------------------
+template <class T>
+void populateBins(vtkIntArray* bins, const ctkVTKHistogram* histogram, bool regularBins)
+{
+  vtkDataArray* scalars = histogram->dataArray();
+  const int binCount = bins->GetNumberOfTuples();
+  int* binsPtr = bins->WritePointer(0, binCount);
 
   const vtkIdType componentNumber = scalars->GetNumberOfComponents();
   const vtkIdType tupleNumber = scalars->GetNumberOfTuples();
-  int component = histogram->component();
+  const int samplingStride = histogram->samplingStride();
 
   double range[2];
   histogram->range(range[0], range[1]);
-  double offset = range[0];
 
   double binWidth = 1.;
   if (range[1] != range[0])
     {
-    binWidth = static_cast<double>(bins->GetNumberOfTuples()) / (range[1] - range[0]);
+    binWidth = static_cast<double>(binCount) / (range[1] - range[0]);
     }
 
-  T* ptr = static_cast<T*>(scalars->WriteVoidPointer(0, tupleNumber));
-  T* endPtr = ptr + tupleNumber * componentNumber;
-  ptr += component;
+  // Split the sampled tuples between the threads
+  const vtkIdType sampleNumber = (tupleNumber + samplingStride - 1) / samplingStride;
+  int threadNumber = histogram->numberOfThreads();
+  if (threadNumber <= 0)
+    {
+    threadNumber = QThread::idealThreadCount();
+    }
+  threadNumber = static_cast<int>(qBound<vtkIdType>(
+    1, qMin<vtkIdType>(threadNumber, sampleNumber / MinimumNumberOfSamplesPerThread), 64));
+  const vtkIdType samplesPerThread = (sampleNumber + threadNumber - 1) / threadNumber;
+
+  const T* dataPtr = static_cast<T*>(scalars->GetVoidPointer(0)) + histogram->component();
+  const T* dataEndPtr = static_cast<T*>(scalars->GetVoidPointer(0)) + tupleNumber * componentNumber;
+
+  QList<ctkVTKHistogramChunk<T> > chunks;
+  for (int i = 0; i < threadNumber; ++i)
+    {
+    const vtkIdType firstTuple = i * samplesPerThread * samplingStride;
+    if (firstTuple >= tupleNumber)
+      {
+      break;
+      }
+    const vtkIdType lastTuple = qMin(tupleNumber, firstTuple + samplesPerThread * samplingStride);
+    ctkVTKHistogramChunk<T> chunk;
+    chunk.Begin = dataPtr + firstTuple * componentNumber;
+    chunk.End = qMin(dataEndPtr, dataPtr + lastTuple * componentNumber);
+    chunk.Stride = componentNumber * samplingStride;
+    chunk.RegularBins = regularBins;
+    chunk.Offset = range[0];
+    chunk.BinWidth = binWidth;
+    chunk.NumberOfBins = binCount;
+    chunks << chunk;
+    }
+
+  if (chunks.size() == 1)
+    {
+    chunks.first().populate();
+    }
+  else
+    {
+    QtConcurrent::blockingMap(chunks, &ctkVTKHistogramChunk<T>::populate);
+    }
+
+  // Merge the partial histograms
+  memset(binsPtr, 0, binCount * sizeof(int));
+  foreach(const ctkVTKHistogramChunk<T>& chunk, chunks)
+    {
+    const int* chunkBinsPtr = chunk.Bins.constData();
+    for (int bin = 0; bin < binCount; ++bin)
+      {
+      binsPtr[bin] += chunkBinsPtr[bin];
+      }
+    }
+  if (samplingStride > 1)
+    {
+    for (int bin = 0; bin < binCount; ++bin)
+      {
+      binsPtr[bin] *= samplingStride;
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Add increment to the bins of the given tuples. Return false if a value is
+// out of the range of the histogram.
+template <class T>
+bool updateBins(vtkIntArray* bins, const ctkVTKHistogram* histogram, bool regularBins,
+                vtkIdType firstTuple, vtkIdType numberOfTuples, int increment)
+{
+  vtkDataArray* scalars = histogram->dataArray();
+  if (firstTuple < 0 || numberOfTuples < 0 ||
+      firstTuple + numberOfTuples > scalars->GetNumberOfTuples())
+    {
+    return false;
+    }
+  const int binCount = bins->GetNumberOfTuples();
+  int* binsPtr = bins->GetPointer(0);
+
+  double range[2];
+  histogram->range(range[0], range[1]);
+  double binWidth = 1.;
+  if (range[1] != range[0])
+    {
+    binWidth = static_cast<double>(binCount) / (range[1] - range[0]);
+    }
+  const T offset = static_cast<T>(range[0]);
+
+  const vtkIdType componentNumber = scalars->GetNumberOfComponents();
+  const T* ptr = static_cast<T*>(scalars->GetVoidPointer(0))
+    + firstTuple * componentNumber + histogram->component();
+  const T* endPtr = ptr + numberOfTuples * componentNumber;
   for (; ptr < endPtr; ptr += componentNumber)
     {
-    if (std::numeric_limits<T>::has_quiet_NaN &&
-        vtkMath::IsNan(*ptr))
+    const double value = static_cast<double>(*ptr);
+    if (std::numeric_limits<T>::has_quiet_NaN && value != value)
       {
       continue;
       }
-    binsPtr[vtkMath::Floor((static_cast<double>(*ptr) - offset) * binWidth)]++;
+    if (value < range[0] || value > range[1])
+      {
+      return false;
+      }
+    const int bin = regularBins ? static_cast<int>(*ptr - offset)
+      : irregularBin(value, range[0], binWidth, binCount - 1);
+    if (bin < 0 || bin >= binCount)
+      {
+      return false;
+      }
+    binsPtr[bin] += increment;
     }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::aboutToModifyTuples(vtkIdType firstTuple, vtkIdType numberOfTuples)
+{
+  Q_D(ctkVTKHistogram);
+  if (!d->Built || d->FullBuildNeeded)
+    {
+    return;
+    }
+  const int binCount = d->Bins->GetNumberOfTuples();
+  if (d->SamplingStride != 1 || binCount <= 0)
+    {
+    d->FullBuildNeeded = true;
+    return;
+    }
+
+  if (firstTuple < 0 || numberOfTuples < 0 ||
+      firstTuple + numberOfTuples > d->DataArray->GetNumberOfTuples())
+    {
+    d->FullBuildNeeded = true;
+    return;
+    }
+
+  // Tuples which are already modified have been removed from the bins
+  const bool regularBins = (static_cast<double>(binCount) == (d->Range[1] - d->Range[0] + 1));
+  QPair<vtkIdType, vtkIdType> tuples;
+  foreach(tuples, d->addModifiedTuples(firstTuple, firstTuple + numberOfTuples))
+    {
+    bool updated = false;
+    switch(d->DataArray->GetDataType())
+      {
+      vtkTemplateMacro(updated = updateBins<VTK_TT>(
+        d->Bins, this, regularBins, tuples.first, tuples.second - tuples.first, -1));
+      }
+    if (!updated)
+      {
+      d->FullBuildNeeded = true;
+      break;
+      }
+    }
+  d->CumulativeBins.clear();
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::aboutToModifyExtent(const int extent[6], const int wholeExtent[6])
+{
+  Q_D(ctkVTKHistogram);
+  for (int axis = 0; axis < 3; ++axis)
+    {
+    if (extent[2 * axis] < wholeExtent[2 * axis] ||
+        extent[2 * axis + 1] > wholeExtent[2 * axis + 1])
+      {
+      d->FullBuildNeeded = true;
+      return;
+      }
+    }
+  // Tuples are stored relative to the origin of the whole extent
+  const vtkIdType dimensions[2] = {
+    wholeExtent[1] - wholeExtent[0] + 1, wholeExtent[3] - wholeExtent[2] + 1};
+  const vtkIdType rowLength = extent[1] - extent[0] + 1;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+    {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+      {
+      const vtkIdType firstTuple =
+        ((k - wholeExtent[4]) * dimensions[1] + (j - wholeExtent[2])) * dimensions[0]
+        + (extent[0] - wholeExtent[0]);
+      this->aboutToModifyTuples(firstTuple, rowLength);
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+qreal ctkVTKHistogram::percentileValue(qreal percent)const
+{
+  Q_D(const ctkVTKHistogram);
+  const QVector<qint64>& cumulativeBins = d->cumulativeBins();
+  if (cumulativeBins.isEmpty() || cumulativeBins.last() <= 0)
+    {
+    qreal minRange = 0.;
+    qreal maxRange = 0.;
+    this->range(minRange, maxRange);
+    return minRange;
+    }
+  const qint64 total = cumulativeBins.last();
+  const qint64 target = qBound(Q_INT64_C(1),
+    static_cast<qint64>(std::ceil(qBound(0., percent, 100.) / 100. * total)), total);
+  QVector<qint64>::const_iterator bin =
+    qLowerBound(cumulativeBins.constBegin(), cumulativeBins.constEnd(), target);
+  return this->indexToPos(bin - cumulativeBins.constBegin());
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKHistogram::percentileRange(qreal lowerPercent, qreal upperPercent,
+                                      qreal& minValue, qreal& maxValue)const
+{
+  minValue = this->percentileValue(lowerPercent);
+  maxValue = this->percentileValue(upperPercent);
 }
 
 //-----------------------------------------------------------------------------
@@ -310,14 +718,44 @@ void ctkVTKHistogram::build()
 {
   Q_D(ctkVTKHistogram);
 
+  d->CumulativeBins.clear();
+
   if (d->DataArray.GetPointer() == 0)
     {
+    d->invalidate();
     d->MinBin = 0;
     d->MaxBin = 0;
     d->Bins->SetNumberOfTuples(0);
     return;
     }
 
+  // Only bin the new values of the modified tuples
+  if (d->Built && !d->FullBuildNeeded && !d->ModifiedTuples.isEmpty())
+    {
+    const int binCount = d->Bins->GetNumberOfTuples();
+    const bool regularBins = (static_cast<double>(binCount) == (d->Range[1] - d->Range[0] + 1));
+    bool updated = true;
+    QMap<vtkIdType, vtkIdType>::const_iterator tuples;
+    for (tuples = d->ModifiedTuples.constBegin();
+         updated && tuples != d->ModifiedTuples.constEnd(); ++tuples)
+      {
+      switch(d->DataArray->GetDataType())
+        {
+        vtkTemplateMacro(updated = updateBins<VTK_TT>(
+          d->Bins, this, regularBins, tuples.key(), tuples.value() - tuples.key(), 1));
+        }
+      }
+    d->ModifiedTuples.clear();
+    if (updated)
+      {
+      d->updateMinMaxBins();
+      emit changed();
+      return;
+      }
+    }
+  d->ModifiedTuples.clear();
+  d->FullBuildNeeded = false;
+
   const int binCount = d->computeNumberOfBins();
 
   d->Bins->SetNumberOfComponents(1);
@@ -325,36 +763,21 @@ void ctkVTKHistogram::build()
 
   if (binCount <= 0)
     {
+    d->Built = false;
     d->MinBin = 0;
     d->MaxBin = 0;
     return;
     }
 
   // What is the type of the array, discrete or reals
-  if (static_cast<double>(binCount) != (d->Range[1] - d->Range[0] + 1))
+  const bool regularBins = (static_cast<double>(binCount) == (d->Range[1] - d->Range[0] + 1));
+  switch(d->DataArray->GetDataType())
     {
-    switch(d->DataArray->GetDataType())
-      {
-      vtkTemplateMacro(populateIrregularBins<VTK_TT>(d->Bins, this));
-      }
-    }
-  else
-    {
-    switch(d->DataArray->GetDataType())
-      {
-      vtkTemplateMacro(populateBins<VTK_TT>(d->Bins, this));
-      }
+    vtkTemplateMacro(populateBins<VTK_TT>(d->Bins, this, regularBins));
     }
+  d->Built = true;
   // update Min/Max values
-  int* binPtr = d->Bins->GetPointer(0);
-  int* endPtr = d->Bins->GetPointer(binCount-1);
-  d->MinBin = *endPtr;
-  d->MaxBin = *endPtr;
-  for (;binPtr < endPtr; ++binPtr)
-    {
-    d->MinBin = qMin(*binPtr, d->MinBin);
-    d->MaxBin = qMax(*binPtr, d->MaxBin);
-    }
+  d->updateMinMaxBins();
   emit changed();
 }
 
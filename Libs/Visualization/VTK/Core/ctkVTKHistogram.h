@@ -21,6 +21,9 @@
 #ifndef __ctkVTKHistogram_h
 #define __ctkVTKHistogram_h
 
+// VTK includes
+#include <vtkType.h>
+
 // CTK includes
 #include "ctkHistogram.h"
 #include "ctkPimpl.h"
@@ -61,8 +64,47 @@ public:
 
   void setNumberOfBins(int number);
 
+  /// Set the number of threads used by build() to populate the bins.
+  /// 0 (default) uses QThread::idealThreadCount(). Small arrays are always
+  /// processed by a single thread.
+  void setNumberOfThreads(int number);
+  int numberOfThreads()const;
+
+  /// Only consider every \a stride tuple of the data array when building the
+  /// histogram. With a stride larger than 1 (1 by default), the bins are
+  /// approximated: their counts are multiplied by the stride to stay
+  /// comparable with a full histogram.
+  void setSamplingStride(int stride);
+  int samplingStride()const;
+
   virtual void removeControlPoint( qreal pos );
 
+  /// Incremental update of the bins.
+  /// Call aboutToModifyTuples() before changing the values of the given
+  /// tuples: their current values are removed from the bins, and the next
+  /// build() only bins their new values instead of processing the whole array.
+  /// It can be called several times before build(), with overlapping
+  /// tuples or not.
+  /// The range of the histogram is kept: if a new value is out of range, or
+  /// if a sampling stride is set, build() falls back to a full rebuild.
+  void aboutToModifyTuples(vtkIdType firstTuple, vtkIdType numberOfTuples);
+
+  /// Convenience method for image data: \a extent is the inclusive
+  /// (i, j, k) index extent of the region that is going to be modified in
+  /// an image whose data covers \a wholeExtent (see vtkImageData::GetExtent()).
+  /// The extents do not need to start at 0. If \a extent is not inside
+  /// \a wholeExtent, the next build() is a full rebuild.
+  /// \sa aboutToModifyTuples
+  void aboutToModifyExtent(const int extent[6], const int wholeExtent[6]);
+
+  /// Value below which the given percentage (between 0 and 100) of the
+  /// binned values fall, e.g. to automatically set a window/level.
+  /// The cumulative histogram is cached until the next build(), the lookup
+  /// is O(log(count())).
+  qreal percentileValue(qreal percent)const;
+  void percentileRange(qreal lowerPercent, qreal upperPercent,
+                       qreal& minValue, qreal& maxValue)const;
+
   virtual void build();
 protected:
   qreal indexToPos(int index)const;
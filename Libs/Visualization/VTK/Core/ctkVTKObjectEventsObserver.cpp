@@ -19,10 +19,12 @@
 =========================================================================*/
 
 // Qt includes
+#include <QChildEvent>
 #include <QStringList>
 #include <QVariant>
 #include <QList>
 #include <QHash>
+#include <QPair>
 #include <QDebug>
 
 // CTK includes
@@ -98,6 +100,17 @@ public:
   QList<ctkVTKConnection*> findConnections(vtkObject* vtk_obj, unsigned long vtk_event,
     const QObject* qt_obj, const char* qt_slot)const;
 
+  ///
+  /// Return the connections that may match the given parameters
+  QList<ctkVTKConnection*> candidateConnections(vtkObject* vtk_obj,
+    unsigned long vtk_event, const QObject* qt_obj,
+    const QByteArray& normalized_qt_slot)const;
+
+  void indexConnection(ctkVTKConnection* connection,
+                       vtkObject* vtk_obj, unsigned long vtk_event,
+                       const QObject* qt_obj, const QByteArray& normalized_qt_slot);
+  void unindexConnection(QObject* connection);
+
   inline QList<ctkVTKConnection*> connections()const
   {
     Q_Q(const ctkVTKObjectEventsObserver);
@@ -107,6 +120,25 @@ public:
   bool StrictTypeCheck;
   bool AllBlocked;
   bool ObserveDeletion;
+
+  /// Connections indexed by the vtkObject and event they were set up with.
+  /// The vtkObject of a connection is reset when it is deleted, the
+  /// candidates must still be checked with ctkVTKConnection::isEqual().
+  typedef QMultiHash<unsigned long, ctkVTKConnection*> EventConnections;
+  QHash<vtkObject*, EventConnections> ConnectionsByObject;
+  QHash<QString, ctkVTKConnection*> ConnectionsById;
+  /// Connections indexed by their QObject and normalized slot, to find the
+  /// connections of a slot without vtkObject (e.g. reconnection()).
+  typedef QPair<const QObject*, QByteArray> SlotKey;
+  QMultiHash<SlotKey, ctkVTKConnection*> ConnectionsBySlot;
+  struct ConnectionKey
+    {
+    vtkObject* VTKObject;
+    unsigned long VTKEvent;
+    SlotKey Slot;
+    QString Id;
+    };
+  QHash<QObject*, ConnectionKey> ConnectionKeys;
 };
 
 //-----------------------------------------------------------------------------
@@ -126,14 +158,75 @@ ctkVTKObjectEventsObserverPrivate::ctkVTKObjectEventsObserverPrivate(ctkVTKObjec
 ctkVTKConnection*
 ctkVTKObjectEventsObserverPrivate::findConnection(const QString& id)const
 {
-  foreach(ctkVTKConnection* connection, this->connections())
+  return this->ConnectionsById.value(id, 0);
+}
+
+//-----------------------------------------------------------------------------
+QList<ctkVTKConnection*>
+ctkVTKObjectEventsObserverPrivate::candidateConnections(
+  vtkObject* vtk_obj, unsigned long vtk_event,
+  const QObject* qt_obj, const QByteArray& normalized_qt_slot)const
+{
+  if (vtk_obj == NULL)
     {
-    if (connection->id() == id)
+    if (qt_obj && !normalized_qt_slot.isNull())
       {
-      return connection;
+      return this->ConnectionsBySlot.values(qMakePair(qt_obj, normalized_qt_slot));
       }
+    return this->connections();
     }
-  return 0;
+  QHash<vtkObject*, EventConnections>::const_iterator it =
+    this->ConnectionsByObject.constFind(vtk_obj);
+  if (it == this->ConnectionsByObject.constEnd())
+    {
+    return QList<ctkVTKConnection*>();
+    }
+  return vtk_event == vtkCommand::NoEvent ?
+    it.value().values() : it.value().values(vtk_event);
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserverPrivate::indexConnection(
+  ctkVTKConnection* connection, vtkObject* vtk_obj, unsigned long vtk_event,
+  const QObject* qt_obj, const QByteArray& normalized_qt_slot)
+{
+  ConnectionKey key;
+  key.VTKObject = vtk_obj;
+  key.VTKEvent = vtk_event;
+  key.Slot = qMakePair(qt_obj, normalized_qt_slot);
+  key.Id = connection->id();
+  this->ConnectionsByObject[vtk_obj].insert(vtk_event, connection);
+  this->ConnectionsBySlot.insert(key.Slot, connection);
+  this->ConnectionsById.insert(key.Id, connection);
+  this->ConnectionKeys.insert(connection, key);
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserverPrivate::unindexConnection(QObject* connection)
+{
+  QHash<QObject*, ConnectionKey>::iterator keyIt =
+    this->ConnectionKeys.find(connection);
+  if (keyIt == this->ConnectionKeys.end())
+    {
+    return;
+    }
+  const ConnectionKey& key = keyIt.value();
+  QHash<vtkObject*, EventConnections>::iterator objectIt =
+    this->ConnectionsByObject.find(key.VTKObject);
+  if (objectIt != this->ConnectionsByObject.end())
+    {
+    // connection is being destroyed, only its address can be used
+    objectIt.value().remove(key.VTKEvent,
+                            static_cast<ctkVTKConnection*>(connection));
+    if (objectIt.value().isEmpty())
+      {
+      this->ConnectionsByObject.erase(objectIt);
+      }
+    }
+  this->ConnectionsBySlot.remove(key.Slot,
+                                 static_cast<ctkVTKConnection*>(connection));
+  this->ConnectionsById.remove(key.Id);
+  this->ConnectionKeys.erase(keyIt);
 }
 
 //-----------------------------------------------------------------------------
@@ -142,9 +235,11 @@ ctkVTKObjectEventsObserverPrivate::findConnection(
   vtkObject* vtk_obj, unsigned long vtk_event,
   const QObject* qt_obj, const char* qt_slot)const
 {
-  foreach (ctkVTKConnection* connection, this->connections())
+  const QByteArray normalizedSlot = ctkVTKConnection::normalizedSlot(qt_slot);
+  foreach (ctkVTKConnection* connection,
+           this->candidateConnections(vtk_obj, vtk_event, qt_obj, normalizedSlot))
     {
-    if (connection->isEqual(vtk_obj, vtk_event, qt_obj, qt_slot))
+    if (connection->isEqual(vtk_obj, vtk_event, qt_obj, normalizedSlot))
       {
       return connection;
       }
@@ -165,11 +260,13 @@ ctkVTKObjectEventsObserverPrivate::findConnections(
     all_info = false;
     }
 
+  const QByteArray normalizedSlot = ctkVTKConnection::normalizedSlot(qt_slot);
   QList<ctkVTKConnection*> foundConnections;
-  // Loop through all connection
-  foreach (ctkVTKConnection* connection, this->connections())
+  // Loop through the connections of vtk_obj or of the slot, or all of them
+  foreach (ctkVTKConnection* connection,
+           this->candidateConnections(vtk_obj, vtk_event, qt_obj, normalizedSlot))
     {
-    if (connection->isEqual(vtk_obj, vtk_event, qt_obj, qt_slot))
+    if (connection->isEqual(vtk_obj, vtk_event, qt_obj, normalizedSlot))
       {
       foundConnections.append(connection);
       if (all_info)
@@ -315,6 +412,8 @@ QString ctkVTKObjectEventsObserver::addConnection(vtkObject* vtk_obj, unsigned l
   ctkVTKConnection * connection = ctkVTKConnectionFactory::instance()->createConnection(this);
   connection->observeDeletion(d->ObserveDeletion);
   connection->setup(vtk_obj, vtk_event, qt_obj, qt_slot, priority, connectionType);
+  d->indexConnection(connection, vtk_obj, vtk_event,
+                     qt_obj, ctkVTKConnection::normalizedSlot(qt_slot));
 
   // If required, establish connection
   connection->setBlocked(d->AllBlocked);
@@ -396,6 +495,8 @@ int ctkVTKObjectEventsObserver::removeConnection(vtkObject* vtk_obj, unsigned lo
 
   foreach (ctkVTKConnection* connection, connections)
     {
+    // childEvent() would unindex it as well, but only with an application
+    d->unindexConnection(connection);
     delete connection;
     }
   return connections.count();
@@ -414,3 +515,14 @@ bool ctkVTKObjectEventsObserver::containsConnection(vtkObject* vtk_obj, unsigned
   Q_D(const ctkVTKObjectEventsObserver);
   return (d->findConnection(vtk_obj, vtk_event, qt_obj, qt_slot) != 0);
 }
+
+//-----------------------------------------------------------------------------
+void ctkVTKObjectEventsObserver::childEvent(QChildEvent* event)
+{
+  Q_D(ctkVTKObjectEventsObserver);
+  if (event->removed())
+    {
+    d->unindexConnection(event->child());
+    }
+  this->Superclass::childEvent(event);
+}
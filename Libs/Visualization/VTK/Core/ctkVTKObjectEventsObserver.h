@@ -163,6 +163,9 @@ public:
 protected:
   QScopedPointer<ctkVTKObjectEventsObserverPrivate> d_ptr;
 
+  /// Keep the connection indexes up to date when a connection is deleted.
+  virtual void childEvent(QChildEvent* event);
+
 private:
   Q_DECLARE_PRIVATE(ctkVTKObjectEventsObserver);
   Q_DISABLE_COPY(ctkVTKObjectEventsObserver);
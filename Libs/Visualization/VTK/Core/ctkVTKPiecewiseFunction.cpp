@@ -21,6 +21,7 @@
 /// Qt includes
 #include <QColor>
 #include <QDebug>
+#include <QtAlgorithms>
 
 /// CTK includes
 #include "ctkVTKPiecewiseFunction.h"
@@ -32,9 +33,69 @@
 class ctkVTKPiecewiseFunctionPrivate
 {
 public:
+  ctkVTKPiecewiseFunctionPrivate();
+  /// Sample the function again if it has been modified
+  void updateTable()const;
+
   vtkSmartPointer<vtkPiecewiseFunction> PiecewiseFunction;
+
+  static const int TableSize = 1024;
+  mutable bool TableModified;
+  int TableVersion;
+  mutable QVector<qreal> Table;
+  mutable double Range[2];
+  mutable double MinValue;
+  mutable double MaxValue;
 };
 
+//-----------------------------------------------------------------------------
+ctkVTKPiecewiseFunctionPrivate::ctkVTKPiecewiseFunctionPrivate()
+{
+  this->TableModified = true;
+  this->TableVersion = 0;
+  this->Range[0] = 1.;
+  this->Range[1] = 0.;
+  this->MinValue = VTK_DOUBLE_MAX;
+  this->MaxValue = VTK_DOUBLE_MIN;
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKPiecewiseFunctionPrivate::updateTable()const
+{
+  if (!this->TableModified)
+    {
+    return;
+    }
+  this->TableModified = false;
+  this->Table.clear();
+  this->Range[0] = 1.;
+  this->Range[1] = 0.;
+  this->MinValue = VTK_DOUBLE_MAX;
+  this->MaxValue = VTK_DOUBLE_MIN;
+  if (this->PiecewiseFunction.GetPointer() == 0)
+    {
+    return;
+    }
+  this->PiecewiseFunction->GetRange(this->Range);
+  const int count = this->PiecewiseFunction->GetSize();
+  for (int i = 0; i < count; ++i)
+    {
+    double value[4];
+    this->PiecewiseFunction->GetNodeValue(i, value);
+    this->MinValue = qMin(value[1], this->MinValue);
+    this->MaxValue = qMax(value[1], this->MaxValue);
+    }
+  if (count == 0)
+    {
+    return;
+    }
+  QVector<double> table(TableSize);
+  this->PiecewiseFunction->GetTable(this->Range[0], this->Range[1],
+                                    TableSize, table.data());
+  this->Table.resize(TableSize);
+  qCopy(table.constBegin(), table.constEnd(), this->Table.begin());
+}
+
 //-----------------------------------------------------------------------------
 ctkVTKPiecewiseFunction::ctkVTKPiecewiseFunction(vtkPiecewiseFunction* piecewiseFunction,
                                                          QObject* parentObject)
@@ -84,10 +145,9 @@ void ctkVTKPiecewiseFunction::range(qreal& minRange, qreal& maxRange)const
     maxRange = 0.;
     return;
     }
-  double rangeValues[2];
-  d->PiecewiseFunction->GetRange(rangeValues);
-  minRange = rangeValues[0];
-  maxRange = rangeValues[1];
+  d->updateTable();
+  minRange = d->Range[0];
+  maxRange = d->Range[1];
 }
 
 //-----------------------------------------------------------------------------
@@ -99,16 +159,8 @@ QVariant ctkVTKPiecewiseFunction::minValue()const
     Q_ASSERT(d->PiecewiseFunction.GetPointer());
     return -1;
     }
-  //Initialize to max value
-  /// TODO initialize with max value
-  double minValue = VTK_DOUBLE_MAX;
-  for (int i = 0; i < this->count(); ++i)
-    {
-    double value[4];
-    d->PiecewiseFunction->GetNodeValue(i, value);
-    minValue = qMin(value[1], minValue);
-    }
-  return minValue;
+  d->updateTable();
+  return d->MinValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -120,16 +172,8 @@ QVariant ctkVTKPiecewiseFunction::maxValue()const
     Q_ASSERT(d->PiecewiseFunction.GetPointer());
     return -1;
     }
-  //Initialize to max value
-  /// TODO initialize with max value
-  qreal maxValue = VTK_DOUBLE_MIN;
-  for (int i = 0; i < this->count(); ++i)
-    {
-    double value[4];
-    d->PiecewiseFunction->GetNodeValue(i, value);
-    maxValue = qMax(maxValue, value[1]);
-    }
-  return maxValue;
+  d->updateTable();
+  return d->MaxValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -274,12 +318,43 @@ void ctkVTKPiecewiseFunction::setControlPointValue(int index, const QVariant& va
 void ctkVTKPiecewiseFunction::setPiecewiseFunction(vtkPiecewiseFunction* piecewiseFunction)
 {
   Q_D(ctkVTKPiecewiseFunction);
+  this->qvtkReconnect(d->PiecewiseFunction, piecewiseFunction,
+                      vtkCommand::ModifiedEvent,
+                      this, SLOT(onPiecewiseFunctionModified()));
   d->PiecewiseFunction = piecewiseFunction;
-  this->qvtkReconnect(d->PiecewiseFunction,vtkCommand::ModifiedEvent,
-                      this, SIGNAL(changed()));
+  this->onPiecewiseFunctionModified();
+}
+
+//-----------------------------------------------------------------------------
+void ctkVTKPiecewiseFunction::onPiecewiseFunctionModified()
+{
+  Q_D(ctkVTKPiecewiseFunction);
+  d->TableModified = true;
+  ++d->TableVersion;
   emit changed();
 }
 
+//-----------------------------------------------------------------------------
+QVector<qreal> ctkVTKPiecewiseFunction::table()const
+{
+  Q_D(const ctkVTKPiecewiseFunction);
+  d->updateTable();
+  return d->Table;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKPiecewiseFunction::tableSize()
+{
+  return ctkVTKPiecewiseFunctionPrivate::TableSize;
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKPiecewiseFunction::tableVersion()const
+{
+  Q_D(const ctkVTKPiecewiseFunction);
+  return d->TableVersion;
+}
+
 //-----------------------------------------------------------------------------
 vtkPiecewiseFunction* ctkVTKPiecewiseFunction::piecewiseFunction()const
 {
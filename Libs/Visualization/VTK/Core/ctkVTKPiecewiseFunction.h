@@ -21,6 +21,9 @@
 #ifndef __ctkVTKPiecewiseFunction_h
 #define __ctkVTKPiecewiseFunction_h
 
+// Qt includes
+#include <QVector>
+
 // CTK includes
 #include "ctkTransferFunction.h"
 #include "ctkPimpl.h"
@@ -63,6 +66,22 @@ public:
 
   void setPiecewiseFunction(vtkPiecewiseFunction* piecewiseFunction);
   vtkPiecewiseFunction* piecewiseFunction()const;
+
+  /// Return the values of the function sampled at tableSize() regularly
+  /// spaced positions over its range.
+  /// The table is computed once and kept until the function is modified;
+  /// range(), minValue() and maxValue() are served from it. value() always
+  /// evaluates the function: it is exact whatever the color space, midpoints
+  /// and sharpness of the nodes. Use the table to sample many positions.
+  QVector<qreal> table()const;
+  static int tableSize();
+  /// Incremented each time the function is modified and the table
+  /// invalidated.
+  int tableVersion()const;
+
+protected Q_SLOTS:
+  void onPiecewiseFunctionModified();
+
 protected:
   QScopedPointer<ctkVTKPiecewiseFunctionPrivate> d_ptr;
 
@@ -27,6 +27,7 @@
 #include <vtkCornerAnnotation.h>
 #include <vtkImageData.h>
 #include <vtkImageMapper.h>
+#include <vtkImageMapToWindowLevelColors.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPoints.h>
@@ -72,7 +73,17 @@ public:
   /// Set HighlightedBox color
   void SetHighlightedBoxColor(double* newHighlightedBoxColor);
 
+  /// Set the image displayed by the image mapper
+  void SetImageData(vtkImageData* newImageData);
+
+  /// Set the color window and level applied to the displayed slice
+  void SetColorWindowAndLevel(double colorWindow, double colorLevel);
+
   vtkSmartPointer<vtkRenderer>                Renderer;
+  /// Window/level the displayed slice only and keep the result until the
+  /// image, the slice or the window/level change. The image mapper then
+  /// draws unsigned char pixels without any conversion.
+  vtkSmartPointer<vtkImageMapToWindowLevelColors> WindowLevel;
   vtkSmartPointer<vtkImageMapper>             ImageMapper;
   vtkSmartPointer<vtkActor2D>                 HighlightedBoxActor;
 };
@@ -99,7 +110,7 @@ RenderWindowItem::RenderWindowItem(const double rendererBackgroundColor[3],
 //-----------------------------------------------------------------------------
 RenderWindowItem::~RenderWindowItem()
 {
-  this->ImageMapper->SetInput(0);
+  this->SetImageData(0);
 }
 
 //-----------------------------------------------------------------------------
@@ -116,10 +127,15 @@ void RenderWindowItem::SetupImageMapperActor(double colorWindow, double colorLev
   assert(this->Renderer);
   assert(!this->ImageMapper);
 
-  // Instantiate an image mapper
+  // Instantiate the filter computing the slice to display
+  this->WindowLevel = vtkSmartPointer<vtkImageMapToWindowLevelColors>::New();
+  this->WindowLevel->SetWindow(colorWindow);
+  this->WindowLevel->SetLevel(colorLevel);
+
+  // Instantiate an image mapper, its input is already window/leveled
   this->ImageMapper = vtkSmartPointer<vtkImageMapper>::New();
-  this->ImageMapper->SetColorWindow(colorWindow);
-  this->ImageMapper->SetColorLevel(colorLevel);
+  this->ImageMapper->SetColorWindow(255.);
+  this->ImageMapper->SetColorLevel(127.5);
 
   // .. and its corresponding 2D actor
   vtkNew<vtkActor2D> actor2D;
@@ -216,6 +232,51 @@ void RenderWindowItem::SetHighlightedBoxColor(double* newHighlightedBoxColor)
   this->HighlightedBoxActor->GetProperty()->SetColor(newHighlightedBoxColor);
 }
 
+//-----------------------------------------------------------------------------
+void RenderWindowItem::SetImageData(vtkImageData* newImageData)
+{
+  if (!newImageData)
+    {
+    this->ImageMapper->SetInputConnection(0);
+#if VTK_MAJOR_VERSION <= 5
+    this->WindowLevel->SetInput(0);
+#else
+    this->WindowLevel->SetInputData(0);
+#endif
+    return;
+    }
+
+  // Keep the number of components of the image
+  switch (newImageData->GetNumberOfScalarComponents())
+    {
+    case 1:
+      this->WindowLevel->SetOutputFormatToLuminance();
+      break;
+    case 2:
+      this->WindowLevel->SetOutputFormatToLuminanceAlpha();
+      break;
+    case 3:
+      this->WindowLevel->SetOutputFormatToRGB();
+      break;
+    default:
+      this->WindowLevel->SetOutputFormatToRGBA();
+      break;
+    }
+#if VTK_MAJOR_VERSION <= 5
+  this->WindowLevel->SetInput(newImageData);
+#else
+  this->WindowLevel->SetInputData(newImageData);
+#endif
+  this->ImageMapper->SetInputConnection(this->WindowLevel->GetOutputPort());
+}
+
+//-----------------------------------------------------------------------------
+void RenderWindowItem::SetColorWindowAndLevel(double colorWindow, double colorLevel)
+{
+  this->WindowLevel->SetWindow(colorWindow);
+  this->WindowLevel->SetLevel(colorLevel);
+}
+
 //-----------------------------------------------------------------------------
 // vtkInternal
 //-----------------------------------------------------------------------------
@@ -369,7 +430,7 @@ void vtkLightBoxRendererManager::vtkInternal::updateRenderWindowItemsZIndex(int
       assert(itemId <= static_cast<int>(this->RenderWindowItemList.size()));
 
       RenderWindowItem * item = this->RenderWindowItemList.at(itemId);
-      assert(item->ImageMapper->GetInput());
+      assert(item->WindowLevel->GetInput());
 
       // Default to ctkVTKSliceView::LeftRightTopBottom
       int zSliceIndex = rowId * this->RenderWindowColumnCount + columnId;
@@ -469,11 +530,7 @@ void vtkLightBoxRendererManager::SetImageData(vtkImageData* newImageData)
       it != this->Internal->RenderWindowItemList.end();
       ++it)
     {
-#if VTK_MAJOR_VERSION <= 5
-    (*it)->ImageMapper->SetInput(newImageData);
-#else
-    (*it)->ImageMapper->SetInputData(newImageData);
-#endif
+    (*it)->SetImageData(newImageData);
     }
 
   if (newImageData)
@@ -486,6 +543,30 @@ void vtkLightBoxRendererManager::SetImageData(vtkImageData* newImageData)
   this->Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkLightBoxRendererManager::UpdateRenderWindowItem(int id)
+{
+  if (!this->IsInitialized())
+    {
+    vtkErrorMacro(<< "UpdateRenderWindowItem failed - vtkLightBoxRendererManager is NOT initialized");
+    return;
+    }
+  if (id < 0 || id >= static_cast<int>(this->Internal->RenderWindowItemList.size()))
+    {
+    return;
+    }
+  // Only the filter of that item executes again on the next render
+  this->Internal->RenderWindowItemList.at(id)->WindowLevel->Modified();
+
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkLightBoxRendererManager::UpdateRenderWindowItem(int rowId, int columnId)
+{
+  this->UpdateRenderWindowItem(this->ComputeRenderWindowItemId(rowId, columnId));
+}
+
 //----------------------------------------------------------------------------
 vtkCamera* vtkLightBoxRendererManager::GetActiveCamera()
 {
@@ -632,11 +713,7 @@ void vtkLightBoxRendererManager::SetRenderWindowLayout(int rowCount, int columnC
                                this->Internal->HighlightedBoxColor,
                                this->Internal->ColorWindow, this->Internal->ColorLevel);
       item->Renderer->SetLayer(this->Internal->RendererLayer);
-#if VTK_MAJOR_VERSION <= 5
-      item->ImageMapper->SetInput(this->Internal->ImageData);
-#else
-      item->ImageMapper->SetInputData(this->Internal->ImageData);
-#endif
+      item->SetImageData(this->Internal->ImageData);
       this->Internal->RenderWindowItemList.push_back(item);
       --extraItem;
       }
@@ -898,8 +975,7 @@ void vtkLightBoxRendererManager::SetColorWindowAndLevel(double colorWindow, doub
       it != this->Internal->RenderWindowItemList.end();
       ++it)
     {
-    (*it)->ImageMapper->SetColorWindow(colorWindow);
-    (*it)->ImageMapper->SetColorLevel(colorLevel);
+    (*it)->SetColorWindowAndLevel(colorWindow, colorLevel);
     }
 
   this->Internal->ColorWindow = colorWindow;
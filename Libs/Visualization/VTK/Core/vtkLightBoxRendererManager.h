@@ -51,8 +51,22 @@ class CTK_VISUALIZATION_VTK_CORE_EXPORT vtkLightBoxRendererManager : public vtkO
   vtkRenderWindow* GetRenderWindow();
 
   /// Set image data
+  /// Each render window item caches its window/leveled slice of the image:
+  /// it is recomputed only when the image data, the slice or the
+  /// color window/level of the item change.
+  /// \sa UpdateRenderWindowItem()
   void SetImageData(vtkImageData* newImageData);
 
+  /// Recompute the cached slice of the render window item identified by \a id.
+  /// If only the voxels of that slice were changed, call this method instead
+  /// of vtkImageData::Modified() so that the other items keep their cache.
+  void UpdateRenderWindowItem(int id);
+
+  /// Recompute the cached slice of the render window item given its position
+  /// in the grid
+  /// \sa UpdateRenderWindowItem(int)
+  void UpdateRenderWindowItem(int rowId, int columnId);
+
   /// Get active camera
   /// Note that the same camera is used with all the renderWindowItem
   vtkCamera* GetActiveCamera();
@@ -59,6 +59,35 @@ int ctkVTKDataSetArrayComboBoxTest1(int argc, char * argv [] )
   comboBox.setDataSet(dataSet.GetPointer());
   comboBox.show();
 
+  // Arrays beyond the first batch of rows can be selected by name
+  const int arrayCount = 300;
+  vtkNew<vtkPolyData> manyArraysDataSet;
+  for (int i = 0; i < arrayCount; ++i)
+    {
+    vtkNew<vtkFloatArray> array;
+    array->SetName(QString("Array%1").arg(i).toLatin1());
+    manyArraysDataSet->GetPointData()->AddArray(array.GetPointer());
+    }
+  ctkVTKDataSetArrayComboBox manyArraysComboBox;
+  manyArraysComboBox.setDataSet(manyArraysDataSet.GetPointer());
+  manyArraysComboBox.setCurrentArray(QString("Array%1").arg(arrayCount - 1));
+  if (manyArraysComboBox.currentIndex() != arrayCount - 1 ||
+      manyArraysComboBox.currentArrayName() != QString("Array%1").arg(arrayCount - 1) ||
+      manyArraysComboBox.currentArray() !=
+        manyArraysDataSet->GetPointData()->GetArray(arrayCount - 1))
+    {
+    std::cerr << "Line " << __LINE__ << " - setCurrentArray(QString) failed: "
+              << manyArraysComboBox.currentIndex() << std::endl;
+    return EXIT_FAILURE;
+    }
+  manyArraysComboBox.setCurrentArray(QString("Unknown"));
+  if (manyArraysComboBox.currentIndex() != -1)
+    {
+    std::cerr << "Line " << __LINE__ << " - setCurrentArray(QString) failed: "
+              << manyArraysComboBox.currentIndex() << std::endl;
+    return EXIT_FAILURE;
+    }
+
   if (argc < 2 || QString(argv[1]) != "-I")
     {
     QTimer::singleShot(1000, &app, SLOT(quit()));
@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QDebug>
+
+// CTK includes
+#include "ctkVTKDataSetModel.h"
+
+// VTK includes
+#include <vtkCellData.h>
+#include <vtkFloatArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkVTKDataSetModelTest2(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  const int arrayCount = 1000;
+  vtkNew<vtkPolyData> dataSet;
+  for (int i = 0; i < arrayCount; ++i)
+    {
+    vtkSmartPointer<vtkFloatArray> array = vtkSmartPointer<vtkFloatArray>::New();
+    array->SetName(QString("Array%1").arg(i).toLatin1());
+    dataSet->GetPointData()->AddArray(array);
+    }
+
+  ctkVTKDataSetModel dataSetModel;
+  dataSetModel.setDataSet(dataSet.GetPointer());
+
+  // Only the first batch of arrays is inserted.
+  if (dataSetModel.rowCount() >= arrayCount ||
+      !dataSetModel.canFetchMore(QModelIndex()))
+    {
+    std::cerr << "Line " << __LINE__ << " - Model is not lazily populated: "
+              << dataSetModel.rowCount() << " rows" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const int firstBatchRowCount = dataSetModel.rowCount();
+
+  dataSetModel.fetchMore(QModelIndex());
+  if (dataSetModel.rowCount() <= firstBatchRowCount)
+    {
+    std::cerr << "Line " << __LINE__ << " - fetchMore() failed: "
+              << dataSetModel.rowCount() << " rows" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Looking up an array that has no row yet inserts it.
+  vtkDataArray* lastArray = dataSet->GetPointData()->GetArray(arrayCount - 1);
+  QModelIndex lastIndex = dataSetModel.indexFromArray(lastArray);
+  if (lastIndex.row() != arrayCount - 1 ||
+      dataSetModel.rowCount() != arrayCount ||
+      dataSetModel.canFetchMore(QModelIndex()))
+    {
+    std::cerr << "Line " << __LINE__ << " - indexFromArray() failed: "
+              << lastIndex.row() << " " << dataSetModel.rowCount() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Adding or removing arrays only updates the rows of these arrays.
+  QStandardItem* firstItem = dataSetModel.item(0);
+  QStandardItem* lastItem = dataSetModel.item(arrayCount - 1);
+
+  vtkNew<vtkFloatArray> cellArray;
+  cellArray->SetName("CellArray");
+  dataSet->GetCellData()->AddArray(cellArray.GetPointer());
+  dataSet->Modified();
+  if (dataSetModel.item(0) != firstItem ||
+      dataSetModel.item(arrayCount - 1) != lastItem ||
+      dataSetModel.arrayFromIndex(dataSetModel.index(arrayCount, 0)) != cellArray.GetPointer())
+    {
+    std::cerr << "Line " << __LINE__ << " - Failed to add an array" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  dataSet->GetPointData()->RemoveArray(1);
+  dataSet->Modified();
+  if (dataSetModel.rowCount() != arrayCount ||
+      dataSetModel.item(0) != firstItem ||
+      dataSetModel.item(arrayCount - 2) != lastItem ||
+      dataSetModel.findItems("Array1").count() != 0)
+    {
+    std::cerr << "Line " << __LINE__ << " - Failed to remove an array" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  dataSet->GetPointData()->GetArray(0)->SetName("Renamed");
+  dataSet->Modified();
+  if (dataSetModel.item(0) != firstItem ||
+      firstItem->text() != "Renamed")
+    {
+    std::cerr << "Line " << __LINE__ << " - Failed to rename an array" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  dataSetModel.setDataSet(0);
+  if (dataSetModel.rowCount() != 0 ||
+      dataSetModel.canFetchMore(QModelIndex()))
+    {
+    std::cerr << "Line " << __LINE__ << " - Failed to clear the model" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+#include "ctkVTKMagnifyView.h"
+
+// VTK includes
+#include <QVTKWidget.h>
+#include <vtkRenderWindow.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+// Helper functions
+#include "ctkVTKMagnifyViewTestHelper.cpp"
+
+namespace
+{
+//-----------------------------------------------------------------------------
+qint64 moveMouse(QVTKWidget& widget, int firstMove, int numberOfMoves)
+{
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  for (int i = firstMove; i < firstMove + numberOfMoves; ++i)
+    {
+    moveMouse(widget, i);
+    }
+  return timer.elapsedMicro();
+}
+}
+
+//-----------------------------------------------------------------------------
+int ctkVTKMagnifyViewTest3(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  QVTKWidget widget;
+  widget.resize(400, 300);
+  ctkVTKMagnifyView magnify;
+  setupMagnifyView(widget, magnify);
+
+  if (magnify.numberOfReadbacks() != 0)
+    {
+    std::cerr << "ctkVTKMagnifyView: unexpected readback: "
+              << magnify.numberOfReadbacks() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The first move reads the window back, the others reuse it
+  const int numberOfMoves = 100;
+  qint64 cachedMovesTime = moveMouse(widget, 0, numberOfMoves);
+  if (magnify.numberOfReadbacks() != 1 || magnify.pixmap() == 0 ||
+      magnify.pixmap()->isNull())
+    {
+    std::cerr << "ctkVTKMagnifyView: mouse moves without render failed: "
+              << magnify.numberOfReadbacks() << " readbacks" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A render invalidates the readback
+  widget.GetRenderWindow()->Render();
+  moveMouse(widget, 0, numberOfMoves);
+  if (magnify.numberOfReadbacks() != 2)
+    {
+    std::cerr << "ctkVTKMagnifyView: mouse moves after render failed: "
+              << magnify.numberOfReadbacks() << " readbacks" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Render between each move: worst case
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  for (int i = 0; i < numberOfMoves; ++i)
+    {
+    widget.GetRenderWindow()->Render();
+    moveMouse(widget, i);
+    }
+  qint64 renderedMovesTime = timer.elapsedMicro();
+  if (magnify.numberOfReadbacks() != 2 + numberOfMoves)
+    {
+    std::cerr << "ctkVTKMagnifyView: wrong number of readbacks: "
+              << magnify.numberOfReadbacks() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Mouse move without render: "
+            << cachedMovesTime / numberOfMoves << " us, "
+            << "with render: " << renderedMovesTime / numberOfMoves << " us"
+            << std::endl;
+
+  if (argc < 2 || QString(argv[1]) != "-I")
+    {
+    return EXIT_SUCCESS;
+    }
+  return app.exec();
+}
@@ -0,0 +1,67 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QMouseEvent>
+
+// CTK includes
+#include "ctkVTKMagnifyView.h"
+
+// VTK includes
+#include <QVTKWidget.h>
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Show the widget with a gradient background and a magnifier observing it.
+// The magnifier processes the mouse moves as they come.
+void setupMagnifyView(QVTKWidget& widget, ctkVTKMagnifyView& magnify)
+{
+  vtkNew<vtkRenderer> renderer;
+  renderer->SetBackground(0., 0., 0.);
+  renderer->SetBackground2(0., 0., 1.);
+  renderer->SetGradientBackground(true);
+  widget.GetRenderWindow()->AddRenderer(renderer.GetPointer());
+  widget.show();
+  widget.GetRenderWindow()->Render();
+
+  magnify.resize(100, 100);
+  magnify.setMagnification(5.);
+  magnify.setUpdateInterval(0);
+  magnify.setObserveRenderWindowEvents(false);
+  magnify.observe(&widget);
+  magnify.show();
+}
+
+//-----------------------------------------------------------------------------
+// Send the mouse move number \a move of a path that stays in the widget
+void moveMouse(QVTKWidget& widget, int move)
+{
+  QPoint pos(10 + (move * 7) % (widget.width() - 20),
+             10 + (move * 3) % (widget.height() - 20));
+  QMouseEvent event(QEvent::MouseMove, pos, Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+  QApplication::sendEvent(&widget, &event);
+}
+
+} // end of anonymous namespace
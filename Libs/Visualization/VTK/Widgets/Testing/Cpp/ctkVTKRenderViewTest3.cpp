@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QTimer>
+
+// CTK includes
+#include "ctkVTKRenderView.h"
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+//-----------------------------------------------------------------------------
+int ctkVTKRenderViewTest3(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  ctkVTKRenderView renderView;
+  renderView.show();
+  // Let the window be exposed and rendered
+  QTimer::singleShot(100, &app, SLOT(quit()));
+  app.exec();
+
+  // Default values
+  if (renderView.adaptiveFrameRate() != false ||
+      ctkVTKAbstractView::frameBudget() != 500.)
+    {
+    std::cerr << "ctkVTKAbstractView: Wrong default values: "
+              << renderView.adaptiveFrameRate() << " "
+              << ctkVTKAbstractView::frameBudget() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  renderView.resetRenderStatistics();
+  ctkVTKAbstractView::RenderStatistics statistics = renderView.renderStatistics();
+  if (statistics.RequestedRenders != 0 || statistics.Renders != 0 ||
+      statistics.meanRenderTime() != 0.)
+    {
+    std::cerr << "ctkVTKAbstractView::resetRenderStatistics failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Many requests without processing the events are coalesced
+  const int numberOfRequests = 10;
+  for (int i = 0; i < numberOfRequests; ++i)
+    {
+    renderView.scheduleRender();
+    }
+  statistics = renderView.renderStatistics();
+  if (statistics.RequestedRenders != numberOfRequests ||
+      statistics.CoalescedRenders + statistics.ForcedRenders != numberOfRequests - 1)
+    {
+    std::cerr << "ctkVTKAbstractView::scheduleRender failed: "
+              << statistics.RequestedRenders << " requested, "
+              << statistics.CoalescedRenders << " coalesced, "
+              << statistics.ForcedRenders << " forced" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  renderView.forceRender();
+  statistics = renderView.renderStatistics();
+  int histogramCount = 0;
+  foreach(int count, statistics.RenderTimeHistogram)
+    {
+    histogramCount += count;
+    }
+  if (statistics.Renders < 1 ||
+      histogramCount != statistics.Renders ||
+      statistics.LastRenderTime > statistics.MaximumRenderTime ||
+      statistics.TotalRenderTime < statistics.MaximumRenderTime ||
+      ctkVTKAbstractView::renderLoad() < statistics.LastRenderTime)
+    {
+    std::cerr << "ctkVTKAbstractView::forceRender failed: "
+              << statistics.Renders << " renders, "
+              << histogramCount << " in histogram, "
+              << statistics.LastRenderTime << " ms" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A budget of 0 disables the adaptive framerate
+  renderView.setAdaptiveFrameRate(true);
+  ctkVTKAbstractView::setFrameBudget(0.);
+  if (!renderView.adaptiveFrameRate() ||
+      ctkVTKAbstractView::frameBudget() != 0.)
+    {
+    std::cerr << "ctkVTKAbstractView::setAdaptiveFrameRate failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  renderView.scheduleRender();
+  if (renderView.renderStatistics().ThrottledRenders != 0)
+    {
+    std::cerr << "ctkVTKAbstractView: unexpected throttled render" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Let the scheduled render be done
+  QTimer::singleShot(50, &app, SLOT(quit()));
+  app.exec();
+
+  // A background view (not under the mouse and without focus) is delayed
+  // when all the views render over budget
+  renderView.clearFocus();
+  const double renderLoad = ctkVTKAbstractView::renderLoad();
+  if (renderLoad <= 0.)
+    {
+    std::cerr << "ctkVTKAbstractView::renderLoad failed: " << renderLoad << std::endl;
+    return EXIT_FAILURE;
+    }
+  ctkVTKAbstractView::setFrameBudget(renderLoad / 10.);
+  renderView.resetRenderStatistics();
+  renderView.scheduleRender();
+  statistics = renderView.renderStatistics();
+  if (statistics.ThrottledRenders != 1 ||
+      statistics.CoalescedRenders != 0 ||
+      statistics.ForcedRenders != 0)
+    {
+    std::cerr << "ctkVTKAbstractView: render not throttled: "
+              << statistics.ThrottledRenders << " throttled, "
+              << statistics.CoalescedRenders << " coalesced, "
+              << statistics.ForcedRenders << " forced" << std::endl;
+    return EXIT_FAILURE;
+    }
+  // The render is delayed by about 10 frames (the load is 10 times the
+  // budget) but not more than a second.
+  QTimer::singleShot(50, &app, SLOT(quit()));
+  app.exec();
+  if (renderView.renderStatistics().Renders != 0)
+    {
+    std::cerr << "ctkVTKAbstractView: throttled render not delayed" << std::endl;
+    return EXIT_FAILURE;
+    }
+  QTimer::singleShot(1100, &app, SLOT(quit()));
+  app.exec();
+  if (renderView.renderStatistics().Renders < 1)
+    {
+    std::cerr << "ctkVTKAbstractView: throttled render not done: "
+              << renderView.renderStatistics().Renders << " renders" << std::endl;
+    return EXIT_FAILURE;
+    }
+  ctkVTKAbstractView::setFrameBudget(500.);
+
+  if (argc < 2 || QString(argv[1]) != "-I")
+    {
+    QTimer::singleShot(200, &app, SLOT(quit()));
+    }
+  return app.exec();
+}
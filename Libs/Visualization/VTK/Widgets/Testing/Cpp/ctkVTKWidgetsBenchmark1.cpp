@@ -0,0 +1,286 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QImage>
+#include <QStringList>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+#include "ctkVTKHistogram.h"
+#include "ctkVTKMagnifyView.h"
+#include "ctkVTKRenderView.h"
+#include "ctkVTKWidgetsUtils.h"
+#include "vtkLightBoxRendererManager.h"
+
+// VTK includes
+#include <QVTKWidget.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkRenderWindow.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <cstdlib>
+
+// Helper functions
+#include "Testing/Cpp/ctkBenchmarkTestHelper.cpp"
+#include "Testing/Cpp/vtkLightBoxRendererManagerBenchmarkHelper.cpp"
+#include "ctkVTKMagnifyViewTestHelper.cpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+double elapsedMilli(ctkHighPrecisionTimer& timer)
+{
+  return static_cast<double>(timer.elapsedMicro()) / 1000.;
+}
+
+//-----------------------------------------------------------------------------
+ctkBenchmarkMeasurement renderMeasurement(const QString& name, const QList<double>& times)
+{
+  ctkBenchmarkMeasurement measurement = benchmarkMeasurement(name, "ms");
+  measurement.Samples = times;
+  return measurement;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> createRGBImage(int width, int height)
+{
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(width, height, 1);
+  image->SetScalarTypeToUnsignedChar();
+  image->SetNumberOfScalarComponents(3);
+  image->AllocateScalars();
+  unsigned char* ptr = static_cast<unsigned char*>(image->GetScalarPointer());
+  for (int i = 0; i < width * height * 3; ++i)
+    {
+    ptr[i] = static_cast<unsigned char>(i * 7);
+    }
+  return image;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkHistogram(vtkImageData* volume, int iterations,
+                        QList<ctkBenchmarkMeasurement>& measurements)
+{
+  vtkDataArray* scalars = volume->GetPointData()->GetScalars();
+  ctkVTKHistogram histogram(scalars);
+
+  // Without pending modifications, all the values are binned
+  ctkBenchmarkMeasurement build = benchmarkMeasurement("histogram.build", "ms");
+  ctkHighPrecisionTimer timer;
+  for (int i = 0; i < iterations; ++i)
+    {
+    timer.start();
+    histogram.build();
+    build.Samples << elapsedMilli(timer);
+    }
+  measurements << build;
+
+  // Only one slice changes
+  int* dimensions = volume->GetDimensions();
+  vtkIdType sliceSize = static_cast<vtkIdType>(dimensions[0]) * dimensions[1];
+  ctkBenchmarkMeasurement updateSlice = benchmarkMeasurement("histogram.updateSlice", "ms");
+  for (int i = 0; i < iterations; ++i)
+    {
+    timer.start();
+    histogram.aboutToModifyTuples((i % dimensions[2]) * sliceSize, sliceSize);
+    histogram.build();
+    updateSlice.Samples << elapsedMilli(timer);
+    }
+  measurements << updateSlice;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkImageConversion(int size, int iterations,
+                              QList<ctkBenchmarkMeasurement>& measurements)
+{
+  vtkSmartPointer<vtkImageData> image = createRGBImage(size, size);
+  ctkBenchmarkMeasurement conversion = benchmarkMeasurement("vtkImageDataToQImage", "ms");
+  ctkHighPrecisionTimer timer;
+  QImage qimage;
+  for (int i = 0; i < iterations; ++i)
+    {
+    timer.start();
+    qimage = ctk::vtkImageDataToQImage(image);
+    conversion.Samples << elapsedMilli(timer);
+    }
+  measurements << conversion;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkLightBox(vtkImageData* volume, int size, int iterations,
+                       QList<ctkBenchmarkMeasurement>& measurements)
+{
+  vtkSmartPointer<vtkRenderWindow> renderWindow = createOffScreenRenderWindow(size, size);
+
+  vtkNew<vtkLightBoxRendererManager> lightBox;
+  lightBox->Initialize(renderWindow);
+  lightBox->SetImageData(volume);
+  lightBox->SetRenderWindowLayout(4, 4);
+  lightBox->ResetCamera();
+
+  measurements
+    << renderMeasurement("lightBox.firstRender", QList<double>() << renderTime(renderWindow))
+    << renderMeasurement("lightBox.highlightRender",
+         lightBoxHighlightRenderTimes(lightBox.GetPointer(), renderWindow, iterations))
+    << renderMeasurement("lightBox.updateItemRender",
+         lightBoxUpdateItemRenderTimes(lightBox.GetPointer(), renderWindow, iterations))
+    << renderMeasurement("lightBox.windowLevelRender",
+         lightBoxWindowLevelRenderTimes(lightBox.GetPointer(), renderWindow, iterations))
+    << renderMeasurement("lightBox.unchangedRender",
+         lightBoxUnchangedRenderTimes(renderWindow, iterations));
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkMagnifier(int size, int iterations, QList<ctkBenchmarkMeasurement>& measurements)
+{
+  QVTKWidget widget;
+  widget.resize(size, size);
+  ctkVTKMagnifyView magnify;
+  setupMagnifyView(widget, magnify);
+
+  ctkBenchmarkMeasurement moves = benchmarkMeasurement("magnifier.move", "ms");
+  ctkHighPrecisionTimer timer;
+  for (int i = 0; i < iterations; ++i)
+    {
+    timer.start();
+    moveMouse(widget, i);
+    moves.Samples << elapsedMilli(timer);
+    }
+  measurements << moves;
+
+  ctkBenchmarkMeasurement renderedMoves = benchmarkMeasurement("magnifier.renderAndMove", "ms");
+  for (int i = 0; i < iterations; ++i)
+    {
+    timer.start();
+    widget.GetRenderWindow()->Render();
+    moveMouse(widget, i);
+    renderedMoves.Samples << elapsedMilli(timer);
+    }
+  renderedMoves.Values["readbacks"] = magnify.numberOfReadbacks();
+  measurements << renderedMoves;
+}
+
+//-----------------------------------------------------------------------------
+void benchmarkScheduleRender(QApplication& app, int size, int iterations,
+                             QList<ctkBenchmarkMeasurement>& measurements)
+{
+  ctkVTKRenderView renderView;
+  renderView.resize(size, size);
+  renderView.show();
+  renderView.forceRender();
+  app.processEvents();
+  renderView.resetRenderStatistics();
+
+  // Several requests per frame, as done by interactors and observers
+  const int requestsPerFrame = 10;
+  ctkBenchmarkMeasurement frames = benchmarkMeasurement("renderView.scheduledFrame", "ms");
+  ctkHighPrecisionTimer frameTimer;
+  for (int i = 0; i < iterations; ++i)
+    {
+    int renders = renderView.renderStatistics().Renders;
+    frameTimer.start();
+    for (int request = 0; request < requestsPerFrame; ++request)
+      {
+      renderView.scheduleRender();
+      }
+    while (renderView.renderStatistics().Renders == renders &&
+           frameTimer.elapsedMilli() < 1000)
+      {
+      app.processEvents();
+      }
+    frames.Samples << elapsedMilli(frameTimer);
+    }
+  ctkVTKAbstractView::RenderStatistics statistics = renderView.renderStatistics();
+  frames.Values["requestedRenders"] = statistics.RequestedRenders;
+  frames.Values["coalescedRenders"] = statistics.CoalescedRenders;
+  frames.Values["renders"] = statistics.Renders;
+  frames.Values["meanRenderTimeMs"] = statistics.meanRenderTime();
+  measurements << frames;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Usage: ctkVTKWidgetsBenchmark1 [--size N] [--iterations N] [--output file.json]
+// The results are written as JSON in the output file, or on the standard
+// output. The benchmarks that render are skipped if there is no display.
+int ctkVTKWidgetsBenchmark1(int argc, char * argv [] )
+{
+  int size = 256;
+  int iterations = 10;
+  QString outputFileName;
+  for (int i = 1; i + 1 < argc; i += 2)
+    {
+    QString argument(argv[i]);
+    if (argument == "--size")
+      {
+      size = qMax(QString(argv[i + 1]).toInt(), 32);
+      }
+    else if (argument == "--iterations")
+      {
+      iterations = qMax(QString(argv[i + 1]).toInt(), 1);
+      }
+    else if (argument == "--output")
+      {
+      outputFileName = argv[i + 1];
+      }
+    }
+
+  bool gui = canRender();
+  QApplication app(argc, argv, gui);
+
+  QList<ctkBenchmarkMeasurement> measurements;
+  vtkSmartPointer<vtkImageData> volume = createBenchmarkVolume(size, size, qMax(size / 4, 16));
+
+  benchmarkHistogram(volume, iterations, measurements);
+  benchmarkImageConversion(size, iterations, measurements);
+  if (gui)
+    {
+    benchmarkLightBox(volume, 2 * size, iterations, measurements);
+    benchmarkMagnifier(size, iterations, measurements);
+    benchmarkScheduleRender(app, size, iterations, measurements);
+    }
+  else
+    {
+    QStringList skipped;
+    skipped << "lightBox.firstRender" << "lightBox.highlightRender"
+            << "lightBox.updateItemRender" << "lightBox.windowLevelRender"
+            << "lightBox.unchangedRender" << "magnifier.move"
+            << "magnifier.renderAndMove" << "renderView.scheduledFrame";
+    foreach(const QString& name, skipped)
+      {
+      measurements << benchmarkMeasurement(name, "ms");
+      }
+    }
+
+  QVariantMap parameters;
+  parameters["benchmark"] = "ctkVTKWidgetsBenchmark1";
+  parameters["size"] = size;
+  parameters["iterations"] = iterations;
+  parameters["gui"] = gui;
+  return writeBenchmarkJson(outputFileName, parameters, measurements) ?
+    EXIT_SUCCESS : EXIT_FAILURE;
+}
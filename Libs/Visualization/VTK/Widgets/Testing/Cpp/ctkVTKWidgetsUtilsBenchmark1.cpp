@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Library:   CTK
+
+  Copyright (c) Kitware Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0.txt
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+=========================================================================*/
+
+// Qt includes
+#include <QApplication>
+#include <QColor>
+#include <QImage>
+
+// CTK includes
+#include "ctkHighPrecisionTimer.h"
+#include "ctkVTKWidgetsUtils.h"
+
+// VTK includes
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// Per pixel conversion previously used by ctk::vtkImageDataToQImage
+QImage perPixelImageDataToQImage(vtkImageData* imageData)
+{
+  int width = imageData->GetDimensions()[0];
+  int height = imageData->GetDimensions()[1];
+  QImage image(width, height, QImage::Format_RGB32);
+  QRgb* rgbPtr = reinterpret_cast<QRgb*>(image.bits()) +
+    width * (height-1);
+  unsigned char* colorsPtr = reinterpret_cast<unsigned char*>(
+    imageData->GetScalarPointer());
+  for(int row = 0; row < height; ++row)
+    {
+    for (int col = 0; col < width; ++col)
+      {
+      *(rgbPtr++) = QColor(colorsPtr[0], colorsPtr[1], colorsPtr[2]).rgb();
+      colorsPtr +=  3;
+      }
+    rgbPtr -= width * 2;
+    }
+  return image;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> createImage(int width, int height, int numberOfComponents)
+{
+  vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+  imageData->SetDimensions(width, height, 1);
+  imageData->SetScalarTypeToUnsignedChar();
+  imageData->SetNumberOfScalarComponents(numberOfComponents);
+  imageData->AllocateScalars();
+  unsigned char* ptr = static_cast<unsigned char*>(imageData->GetScalarPointer());
+  const int size = width * height * numberOfComponents;
+  unsigned int seed = 1;
+  for (int i = 0; i < size; ++i)
+    {
+    seed = seed * 1103515245u + 12345u;
+    ptr[i] = static_cast<unsigned char>(seed >> 16);
+    }
+  return imageData;
+}
+
+//-----------------------------------------------------------------------------
+bool benchmarkImage(int width, int height, int numberOfComponents, int iterations)
+{
+  vtkSmartPointer<vtkImageData> imageData = createImage(width, height, numberOfComponents);
+
+  ctkHighPrecisionTimer timer;
+  timer.start();
+  QImage image;
+  for (int i = 0; i < iterations; ++i)
+    {
+    image = ctk::vtkImageDataToQImage(imageData);
+    }
+  qint64 convertTime = timer.elapsedMicro() / iterations;
+
+  unsigned char* ptr = static_cast<unsigned char*>(imageData->GetScalarPointer());
+  // Check the first pixel of the bottom row (VTK origin)
+  QRgb expected = 0;
+  switch (numberOfComponents)
+    {
+    case 1: expected = qRgb(ptr[0], ptr[0], ptr[0]); break;
+    case 2: expected = qRgba(ptr[0], ptr[0], ptr[0], ptr[1]); break;
+    case 3: expected = qRgb(ptr[0], ptr[1], ptr[2]); break;
+    default: expected = qRgba(ptr[0], ptr[1], ptr[2], ptr[3]); break;
+    }
+  if (image.size() != QSize(width, height) ||
+      image.pixel(0, height - 1) != expected)
+    {
+    std::cerr << "Wrong conversion of a " << numberOfComponents
+              << " components image" << std::endl;
+    return false;
+    }
+
+  std::cout << width << "x" << height << ", " << numberOfComponents
+            << " components: " << convertTime << " us";
+  if (numberOfComponents == 3)
+    {
+    timer.start();
+    QImage perPixelImage;
+    for (int i = 0; i < iterations; ++i)
+      {
+      perPixelImage = perPixelImageDataToQImage(imageData);
+      }
+    qint64 perPixelTime = timer.elapsedMicro() / iterations;
+    if (perPixelImage != image)
+      {
+      std::cerr << std::endl << "Conversion differs from the per pixel conversion"
+                << std::endl;
+      return false;
+      }
+    std::cout << ", per pixel QColor: " << perPixelTime << " us";
+    }
+  std::cout << std::endl;
+  return true;
+}
+
+} // end of anonymous namespace
+
+//-----------------------------------------------------------------------------
+int ctkVTKWidgetsUtilsBenchmark1(int argc, char * argv [] )
+{
+  QApplication app(argc, argv);
+
+  const int iterations = 10;
+  for (int numberOfComponents = 1; numberOfComponents <= 4; ++numberOfComponents)
+    {
+    if (!benchmarkImage(640, 480, numberOfComponents, iterations) ||
+        !benchmarkImage(1920, 1080, numberOfComponents, iterations))
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Update extent smaller than the image
+  vtkSmartPointer<vtkImageData> imageData = createImage(64, 32, 3);
+  imageData->SetUpdateExtent(8, 23, 4, 11, 0, 0);
+  QImage image = ctk::vtkImageDataToQImage(imageData);
+  unsigned char* ptr = static_cast<unsigned char*>(imageData->GetScalarPointer(8, 4, 0));
+  if (image.size() != QSize(16, 8) ||
+      image.pixel(0, 7) != qRgb(ptr[0], ptr[1], ptr[2]))
+    {
+    std::cerr << "Failed to convert the update extent" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
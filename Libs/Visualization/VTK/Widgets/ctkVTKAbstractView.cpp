@@ -24,6 +24,7 @@
 #include <QDebug>
 
 // CTK includes
+#include "ctkHighPrecisionTimer.h"
 #include "ctkVTKAbstractView.h"
 #include "ctkVTKAbstractView_p.h"
 #include "ctkLogger.h"
@@ -38,9 +39,46 @@
 static ctkLogger logger("org.commontk.visualization.vtk.widgets.ctkVTKAbstractView");
 //--------------------------------------------------------------------------
 
+namespace
+{
+const int NumberOfRenderTimeBuckets = 16;
+// Never delay a background view by more than this
+const double MaximumThrottledMSecsBeforeRender = 1000.;
+// Period from which views rendering when idle (still mode) are throttled
+const double StillModeThrottledMSecsBeforeRender = 1000. / 30.;
+}
+
+// --------------------------------------------------------------------------
+// ctkVTKAbstractView::RenderStatistics methods
+
+// --------------------------------------------------------------------------
+ctkVTKAbstractView::RenderStatistics::RenderStatistics()
+  : RequestedRenders(0)
+  , CoalescedRenders(0)
+  , ThrottledRenders(0)
+  , ForcedRenders(0)
+  , Renders(0)
+  , TotalRenderTime(0.)
+  , LastRenderTime(0.)
+  , MaximumRenderTime(0.)
+  , RenderTimeHistogram(NumberOfRenderTimeBuckets, 0)
+{
+}
+
+// --------------------------------------------------------------------------
+double ctkVTKAbstractView::RenderStatistics::meanRenderTime()const
+{
+  return this->Renders ? this->TotalRenderTime / this->Renders : 0.;
+}
+
 // --------------------------------------------------------------------------
 // ctkVTKAbstractViewPrivate methods
 
+double ctkVTKAbstractViewPrivate::FrameBudget = 500.;
+QTime ctkVTKAbstractViewPrivate::RenderLoadTime;
+double ctkVTKAbstractViewPrivate::CurrentRenderLoad = 0.;
+double ctkVTKAbstractViewPrivate::LastRenderLoad = 0.;
+
 // --------------------------------------------------------------------------
 ctkVTKAbstractViewPrivate::ctkVTKAbstractViewPrivate(ctkVTKAbstractView& object)
   : q_ptr(&object)
@@ -52,6 +90,7 @@ ctkVTKAbstractViewPrivate::ctkVTKAbstractViewPrivate(ctkVTKAbstractView& object)
   this->FPSVisible = false;
   this->FPSTimer = 0;
   this->FPS = 0;
+  this->AdaptiveFrameRate = false;
 }
 
 // --------------------------------------------------------------------------
@@ -127,6 +166,43 @@ vtkRenderer* ctkVTKAbstractViewPrivate::firstRenderer()const
     ->GetItemAsObject(0));
 }
 
+//---------------------------------------------------------------------------
+bool ctkVTKAbstractViewPrivate::isInBackground()const
+{
+  return !this->VTKWidget->underMouse() && !this->VTKWidget->hasFocus();
+}
+
+//---------------------------------------------------------------------------
+void ctkVTKAbstractViewPrivate::addRender(double renderTime)
+{
+  ++this->Statistics.Renders;
+  this->Statistics.TotalRenderTime += renderTime;
+  this->Statistics.LastRenderTime = renderTime;
+  this->Statistics.MaximumRenderTime =
+    qMax(this->Statistics.MaximumRenderTime, renderTime);
+  int bucket = 0;
+  for (double upperBound = 1.; renderTime >= upperBound &&
+       bucket < NumberOfRenderTimeBuckets - 1; upperBound *= 2.)
+    {
+    ++bucket;
+    }
+  ++this->Statistics.RenderTimeHistogram[bucket];
+
+  // Render load of all the views, per second
+  if (!RenderLoadTime.isValid())
+    {
+    RenderLoadTime.start();
+    }
+  else if (RenderLoadTime.elapsed() >= 1000)
+    {
+    // No render during more than a second means no load
+    LastRenderLoad = RenderLoadTime.elapsed() < 2000 ? CurrentRenderLoad : 0.;
+    CurrentRenderLoad = 0.;
+    RenderLoadTime.start();
+    }
+  CurrentRenderLoad += renderTime;
+}
+
 //---------------------------------------------------------------------------
 // ctkVTKAbstractView methods
 
@@ -162,12 +238,27 @@ void ctkVTKAbstractView::scheduleRender()
   //             arg(d->RenderEnabled ? "true" : "false")
   //             .arg(d->RequestTime.elapsed()));
 
+  ++d->Statistics.RequestedRenders;
   if (!d->RenderEnabled)
     {
     return;
     }
 
   double msecsBeforeRender = 100. / d->RenderWindow->GetDesiredUpdateRate();
+  // Slow down background views when all the views render over budget
+  bool throttled = false;
+  if (d->AdaptiveFrameRate && d->isInBackground())
+    {
+    const double renderLoad = ctkVTKAbstractView::renderLoad();
+    if (renderLoad > d->FrameBudget && d->FrameBudget > 0.)
+      {
+      const double period = msecsBeforeRender > 10000 ?
+        StillModeThrottledMSecsBeforeRender : msecsBeforeRender;
+      msecsBeforeRender = qMin(period * renderLoad / d->FrameBudget,
+                               qMax(period, MaximumThrottledMSecsBeforeRender));
+      throttled = true;
+      }
+    }
   if(d->VTKWidget->testAttribute(Qt::WA_WState_InPaintEvent))
     {
     // If the request comes from the system (widget exposed, resized...), the
@@ -186,6 +277,10 @@ void ctkVTKAbstractView::scheduleRender()
       {
       msecsBeforeRender = 0;
       }
+    if (throttled)
+      {
+      ++d->Statistics.ThrottledRenders;
+      }
     d->RequestTime.start();
     d->RequestTimer->start(static_cast<int>(msecsBeforeRender));
     }
@@ -197,6 +292,11 @@ void ctkVTKAbstractView::scheduleRender()
     // done now to ensure the desired framerate is respected.
     this->forceRender();
     }
+  else
+    {
+    // A render is already scheduled
+    ++d->Statistics.CoalescedRenders;
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -213,6 +313,11 @@ void ctkVTKAbstractView::forceRender()
     return;
     }
 
+  if (this->sender() != d->RequestTimer)
+    {
+    ++d->Statistics.ForcedRenders;
+    }
+
   // The timer can be stopped if it hasn't timed out yet.
   d->RequestTimer->stop();
   d->RequestTime = QTime();
@@ -224,7 +329,10 @@ void ctkVTKAbstractView::forceRender()
     {
     return;
     }
+  ctkHighPrecisionTimer timer;
+  timer.start();
   d->RenderWindow->Render();
+  d->addRender(static_cast<double>(timer.elapsedMicro()) / 1000.);
 }
 
 //----------------------------------------------------------------------------
@@ -458,3 +566,46 @@ void ctkVTKAbstractView::setUseDepthPeeling(bool use)
     use ? 0 : vtkOpenGLRenderWindow::GetGlobalMaximumNumberOfMultiSamples());
   renderer->SetUseDepthPeeling(use ? 1 : 0);
 }
+
+//----------------------------------------------------------------------------
+CTK_GET_CPP(ctkVTKAbstractView, bool, adaptiveFrameRate, AdaptiveFrameRate);
+CTK_SET_CPP(ctkVTKAbstractView, bool, setAdaptiveFrameRate, AdaptiveFrameRate);
+
+//----------------------------------------------------------------------------
+ctkVTKAbstractView::RenderStatistics ctkVTKAbstractView::renderStatistics()const
+{
+  Q_D(const ctkVTKAbstractView);
+  return d->Statistics;
+}
+
+//----------------------------------------------------------------------------
+void ctkVTKAbstractView::resetRenderStatistics()
+{
+  Q_D(ctkVTKAbstractView);
+  d->Statistics = RenderStatistics();
+}
+
+//----------------------------------------------------------------------------
+void ctkVTKAbstractView::setFrameBudget(double msecsPerSecond)
+{
+  ctkVTKAbstractViewPrivate::FrameBudget = msecsPerSecond;
+}
+
+//----------------------------------------------------------------------------
+double ctkVTKAbstractView::frameBudget()
+{
+  return ctkVTKAbstractViewPrivate::FrameBudget;
+}
+
+//----------------------------------------------------------------------------
+double ctkVTKAbstractView::renderLoad()
+{
+  const QTime& loadTime = ctkVTKAbstractViewPrivate::RenderLoadTime;
+  if (!loadTime.isValid() || loadTime.elapsed() >= 2000)
+    {
+    return 0.;
+    }
+  // The current second can already be over budget
+  return qMax(ctkVTKAbstractViewPrivate::LastRenderLoad,
+              ctkVTKAbstractViewPrivate::CurrentRenderLoad);
+}
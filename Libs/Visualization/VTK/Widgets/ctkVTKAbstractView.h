@@ -22,6 +22,7 @@
 #define __ctkVTKAbstractView_h
 
 // Qt includes
+#include <QVector>
 #include <QWidget>
 
 // VTK includes
@@ -55,12 +56,50 @@ class CTK_VISUALIZATION_VTK_WIDGETS_EXPORT ctkVTKAbstractView : public QWidget
   /// not.
   /// false by default.
   Q_PROPERTY(bool useDepthPeeling READ useDepthPeeling WRITE setUseDepthPeeling)
+  /// This property controls whether the framerate of the view is lowered
+  /// when it is in the background (not under the mouse and without focus)
+  /// and all the views together render longer than frameBudget() per second.
+  /// Scheduled renders are then delayed in proportion of the overload.
+  /// false by default.
+  /// \sa setFrameBudget(), renderLoad()
+  Q_PROPERTY(bool adaptiveFrameRate READ adaptiveFrameRate WRITE setAdaptiveFrameRate)
 public:
 
   typedef QWidget Superclass;
   explicit ctkVTKAbstractView(QWidget* parent = 0);
   virtual ~ctkVTKAbstractView();
 
+  /// Counters of the render requests and renders of a view.
+  /// \sa renderStatistics(), resetRenderStatistics()
+  struct RenderStatistics
+  {
+    RenderStatistics();
+
+    /// Number of scheduleRender() calls
+    int RequestedRenders;
+    /// Requests merged into an already scheduled render
+    int CoalescedRenders;
+    /// Requests that scheduled a render delayed by the adaptive framerate.
+    /// A request is counted at most once in CoalescedRenders,
+    /// ThrottledRenders and ForcedRenders.
+    int ThrottledRenders;
+    /// Renders done immediately (forceRender(), paint events or late
+    /// scheduled renders) instead of when the request timer times out
+    int ForcedRenders;
+    /// Number of times the render window has been rendered
+    int Renders;
+    /// Render times in milliseconds
+    double TotalRenderTime;
+    double LastRenderTime;
+    double MaximumRenderTime;
+    /// Number of renders per render time: bucket 0 counts the renders faster
+    /// than 1ms, bucket i the renders between 2^(i-1) and 2^i ms, the last
+    /// bucket all the slower renders.
+    QVector<int> RenderTimeHistogram;
+
+    double meanRenderTime()const;
+  };
+
 public Q_SLOTS:
   /// Notify QVTKWidget that the view needs to be rendered.
   /// scheduleRender() respects the desired framerate of the render window,
@@ -97,6 +136,13 @@ public Q_SLOTS:
   /// \sa useDepthPeeling
   void setUseDepthPeeling(bool use);
 
+  /// Set the adaptiveFrameRate property value.
+  /// \sa adaptiveFrameRate
+  void setAdaptiveFrameRate(bool adaptive);
+
+  /// Reset the render statistics of the view.
+  void resetRenderStatistics();
+
 public:
   /// Get underlying RenderWindow
   Q_INVOKABLE vtkRenderWindow* renderWindow()const;
@@ -141,6 +187,25 @@ public:
   /// \sa useDepthPeeling
   bool useDepthPeeling()const;
 
+  /// Return the adaptiveFrameRate property value.
+  /// \sa adaptiveFrameRate
+  bool adaptiveFrameRate()const;
+
+  /// Return the render statistics since the creation of the view or the last
+  /// resetRenderStatistics().
+  RenderStatistics renderStatistics()const;
+
+  /// Time in milliseconds all the views may spend rendering each second
+  /// before the views with an adaptive framerate are slowed down.
+  /// 500ms by default.
+  /// \sa adaptiveFrameRate
+  static void setFrameBudget(double msecsPerSecond);
+  static double frameBudget();
+
+  /// Time in milliseconds spent rendering by all the views during the last
+  /// second.
+  static double renderLoad();
+
   virtual QSize minimumSizeHint()const;
   virtual QSize sizeHint()const;
   virtual bool hasHeightForWidth()const;
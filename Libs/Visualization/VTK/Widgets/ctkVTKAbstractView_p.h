@@ -57,6 +57,17 @@ public:
   QList<vtkRenderer*> renderers()const;
   vtkRenderer* firstRenderer()const;
 
+  /// Return true if the view is not under the mouse and doesn't have the focus
+  bool isInBackground()const;
+  /// Add a render to the statistics of the view and to the render load
+  void addRender(double renderTime);
+
+  static double FrameBudget;
+  /// Time spent rendering by all the views during the current/last second
+  static QTime  RenderLoadTime;
+  static double CurrentRenderLoad;
+  static double LastRenderLoad;
+
   QVTKWidget*                                   VTKWidget;
   vtkSmartPointer<vtkRenderWindow>              RenderWindow;
   QTimer*                                       RequestTimer;
@@ -65,6 +76,8 @@ public:
   bool                                          FPSVisible;
   QTimer*                                       FPSTimer;
   int                                           FPS;
+  bool                                          AdaptiveFrameRate;
+  ctkVTKAbstractView::RenderStatistics          Statistics;
 
   vtkSmartPointer<vtkCornerAnnotation>          CornerAnnotation;
 };
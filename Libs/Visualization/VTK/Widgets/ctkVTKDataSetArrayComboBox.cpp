@@ -72,8 +72,7 @@ ctkVTKDataSetModel* ctkVTKDataSetArrayComboBoxPrivate::dataSetModel()const
 // --------------------------------------------------------------------------
 int ctkVTKDataSetArrayComboBoxPrivate::indexFromArrayName(const QString& dataArrayName)const
 {
-  Q_Q(const ctkVTKDataSetArrayComboBox);
-  return q->findText(dataArrayName);
+  return this->dataSetModel()->indexFromArrayName(dataArrayName, 0).row();
 }
 
 // --------------------------------------------------------------------------
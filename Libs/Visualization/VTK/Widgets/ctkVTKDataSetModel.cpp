@@ -20,6 +20,7 @@
 
 // Qt includes
 #include <QDebug>
+#include <QSet>
 
 // CTK includes
 #include "ctkVTKDataSetModel.h"
@@ -45,9 +46,23 @@ public:
   static QList<vtkDataArray*> attributeArrayToInsert(const ctkVTKDataSetModel::AttributeTypes& attributeType,
                                                      vtkDataSetAttributes * dataSetAttributes);
 
+  /// Return the arrays of the dataset to list in the model, in row order.
+  QList<vtkDataArray*> arraysToShow()const;
+  /// Return the arrays currently having a row, in row order.
+  QList<vtkDataArray*> shownArrays()const;
+  /// Remove \a count rows starting at \a row and stop observing their arrays.
+  void removeArrays(int row, int count);
+  /// Insert the rows of the next \a count arrays waiting to be fetched.
+  void fetchArrays(int count);
+
   vtkSmartPointer<vtkDataSet> DataSet;
   bool ListenDataArrayModifiedEvent;
   ctkVTKDataSetModel::AttributeTypes AttributeType;
+  /// Arrays to show that don't have a row yet. They come after the arrays
+  /// that have a row.
+  QList<vtkDataArray*> ArraysToFetch;
+  /// Number of rows inserted at once by fetchMore().
+  static const int FetchBatchSize = 256;
 };
 
 
@@ -130,6 +145,61 @@ QList<vtkDataArray*> ctkVTKDataSetModelPrivate::attributeArrayToInsert(
   return attributeArraysToInsert;
 }
 
+//------------------------------------------------------------------------------
+QList<vtkDataArray*> ctkVTKDataSetModelPrivate::arraysToShow()const
+{
+  QList<vtkDataArray*> arrays;
+  if (this->DataSet.GetPointer() == 0)
+    {
+    return arrays;
+    }
+  arrays << attributeArrayToInsert(this->AttributeType, this->DataSet->GetPointData());
+  arrays << attributeArrayToInsert(this->AttributeType, this->DataSet->GetCellData());
+  return arrays;
+}
+
+//------------------------------------------------------------------------------
+QList<vtkDataArray*> ctkVTKDataSetModelPrivate::shownArrays()const
+{
+  Q_Q(const ctkVTKDataSetModel);
+  QList<vtkDataArray*> arrays;
+  const int count = q->rowCount();
+  for (int row = 0; row < count; ++row)
+    {
+    arrays << q->arrayFromItem(q->item(row, 0));
+    }
+  return arrays;
+}
+
+//------------------------------------------------------------------------------
+void ctkVTKDataSetModelPrivate::removeArrays(int row, int count)
+{
+  Q_Q(ctkVTKDataSetModel);
+  if (this->ListenDataArrayModifiedEvent)
+    {
+    for (int i = row; i < row + count; ++i)
+      {
+      q->qvtkDisconnect(q->arrayFromItem(q->item(i, 0)), vtkCommand::ModifiedEvent,
+                        q, SLOT(onArrayModified(vtkObject*)));
+      }
+    }
+  q->removeRows(row, count);
+}
+
+//------------------------------------------------------------------------------
+void ctkVTKDataSetModelPrivate::fetchArrays(int count)
+{
+  Q_Q(ctkVTKDataSetModel);
+  count = qMin(count, this->ArraysToFetch.count());
+  QList<vtkDataArray*> arrays = this->ArraysToFetch.mid(0, count);
+  this->ArraysToFetch.erase(this->ArraysToFetch.begin(),
+                            this->ArraysToFetch.begin() + count);
+  foreach(vtkDataArray* dataArray, arrays)
+    {
+    q->insertArray(dataArray);
+    }
+}
+
 //------------------------------------------------------------------------------
 // ctkVTKDataSetModel
 
@@ -214,10 +284,17 @@ vtkDataArray* ctkVTKDataSetModel::arrayFromItem(QStandardItem* dataArrayItem)con
 //------------------------------------------------------------------------------
 QStandardItem* ctkVTKDataSetModel::itemFromArray(vtkDataArray* dataArray, int column)const
 {
+  Q_D(const ctkVTKDataSetModel);
   if (dataArray == 0)
     {
     return 0;
     }
+  // The array may not have a row yet.
+  int pendingIndex = d->ArraysToFetch.indexOf(dataArray);
+  if (pendingIndex != -1)
+    {
+    const_cast<ctkVTKDataSetModelPrivate*>(d)->fetchArrays(pendingIndex + 1);
+    }
   QModelIndexList indexes = this->match(this->index(-1,-1), ctkVTK::PointerRole,
                                       reinterpret_cast<long long>(dataArray), 1,
                                       Qt::MatchExactly | Qt::MatchRecursive);
@@ -237,11 +314,41 @@ QStandardItem* ctkVTKDataSetModel::itemFromArray(vtkDataArray* dataArray, int co
 //------------------------------------------------------------------------------
 QModelIndexList ctkVTKDataSetModel::indexes(vtkDataArray* dataArray)const
 {
+  Q_D(const ctkVTKDataSetModel);
+  int pendingIndex = d->ArraysToFetch.indexOf(dataArray);
+  if (pendingIndex != -1)
+    {
+    const_cast<ctkVTKDataSetModelPrivate*>(d)->fetchArrays(pendingIndex + 1);
+    }
   return this->match(this->index(-1,-1), ctkVTK::PointerRole,
                      QVariant::fromValue(reinterpret_cast<long long>(dataArray)),
                      -1, Qt::MatchExactly | Qt::MatchRecursive);
 }
 
+//------------------------------------------------------------------------------
+QModelIndex ctkVTKDataSetModel::indexFromArrayName(const QString& dataArrayName, int column)const
+{
+  Q_D(const ctkVTKDataSetModel);
+  const int count = this->rowCount();
+  for (int row = 0; row < count; ++row)
+    {
+    vtkDataArray* dataArray = this->arrayFromItem(this->item(row, 0));
+    if (dataArray && QString(dataArray->GetName()) == dataArrayName)
+      {
+      return this->index(row, column);
+      }
+    }
+  // The array may not have a row yet.
+  foreach(vtkDataArray* dataArray, d->ArraysToFetch)
+    {
+    if (QString(dataArray->GetName()) == dataArrayName)
+      {
+      return this->indexFromArray(dataArray, column);
+      }
+    }
+  return QModelIndex();
+}
+
 /*
 //------------------------------------------------------------------------------
 void ctkVTKDataSetModel::setListenArrayModifiedEvent(bool listen)
@@ -262,14 +369,33 @@ bool ctkVTKDataSetModel::listenNodeModifiedEvent()const
   return d->ListenNodeModifiedEvent;
 }
 */
+
 //------------------------------------------------------------------------------
-void ctkVTKDataSetModel::updateDataSet()
+bool ctkVTKDataSetModel::canFetchMore(const QModelIndex& parent)const
+{
+  Q_D(const ctkVTKDataSetModel);
+  return !parent.isValid() && !d->ArraysToFetch.isEmpty();
+}
+
+//------------------------------------------------------------------------------
+void ctkVTKDataSetModel::fetchMore(const QModelIndex& parent)
 {
   Q_D(ctkVTKDataSetModel);
-  this->setRowCount(0);
+  if (parent.isValid())
+    {
+    return;
+    }
+  d->fetchArrays(ctkVTKDataSetModelPrivate::FetchBatchSize);
+}
 
+//------------------------------------------------------------------------------
+void ctkVTKDataSetModel::updateDataSet()
+{
+  Q_D(ctkVTKDataSetModel);
   if (d->DataSet.GetPointer() == 0)
     {
+    d->ArraysToFetch.clear();
+    d->removeArrays(0, this->rowCount());
     return;
     }
 
@@ -283,12 +409,70 @@ void ctkVTKDataSetModel::populateDataSet()
   Q_D(ctkVTKDataSetModel);
   Q_ASSERT(d->DataSet);
 
-  QList<vtkDataArray*> attributeArrays;
-  attributeArrays << ctkVTKDataSetModelPrivate::attributeArrayToInsert(d->AttributeType, d->DataSet->GetPointData());
-  attributeArrays << ctkVTKDataSetModelPrivate::attributeArrayToInsert(d->AttributeType, d->DataSet->GetCellData());
-  foreach(vtkDataArray* attributeArray, attributeArrays)
+  const QList<vtkDataArray*> attributeArrays = d->arraysToShow();
+  QList<vtkDataArray*> shownArrays = d->shownArrays();
+  // If all the arrays have a row, new arrays are appended right away
+  const bool arraysPending = !d->ArraysToFetch.isEmpty();
+
+  // Remove the rows of the arrays that are no longer listed.
+  QSet<vtkDataArray*> attributeArraySet = attributeArrays.toSet();
+  for (int row = shownArrays.count() - 1; row >= 0; --row)
+    {
+    if (attributeArraySet.contains(shownArrays[row]))
+      {
+      continue;
+      }
+    int first = row;
+    while (first > 0 && !attributeArraySet.contains(shownArrays[first - 1]))
+      {
+      --first;
+      }
+    d->removeArrays(first, row - first + 1);
+    shownArrays.erase(shownArrays.begin() + first, shownArrays.begin() + row + 1);
+    row = first;
+    }
+
+  // Insert the rows of the new arrays that come before the last shown array,
+  // the others are inserted when fetched.
+  QSet<vtkDataArray*> shownArraySet = shownArrays.toSet();
+  int row = 0;
+  int i = 0;
+  for (; i < attributeArrays.count() && row < shownArrays.count(); ++i)
+    {
+    vtkDataArray* attributeArray = attributeArrays[i];
+    if (attributeArray == shownArrays[row])
+      {
+      // The array may have been renamed.
+      for (int column = 0; column < this->columnCount(); ++column)
+        {
+        this->updateItemFromArray(this->item(row, column), attributeArray, column);
+        }
+      ++row;
+      }
+    else if (!shownArraySet.contains(attributeArray))
+      {
+      this->insertArray(attributeArray, row);
+      shownArrays.insert(row, attributeArray);
+      ++row;
+      }
+    else
+      {
+      // The arrays have been reordered, start over.
+      d->removeArrays(0, this->rowCount());
+      shownArrays.clear();
+      i = 0;
+      break;
+      }
+    }
+  d->ArraysToFetch = attributeArrays.mid(i);
+  if (!arraysPending && !shownArrays.isEmpty())
+    {
+    d->fetchArrays(d->ArraysToFetch.count());
+    }
+
+  if (this->rowCount() < ctkVTKDataSetModelPrivate::FetchBatchSize)
     {
-    this->insertArray(attributeArray);
+    d->fetchArrays(ctkVTKDataSetModelPrivate::FetchBatchSize - this->rowCount());
     }
 }
 
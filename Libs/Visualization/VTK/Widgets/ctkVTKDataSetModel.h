@@ -45,6 +45,12 @@ class ctkVTKDataSetModelPrivate;
 
 //------------------------------------------------------------------------------
 /// \ingroup Visualization_VTK_Widgets
+/// Model listing the point and cell data arrays of a vtkDataSet.
+/// Rows are created lazily: only the first arrays are inserted when the
+/// dataset is set, the others are inserted by batches when a view asks for
+/// them (see fetchMore()) or when they are looked up with itemFromArray().
+/// When the dataset is modified, only the rows of the arrays that were
+/// added or removed are updated.
 class CTK_VISUALIZATION_VTK_WIDGETS_EXPORT ctkVTKDataSetModel
   : public QStandardItemModel
 {
@@ -91,6 +97,15 @@ public:
   inline QModelIndex indexFromArray(vtkDataArray* dataArray, int column = 0)const;
   QStandardItem* itemFromArray(vtkDataArray* dataArray, int column = 0)const;
   QModelIndexList indexes(vtkDataArray* dataArray)const;
+  /// Return the index of the first array named \a dataArrayName. Like
+  /// itemFromArray(), the row of the array is inserted if it was not
+  /// fetched yet.
+  QModelIndex indexFromArrayName(const QString& dataArrayName, int column = 0)const;
+
+  /// Return true if some arrays of the dataset don't have a row yet.
+  virtual bool canFetchMore(const QModelIndex& parent)const;
+  /// Insert the rows of the next batch of arrays.
+  virtual void fetchMore(const QModelIndex& parent);
 
 protected Q_SLOTS:
   void onDataSetModified(vtkObject* dataSet);
@@ -20,6 +20,7 @@
 
 // Qt includes
 #include <QEvent>
+#include <QVector>
 #include <QMouseEvent>
 #include <QPointF>
 #include <QTimerEvent>
@@ -27,6 +28,7 @@
 // CTK includes
 #include "ctkVTKMagnifyView.h"
 #include "ctkVTKMagnifyView_p.h"
+#include "ctkVTKWidgetsUtils.h"
 #include "ctkLogger.h"
 
 // VTK includes
@@ -37,11 +39,56 @@
 
 // STD includes
 #include <cmath>
+#include <cstring>
 
 //--------------------------------------------------------------------------
 static ctkLogger logger("org.commontk.visualization.vtk.widgets.ctkVTKMagnifyView");
 //--------------------------------------------------------------------------
 
+namespace
+{
+// --------------------------------------------------------------------------
+// Nearest neighbour zoom of sourceRect (in source) to zoomedSize, of which
+// only cropRect is computed.
+QImage zoomImage(const QImage& source, const QRect& sourceRect,
+                 const QSize& zoomedSize, const QRect& cropRect)
+{
+  if (zoomedSize.isEmpty() || cropRect.isEmpty())
+    {
+    return QImage();
+    }
+  QImage image(cropRect.size(), QImage::Format_RGB32);
+  QVector<int> columns(cropRect.width());
+  for (int x = 0; x < cropRect.width(); ++x)
+    {
+    const int column = (cropRect.left() + x) * sourceRect.width() / zoomedSize.width();
+    columns[x] = sourceRect.left() + qBound(0, column, sourceRect.width() - 1);
+    }
+  int previousRow = -1;
+  for (int y = 0; y < cropRect.height(); ++y)
+    {
+    const int row = sourceRect.top() + qBound(0,
+      (cropRect.top() + y) * sourceRect.height() / zoomedSize.height(),
+      sourceRect.height() - 1);
+    QRgb* destination = reinterpret_cast<QRgb*>(image.scanLine(y));
+    if (row == previousRow)
+      {
+      // Magnified pixels span several lines
+      memcpy(destination, image.scanLine(y - 1), image.bytesPerLine());
+      continue;
+      }
+    const QRgb* sourceLine = reinterpret_cast<const QRgb*>(
+      source.bits() + row * source.bytesPerLine());
+    for (int x = 0; x < cropRect.width(); ++x)
+      {
+      destination[x] = sourceLine[columns[x]];
+      }
+    previousRow = row;
+    }
+  return image;
+}
+}
+
 // --------------------------------------------------------------------------
 // ctkVTKMagnifyViewPrivate methods
 
@@ -59,6 +106,8 @@ ctkVTKMagnifyViewPrivate::ctkVTKMagnifyViewPrivate(ctkVTKMagnifyView& object)
   this->EventHandler.UpdateInterval = 20;
   this->EventHandler.TimerId = 0;
 
+  this->CachedImageModified = true;
+  this->NumberOfReadbacks = 0;
 }
 
 // --------------------------------------------------------------------------
@@ -168,6 +217,61 @@ void ctkVTKMagnifyViewPrivate::pushRemovePixmapEvent()
     }
 }
 
+// --------------------------------------------------------------------------
+void ctkVTKMagnifyViewPrivate::invalidateCachedImage()
+{
+  this->CachedImageModified = true;
+}
+
+// --------------------------------------------------------------------------
+bool ctkVTKMagnifyViewPrivate::updateCachedImage(QVTKWidget* widget,
+                                                 vtkRenderWindow* renderWindow)
+{
+  int * windowSize = renderWindow->GetSize();
+  const QSize size(windowSize[0], windowSize[1]);
+  if (!this->CachedImageModified &&
+      this->CachedWidget.data() == widget &&
+      this->CachedImage.size() == size)
+    {
+    return true;
+    }
+
+  // Read back the whole window once, the mouse moves resample it until the
+  // next render.
+  if (!this->PixelData)
+    {
+    this->PixelData = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    }
+  int front = renderWindow->GetDoubleBuffer();
+  int success = renderWindow->GetPixelData(
+      0, 0, size.width() - 1, size.height() - 1, front, this->PixelData);
+  ++this->NumberOfReadbacks;
+  if (!success ||
+      this->PixelData->GetNumberOfTuples() * this->PixelData->GetNumberOfComponents()
+      < 3 * size.width() * size.height())
+    {
+    this->CachedImage = QImage();
+    this->CachedWidget.clear();
+    return false;
+    }
+
+  if (this->CachedImage.size() != size)
+    {
+    this->CachedImage = QImage(size, QImage::Format_RGB32);
+    }
+  // Flip vertically to move from render window coordinates to Qt coordinates
+  const unsigned char* pixels = this->PixelData->GetPointer(0);
+  for (int row = 0; row < size.height(); ++row)
+    {
+    ctk::pixelsToQRgb(pixels + 3 * size.width() * (size.height() - 1 - row), 3,
+                      reinterpret_cast<QRgb*>(this->CachedImage.scanLine(row)),
+                      size.width());
+    }
+  this->CachedWidget = QWeakPointer<QVTKWidget>(widget);
+  this->CachedImageModified = false;
+  return true;
+}
+
 // --------------------------------------------------------------------------
 void ctkVTKMagnifyViewPrivate::connectRenderWindow(QVTKWidget * widget)
 {
@@ -207,6 +311,12 @@ void ctkVTKMagnifyViewPrivate::observe(QVTKWidget * widget)
     this->ObservedQVTKWidgets.append(widget);
     Q_Q(ctkVTKMagnifyView);
     widget->installEventFilter(q);
+    // Invalidate the cached image before pushUpdatePixmapEvent() reads it
+    if (widget->GetRenderWindow())
+      {
+      this->qvtkConnect(widget->GetRenderWindow(), vtkCommand::EndEvent,
+                        this, SLOT(invalidateCachedImage()), 1.0);
+      }
     if (this->ObserveRenderWindowEvents)
       {
       this->connectRenderWindow(widget);
@@ -227,6 +337,16 @@ void ctkVTKMagnifyViewPrivate::remove(QVTKWidget * widget)
     this->ObservedQVTKWidgets.removeOne(widget);
     Q_Q(ctkVTKMagnifyView);
     widget->removeEventFilter(q);
+    if (widget->GetRenderWindow())
+      {
+      this->qvtkDisconnect(widget->GetRenderWindow(), vtkCommand::EndEvent,
+                           this, SLOT(invalidateCachedImage()));
+      }
+    if (this->CachedWidget.data() == widget)
+      {
+      this->CachedImage = QImage();
+      this->CachedWidget.clear();
+      }
     if (this->ObserveRenderWindowEvents)
       {
       this->disconnectRenderWindow(widget);
@@ -354,27 +474,16 @@ void ctkVTKMagnifyViewPrivate::updatePixmap()
     }
   q->setAlignment(alignment);
 
-  // Retrieve the pixel data into a QImage (flip vertically to move from render
-  // window coordinates to Qt coordinates)
-  QSize actualSize(indexRight-indexLeft+1, indexTop-indexBottom+1);
-  QImage image(actualSize.width(), actualSize.height(), QImage::Format_RGB32);
-  vtkUnsignedCharArray * pixelData = vtkUnsignedCharArray::New();
-  pixelData->SetArray(image.bits(), actualSize.width() * actualSize.height() * 4, 1);
-  int front = renderWindow->GetDoubleBuffer();
-  int success = renderWindow->GetRGBACharPixelData(
-      indexLeft, indexBottom, indexRight, indexTop, front, pixelData);
-  if (!success)
+  // Retrieve the pixel data of the whole window, unless it has not been
+  // rendered since the last update.
+  if (!this->updateCachedImage(this->EventHandler.Widget.data(), renderWindow))
     {
     return;
     }
-  pixelData->Delete();
-  image = image.rgbSwapped();
-  image = image.mirrored();
-
-  // Scale the image to zoom, using FastTransformation to prevent smoothing
+  // Region to magnify, in Qt coordinates
+  QSize actualSize(indexRight-indexLeft+1, indexTop-indexBottom+1);
+  QRect sourceRect(QPoint(indexLeft, windowSize[1] - 1 - indexTop), actualSize);
   QSize imageSize = actualSize * this->Magnification;
-  image = image.scaled(imageSize, Qt::KeepAspectRatioByExpanding,
-                       Qt::FastTransformation);
 
   // Crop the magnified image to solve the problem of magnified partial pixels
   double errorLeft
@@ -427,11 +536,11 @@ void ctkVTKMagnifyViewPrivate::updatePixmap()
     cropIndexTop -= diffHeight;
     }
 
-  // Finally crop the QImage for display
+  // Finally zoom the visible part of the region for display, using the
+  // nearest neighbour to prevent smoothing
   QRect cropRect(QPoint(cropIndexLeft, cropIndexTop),
                  QPoint(cropIndexRight, cropIndexBottom));
-  image = image.copy(cropRect);
-
+  QImage image = zoomImage(this->CachedImage, sourceRect, imageSize, cropRect);
 
   // Finally, set the pixelmap to the new one we have created and update
   q->setPixmap(QPixmap::fromImage(image));
@@ -578,6 +687,13 @@ bool ctkVTKMagnifyView::hasCursorInObservedWidget()const
   return false;
 }
 
+// --------------------------------------------------------------------------
+int ctkVTKMagnifyView::numberOfReadbacks()const
+{
+  Q_D(const ctkVTKMagnifyView);
+  return d->NumberOfReadbacks;
+}
+
 // --------------------------------------------------------------------------
 void ctkVTKMagnifyView::remove(QVTKWidget * widget)
 {
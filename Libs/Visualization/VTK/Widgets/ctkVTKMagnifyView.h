@@ -101,6 +101,11 @@ public:
   /// Returns true if the mouse cursor is over an observed widget,
   /// false otherwise.
   bool hasCursorInObservedWidget()const;
+
+  /// Number of times the pixels of an observed render window have been read
+  /// back. The readback is cached until the render window renders again,
+  /// moving the mouse only resamples the cached image.
+  int numberOfReadbacks()const;
 protected:
   QScopedPointer<ctkVTKMagnifyViewPrivate> d_ptr;
 
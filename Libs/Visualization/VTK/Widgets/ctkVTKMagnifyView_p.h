@@ -22,6 +22,7 @@
 #define __ctkVTKMagnifyView_p_h
 
 // Qt includes
+#include <QImage>
 #include <QObject>
 class QPointF;
 class QTimerEvent;
@@ -31,7 +32,10 @@ class QTimerEvent;
 #include <ctkVTKObject.h>
 
 // VTK includes
+#include <vtkSmartPointer.h>
 class QVTKWidget;
+class vtkRenderWindow;
+class vtkUnsignedCharArray;
 
 /// \ingroup Visualization_VTK_Widgets
 class ctkVTKMagnifyViewPrivate : public QObject
@@ -58,6 +62,9 @@ protected:
   void restartTimer();
   void resetEventHandler();
 
+  /// Read back the render window pixels if the cached image is out of date
+  bool updateCachedImage(QVTKWidget* widget, vtkRenderWindow* renderWindow);
+
   enum PendingEventType {
     NoEvent = 0,
     UpdatePixmapEvent,
@@ -77,12 +84,21 @@ public Q_SLOTS:
   void pushUpdatePixmapEvent();
   void pushUpdatePixmapEvent(QPointF pos);
   void pushRemovePixmapEvent();
+  void invalidateCachedImage();
 
 public:
   QList<QVTKWidget *> ObservedQVTKWidgets;
   double Magnification;
   bool ObserveRenderWindowEvents;
   EventHandlerStruct EventHandler;
+
+  /// Last full window readback, in Qt coordinates. It is reused while the
+  /// render window does not render again.
+  QImage CachedImage;
+  QWeakPointer<QVTKWidget> CachedWidget;
+  bool CachedImageModified;
+  vtkSmartPointer<vtkUnsignedCharArray> PixelData;
+  int NumberOfReadbacks;
 };
 
 #endif
@@ -23,10 +23,12 @@
 #include <QBuffer>
 #include <QImage>
 #include <QStyle>
+#include <QVector>
 
 // CTK includes
 #include "ctkLogger.h"
 #include "ctkVTKScalarsToColorsUtils.h"
+#include "ctkVTKWidgetsUtils.h"
 
 // VTK includes
 #include <vtkScalarsToColors.h>
@@ -60,17 +62,12 @@ QImage ctk::scalarsToColorsImage(vtkScalarsToColors* scalarsToColors, const QSiz
   QImage transferFunctionImage(width, height, QImage::Format_RGB32);
   unsigned char* colors = transferFunctionImage.bits();
   // Map the first line
+  QVector<unsigned char> rgb(VTK_RGB * width);
   scalarsToColors->MapScalarsThroughTable2(
-    values, colors, VTK_DOUBLE, width, 1, VTK_RGBA);
+    values, rgb.data(), VTK_DOUBLE, width, 1, VTK_RGB);
   delete [] values;
-  // Pixels are not correctly ordered, reorder them correctly
-  unsigned char* colorsPtr = colors;
-  QRgb* rgbPtr = reinterpret_cast<QRgb*>(colors);
-  for (int i = 0; i < width; ++i)
-    {
-    *(rgbPtr++) = QColor(colorsPtr[0], colorsPtr[1], colorsPtr[2]).rgb();
-    colorsPtr += 4;
-    }
+  ctk::pixelsToQRgb(rgb.constData(), VTK_RGB,
+                    reinterpret_cast<QRgb*>(colors), width);
   // Fill the other lines
   for (int i = 1; i < height; ++i)
     {
@@ -21,6 +21,7 @@
 // Qt includes
 #include <QImage>
 #include <QPainter>
+#include <QVector>
 #include <QWidget>
 
 // ctkWidgets includes
@@ -31,6 +32,14 @@
 #include <QVTKWidget.h>
 #include <vtkImageData.h>
 
+// STD includes
+#include <algorithm>
+#ifdef __SSSE3__
+# include <tmmintrin.h>
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
 //----------------------------------------------------------------------------
 QImage ctk::grabVTKWidget(QWidget* widget, QRect rectangle)
 {
@@ -65,6 +74,92 @@ QImage ctk::grabVTKWidget(QWidget* widget, QRect rectangle)
   return widgetImage;
 }
 
+//----------------------------------------------------------------------------
+void ctk::pixelsToQRgb(const unsigned char* source, int numberOfComponents,
+                       QRgb* destination, int count)
+{
+  int i = 0;
+  switch (numberOfComponents)
+    {
+    case 1:
+      // Luminance
+      for (; i < count; ++i)
+        {
+        destination[i] = 0xff000000u | (source[i] * 0x00010101u);
+        }
+      break;
+    case 2:
+      // Luminance, alpha
+      for (; i < count; ++i, source += 2)
+        {
+        destination[i] = (static_cast<QRgb>(source[1]) << 24) |
+          (source[0] * 0x00010101u);
+        }
+      break;
+    case 3:
+#ifdef __SSSE3__
+      {
+      // RGB -> BGRA bytes (0xAARRGGBB words), 4 pixels per iteration.
+      // 16 bytes are loaded for 12 bytes of pixels: stop 2 pixels early.
+      const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1,
+                                            8, 7, 6, -1, 11, 10, 9, -1);
+      const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+      for (; i + 6 <= count; i += 4, source += 12)
+        {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), pixels);
+        }
+      }
+#endif
+      for (; i < count; ++i, source += 3)
+        {
+        destination[i] = 0xff000000u | (static_cast<QRgb>(source[0]) << 16) |
+          (static_cast<QRgb>(source[1]) << 8) | source[2];
+        }
+      break;
+    case 4:
+#ifdef __SSE2__
+      {
+      // RGBA bytes are 0xAABBGGRR words on x86: swap the red and blue
+      // channels of 4 pixels per iteration.
+      const __m128i alphaGreen = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+      const __m128i redBlue = _mm_set1_epi32(0x00ff00ff);
+      for (; i + 4 <= count; i += 4, source += 16)
+        {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i rb = _mm_and_si128(pixels, redBlue);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        pixels = _mm_or_si128(_mm_and_si128(pixels, alphaGreen), rb);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), pixels);
+        }
+      }
+#endif
+      for (; i < count; ++i, source += 4)
+        {
+        destination[i] = qRgba(source[0], source[1], source[2], source[3]);
+        }
+      break;
+    default:
+      break;
+    }
+}
+
+namespace
+{
+//----------------------------------------------------------------------------
+template <class T>
+void clampToUnsignedChar(const T* source, unsigned char* destination, int count)
+{
+  for (int i = 0; i < count; ++i)
+    {
+    const double value = static_cast<double>(source[i]);
+    destination[i] = value <= 0. ? 0 :
+      (value >= 255. ? 255 : static_cast<unsigned char>(value));
+    }
+}
+}
+
 //----------------------------------------------------------------------------
 QImage ctk::vtkImageDataToQImage(vtkImageData* imageData)
 {
@@ -73,24 +168,55 @@ QImage ctk::vtkImageDataToQImage(vtkImageData* imageData)
     return QImage();
     }
   imageData->Update();
-  /// \todo retrieve just the UpdateExtent
-  int width = imageData->GetDimensions()[0];
-  int height = imageData->GetDimensions()[1];
-  QImage image(width, height, QImage::Format_RGB32);
-  QRgb* rgbPtr = reinterpret_cast<QRgb*>(image.bits()) +
-    width * (height-1);
-  unsigned char* colorsPtr = reinterpret_cast<unsigned char*>(
-    imageData->GetScalarPointer());
-  // mirror vertically
-  for(int row = 0; row < height; ++row)
+  int extent[6];
+  imageData->GetExtent(extent);
+  // Only convert the update extent if it is set and within the data extent
+  int updateExtent[6];
+  imageData->GetUpdateExtent(updateExtent);
+  if (updateExtent[0] <= updateExtent[1] &&
+      updateExtent[2] <= updateExtent[3] &&
+      updateExtent[4] <= updateExtent[5] &&
+      updateExtent[0] >= extent[0] && updateExtent[1] <= extent[1] &&
+      updateExtent[2] >= extent[2] && updateExtent[3] <= extent[3] &&
+      updateExtent[4] >= extent[4] && updateExtent[5] <= extent[5])
+    {
+    std::copy(updateExtent, updateExtent + 6, extent);
+    }
+  const int width = extent[1] - extent[0] + 1;
+  const int height = extent[3] - extent[2] + 1;
+  const int numberOfComponents = imageData->GetNumberOfScalarComponents();
+  if (width <= 0 || height <= 0 ||
+      numberOfComponents < 1 || numberOfComponents > 4 ||
+      !imageData->GetScalarPointer())
+    {
+    return QImage();
+    }
+  const bool hasAlpha = (numberOfComponents == 2 || numberOfComponents == 4);
+  QImage image(width, height,
+               hasAlpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+  const int scalarType = imageData->GetScalarType();
+  QVector<unsigned char> row;
+  if (scalarType != VTK_UNSIGNED_CHAR)
+    {
+    row.resize(width * numberOfComponents);
+    }
+  for (int y = 0; y < height; ++y)
     {
-    for (int col = 0; col < width; ++col)
+    // mirror vertically
+    QRgb* rgbPtr = reinterpret_cast<QRgb*>(image.scanLine(height - 1 - y));
+    void* scalars = imageData->GetScalarPointer(extent[0], extent[2] + y, extent[4]);
+    if (scalarType == VTK_UNSIGNED_CHAR)
+      {
+      ctk::pixelsToQRgb(static_cast<unsigned char*>(scalars),
+                        numberOfComponents, rgbPtr, width);
+      continue;
+      }
+    switch (scalarType)
       {
-      // Swap rgb
-      *(rgbPtr++) = QColor(colorsPtr[0], colorsPtr[1], colorsPtr[2]).rgb();
-      colorsPtr +=  3;
+      vtkTemplateMacro(clampToUnsignedChar(static_cast<VTK_TT*>(scalars),
+                                           row.data(), row.size()));
       }
-    rgbPtr -= width * 2;
+    ctk::pixelsToQRgb(row.constData(), numberOfComponents, rgbPtr, width);
     }
   return image;
 }
@@ -23,6 +23,7 @@
 
 // Qt includes
 #include <QRect>
+#include <QRgb>
 class QImage;
 class QWidget;
 
@@ -43,9 +44,21 @@ QImage CTK_VISUALIZATION_VTK_WIDGETS_EXPORT grabVTKWidget(QWidget* widget, QRect
 
 ///
 /// \ingroup Visualization_VTK_Widgets
-/// Convert a vtkImageData into a QImage
+/// Convert a vtkImageData into a QImage.
+/// Only the update extent is converted if it is set, the whole image
+/// otherwise. Images with 1 (luminance), 2 (luminance, alpha), 3 (RGB) or
+/// 4 (RGBA) components are supported, non unsigned char scalars are clamped
+/// to [0, 255].
 QImage CTK_VISUALIZATION_VTK_WIDGETS_EXPORT vtkImageDataToQImage(vtkImageData* imageData);
 
+///
+/// \ingroup Visualization_VTK_Widgets
+/// Convert \a count pixels of \a numberOfComponents unsigned chars
+/// (luminance, luminance-alpha, RGB or RGBA) into QRgb values.
+/// \a source and \a destination can be the same buffer for RGBA pixels.
+void CTK_VISUALIZATION_VTK_WIDGETS_EXPORT pixelsToQRgb(const unsigned char* source, int numberOfComponents,
+                                                       QRgb* destination, int count);
+
 }
 
 #endif
@@ -79,6 +79,7 @@ set(ctk_cmake_boolean_args
   CTK_BUILD_QTDESIGNER_PLUGINS
   CTK_USE_QTTESTING
   CTK_USE_KWSTYLE
+  CTK_BUILD_BENCHMARKS
   CTK_USE_CONTRIBUTED_PLUGINS
   WITH_COVERAGE
   DOCUMENTATION_TARGET_IN_ALL